@@ -264,6 +264,112 @@ int AGC(_squelch_get_status)(AGC() _q);                                     \
 LIQUID_AGC_DEFINE_API(LIQUID_AGC_MANGLE_CRCF, float, liquid_float_complex)
 LIQUID_AGC_DEFINE_API(LIQUID_AGC_MANGLE_RRRF, float, float)
 
+#define LIQUID_AGCBANK_MANGLE_CRCF(name) LIQUID_CONCAT(agcbank_crcf, name)
+#define LIQUID_AGCBANK_MANGLE_RRRF(name) LIQUID_CONCAT(agcbank_rrrf, name)
+
+#define LIQUID_AGCBANK_DEFINE_API(AGCBANK,T,TC)                             \
+                                                                            \
+/* Multi-channel automatic gain control: one independent gain control   */  \
+/* loop per channel with the same response as the agc object, updated   */  \
+/* for several channels at once (e.g. on channelizer outputs)           */  \
+typedef struct AGCBANK(_s) * AGCBANK();                                     \
+                                                                            \
+/* Create multi-channel automatic gain control object.                  */  \
+/*  _num_channels  : number of channels, _num_channels > 0              */  \
+AGCBANK() AGCBANK(_create)(unsigned int _num_channels);                     \
+                                                                            \
+/* Destroy object, freeing all internally-allocated memory.             */  \
+void AGCBANK(_destroy)(AGCBANK() _q);                                       \
+                                                                            \
+/* Print object properties to stdout                                    */  \
+void AGCBANK(_print)(AGCBANK() _q);                                         \
+                                                                            \
+/* Reset gain estimates, lock status, and squelch mode of all channels  */  \
+void AGCBANK(_reset)(AGCBANK() _q);                                         \
+                                                                            \
+/* Get number of channels                                               */  \
+unsigned int AGCBANK(_get_num_channels)(AGCBANK() _q);                      \
+                                                                            \
+/* Execute automatic gain control on a single sample of each channel    */  \
+/*  _q      : automatic gain control object                             */  \
+/*  _x      : input samples, [size: num_channels x 1]                   */  \
+/*  _y      : output samples, [size: num_channels x 1]                  */  \
+void AGCBANK(_execute)(AGCBANK() _q,                                        \
+                       TC *      _x,                                        \
+                       TC *      _y);                                       \
+                                                                            \
+/* Execute automatic gain control on a block of samples of each channel */  \
+/* where samples are stored time-major: all channels of the first       */  \
+/* sample, then all channels of the second, and so on.                  */  \
+/*  _q      : automatic gain control object                             */  \
+/*  _x      : input samples, [size: _n*num_channels x 1]                */  \
+/*  _n      : number of samples per channel                             */  \
+/*  _y      : output samples, [size: _n*num_channels x 1]               */  \
+void AGCBANK(_execute_block)(AGCBANK()    _q,                               \
+                             TC *         _x,                               \
+                             unsigned int _n,                               \
+                             TC *         _y);                              \
+                                                                            \
+/* Lock gain of a particular channel (see agc lock method)              */  \
+void AGCBANK(_lock)(AGCBANK() _q, unsigned int _channel);                   \
+                                                                            \
+/* Unlock gain of a particular channel                                  */  \
+void AGCBANK(_unlock)(AGCBANK() _q, unsigned int _channel);                 \
+                                                                            \
+/* Set loop filter bandwidth of all channels                            */  \
+/*  _q      : automatic gain control object                             */  \
+/*  _bt     : bandwidth-time constant, _bt > 0                          */  \
+void AGCBANK(_set_bandwidth)(AGCBANK() _q, float _bt);                      \
+                                                                            \
+/* Get loop filter bandwidth                                            */  \
+float AGCBANK(_get_bandwidth)(AGCBANK() _q);                                \
+                                                                            \
+/* Get gain currently being applied to a particular channel (linear)    */  \
+float AGCBANK(_get_gain)(AGCBANK() _q, unsigned int _channel);              \
+                                                                            \
+/* Set gain of a particular channel (linear)                            */  \
+/*  _q       : automatic gain control object                            */  \
+/*  _channel : channel index                                            */  \
+/*  _gain    : gain to apply to input signal, _gain > 0                 */  \
+void AGCBANK(_set_gain)(AGCBANK()    _q,                                    \
+                        unsigned int _channel,                              \
+                        float        _gain);                                \
+                                                                            \
+/* Get estimated received signal strength of a particular channel [dB]  */  \
+float AGCBANK(_get_rssi)(AGCBANK() _q, unsigned int _channel);              \
+                                                                            \
+/* Get output scaling applied to each sample (linear)                   */  \
+float AGCBANK(_get_scale)(AGCBANK() _q);                                    \
+                                                                            \
+/* Set output scaling of all channels (linear)                          */  \
+void AGCBANK(_set_scale)(AGCBANK() _q, float _scale);                       \
+                                                                            \
+/* Enable squelch mode on all channels                                  */  \
+void AGCBANK(_squelch_enable)(AGCBANK() _q);                                \
+                                                                            \
+/* Disable squelch mode on all channels                                 */  \
+void AGCBANK(_squelch_disable)(AGCBANK() _q);                               \
+                                                                            \
+/* Set threshold for enabling/disabling squelch [dB]                    */  \
+void AGCBANK(_squelch_set_threshold)(AGCBANK() _q,                          \
+                                     T         _thresh);                    \
+                                                                            \
+/* Get squelch threshold (value in dB)                                  */  \
+T    AGCBANK(_squelch_get_threshold)(AGCBANK() _q);                         \
+                                                                            \
+/* Set timeout before enabling squelch [samples]                        */  \
+void AGCBANK(_squelch_set_timeout)(AGCBANK()    _q,                         \
+                                   unsigned int _timeout);                  \
+                                                                            \
+/* Get squelch timeout (number of samples)                              */  \
+unsigned int AGCBANK(_squelch_get_timeout)(AGCBANK() _q);                   \
+                                                                            \
+/* Get squelch status of a particular channel                           */  \
+int AGCBANK(_squelch_get_status)(AGCBANK() _q, unsigned int _channel);      \
+
+LIQUID_AGCBANK_DEFINE_API(LIQUID_AGCBANK_MANGLE_CRCF, float, liquid_float_complex)
+LIQUID_AGCBANK_DEFINE_API(LIQUID_AGCBANK_MANGLE_RRRF, float, float)
+
 
 
 //
@@ -1084,7 +1190,7 @@ unsigned int crc_sizeof_key(crc_scheme _scheme);
 
 
 // available FEC schemes
-#define LIQUID_FEC_NUM_SCHEMES  28
+#define LIQUID_FEC_NUM_SCHEMES  32
 typedef enum {
     LIQUID_FEC_UNKNOWN=0,       // unknown/unsupported scheme
     LIQUID_FEC_NONE,            // no error-correction
@@ -1121,7 +1227,13 @@ typedef enum {
     LIQUID_FEC_CONV_V29P78,     // r7/8, K=9, dfree=4
 
     // Reed-Solomon codes
-    LIQUID_FEC_RS_M8            // m=8, n=255, k=223
+    LIQUID_FEC_RS_M8,           // m=8, n=255, k=223
+
+    // quasi-cyclic low-density parity-check codes (n=1536, Z=64)
+    LIQUID_FEC_LDPC_R12,        // r1/2, k=768
+    LIQUID_FEC_LDPC_R23,        // r2/3, k=1024
+    LIQUID_FEC_LDPC_R34,        // r3/4, k=1152
+    LIQUID_FEC_LDPC_R56         // r5/6, k=1280
 } fec_scheme;
 
 // pretty names for fec schemes
@@ -1249,6 +1361,29 @@ packetizer packetizer_recreate(packetizer _p,
                                int _fec0,
                                int _fec1);
 
+// compute size of workspace (bytes) required to run a packetizer
+// with any decoded length up to _max_len without allocating memory
+//  _max_len:   maximum number of uncoded input bytes
+//  _crc    :   error-detecting scheme
+//  _fec0   :   inner forward error-correction code
+//  _fec1   :   outer forward error-correction code
+unsigned int packetizer_get_workspace_size(unsigned int _max_len,
+                                           int          _crc,
+                                           int          _fec0,
+                                           int          _fec1);
+
+// set external workspace for internal buffers; subsequent calls to
+// packetizer_recreate() with the same schemes and a length within the
+// workspace size re-configure the object in place. Memory must remain
+// valid until the workspace is removed (_workspace=NULL) or the object
+// is destroyed.
+//  _p          :   packetizer object
+//  _workspace  :   workspace memory (NULL to revert to internal memory)
+//  _size       :   workspace size (bytes)
+void packetizer_set_workspace(packetizer   _p,
+                              void *       _workspace,
+                              unsigned int _size);
+
 // destroy packetizer object
 void packetizer_destroy(packetizer _p);
 
@@ -1607,6 +1742,47 @@ void SPGRAM(_estimate_psd)(unsigned int _nfft,                              \
                            TI *         _x,                                 \
                            unsigned int _n,                                 \
                            T *          _psd);                              \
+                                                                            \
+/* Estimate spectrum on input signal with Welch's method: the signal is */  \
+/* split into overlapping segments (transform t covers samples          */  \
+/* [t*_delay, t*_delay+_window_len)), which are processed on separate   */  \
+/* threads with independent FFT plans. Partial results are reduced in a */  \
+/* fixed order so that the output does not depend on the number of      */  \
+/* threads. Each bin is either the mean or the given percentile of the  */  \
+/* transforms (the latter from a 0.25 dB histogram). Returns 0 on       */  \
+/* success.                                                             */  \
+/*  _nfft       : FFT size                                              */  \
+/*  _wtype      : window type, e.g. LIQUID_WINDOW_HAMMING               */  \
+/*  _window_len : window length, _window_len <= _nfft                   */  \
+/*  _delay      : delay between transforms, _delay > 0                  */  \
+/*  _x          : input signal, [size: _n x 1]                          */  \
+/*  _n          : input signal length, _n >= _window_len                */  \
+/*  _percentile : percentile in [0,1], or -1 for mean                   */  \
+/*  _num_threads: number of threads                                     */  \
+/*  _psd        : output spectrum (dB), [size: _nfft x 1]               */  \
+int SPGRAM(_estimate_psd_welch)(unsigned int _nfft,                         \
+                                int          _wtype,                        \
+                                unsigned int _window_len,                   \
+                                unsigned int _delay,                        \
+                                TI *         _x,                            \
+                                uint64_t     _n,                            \
+                                float        _percentile,                   \
+                                unsigned int _num_threads,                  \
+                                T *          _psd);                         \
+                                                                            \
+/* Estimate spectrum of samples stored in a file (raw, native-endian    */  \
+/* values of the input type) with Welch's method; the file is memory-  */  \
+/* mapped where supported. Returns 0 on success.                        */  \
+/*  _filename   : input file name                                       */  \
+/*  (remaining arguments as for _estimate_psd_welch)                    */  \
+int SPGRAM(_estimate_psd_file)(const char * _filename,                      \
+                               unsigned int _nfft,                          \
+                               int          _wtype,                         \
+                               unsigned int _window_len,                    \
+                               unsigned int _delay,                         \
+                               float        _percentile,                    \
+                               unsigned int _num_threads,                   \
+                               T *          _psd);                          \
 
 LIQUID_SPGRAM_DEFINE_API(LIQUID_SPGRAM_MANGLE_CFLOAT,
                          float,
@@ -1708,6 +1884,23 @@ LIQUID_ASGRAM_DEFINE_API(LIQUID_ASGRAM_MANGLE_FLOAT,
 // spectral periodogram waterfall
 //
 
+// spwaterfall stream export file header; all fields are native-endian
+// and rows of num_freq float values follow at offset header_size
+struct spwaterfall_stream_header_s {
+    char                magic[4];       // "LQWF"
+    unsigned int        version;        // format version (1)
+    unsigned int        header_size;    // offset of first row [bytes]
+    unsigned int        num_freq;       // row length (FFT size)
+    unsigned int        decim;          // pyramid level decimation (1,2,4,8)
+    unsigned int        num_transforms; // transforms per row
+    unsigned int        delay;          // samples between transforms
+    float               frequency;      // center frequency [Hz]
+    float               sample_rate;    // sample rate [Hz] (-1 if unset)
+    unsigned int        reserved;       // reserved (zero)
+    unsigned long long  sample_offset;  // sample count at start of stream
+    unsigned long long  num_rows;       // number of rows written
+};
+
 #define LIQUID_SPWATERFALL_MANGLE_CFLOAT(name) LIQUID_CONCAT(spwaterfallcf,name)
 #define LIQUID_SPWATERFALL_MANGLE_FLOAT(name)  LIQUID_CONCAT(spwaterfallf, name)
 
@@ -1815,6 +2008,25 @@ void SPWATERFALL(_write)(SPWATERFALL() _q,                                  \
 /*  _base : base filename (will export .gnu, .bin, and .png files)      */  \
 int SPWATERFALL(_export)(SPWATERFALL() _q,                                  \
                          const char *  _base);                              \
+                                                                            \
+/* Start streaming export: every _decim transforms a row (fft-shifted   */  \
+/* PSD in dB) is appended to the memory-mapped file <_base>.x1.lqw, and */  \
+/* time-decimated pyramid levels are built incrementally in the files   */  \
+/* <_base>.x2.lqw, <_base>.x4.lqw and <_base>.x8.lqw by log-averaging   */  \
+/* pairs of rows from the level below. Each file begins with a header   */  \
+/* (see struct spwaterfall_stream_header_s) whose row count is updated  */  \
+/* as rows are appended, so files can be read while being written.      */  \
+/* Only a small window of each file is mapped at any time.              */  \
+/*  _q      : spwaterfall object                                        */  \
+/*  _base   : base filename                                             */  \
+/*  _decim  : number of transforms per base row, _decim > 0             */  \
+int SPWATERFALL(_stream_open)(SPWATERFALL() _q,                             \
+                              const char *  _base,                          \
+                              unsigned int  _decim);                        \
+                                                                            \
+/* Stop streaming export, truncating files to the number of rows        */  \
+/* written; incomplete rows are discarded.                              */  \
+int SPWATERFALL(_stream_close)(SPWATERFALL() _q);                           \
 
 
 LIQUID_SPWATERFALL_DEFINE_API(LIQUID_SPWATERFALL_MANGLE_CFLOAT,
@@ -3047,6 +3259,104 @@ LIQUID_IIRFILT_DEFINE_API(LIQUID_IIRFILT_MANGLE_CCCF,
                           liquid_float_complex)
 
 
+//
+// Multi-channel infinite impulse response filter bank
+//
+
+#define LIQUID_IIRFILTBANK_MANGLE_RRRF(name) LIQUID_CONCAT(iirfiltbank_rrrf,name)
+#define LIQUID_IIRFILTBANK_MANGLE_CRCF(name) LIQUID_CONCAT(iirfiltbank_crcf,name)
+#define LIQUID_IIRFILTBANK_MANGLE_CCCF(name) LIQUID_CONCAT(iirfiltbank_cccf,name)
+
+// Macro:
+//   IIRFILTBANK : name-mangling macro
+//   TO          : output data type
+//   TC          : coefficients data type
+//   TI          : input data type
+#define LIQUID_IIRFILTBANK_DEFINE_API(IIRFILTBANK,TO,TC,TI)                 \
+                                                                            \
+/* Bank of identical infinite impulse response (IIR) filters, each      */  \
+/* operating on an independent channel. Channels are filtered in        */  \
+/* parallel with results identical to separate iirfilt objects created  */  \
+/* from the same second-order sections.                                 */  \
+typedef struct IIRFILTBANK(_s) * IIRFILTBANK();                             \
+                                                                            \
+/* Create filter bank from second-order sections                        */  \
+/*  _B             : feed-forward coefficients [size: _nsos x 3]        */  \
+/*  _A             : feed-back coefficients    [size: _nsos x 3]        */  \
+/*  _nsos          : number of second-order sections, _nsos > 0         */  \
+/*  _num_channels  : number of channels, _num_channels > 0              */  \
+IIRFILTBANK() IIRFILTBANK(_create_sos)(TC *         _B,                     \
+                                       TC *         _A,                     \
+                                       unsigned int _nsos,                  \
+                                       unsigned int _num_channels);         \
+                                                                            \
+/* Create filter bank from design template (second-order sections)      */  \
+/*  _ftype         : filter type (e.g. LIQUID_IIRDES_BUTTER)            */  \
+/*  _btype         : band type (e.g. LIQUID_IIRDES_BANDPASS)            */  \
+/*  _order         : filter order, _order > 0                           */  \
+/*  _fc            : low-pass prototype cut-off frequency               */  \
+/*  _f0            : center frequency (band-pass, band-stop)            */  \
+/*  _Ap            : pass-band ripple in dB, _Ap > 0                    */  \
+/*  _As            : stop-band ripple in dB, _As > 0                    */  \
+/*  _num_channels  : number of channels, _num_channels > 0              */  \
+IIRFILTBANK() IIRFILTBANK(_create_prototype)(                               \
+            liquid_iirdes_filtertype _ftype,                                \
+            liquid_iirdes_bandtype   _btype,                                \
+            unsigned int             _order,                                \
+            float                    _fc,                                   \
+            float                    _f0,                                   \
+            float                    _Ap,                                   \
+            float                    _As,                                   \
+            unsigned int             _num_channels);                        \
+                                                                            \
+/* Destroy filter bank object, freeing all internal memory              */  \
+void IIRFILTBANK(_destroy)(IIRFILTBANK() _q);                               \
+                                                                            \
+/* Print filter bank object properties to stdout                        */  \
+void IIRFILTBANK(_print)(IIRFILTBANK() _q);                                 \
+                                                                            \
+/* Reset internal state of all channels                                 */  \
+void IIRFILTBANK(_reset)(IIRFILTBANK() _q);                                 \
+                                                                            \
+/* Get number of channels                                               */  \
+unsigned int IIRFILTBANK(_get_num_channels)(IIRFILTBANK() _q);              \
+                                                                            \
+/* Execute filter bank on one sample from each channel                  */  \
+/*  _q      : filter bank object                                        */  \
+/*  _x      : input array, [size: num_channels x 1]                     */  \
+/*  _y      : output array, [size: num_channels x 1]                    */  \
+void IIRFILTBANK(_execute)(IIRFILTBANK() _q,                                \
+                           TI *          _x,                                \
+                           TO *          _y);                               \
+                                                                            \
+/* Execute filter bank on a block of samples stored time-major, i.e.    */  \
+/* sample i of channel k is at index i*num_channels + k; in-place       */  \
+/* operation is permitted                                               */  \
+/*  _q      : filter bank object                                        */  \
+/*  _x      : input array, [size: _n*num_channels x 1]                  */  \
+/*  _n      : number of samples per channel                             */  \
+/*  _y      : output array, [size: _n*num_channels x 1]                 */  \
+void IIRFILTBANK(_execute_block)(IIRFILTBANK() _q,                          \
+                                 TI *          _x,                          \
+                                 unsigned int  _n,                          \
+                                 TO *          _y);                         \
+
+LIQUID_IIRFILTBANK_DEFINE_API(LIQUID_IIRFILTBANK_MANGLE_RRRF,
+                              float,
+                              float,
+                              float)
+
+LIQUID_IIRFILTBANK_DEFINE_API(LIQUID_IIRFILTBANK_MANGLE_CRCF,
+                              liquid_float_complex,
+                              float,
+                              liquid_float_complex)
+
+LIQUID_IIRFILTBANK_DEFINE_API(LIQUID_IIRFILTBANK_MANGLE_CCCF,
+                              liquid_float_complex,
+                              liquid_float_complex,
+                              liquid_float_complex)
+
+
 //
 // FIR Polyphase filter bank
 //
@@ -3696,6 +4006,18 @@ void RESAMP2(_decim_execute)(RESAMP2() _q,                                  \
                              TI *      _x,                                  \
                              TO *      _y);                                 \
                                                                             \
+/* Execute resampler as half-band decimator on a block of samples; the  */  \
+/* filter branch is computed with a symmetric (folded) kernel that only */  \
+/* touches the non-zero taps for real coefficients.                     */  \
+/*  _q  : resampler object                                              */  \
+/*  _x  : input array, [size: 2*_n x 1]                                 */  \
+/*  _n  : number of output samples                                      */  \
+/*  _y  : output array, [size: _n x 1]                                  */  \
+void RESAMP2(_decim_execute_block)(RESAMP2()    _q,                         \
+                                   TI *         _x,                         \
+                                   unsigned int _n,                         \
+                                   TO *         _y);                        \
+                                                                            \
 /* Execute resampler as half-band interpolator on a single input sample */  \
 /*  _q  : resampler object                                              */  \
 /*  _x  : input sample                                                  */  \
@@ -3703,6 +4025,16 @@ void RESAMP2(_decim_execute)(RESAMP2() _q,                                  \
 void RESAMP2(_interp_execute)(RESAMP2() _q,                                 \
                               TI        _x,                                 \
                               TO *      _y);                                \
+                                                                            \
+/* Execute resampler as half-band interpolator on a block of samples    */  \
+/*  _q  : resampler object                                              */  \
+/*  _x  : input array, [size: _n x 1]                                   */  \
+/*  _n  : number of input samples                                       */  \
+/*  _y  : output array, [size: 2*_n x 1]                                */  \
+void RESAMP2(_interp_execute_block)(RESAMP2()    _q,                        \
+                                    TI *         _x,                        \
+                                    unsigned int _n,                        \
+                                    TO *         _y);                       \
 
 LIQUID_RESAMP2_DEFINE_API(LIQUID_RESAMP2_MANGLE_RRRF,
                           float,
@@ -3852,6 +4184,19 @@ float RRESAMP(_get_rate)(RRESAMP() _q);                                     \
 void RRESAMP(_execute)(RRESAMP()       _q,                                  \
                         TI *           _x,                                  \
                         TO *           _y);                                 \
+                                                                            \
+/* Execute rational-rate resampler on many blocks of input samples and  */  \
+/* store the resulting samples in the output array. This is equivalent  */  \
+/* to calling execute() _n times on consecutive blocks, but computes    */  \
+/* every output from a pre-computed schedule in a single pass.          */  \
+/*  _q  : resamp object                                                 */  \
+/*  _x  : input sample array, [size: Q*_n x 1]                          */  \
+/*  _n  : number of blocks                                              */  \
+/*  _y  : output sample array [size: P*_n x 1]                          */  \
+void RRESAMP(_execute_block)(RRESAMP()      _q,                             \
+                             TI *           _x,                             \
+                             unsigned int   _n,                             \
+                             TO *           _y);                            \
 
 LIQUID_RRESAMP_DEFINE_API(LIQUID_RRESAMP_MANGLE_RRRF,
                           float,
@@ -3944,6 +4289,14 @@ void RESAMP(_set_timing_phase)(RESAMP() _q,                                 \
 void RESAMP(_adjust_timing_phase)(RESAMP() _q,                              \
                                   float    _delta);                         \
                                                                             \
+/* Get the exact number of output samples the resampler will produce    */  \
+/* for the next _num_input input samples given its current state; use   */  \
+/* to size the output buffer for _execute_block()                       */  \
+/*  _q          : resampling object                                     */  \
+/*  _num_input  : number of input samples                               */  \
+unsigned int RESAMP(_get_num_output)(RESAMP()     _q,                       \
+                                     unsigned int _num_input);              \
+                                                                            \
 /* Execute arbitrary resampler on a single input sample and store the   */  \
 /* resulting samples in the output array. The number of output samples  */  \
 /* is depenent upon the resampling rate but will be at most             */  \
@@ -3988,6 +4341,122 @@ LIQUID_RESAMP_DEFINE_API(LIQUID_RESAMP_MANGLE_CCCF,
                          liquid_float_complex)
 
 
+// 
+// Arbitrary resampler (Farrow structure)
+//
+#define LIQUID_FRESAMP_MANGLE_RRRF(name) LIQUID_CONCAT(fresamp_rrrf,name)
+#define LIQUID_FRESAMP_MANGLE_CRCF(name) LIQUID_CONCAT(fresamp_crcf,name)
+
+#define LIQUID_FRESAMP_DEFINE_API(FRESAMP,TO,TC,TI)                         \
+                                                                            \
+/* Arbitrary rate resampler, implemented with a Farrow structure: each  */  \
+/* filter tap is a low-order polynomial in the fractional sample delay  */  \
+/* so no filterbank needs to be stored                                  */  \
+typedef struct FRESAMP(_s) * FRESAMP();                                     \
+                                                                            \
+/* Create Farrow resampler object from filter prototype                 */  \
+/*  _rate   : arbitrary resampling rate,         0 < _rate              */  \
+/*  _m      : filter semi-length (delay),        0 < _m                 */  \
+/*  _order  : polynomial order,                  1 <= _order <= 7       */  \
+/*  _fc     : filter cutoff frequency,           0 < _fc < 0.5          */  \
+/*  _As     : filter stop-band attenuation [dB], 0 < _As                */  \
+FRESAMP() FRESAMP(_create)(float        _rate,                              \
+                           unsigned int _m,                                 \
+                           unsigned int _order,                             \
+                           float        _fc,                                \
+                           float        _As);                               \
+                                                                            \
+/* Create Farrow resampler object with a specified resampling rate and  */  \
+/* default parameters                                                   */  \
+/*  m     = 8                  (filter semi-length),                    */  \
+/*  order = 3                  (polynomial order),                      */  \
+/*  fc    = 0.45*min(1,_rate)  (filter cutoff frequency), and           */  \
+/*  As    = 60 dB              (filter stop-band attenuation).          */  \
+/*  _rate   : arbitrary resampling rate,         0 < _rate              */  \
+FRESAMP() FRESAMP(_create_default)(float _rate);                            \
+                                                                            \
+/* Destroy Farrow resampler object, freeing all internal memory         */  \
+void FRESAMP(_destroy)(FRESAMP() _q);                                       \
+                                                                            \
+/* Print fresamp object internals to stdout                             */  \
+void FRESAMP(_print)(FRESAMP() _q);                                         \
+                                                                            \
+/* Reset fresamp object internals                                       */  \
+void FRESAMP(_reset)(FRESAMP() _q);                                         \
+                                                                            \
+/* Get resampler delay (filter semi-length \(m\))                       */  \
+unsigned int FRESAMP(_get_delay)(FRESAMP() _q);                             \
+                                                                            \
+/* Set rate of Farrow resampler                                         */  \
+/*  _q      : resampling object                                         */  \
+/*  _rate   : new sampling rate, _rate > 0                              */  \
+void FRESAMP(_set_rate)(FRESAMP() _q,                                       \
+                        float     _rate);                                   \
+                                                                            \
+/* Get rate of Farrow resampler                                         */  \
+float FRESAMP(_get_rate)(FRESAMP() _q);                                     \
+                                                                            \
+/* Adjust rate of Farrow resampler                                      */  \
+/*  _q      : resampling object                                         */  \
+/*  _gamma  : rate adjustment factor: rate <- rate * gamma, _gamma > 0  */  \
+void FRESAMP(_adjust_rate)(FRESAMP() _q,                                    \
+                           float     _gamma);                               \
+                                                                            \
+/* Set resampling timing phase                                          */  \
+/*  _q      : resampling object                                         */  \
+/*  _tau    : sample timing phase, -1 <= _tau <= 1                      */  \
+void FRESAMP(_set_timing_phase)(FRESAMP() _q,                               \
+                                float     _tau);                            \
+                                                                            \
+/* Adjust resampling timing phase                                       */  \
+/*  _q      : resampling object                                         */  \
+/*  _delta  : sample timing adjustment, -1 <= _delta <= 1               */  \
+void FRESAMP(_adjust_timing_phase)(FRESAMP() _q,                            \
+                                   float     _delta);                       \
+                                                                            \
+/* Get the exact number of output samples the resampler will produce    */  \
+/* for the next _num_input input samples given its current state        */  \
+/*  _q          : resampling object                                     */  \
+/*  _num_input  : number of input samples                               */  \
+unsigned int FRESAMP(_get_num_output)(FRESAMP()    _q,                      \
+                                      unsigned int _num_input);             \
+                                                                            \
+/* Execute Farrow resampler on a single input sample and store the      */  \
+/* resulting samples in the output array                                */  \
+/*  _q              : fresamp object                                    */  \
+/*  _x              : single input sample                               */  \
+/*  _y              : output sample array (pointer)                     */  \
+/*  _num_written    : number of samples written to _y                   */  \
+void FRESAMP(_execute)(FRESAMP()      _q,                                   \
+                       TI             _x,                                   \
+                       TO *           _y,                                   \
+                       unsigned int * _num_written);                        \
+                                                                            \
+/* Execute Farrow resampler on a block of input samples, operating      */  \
+/* directly on the input buffer rather than copying each sample into    */  \
+/* the internal window                                                  */  \
+/*  _q              : fresamp object                                    */  \
+/*  _x              : input buffer, [size: _nx x 1]                     */  \
+/*  _nx             : input buffer size                                 */  \
+/*  _y              : output sample array (pointer)                     */  \
+/*  _ny             : number of samples written to _y                   */  \
+void FRESAMP(_execute_block)(FRESAMP()      _q,                             \
+                             TI *           _x,                             \
+                             unsigned int   _nx,                            \
+                             TO *           _y,                             \
+                             unsigned int * _ny);                           \
+
+LIQUID_FRESAMP_DEFINE_API(LIQUID_FRESAMP_MANGLE_RRRF,
+                          float,
+                          float,
+                          float)
+
+LIQUID_FRESAMP_DEFINE_API(LIQUID_FRESAMP_MANGLE_CRCF,
+                          liquid_float_complex,
+                          float,
+                          liquid_float_complex)
+
+
 // 
 // Multi-stage half-band resampler
 //
@@ -4051,6 +4520,19 @@ float MSRESAMP2(_get_delay)(MSRESAMP2() _q);                                \
 void MSRESAMP2(_execute)(MSRESAMP2() _q,                                    \
                          TI *        _x,                                    \
                          TO *        _y);                                   \
+                                                                            \
+/* Execute multi-stage resampler on a block of samples; each half-band  */  \
+/* stage processes the whole block before the next stage is run.        */  \
+/*  LIQUID_RESAMP_INTERP:   input: _n,   output: _n*M                   */  \
+/*  LIQUID_RESAMP_DECIM:    input: _n*M, output: _n                     */  \
+/*  _q      : msresamp object                                           */  \
+/*  _x      : input sample array                                        */  \
+/*  _n      : number of executions (input/output groups)                */  \
+/*  _y      : output sample array                                       */  \
+void MSRESAMP2(_execute_block)(MSRESAMP2()  _q,                             \
+                               TI *         _x,                             \
+                               unsigned int _n,                             \
+                               TO *         _y);                            \
 
 LIQUID_MSRESAMP2_DEFINE_API(LIQUID_MSRESAMP2_MANGLE_RRRF,
                             float,
@@ -4455,6 +4937,38 @@ void framedatastats_reset(framedatastats_s * _stats);
 // print framedatastats object
 void framedatastats_print(framedatastats_s * _stats);
 
+// frameprofile : execution time of frame synchronizer stages
+typedef enum {
+    LIQUID_FRAMEPROFILE_DETECT=0,   // frame detection (preamble search)
+    LIQUID_FRAMEPROFILE_PREAMBLE,   // preamble reception, timing/carrier recovery
+    LIQUID_FRAMEPROFILE_HEADER,     // header reception and decoding
+    LIQUID_FRAMEPROFILE_PAYLOAD,    // payload symbol reception
+    LIQUID_FRAMEPROFILE_DECODE,     // payload demodulation and decoding
+    LIQUID_FRAMEPROFILE_CALLBACK,   // user callback
+    LIQUID_FRAMEPROFILE_NUM_STAGES
+} liquid_frameprofile_stage;
+
+// stage names
+extern const char * liquid_frameprofile_stage_str[LIQUID_FRAMEPROFILE_NUM_STAGES];
+
+typedef struct {
+    int      enabled;                                   // profiling enabled?
+    uint64_t num_calls [LIQUID_FRAMEPROFILE_NUM_STAGES];// number of times each stage was entered
+    uint64_t num_ns    [LIQUID_FRAMEPROFILE_NUM_STAGES];// elapsed time in each stage [ns]
+    uint64_t num_cycles[LIQUID_FRAMEPROFILE_NUM_STAGES];// elapsed time-stamp counter cycles (zero if unavailable)
+
+    // internal timing state
+    int      stage;                                     // active stage (-1 if none)
+    uint64_t t0_ns;                                     // start time of active stage [ns]
+    uint64_t t0_cycles;                                 // start counter of active stage
+} frameprofile_s;
+
+// reset frameprofile object, retaining enabled flag
+void frameprofile_reset(frameprofile_s * _profile);
+
+// print frameprofile object
+void frameprofile_print(frameprofile_s * _profile);
+
 
 // Generic frame synchronizer callback function type
 //  _header         :   header data [size: 8 bytes]
@@ -4696,6 +5210,12 @@ void framesync64_debug_print(framesync64 _q, const char * _filename);
 void             framesync64_reset_framedatastats(framesync64 _q);
 framedatastats_s framesync64_get_framedatastats  (framesync64 _q);
 
+// profiling of internal stages (disabled by default)
+void           framesync64_profile_enable (framesync64 _q);
+void           framesync64_profile_disable(framesync64 _q);
+void           framesync64_reset_profile  (framesync64 _q);
+frameprofile_s framesync64_get_profile    (framesync64 _q);
+
 #if 0
 // advanced modes
 void framesync64_set_csma_callbacks(framesync64             _q,
@@ -4763,9 +5283,9 @@ void flexframegen_assemble(flexframegen          _q,
                            const unsigned char * _payload,
                            unsigned int          _payload_len);
 
-// write samples of assembled frame, two samples at a time, returning
-// '1' when frame is complete, '0' otherwise. Zeros will be written
-// to the buffer if the frame is not assembled
+// write samples of assembled frame, returning '1' when frame is
+// complete, '0' otherwise. Zeros will be written to the buffer if
+// the frame is not assembled
 //  _q          :   frame generator object
 //  _buffer     :   output buffer [size: _buffer_len x 1]
 //  _buffer_len :   output buffer length
@@ -4773,6 +5293,30 @@ int flexframegen_write_samples(flexframegen           _q,
                                liquid_float_complex * _buffer,
                                unsigned int           _buffer_len);
 
+// assemble and write a batch of frames with a common header to one
+// contiguous buffer, separated by _gap zero-valued samples; stops at
+// the first frame which does not fit in the remaining buffer. Any
+// frame currently assembled is discarded. Returns number of frames
+// written.
+//  _q          :   frame generator object
+//  _header     :   frame header (NULL for zeros)
+//  _payloads   :   payload data for each frame [size: _n x 1]
+//  _lens       :   payload data length for each frame [size: _n x 1]
+//  _n          :   number of frames
+//  _gap        :   number of zero-valued samples between frames
+//  _buffer     :   output buffer [size: _buffer_len x 1]
+//  _buffer_len :   output buffer length
+//  _num_written:   number of samples written (ignored if NULL)
+unsigned int flexframegen_generate_batch(flexframegen            _q,
+                                         const unsigned char *   _header,
+                                         const unsigned char * * _payloads,
+                                         const unsigned int *    _lens,
+                                         unsigned int            _n,
+                                         unsigned int            _gap,
+                                         liquid_float_complex *  _buffer,
+                                         unsigned int            _buffer_len,
+                                         unsigned int *          _num_written);
+
 // frame synchronizer
 
 typedef struct flexframesync_s * flexframesync;
@@ -4811,6 +5355,20 @@ void flexframesync_decode_payload_soft(flexframesync _q,
 int flexframesync_set_header_props(flexframesync          _q,
                                    flexframegenprops_s * _props);
 
+// set number of threads used to decode frame payloads; with one or more
+// threads the synchronizer only captures payload symbols and hands them
+// off to worker threads which demodulate and decode the payload and
+// invoke the callback. Callbacks are never invoked concurrently, always
+// fire in the order frames were received, and may be invoked after
+// flexframesync_execute() returns; they must not call back into the
+// synchronizer. Zero (the default) decodes on the calling thread.
+void flexframesync_set_decode_threads(flexframesync _q,
+                                      unsigned int  _num_threads);
+
+// block until all received frames have been decoded and delivered
+// (no-op when called from within the callback)
+void flexframesync_drain(flexframesync _q);
+
 // push samples through frame synchronizer
 //  _q      :   frame synchronizer object
 //  _x      :   input samples [size: _n x 1]
@@ -4823,12 +5381,68 @@ void flexframesync_execute(flexframesync          _q,
 void             flexframesync_reset_framedatastats(flexframesync _q);
 framedatastats_s flexframesync_get_framedatastats  (flexframesync _q);
 
+// profiling of internal stages (disabled by default)
+void           flexframesync_profile_enable (flexframesync _q);
+void           flexframesync_profile_disable(flexframesync _q);
+void           flexframesync_reset_profile  (flexframesync _q);
+frameprofile_s flexframesync_get_profile    (flexframesync _q);
+
 // enable/disable debugging
 void flexframesync_debug_enable(flexframesync _q);
 void flexframesync_debug_disable(flexframesync _q);
 void flexframesync_debug_print(flexframesync _q,
                                const char *  _filename);
 
+// flexframe receiver for overlapping frames: a single detector runs
+// continuously and each detected frame is received by its own pooled
+// synchronizer context, so frames arriving while another frame is being
+// received are not lost
+typedef struct flexframesyncbank_s * flexframesyncbank;
+
+// create flexframesyncbank object
+//  _num_contexts   :   maximum number of frames received at once, > 0
+//  _callback       :   callback function
+//  _userdata       :   user data pointer passed to callback function
+flexframesyncbank flexframesyncbank_create(unsigned int       _num_contexts,
+                                           framesync_callback _callback,
+                                           void *             _userdata);
+
+// destroy, print, reset frame receiver
+void flexframesyncbank_destroy(flexframesyncbank _q);
+void flexframesyncbank_print  (flexframesyncbank _q);
+void flexframesyncbank_reset  (flexframesyncbank _q);
+
+// set number of threads used to run synchronizer contexts (including the
+// calling thread); callbacks are always invoked on the calling thread
+void flexframesyncbank_set_num_threads(flexframesyncbank _q,
+                                       unsigned int      _num_threads);
+
+// get number of contexts currently receiving a frame
+unsigned int flexframesyncbank_get_num_active(flexframesyncbank _q);
+
+// get number of detections dropped because all contexts were busy
+unsigned int flexframesyncbank_get_num_dropped(flexframesyncbank _q);
+
+// header and payload decoding options (see flexframesync)
+void flexframesyncbank_set_header_len     (flexframesyncbank _q, unsigned int _len);
+void flexframesyncbank_decode_header_soft (flexframesyncbank _q, int _soft);
+void flexframesyncbank_decode_payload_soft(flexframesyncbank _q, int _soft);
+int  flexframesyncbank_set_header_props   (flexframesyncbank     _q,
+                                           flexframegenprops_s * _props);
+
+// push samples through frame receiver; callbacks for frames completed
+// within the call are invoked in order of frame arrival
+//  _q      :   frame receiver object
+//  _x      :   input samples [size: _n x 1]
+//  _n      :   number of input samples
+void flexframesyncbank_execute(flexframesyncbank      _q,
+                               liquid_float_complex * _x,
+                               unsigned int           _n);
+
+// frame data statistics
+void             flexframesyncbank_reset_framedatastats(flexframesyncbank _q);
+framedatastats_s flexframesyncbank_get_framedatastats  (flexframesyncbank _q);
+
 //
 // bpacket : binary packet suitable for data streaming
 //
@@ -4969,6 +5583,12 @@ void fskframesync_debug_enable (fskframesync _q);
 void fskframesync_debug_disable(fskframesync _q);
 void fskframesync_debug_export (fskframesync _q, const char * _filename);
 
+// profiling of internal stages (disabled by default)
+void           fskframesync_profile_enable (fskframesync _q);
+void           fskframesync_profile_disable(fskframesync _q);
+void           fskframesync_reset_profile  (fskframesync _q);
+frameprofile_s fskframesync_get_profile    (fskframesync _q);
+
 
 //
 // GMSK frame generator
@@ -5020,6 +5640,12 @@ void gmskframesync_debug_enable(gmskframesync _q);
 void gmskframesync_debug_disable(gmskframesync _q);
 void gmskframesync_debug_print(gmskframesync _q, const char * _filename);
 
+// profiling of internal stages (disabled by default)
+void           gmskframesync_profile_enable (gmskframesync _q);
+void           gmskframesync_profile_disable(gmskframesync _q);
+void           gmskframesync_reset_profile  (gmskframesync _q);
+frameprofile_s gmskframesync_get_profile    (gmskframesync _q);
+
 
 //
 // DSSS frame generator
@@ -5088,6 +5714,12 @@ void dsssframesync_debug_enable(dsssframesync _q);
 void dsssframesync_debug_disable(dsssframesync _q);
 void dsssframesync_debug_print(dsssframesync _q, const char * _filename);
 
+// profiling of internal stages (disabled by default)
+void           dsssframesync_profile_enable (dsssframesync _q);
+void           dsssframesync_profile_disable(dsssframesync _q);
+void           dsssframesync_reset_profile  (dsssframesync _q);
+frameprofile_s dsssframesync_get_profile    (dsssframesync _q);
+
 // 
 // OFDM flexframe generator
 //
@@ -5200,6 +5832,15 @@ void ofdmflexframesync_decode_payload_soft(ofdmflexframesync _q,
 void ofdmflexframesync_set_header_props(ofdmflexframesync _q,
                                         ofdmflexframegenprops_s * _props);
 
+// set number of threads used to decode frame payloads (see
+// flexframesync_set_decode_threads()); zero decodes on the calling thread
+void ofdmflexframesync_set_decode_threads(ofdmflexframesync _q,
+                                          unsigned int      _num_threads);
+
+// block until all received frames have been decoded and delivered
+// (no-op when called from within the callback)
+void ofdmflexframesync_drain(ofdmflexframesync _q);
+
 void ofdmflexframesync_reset(ofdmflexframesync _q);
 int  ofdmflexframesync_is_frame_open(ofdmflexframesync _q);
 void ofdmflexframesync_execute(ofdmflexframesync _q,
@@ -5221,6 +5862,12 @@ void ofdmflexframesync_debug_disable(ofdmflexframesync _q);
 void ofdmflexframesync_debug_print(ofdmflexframesync _q,
                                    const char *      _filename);
 
+// profiling of internal stages (disabled by default)
+void           ofdmflexframesync_profile_enable (ofdmflexframesync _q);
+void           ofdmflexframesync_profile_disable(ofdmflexframesync _q);
+void           ofdmflexframesync_reset_profile  (ofdmflexframesync _q);
+frameprofile_s ofdmflexframesync_get_profile    (ofdmflexframesync _q);
+
 
 
 //
@@ -5465,6 +6112,29 @@ int detector_cccf_correlate(detector_cccf        _q,
                             float *              _dphi_hat,
                             float *              _gamma_hat);
 
+// Run block of samples through pre-demod detector's correlator, stopping
+// after the first sample on which a signal is detected. Approximately
+// equivalent to calling detector_cccf_correlate() on each sample
+// (frequency-domain rounding may change marginal detections), but
+// computes all correlators over blocks in the frequency domain
+// (overlap-save) when this is less expensive. Returns the number of
+// samples consumed.
+//  _q          :   pre-demod detector
+//  _x          :   input samples, [size: _n x 1]
+//  _n          :   number of input samples
+//  _detected   :   set to '1' if signal was detected on the last
+//                  consumed sample, '0' otherwise
+//  _tau_hat    :   fractional sample offset estimate (set when detected)
+//  _dphi_hat   :   carrier frequency offset estimate (set when detected)
+//  _gamma_hat  :   channel gain estimate (set when detected)
+unsigned int detector_cccf_correlate_block(detector_cccf          _q,
+                                           liquid_float_complex * _x,
+                                           unsigned int           _n,
+                                           int *                  _detected,
+                                           float *                _tau_hat,
+                                           float *                _dphi_hat,
+                                           float *                _gamma_hat);
+
 
 // 
 // symbol streaming for testing (no meaningful data, just symbols)
@@ -7886,6 +8556,34 @@ void SYNTH(_despread_triple)(SYNTH() _q,                        \
                              TC *_early,                        \
                              TC *_punctual,                     \
                              TC *_late);                        \
+                                                                \
+/* Despread _n consecutive symbols of _length chips each,  */   \
+/* stepping synth                                          */   \
+/*  _x      : input chips [size: _n*_length x 1]           */   \
+/*  _n      : number of symbols                            */   \
+/*  _y      : despread symbols [size: _n x 1]              */   \
+void SYNTH(_despread_block)(SYNTH() _q,                         \
+                            TC *_x,                             \
+                            unsigned int _n,                    \
+                            TC *_y);                            \
+                                                                \
+/* Despread _n consecutive symbols with early, punctual,   */   \
+/* and late correlation outputs [each size: _n x 1]        */   \
+void SYNTH(_despread_triple_block)(SYNTH() _q,                  \
+                                   TC *_x,                      \
+                                   unsigned int _n,             \
+                                   TC *_early,                  \
+                                   TC *_punctual,               \
+                                   TC *_late);                  \
+                                                                \
+/* Correlate one symbol of input against every code phase  */   \
+/* for acquisition (no stepping); output _y[p] aligns the  */   \
+/* first input chip with table entry p                     */   \
+/*  _x      : input chips [size: _length x 1]              */   \
+/*  _y      : normalized correlation [size: _length x 1]   */   \
+void SYNTH(_correlate_phases)(SYNTH() _q,                       \
+                              TC *_x,                           \
+                              TC *_y);                          \
 
 // Define synth APIs
 LIQUID_SYNTH_DEFINE_API(SYNTH_MANGLE_FLOAT, float, liquid_float_complex)
@@ -8330,6 +9028,12 @@ void bsequence_print(bsequence _bs);
 void bsequence_push(bsequence _bs,
                     unsigned int _bit);
 
+// Push several bits into back of a binary sequence at once, starting
+// with the most-significant of the _n right-justified bits, _n <= 32
+void bsequence_push_bits(bsequence    _bs,
+                         unsigned int _bits,
+                         unsigned int _n);
+
 // circular shift (left)
 void bsequence_circshift(bsequence _bs);
 
@@ -8689,6 +9393,91 @@ void liquid_vectorf_add(float *      _a,
                         float *      _c);
 #endif
 
+//
+// MODULE : flowgraph (streaming processing graph)
+//
+
+// data type carried on a flowgraph port
+typedef enum {
+    LIQUID_FLOWGRAPH_NONE=0,    // no port (source input, sink output)
+    LIQUID_FLOWGRAPH_FLOAT,     // float
+    LIQUID_FLOWGRAPH_CFLOAT,    // float complex
+    LIQUID_FLOWGRAPH_BYTE,      // unsigned char
+} liquid_flowgraph_type;
+
+// flowgraph node callback, invoked with a block of input samples and
+// returning the number of output samples written
+//  _userdata   :   user-defined data pointer (e.g. liquid object)
+//  _x          :   input samples (NULL for source nodes)
+//  _nx         :   number of input samples (sources: maximum number of
+//                  output samples to generate)
+//  _y          :   output samples (NULL for sink nodes)
+//  returns number of output samples; a source returns 0 when exhausted
+typedef unsigned int (*flowgraph_callback)(void *       _userdata,
+                                           void *       _x,
+                                           unsigned int _nx,
+                                           void *       _y);
+
+typedef struct flowgraph_s * flowgraph;
+
+// create flowgraph object
+//  _block_len  :   maximum number of input samples per node execution
+flowgraph flowgraph_create(unsigned int _block_len);
+void      flowgraph_destroy(flowgraph _g);
+void      flowgraph_print  (flowgraph _g);
+
+// add generic node to graph, returning node index. Each execution
+// consumes a multiple of _decim input samples and produces roughly
+// _interp output samples for every _decim inputs (a small margin is
+// allowed for timing recovery and arbitrary-rate resampling).
+//  _g          :   flowgraph object
+//  _name       :   node name (for printing)
+//  _type_in    :   input port type (LIQUID_FLOWGRAPH_NONE for sources)
+//  _type_out   :   output port type (LIQUID_FLOWGRAPH_NONE for sinks)
+//  _interp     :   nominal output samples per _decim input samples
+//  _decim      :   input sample granularity
+//  _callback   :   execution callback
+//  _userdata   :   user-defined data pointer passed to callback
+unsigned int flowgraph_add_node(flowgraph             _g,
+                                const char *          _name,
+                                liquid_flowgraph_type _type_in,
+                                liquid_flowgraph_type _type_out,
+                                unsigned int          _interp,
+                                unsigned int          _decim,
+                                flowgraph_callback    _callback,
+                                void *                _userdata);
+
+// connect output of node _src to input of node _dst; an output port
+// may drive several inputs, but each input has exactly one driver
+void flowgraph_connect(flowgraph    _g,
+                       unsigned int _src,
+                       unsigned int _dst);
+
+// run graph until all sources are exhausted and all buffers drained;
+// nodes execute concurrently on _num_threads worker threads (if
+// threads are unavailable the graph runs on the calling thread)
+void flowgraph_run(flowgraph    _g,
+                   unsigned int _num_threads);
+
+// get number of times node has been executed during last run
+unsigned int flowgraph_get_num_executions(flowgraph    _g,
+                                          unsigned int _node);
+
+// adapters for common objects (complex float ports)
+unsigned int flowgraph_add_nco_crcf_mix_down(flowgraph _g, nco_crcf _q);
+unsigned int flowgraph_add_firfilt_crcf     (flowgraph _g, firfilt_crcf _q);
+unsigned int flowgraph_add_agc_crcf         (flowgraph _g, agc_crcf _q);
+unsigned int flowgraph_add_resamp_crcf      (flowgraph _g, resamp_crcf _q);
+unsigned int flowgraph_add_firdecim_crcf    (flowgraph _g, firdecim_crcf _q,
+                                             unsigned int _M);
+unsigned int flowgraph_add_firinterp_crcf   (flowgraph _g, firinterp_crcf _q,
+                                             unsigned int _M);
+unsigned int flowgraph_add_symsync_crcf     (flowgraph _g, symsync_crcf _q,
+                                             unsigned int _k,
+                                             unsigned int _k_out);
+unsigned int flowgraph_add_framesync64      (flowgraph _g, framesync64 _q);
+unsigned int flowgraph_add_flexframesync    (flowgraph _g, flexframesync _q);
+
 #ifdef __cplusplus
 } //extern "C"
 #endif // __cplusplus
@@ -42,6 +42,10 @@
 #  define LIBFEC_ENABLED 1
 #endif
 
+#if defined HAVE_PTHREAD_H && defined HAVE_LIBPTHREAD
+#  define LIQUID_PTHREADS_ENABLED 1
+#endif
+
 
 //
 // Debugging macros
@@ -144,6 +148,21 @@ struct fec_s {
     int * derrlocs;             // decoded error locations [size: 1 x n]
     int erasures;               // number of erasures
 
+    // LDPC (quasi-cyclic, layered min-sum decoder)
+    const int * ldpc_base;      // base matrix shifts [size: mb x nb], -1 for empty
+    unsigned int ldpc_mb;       // number of base matrix rows (layers)
+    unsigned int ldpc_nb;       // number of base matrix columns
+    unsigned int ldpc_Z;        // lifting factor (circulant size)
+    unsigned int ldpc_num_edges;// number of non-empty circulants in base matrix
+    unsigned int ldpc_max_iterations; // maximum number of decoder iterations
+    unsigned int * ldpc_row_ptr;// edge offsets for each layer [size: mb+1 x 1]
+    unsigned int * ldpc_col;    // base column index for each edge
+    unsigned int * ldpc_shift;  // circulant shift for each edge
+    float * ldpc_L;             // posterior log-likelihood ratios [size: nb*Z x 1]
+    float * ldpc_R;             // check-to-variable messages [size: num_edges*Z x 1]
+    float * ldpc_t;             // variable-to-check messages for a layer
+    unsigned char * ldpc_c;     // codeword bits, one per byte [size: nb*Z x 1]
+
     // encode function pointer
     void (*encode_func)(fec _q,
                         unsigned int _dec_msg_len,
@@ -168,6 +187,7 @@ int fec_scheme_is_convolutional(fec_scheme _scheme);
 int fec_scheme_is_punctured(fec_scheme _scheme);
 int fec_scheme_is_reedsolomon(fec_scheme _scheme);
 int fec_scheme_is_hamming(fec_scheme _scheme);
+int fec_scheme_is_ldpc(fec_scheme _scheme);
 int fec_scheme_is_repeat(fec_scheme _scheme);
 
 // Pass
@@ -285,15 +305,35 @@ unsigned int fecsoft_hamming128_decode(unsigned char * _soft_bits);
 extern unsigned char fecsoft_hamming128_n3[256][17];
 unsigned int fecsoft_hamming128_decode_n3(unsigned char * _soft_bits);
 
+// batch decoding of _n symbol pairs packed into 3*_n bytes
+void fec_hamming128_decode_batch(unsigned int    _n,
+                                 unsigned char * _msg_enc,
+                                 unsigned char * _msg_dec);
+
+// batch soft decoding (nearest neighbors) of _n symbols [12*_n soft bits]
+void fecsoft_hamming128_decode_batch(unsigned int    _n,
+                                     unsigned char * _soft_bits,
+                                     unsigned char * _sym_dec);
+
 
 // Hamming(15,11)
 unsigned int fec_hamming1511_encode_symbol(unsigned int _sym_dec);
 unsigned int fec_hamming1511_decode_symbol(unsigned int _sym_enc);
 
+// batch decoding of _n symbols
+void fec_hamming1511_decode_batch(unsigned int         _n,
+                                  unsigned short int * _sym_enc,
+                                  unsigned short int * _sym_dec);
+
 // Hamming(31,26)
 unsigned int fec_hamming3126_encode_symbol(unsigned int _sym_dec);
 unsigned int fec_hamming3126_decode_symbol(unsigned int _sym_enc);
 
+// batch decoding of _n symbols
+void fec_hamming3126_decode_batch(unsigned int   _n,
+                                  unsigned int * _sym_enc,
+                                  unsigned int * _sym_dec);
+
 
 // Golay(24,12)
 
@@ -303,6 +343,17 @@ extern unsigned int golay2412_P[12];
 extern unsigned int golay2412_Gt[24];
 extern unsigned int golay2412_H[12];
 
+// syndrome contribution of each byte of a 24-bit received symbol
+// (most-significant byte first) [size: 3 x 256], and estimated error
+// on the 12 message bits for each syndrome [size: 4096]
+extern unsigned short int golay2412_syndrome_gentab[3][256];
+extern unsigned short int golay2412_ehat_gentab[4096];
+
+// batch decoding of _n symbol pairs packed into 6*_n bytes
+void fec_golay2412_decode_batch(unsigned int    _n,
+                                unsigned char * _msg_enc,
+                                unsigned char * _msg_dec);
+
 // multiply input vector with matrix
 unsigned int golay2412_matrix_mul(unsigned int   _v,
                                   unsigned int * _A,
@@ -583,6 +634,53 @@ void fec_rs_decode(fec _q,
                    unsigned char * _msg_enc,
                    unsigned char * _msg_dec);
 
+// LDPC codes (quasi-cyclic, dual-diagonal parity structure)
+#define FEC_LDPC_NB         (24)    // number of base matrix columns
+#define FEC_LDPC_Z          (64)    // lifting factor
+#define FEC_LDPC_ALPHA      (0.75f) // min-sum normalization factor
+#define FEC_LDPC_MAX_ITER   (20)    // default maximum number of iterations
+
+// base matrices (circulant shifts, -1 for zero block)
+extern const int fec_ldpc_r12_base[12*FEC_LDPC_NB];
+extern const int fec_ldpc_r23_base[ 8*FEC_LDPC_NB];
+extern const int fec_ldpc_r34_base[ 6*FEC_LDPC_NB];
+extern const int fec_ldpc_r56_base[ 4*FEC_LDPC_NB];
+
+// compute encoded message length for LDPC codes
+//  _dec_msg_len    :   decoded message length (bytes)
+//  _k              :   information bytes per codeword
+//  _p              :   parity bytes per codeword
+unsigned int fec_ldpc_get_enc_msg_len(unsigned int _dec_msg_len,
+                                      unsigned int _k,
+                                      unsigned int _p);
+
+fec fec_ldpc_create(fec_scheme _fs);
+void fec_ldpc_destroy(fec _q);
+void fec_ldpc_setlength(fec _q,
+                        unsigned int _dec_msg_len);
+void fec_ldpc_encode(fec _q,
+                     unsigned int _dec_msg_len,
+                     unsigned char * _msg_dec,
+                     unsigned char * _msg_enc);
+void fec_ldpc_decode(fec _q,
+                     unsigned int _dec_msg_len,
+                     unsigned char * _msg_enc,
+                     unsigned char * _msg_dec);
+void fec_ldpc_decode_soft(fec _q,
+                          unsigned int _dec_msg_len,
+                          unsigned char * _msg_enc,
+                          unsigned char * _msg_dec);
+
+// run layered normalized min-sum decoder on a single codeword using
+// posterior log-likelihood ratios in _q->ldpc_L (positive for '0'),
+// returning the number of iterations run or -1 if the parity checks
+// failed to converge
+int fec_ldpc_decode_codeword(fec _q);
+
+// check parity of hard decisions from posterior log-likelihood
+// ratios in _q->ldpc_L, returning 1 if all checks are satisfied
+int fec_ldpc_check_parity(fec _q);
+
 // phi(x) = -logf( tanhf( x/2 ) )
 float sumproduct_phi(float _x);
 
@@ -623,6 +721,24 @@ int fec_sumproduct_step(unsigned int    _m,
                         float *         _LQ,
                         unsigned char * _parity);
 
+//
+// interleaver
+//
+
+// get size of external workspace (bytes) required for an
+// interleaver of length _n bytes
+unsigned int interleaver_get_workspace_size(unsigned int _n);
+
+// set interleaver length, keeping current depth
+//  _q          :   interleaver object
+//  _n          :   new length (bytes)
+//  _workspace  :   external memory of at least
+//                  interleaver_get_workspace_size(_n) bytes aligned
+//                  for unsigned int, or NULL to use internal memory
+void interleaver_set_length(interleaver  _q,
+                            unsigned int _n,
+                            void *       _workspace);
+
 //
 // packetizer
 //
@@ -657,8 +773,57 @@ struct packetizer_s {
     unsigned int buffer_len;
     unsigned char * buffer_0;
     unsigned char * buffer_1;
+
+    // external workspace (NULL if using internal memory)
+    unsigned char * workspace;
+    unsigned int workspace_size;
+};
+
+// packetizer cache: small set of packetizer objects keyed by
+// (length, crc, fec0, fec1) for objects which switch between
+// configurations frequently (e.g. frame generators)
+#define PACKETIZER_CACHE_LEN (4)
+typedef struct packetizer_cache_s * packetizer_cache;
+struct packetizer_cache_s {
+    packetizer   p[PACKETIZER_CACHE_LEN];       // cached objects
+    unsigned int stamp[PACKETIZER_CACHE_LEN];   // time of last use
+    unsigned int counter;                       // access counter
 };
 
+// create/destroy packetizer cache
+packetizer_cache packetizer_cache_create();
+void packetizer_cache_destroy(packetizer_cache _c);
+
+// get packetizer matching configuration, re-configuring the least
+// recently used entry if none is found
+packetizer packetizer_cache_get(packetizer_cache _c,
+                                unsigned int     _n,
+                                int              _crc,
+                                int              _fec0,
+                                int              _fec1);
+
+
+//
+// MODULE : flowgraph
+//
+
+// adapter state for wrapping liquid objects as flowgraph nodes
+struct flowgraph_adapter_s {
+    void *       q;     // wrapped object
+    unsigned int M;     // object rate parameter (e.g. decimation rate)
+};
+
+// add node with adapter state owned by the graph; the callback is
+// invoked with a pointer to the adapter state
+unsigned int flowgraph_add_adapter(flowgraph             _g,
+                                   const char *          _name,
+                                   liquid_flowgraph_type _type_in,
+                                   liquid_flowgraph_type _type_out,
+                                   unsigned int          _interp,
+                                   unsigned int          _decim,
+                                   flowgraph_callback    _callback,
+                                   void *                _object,
+                                   unsigned int          _M);
 
 //
 // MODULE : fft (fast discrete Fourier transform)
@@ -877,6 +1042,19 @@ void IIRFILTSOS(_execute_df2)(IIRFILTSOS() _q,                  \
 /*  _fc     : frequency to evaluate                         */  \
 float IIRFILTSOS(_groupdelay)(IIRFILTSOS() _q,                  \
                               float        _fc);                \
+                                                                \
+/* run cascade of sections on block of samples; the input   */  \
+/* and output arrays may be the same                        */  \
+/*  _q      : array of sections [size: _nsos x 1]           */  \
+/*  _nsos   : number of sections                            */  \
+/*  _x      : input array [size: _n x 1]                    */  \
+/*  _n      : number of samples                             */  \
+/*  _y      : output array [size: _n x 1]                   */  \
+void IIRFILTSOS(_execute_cascade_block)(IIRFILTSOS() * _q,      \
+                                        unsigned int   _nsos,   \
+                                        TI *           _x,      \
+                                        unsigned int   _n,      \
+                                        TO *           _y);     \
 
 LIQUID_IIRFILTSOS_DEFINE_INTERNAL_API(LIQUID_IIRFILTSOS_MANGLE_RRRF,
                                       float,
@@ -1082,6 +1260,33 @@ void bpacketsync_decode_payload(bpacketsync _q);
 void bpacketsync_reconfig(bpacketsync _q);
 
 
+//
+// frameprofile
+//
+
+// accumulate time spent in active stage (if any) and start timing
+// _stage (none if negative); reads the clocks, so callers check
+// the enabled flag first
+void frameprofile_set_stage(frameprofile_s * _profile,
+                            int              _stage);
+
+// switch active profiling stage, accumulating time spent in previous
+// stage; no-op if profiling is disabled or stage is unchanged
+static inline void frameprofile_switch(frameprofile_s * _profile,
+                                       int              _stage)
+{
+    if (_profile->enabled && _profile->stage != _stage)
+        frameprofile_set_stage(_profile, _stage);
+}
+
+// stop timing active stage (no-op if profiling is disabled)
+static inline void frameprofile_stop(frameprofile_s * _profile)
+{
+    if (_profile->enabled && _profile->stage >= 0)
+        frameprofile_set_stage(_profile, -1);
+}
+
+
 // 
 // flexframe
 //
@@ -1097,6 +1302,21 @@ void bpacketsync_reconfig(bpacketsync _q);
 #define FLEXFRAME_H_FEC1         (LIQUID_FEC_HAMMING84)  // header FEC (outer)
 #define FLEXFRAME_H_MOD          (LIQUID_MODEM_QPSK)     // modulation scheme
 
+// start receiving frame from external detector estimates; the next
+// sample pushed is the first sample of the detector buffer
+void flexframesync_start_frame(flexframesync _q,
+                               float         _tau,
+                               float         _dphi,
+                               float         _phi,
+                               float         _gamma);
+
+// push samples through synchronizer for a frame started with
+// flexframesync_start_frame(), stopping once the frame is complete;
+// returns number of samples consumed
+unsigned int flexframesync_execute_frame(flexframesync   _q,
+                                         float complex * _x,
+                                         unsigned int    _n);
+
 
 // 
 // gmskframe
@@ -1137,6 +1357,70 @@ void bpacketsync_reconfig(bpacketsync _q);
 #define DSSSFRAME_H_FEC0         (LIQUID_FEC_GOLAY2412)
 #define DSSSFRAME_H_FEC1         (LIQUID_FEC_NONE)
 
+//
+// framedecpool : asynchronous payload decoder for frame synchronizers
+//
+
+// pooled frame; fields above 'internal' are set by the synchronizer
+// between acquire() and submit()
+typedef struct framedecpool_frame_s * framedecpool_frame;
+struct framedecpool_frame_s {
+    unsigned char *     header;         // decoded header [size: header_len]
+    unsigned int        header_len;     // decoded header length
+    int                 header_valid;   // header valid flag
+    float complex *     payload_sym;    // received payload symbols
+    unsigned int        payload_sym_len;// number of payload symbols
+    unsigned int        payload_len;    // decoded payload length [bytes]
+    int                 check;          // payload validity check
+    int                 fec0;           // payload FEC (inner)
+    int                 fec1;           // payload FEC (outer)
+    int                 mod_scheme;     // payload modulation scheme
+    int                 soft;           // soft-decision decoding flag
+    framesyncstats_s    stats;          // frame statistics
+
+    // internal
+    unsigned int        header_cap;     // header buffer size
+    unsigned int        payload_sym_cap;// payload symbol buffer size
+    unsigned char *     payload_dec;    // decoded payload
+    unsigned int        payload_dec_cap;// decoded payload buffer size
+    int                 payload_valid;  // payload valid flag
+    unsigned long       seq;            // submission sequence number
+    framedecpool_frame  next;           // free list/queue link
+};
+
+typedef struct framedecpool_s * framedecpool;
+
+// create pool
+//  _num_threads    :   number of worker threads (0: decode on calling thread)
+//  _num_frames     :   number of pooled frames, _num_frames > 0
+//  _callback       :   user-defined callback function
+//  _userdata       :   user-defined data structure passed to callback
+//  _stats          :   packet statistics updated on delivery (may be NULL)
+framedecpool framedecpool_create(unsigned int       _num_threads,
+                                 unsigned int       _num_frames,
+                                 framesync_callback _callback,
+                                 void *             _userdata,
+                                 framedatastats_s * _stats);
+void framedecpool_destroy(framedecpool _q);
+unsigned int framedecpool_get_num_threads(framedecpool _q);
+
+// acquire frame from pool, blocking until one is available
+framedecpool_frame framedecpool_acquire(framedecpool _q,
+                                        unsigned int _header_len,
+                                        unsigned int _payload_sym_len);
+
+// return acquired frame to pool without submitting it
+void framedecpool_release(framedecpool       _q,
+                          framedecpool_frame _f);
+
+// submit acquired frame for decoding and in-order delivery
+void framedecpool_submit(framedecpool       _q,
+                         framedecpool_frame _f);
+
+// block until every submitted frame has been delivered; returns
+// immediately when called from within the callback
+void framedecpool_drain(framedecpool _q);
+
 //
 // multi-signal source for testing (no meaningful data, just signals)
 //
@@ -1640,6 +1924,26 @@ LIQUID_NCO_DEFINE_INTERNAL_API(LIQUID_NCO_MANGLE_FLOAT,
 void SYNTH(_constrain_phase)(SYNTH() _q);                       \
 void SYNTH(_constrain_frequency)(SYNTH() _q);                   \
 void SYNTH(_compute_synth)(SYNTH() _q);                         \
+unsigned int SYNTH(_compute_index)(SYNTH() _q);                 \
+                                                                \
+/* despread up to 16 consecutive symbols in one pass    */      \
+/* (early/late outputs optional) [each size: _n x 1]    */      \
+void SYNTH(_despread_symbols)(SYNTH() _q,                       \
+                              TC * _x,                          \
+                              unsigned int _n,                  \
+                              TC * _early,                      \
+                              TC * _punctual,                   \
+                              TC * _late);                      \
+                                                                \
+/* despreading kernels                                  */      \
+void SYNTH(_compute_abs)(TC * _x, unsigned int _n, T * _y);     \
+void SYNTH(_correlate)(TC *         _x,                         \
+                       T *          _x_abs,                     \
+                       TC *         _r,                         \
+                       T *          _r_abs,                     \
+                       unsigned int _n,                         \
+                       TC *         _v,                         \
+                       T *          _sum);                      \
                                                                 \
 /* reset internal phase-locked loop filter              */      \
 void SYNTH(_pll_reset)(SYNTH() _q);                             \
@@ -1913,6 +2217,23 @@ extern const unsigned char liquid_c_ones_mod2[256];
     liquid_c_ones_mod2[ ((x)>>16)  & 0xff ] +       \
     liquid_c_ones_mod2[ ((x)>>24)  & 0xff ]) % 2)
 
+// count the number of ones in a 64-bit word
+unsigned int liquid_count_ones_uint64(uint64_t _x);
+
+// count the number of different bits between an input sequence and each
+// of a bank of reference sequences, all packed in 64-bit words; uses the
+// POPCNT instruction when the processor supports it (checked at run time)
+//  _x          :   input sequence, [size: _num_words x 1]
+//  _h          :   reference sequences, [size: _num_seq*_num_words x 1]
+//  _num_words  :   number of words in each sequence
+//  _num_seq    :   number of reference sequences
+//  _d          :   number of different bits, [size: _num_seq x 1]
+void liquid_count_bit_errors_bank64(uint64_t *     _x,
+                                    uint64_t *     _h,
+                                    unsigned int   _num_words,
+                                    unsigned int   _num_seq,
+                                    unsigned int * _d);
+
 // compute binary dot-products (inline pre-processor macros)
 #define liquid_bdotprod_uint8(x,y)  liquid_c_ones_mod2[(x)&(y)]
 #define liquid_bdotprod_uint16(x,y) liquid_count_ones_mod2_uint16((x)&(y))
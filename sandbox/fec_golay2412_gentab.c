@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+//
+// Golay(24,12) code syndrome decoding table generator
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+int main()
+{
+    unsigned int i, k;
+
+    // syndrome is linear in the received symbol; compute contribution
+    // of each of the three bytes separately
+    printf("// syndrome contribution of each byte of received symbol\n");
+    printf("unsigned short int golay2412_syndrome_gentab[3][256] = {\n");
+    for (k=0; k<3; k++) {
+        printf("  {\n    ");
+        for (i=0; i<256; i++) {
+            unsigned int v = i << (16 - 8*k);
+            printf("0x%.3x", golay2412_matrix_mul(v, golay2412_H, 12));
+            if (i != 255)               printf(", ");
+            if ( ((i+1)%8) == 0 && i != 255) printf("\n    ");
+        }
+        printf("}%s\n", k==2 ? "};" : ",");
+    }
+    printf("\n");
+
+    // The error vector estimated by the decoder only depends upon the
+    // syndrome; the received vector [s 0(12)] has syndrome s, so decoding
+    // it yields the estimated error on the message bits directly.
+    printf("// estimated error on message bits for each syndrome\n");
+    printf("unsigned short int golay2412_ehat_gentab[4096] = {\n    ");
+    for (i=0; i<4096; i++) {
+        printf("0x%.3x", fec_golay2412_decode_symbol(i << 12));
+        if (i != 4095)
+            printf(", ");
+        else
+            printf("};");
+
+        if ( ((i+1)%8) == 0)
+            printf("\n    ");
+    }
+    printf("\n");
+
+    return 0;
+}
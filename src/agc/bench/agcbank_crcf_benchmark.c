@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include <stdlib.h>
+
+#include "liquid.h"
+
+// helper function to keep code base small
+//  _num_channels   :   number of channels
+//  _bank           :   use agcbank (1) or independent agc objects (0)
+void agcbank_crcf_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _num_channels,
+                        int                 _bank)
+{
+    // normalize number of iterations to number of samples processed
+    *_num_iterations /= _num_channels;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned int i, k;
+    unsigned int n = 64;    // samples per channel per block
+    float complex * x = (float complex*) malloc(n*_num_channels*sizeof(float complex));
+    float complex * y = (float complex*) malloc(n*_num_channels*sizeof(float complex));
+    for (i=0; i<n*_num_channels; i++)
+        x[i] = 0.1f*(randnf() + _Complex_I*randnf());
+
+    agcbank_crcf q = agcbank_crcf_create(_num_channels);
+    agcbank_crcf_set_bandwidth(q, 0.05f);
+    agc_crcf agc[_num_channels];
+    for (k=0; k<_num_channels; k++) {
+        agc[k] = agc_crcf_create();
+        agc_crcf_set_bandwidth(agc[k], 0.05f);
+    }
+
+    unsigned long int t;
+    getrusage(RUSAGE_SELF, _start);
+    for (t=0; t<(*_num_iterations); t+=n) {
+        if (_bank) {
+            agcbank_crcf_execute_block(q, x, n, y);
+        } else {
+            for (i=0; i<n; i++) {
+                for (k=0; k<_num_channels; k++)
+                    agc_crcf_execute(agc[k], x[i*_num_channels+k], &y[i*_num_channels+k]);
+            }
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = t * _num_channels;
+
+    // destroy objects
+    agcbank_crcf_destroy(q);
+    for (k=0; k<_num_channels; k++)
+        agc_crcf_destroy(agc[k]);
+    free(x);
+    free(y);
+}
+
+#define AGCBANK_CRCF_BENCHMARK_API(M,BANK)  \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ agcbank_crcf_bench(_start, _finish, _num_iterations, M, BANK); }
+
+// independent agc objects vs. multi-channel agc
+void benchmark_agcbank_crcf_M1_agc      AGCBANK_CRCF_BENCHMARK_API(   1, 0)
+void benchmark_agcbank_crcf_M1          AGCBANK_CRCF_BENCHMARK_API(   1, 1)
+void benchmark_agcbank_crcf_M16_agc     AGCBANK_CRCF_BENCHMARK_API(  16, 0)
+void benchmark_agcbank_crcf_M16         AGCBANK_CRCF_BENCHMARK_API(  16, 1)
+void benchmark_agcbank_crcf_M1024_agc   AGCBANK_CRCF_BENCHMARK_API(1024, 0)
+void benchmark_agcbank_crcf_M1024       AGCBANK_CRCF_BENCHMARK_API(1024, 1)
@@ -36,6 +36,17 @@
 // internal method definition
 void AGC(_squelch_update_mode)(AGC() _q);
 
+// advance squelch state machine by one sample
+//  _mode       :   current squelch mode
+//  _timer      :   squelch timer
+//  _timeout    :   squelch timeout [samples]
+//  _exceeded   :   signal level exceeds squelch threshold?
+//  returns updated squelch mode
+int AGC(_squelch_step)(int            _mode,
+                       unsigned int * _timer,
+                       unsigned int   _timeout,
+                       int            _exceeded);
+
 // agc structure object
 struct AGC(_s) {
     // gain variables
@@ -168,8 +179,34 @@ void AGC(_execute_block)(AGC()        _q,
                          unsigned int _n,
                          TC *         _y)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++)
+    unsigned int i = 0;
+
+    // while locked the gain is fixed and the energy estimate is a linear
+    // recursion on the output; run it four samples at a time using
+    // precomputed powers of the decay factor
+    if (_q->is_locked) {
+        float d1 = 1.0f - _q->alpha;
+        float d2 = d1*d1;
+        float d3 = d2*d1;
+        float d4 = d2*d2;
+        float a  = _q->alpha;
+        for (i=0; i+4<=_n; i+=4) {
+            TC y0 = _x[i+0] * _q->g;
+            TC y1 = _x[i+1] * _q->g;
+            TC y2 = _x[i+2] * _q->g;
+            TC y3 = _x[i+3] * _q->g;
+            _y[i+0] = y0;
+            _y[i+1] = y1;
+            _y[i+2] = y2;
+            _y[i+3] = y3;
+            _q->y2_prime = d4*_q->y2_prime + a*(d3*crealf(y0*conjf(y0)) +
+                                                d2*crealf(y1*conjf(y1)) +
+                                                d1*crealf(y2*conjf(y2)) +
+                                                   crealf(y3*conjf(y3)));
+        }
+    }
+
+    for ( ; i<_n; i++)
         AGC(_execute)(_q, _x[i], &_y[i]);
 }
 
@@ -390,36 +427,44 @@ void AGC(_squelch_update_mode)(AGC() _q)
     int threshold_exceeded = (AGC(_get_rssi)(_q) > _q->squelch_threshold);
 
     // update state
-    switch (_q->squelch_mode) {
+    _q->squelch_mode = AGC(_squelch_step)(_q->squelch_mode,
+                                          &_q->squelch_timer,
+                                          _q->squelch_timeout,
+                                          threshold_exceeded);
+}
+
+// advance squelch state machine by one sample
+int AGC(_squelch_step)(int            _mode,
+                       unsigned int * _timer,
+                       unsigned int   _timeout,
+                       int            _exceeded)
+{
+    switch (_mode) {
     case LIQUID_AGC_SQUELCH_ENABLED:
-        _q->squelch_mode = threshold_exceeded ? LIQUID_AGC_SQUELCH_RISE : LIQUID_AGC_SQUELCH_ENABLED;
-        break;
+        return _exceeded ? LIQUID_AGC_SQUELCH_RISE : LIQUID_AGC_SQUELCH_ENABLED;
     case LIQUID_AGC_SQUELCH_RISE:
-        _q->squelch_mode = threshold_exceeded ? LIQUID_AGC_SQUELCH_SIGNALHI : LIQUID_AGC_SQUELCH_FALL;
-        break;
+        return _exceeded ? LIQUID_AGC_SQUELCH_SIGNALHI : LIQUID_AGC_SQUELCH_FALL;
     case LIQUID_AGC_SQUELCH_SIGNALHI:
-        _q->squelch_mode = threshold_exceeded ? LIQUID_AGC_SQUELCH_SIGNALHI : LIQUID_AGC_SQUELCH_FALL;
-        break;
+        return _exceeded ? LIQUID_AGC_SQUELCH_SIGNALHI : LIQUID_AGC_SQUELCH_FALL;
     case LIQUID_AGC_SQUELCH_FALL:
-        _q->squelch_mode = threshold_exceeded ? LIQUID_AGC_SQUELCH_SIGNALHI : LIQUID_AGC_SQUELCH_SIGNALLO;
-        _q->squelch_timer = _q->squelch_timeout;
-        break;
+        *_timer = _timeout;
+        return _exceeded ? LIQUID_AGC_SQUELCH_SIGNALHI : LIQUID_AGC_SQUELCH_SIGNALLO;
     case LIQUID_AGC_SQUELCH_SIGNALLO:
-        _q->squelch_timer--;
-        if (_q->squelch_timer == 0)
-            _q->squelch_mode = LIQUID_AGC_SQUELCH_TIMEOUT;
-        else if (threshold_exceeded)
-            _q->squelch_mode = LIQUID_AGC_SQUELCH_SIGNALHI;
-        break;
+        (*_timer)--;
+        if (*_timer == 0)
+            return LIQUID_AGC_SQUELCH_TIMEOUT;
+        else if (_exceeded)
+            return LIQUID_AGC_SQUELCH_SIGNALHI;
+        return LIQUID_AGC_SQUELCH_SIGNALLO;
     case LIQUID_AGC_SQUELCH_TIMEOUT:
-        _q->squelch_mode = LIQUID_AGC_SQUELCH_ENABLED;
-        break;
+        return LIQUID_AGC_SQUELCH_ENABLED;
     case LIQUID_AGC_SQUELCH_DISABLED:
-        break;
+        return LIQUID_AGC_SQUELCH_DISABLED;
     case LIQUID_AGC_SQUELCH_UNKNOWN:
     default:
         fprintf(stderr,"warning: agc_%s_execute(), invalid squelch mode: %d\n",
-                EXTENSION_FULL, _q->squelch_mode);
+                EXTENSION_FULL, _mode);
     }
+    return _mode;
 }
 
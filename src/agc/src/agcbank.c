@@ -0,0 +1,482 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Multi-channel automatic gain control
+//
+// Runs one gain control loop per channel with the same behavior as the
+// agc object, but with the energy estimate, gain update, and gain
+// application computed four channels at a time.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H
+#include <emmintrin.h>
+#define AGCBANK_USE_SSE 1
+#else
+#define AGCBANK_USE_SSE 0
+#endif
+
+// main object
+struct AGCBANK(_s) {
+    unsigned int    num_channels;   // number of channels
+
+    // per-channel state [size: num_channels x 1]
+    float *         g;              // current gain value
+    float *         y2_prime;       // filtered output signal energy estimate
+    unsigned int *  unlocked;       // all bits set if unlocked, else zero
+    int *           squelch_mode;   // squelch mode
+    unsigned int *  squelch_timer;  // squelch timer
+
+    // common parameters
+    float           scale;          // output scale value
+    float           bandwidth;      // bandwidth-time constant
+    float           alpha;          // feed-back gain
+    int             squelch_enabled;// squelch enabled on all channels
+    T               squelch_threshold;
+    unsigned int    squelch_timeout;
+};
+
+// update group of four channels for one sample
+//  _q      :   agcbank object
+//  _k      :   index of first channel in group
+//  _x      :   input samples [size: 4 x 1]
+//  _y      :   output samples [size: 4 x 1]
+void AGCBANK(_execute4)(AGCBANK() _q,
+                        unsigned int _k,
+                        TC *      _x,
+                        TC *      _y);
+
+// update single channel for one sample
+//  _q      :   agcbank object
+//  _k      :   channel index
+//  _x      :   input sample
+//  _y      :   output sample
+void AGCBANK(_execute1)(AGCBANK()    _q,
+                        unsigned int _k,
+                        TC           _x,
+                        TC *         _y);
+
+// update squelch state for all channels
+void AGCBANK(_squelch_update)(AGCBANK() _q);
+
+// create multi-channel agc object
+//  _num_channels   :   number of channels
+AGCBANK() AGCBANK(_create)(unsigned int _num_channels)
+{
+    if (_num_channels == 0) {
+        fprintf(stderr,"error: agcbank_%s_create(), number of channels must be greater than zero\n", EXTENSION_FULL);
+        exit(-1);
+    }
+
+    // create object and allocate per-channel state
+    AGCBANK() q = (AGCBANK()) malloc(sizeof(struct AGCBANK(_s)));
+    q->num_channels  = _num_channels;
+    q->g             = (float*)        malloc(q->num_channels*sizeof(float));
+    q->y2_prime      = (float*)        malloc(q->num_channels*sizeof(float));
+    q->unlocked      = (unsigned int*) malloc(q->num_channels*sizeof(unsigned int));
+    q->squelch_mode  = (int*)          malloc(q->num_channels*sizeof(int));
+    q->squelch_timer = (unsigned int*) calloc(q->num_channels,sizeof(unsigned int));
+
+    // initialize to default parameters (same as agc object)
+    AGCBANK(_set_bandwidth)(q, 1e-2f);
+    q->squelch_enabled = 0;
+    AGCBANK(_reset)(q);
+    AGCBANK(_squelch_set_threshold)(q, 0.0f);
+    AGCBANK(_squelch_set_timeout  )(q, 100);
+    q->scale = 1.0f;
+
+    // return object
+    return q;
+}
+
+// destroy object, freeing all internally-allocated memory
+void AGCBANK(_destroy)(AGCBANK() _q)
+{
+    free(_q->g);
+    free(_q->y2_prime);
+    free(_q->unlocked);
+    free(_q->squelch_mode);
+    free(_q->squelch_timer);
+    free(_q);
+}
+
+// print object properties to stdout
+void AGCBANK(_print)(AGCBANK() _q)
+{
+    printf("agcbank [channels: %u, bw: %12.4e, squelch: %s]:\n",
+            _q->num_channels,
+            _q->bandwidth,
+            _q->squelch_enabled ? "enabled" : "disabled");
+}
+
+// reset gain estimates, lock status, and squelch mode of all channels
+void AGCBANK(_reset)(AGCBANK() _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        _q->g[i]            = 1.0f;
+        _q->y2_prime[i]     = 1.0f;
+        _q->unlocked[i]     = ~0u;
+        _q->squelch_mode[i] = _q->squelch_enabled ?
+            LIQUID_AGC_SQUELCH_ENABLED : LIQUID_AGC_SQUELCH_DISABLED;
+    }
+}
+
+// get number of channels
+unsigned int AGCBANK(_get_num_channels)(AGCBANK() _q)
+{
+    return _q->num_channels;
+}
+
+// execute gain control on a single sample for each channel
+//  _q      :   agcbank object
+//  _x      :   input samples, [size: num_channels x 1]
+//  _y      :   output samples, [size: num_channels x 1]
+void AGCBANK(_execute)(AGCBANK() _q,
+                       TC *      _x,
+                       TC *      _y)
+{
+    unsigned int k;
+    unsigned int n = _q->num_channels & ~3u;
+    for (k=0; k<n; k+=4)
+        AGCBANK(_execute4)(_q, k, _x + k, _y + k);
+
+    // remaining channels
+    for ( ; k<_q->num_channels; k++)
+        AGCBANK(_execute1)(_q, k, _x[k], &_y[k]);
+
+    if (_q->squelch_enabled)
+        AGCBANK(_squelch_update)(_q);
+}
+
+// execute gain control on block of samples for each channel
+//  _q      :   agcbank object
+//  _x      :   input samples, time-major [size: _n*num_channels x 1]
+//  _n      :   number of samples per channel
+//  _y      :   output samples, time-major [size: _n*num_channels x 1]
+void AGCBANK(_execute_block)(AGCBANK()    _q,
+                             TC *         _x,
+                             unsigned int _n,
+                             TC *         _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        AGCBANK(_execute)(_q, _x + i*_q->num_channels, _y + i*_q->num_channels);
+}
+
+// lock gain of a particular channel
+void AGCBANK(_lock)(AGCBANK()    _q,
+                    unsigned int _channel)
+{
+    AGCBANK(_get_gain)(_q, _channel); // validate channel index
+    _q->unlocked[_channel] = 0;
+}
+
+// unlock gain of a particular channel
+void AGCBANK(_unlock)(AGCBANK()    _q,
+                      unsigned int _channel)
+{
+    AGCBANK(_get_gain)(_q, _channel); // validate channel index
+    _q->unlocked[_channel] = ~0u;
+}
+
+// set loop filter bandwidth for all channels
+void AGCBANK(_set_bandwidth)(AGCBANK() _q,
+                             float     _bt)
+{
+    if ( _bt < 0 ) {
+        fprintf(stderr,"error: agcbank_%s_set_bandwidth(), bandwidth must be positive\n", EXTENSION_FULL);
+        exit(-1);
+    } else if ( _bt > 1.0f ) {
+        fprintf(stderr,"error: agcbank_%s_set_bandwidth(), bandwidth must less than 1.0\n", EXTENSION_FULL);
+        exit(-1);
+    }
+    _q->bandwidth = _bt;
+    _q->alpha     = _bt;
+}
+
+// get loop filter bandwidth
+float AGCBANK(_get_bandwidth)(AGCBANK() _q)
+{
+    return _q->bandwidth;
+}
+
+// get gain of a particular channel (linear)
+float AGCBANK(_get_gain)(AGCBANK()    _q,
+                         unsigned int _channel)
+{
+    if (_channel >= _q->num_channels) {
+        fprintf(stderr,"error: agcbank_%s, channel index (%u) exceeds number of channels (%u)\n",
+                EXTENSION_FULL, _channel, _q->num_channels);
+        exit(-1);
+    }
+    return _q->g[_channel];
+}
+
+// set gain of a particular channel (linear)
+void AGCBANK(_set_gain)(AGCBANK()    _q,
+                        unsigned int _channel,
+                        float        _gain)
+{
+    AGCBANK(_get_gain)(_q, _channel); // validate channel index
+    if ( _gain <= 0 ) {
+        fprintf(stderr,"error: agcbank_%s_set_gain(), gain must be greater than zero\n", EXTENSION_FULL);
+        exit(-1);
+    }
+    _q->g[_channel] = _gain;
+}
+
+// get received signal strength indication of a particular channel [dB]
+float AGCBANK(_get_rssi)(AGCBANK()    _q,
+                         unsigned int _channel)
+{
+    return -20*log10(AGCBANK(_get_gain)(_q, _channel));
+}
+
+// get output scale
+float AGCBANK(_get_scale)(AGCBANK() _q)
+{
+    return _q->scale;
+}
+
+// set output scale for all channels
+void AGCBANK(_set_scale)(AGCBANK() _q,
+                         float     _scale)
+{
+    if ( _scale <= 0 ) {
+        fprintf(stderr,"error: agcbank_%s_set_scale(), scale must be greater than zero\n", EXTENSION_FULL);
+        exit(-1);
+    }
+    _q->scale = _scale;
+}
+
+// enable squelch on all channels
+void AGCBANK(_squelch_enable)(AGCBANK() _q)
+{
+    unsigned int i;
+    _q->squelch_enabled = 1;
+    for (i=0; i<_q->num_channels; i++)
+        _q->squelch_mode[i] = LIQUID_AGC_SQUELCH_ENABLED;
+}
+
+// disable squelch on all channels
+void AGCBANK(_squelch_disable)(AGCBANK() _q)
+{
+    unsigned int i;
+    _q->squelch_enabled = 0;
+    for (i=0; i<_q->num_channels; i++)
+        _q->squelch_mode[i] = LIQUID_AGC_SQUELCH_DISABLED;
+}
+
+// set squelch threshold [dB]
+void AGCBANK(_squelch_set_threshold)(AGCBANK() _q,
+                                     T         _threshold)
+{
+    _q->squelch_threshold = _threshold;
+}
+
+// get squelch threshold [dB]
+T AGCBANK(_squelch_get_threshold)(AGCBANK() _q)
+{
+    return _q->squelch_threshold;
+}
+
+// set squelch timeout [samples]
+void AGCBANK(_squelch_set_timeout)(AGCBANK()    _q,
+                                   unsigned int _timeout)
+{
+    _q->squelch_timeout = _timeout;
+}
+
+// get squelch timeout [samples]
+unsigned int AGCBANK(_squelch_get_timeout)(AGCBANK() _q)
+{
+    return _q->squelch_timeout;
+}
+
+// get squelch status of a particular channel
+int AGCBANK(_squelch_get_status)(AGCBANK()    _q,
+                                 unsigned int _channel)
+{
+    AGCBANK(_get_gain)(_q, _channel); // validate channel index
+    return _q->squelch_mode[_channel];
+}
+
+//
+// internal methods
+//
+
+#if AGCBANK_USE_SSE
+// natural logarithm of four positive values (Cephes polynomial, about
+// one ulp of error over the normal range)
+static inline __m128 AGCBANK(_log_ps)(__m128 _x)
+{
+    // split into exponent and mantissa, m in [sqrt(0.5)-1, sqrt(2)-1)
+    __m128i xi = _mm_castps_si128(_x);
+    __m128  e  = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(xi, 23), _mm_set1_epi32(126)));
+    __m128  m  = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(xi, _mm_set1_epi32(0x007fffff)),
+                                               _mm_set1_epi32(0x3f000000)));
+    __m128  lt = _mm_cmplt_ps(m, _mm_set1_ps(0.707106781186547524f));
+    e = _mm_sub_ps(e, _mm_and_ps(lt, _mm_set1_ps(1.0f)));
+    m = _mm_add_ps(_mm_sub_ps(m, _mm_set1_ps(1.0f)), _mm_and_ps(lt, m));
+
+    __m128 z = _mm_mul_ps(m, m);
+    __m128 p = _mm_set1_ps( 7.0376836292e-2f);
+    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps(-1.1514610310e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps( 1.1676998740e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps(-1.2420140846e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps( 1.4249322787e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps(-1.6668057665e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps( 2.0000714765e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps(-2.4999993993e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, m), _mm_set1_ps( 3.3333331174e-1f));
+    p = _mm_mul_ps(_mm_mul_ps(p, m), z);
+    p = _mm_add_ps(p, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+    p = _mm_sub_ps(p, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+    return _mm_add_ps(_mm_add_ps(m, p), _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+}
+
+// exponential of four values, |x| < 87 (Cephes polynomial)
+static inline __m128 AGCBANK(_exp_ps)(__m128 _x)
+{
+    // x = n*ln(2) + r, |r| <= ln(2)/2
+    __m128  n  = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(_x, _mm_set1_ps(1.44269504088896341f))));
+    __m128  r  = _mm_sub_ps(_x, _mm_mul_ps(n, _mm_set1_ps(0.693359375f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(-2.12194440e-4f)));
+
+    __m128 p = _mm_set1_ps(1.9875691500e-4f);
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.3981999507e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(8.3334519073e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(4.1665795894e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.6666665459e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(5.0000001201e-1f));
+    p = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, r), r), _mm_add_ps(r, _mm_set1_ps(1.0f)));
+
+    // scale by 2^n
+    __m128i e = _mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23);
+    return _mm_mul_ps(p, _mm_castsi128_ps(e));
+}
+#endif
+
+// update group of four channels for one sample
+void AGCBANK(_execute4)(AGCBANK()    _q,
+                        unsigned int _k,
+                        TC *         _x,
+                        TC *         _y)
+{
+#if AGCBANK_USE_SSE
+    __m128 g  = _mm_loadu_ps(_q->g        + _k);
+    __m128 y2p= _mm_loadu_ps(_q->y2_prime + _k);
+    __m128 ul = _mm_loadu_ps((float*)(_q->unlocked + _k));
+
+    // apply gain and compute output signal energy
+#if TC_COMPLEX
+    __m128 x0 = _mm_loadu_ps((float*)(_x + 0));         // { re0, im0, re1, im1 }
+    __m128 x1 = _mm_loadu_ps((float*)(_x + 2));         // { re2, im2, re3, im3 }
+    __m128 y0 = _mm_mul_ps(x0, _mm_unpacklo_ps(g, g));
+    __m128 y1 = _mm_mul_ps(x1, _mm_unpackhi_ps(g, g));
+    __m128 s0 = _mm_mul_ps(y0, y0);
+    __m128 s1 = _mm_mul_ps(y1, y1);
+    __m128 y2 = _mm_add_ps(_mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2,0,2,0)),
+                           _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(3,1,3,1)));
+#else
+    __m128 y0 = _mm_mul_ps(_mm_loadu_ps(_x), g);
+    __m128 y2 = _mm_mul_ps(y0, y0);
+#endif
+
+    // smooth energy estimate using single-pole low-pass filter
+    __m128 alpha = _mm_set1_ps(_q->alpha);
+    y2p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.0f - _q->alpha), y2p),
+                     _mm_mul_ps(alpha, y2));
+
+    // update gain of unlocked channels according to output energy:
+    // g *= exp(-alpha/2 * log(y2_prime)), clamped to 120 dB
+    __m128 v = _mm_max_ps(y2p, _mm_set1_ps(1e-6f));
+    __m128 d = AGCBANK(_exp_ps)(_mm_mul_ps(_mm_set1_ps(-0.5f*_q->alpha), AGCBANK(_log_ps)(v)));
+    __m128 u = _mm_and_ps(ul, _mm_cmpgt_ps(y2p, _mm_set1_ps(1e-6f)));
+    __m128 gn = _mm_or_ps(_mm_and_ps(u, _mm_mul_ps(g, d)), _mm_andnot_ps(u, g));
+    gn = _mm_min_ps(gn, _mm_set1_ps(1e6f));
+    g  = _mm_or_ps(_mm_and_ps(ul, gn), _mm_andnot_ps(ul, g));
+
+    // apply output scale to unlocked channels
+    __m128 s = _mm_or_ps(_mm_and_ps(ul, _mm_set1_ps(_q->scale)),
+                         _mm_andnot_ps(ul, _mm_set1_ps(1.0f)));
+#if TC_COMPLEX
+    _mm_storeu_ps((float*)(_y + 0), _mm_mul_ps(y0, _mm_unpacklo_ps(s, s)));
+    _mm_storeu_ps((float*)(_y + 2), _mm_mul_ps(y1, _mm_unpackhi_ps(s, s)));
+#else
+    _mm_storeu_ps(_y, _mm_mul_ps(y0, s));
+#endif
+    _mm_storeu_ps(_q->g        + _k, g);
+    _mm_storeu_ps(_q->y2_prime + _k, y2p);
+#else
+    unsigned int i;
+    for (i=0; i<4; i++)
+        AGCBANK(_execute1)(_q, _k+i, _x[i], &_y[i]);
+#endif
+}
+
+// update single channel for one sample
+void AGCBANK(_execute1)(AGCBANK()    _q,
+                        unsigned int _k,
+                        TC           _x,
+                        TC *         _y)
+{
+    float * g   = _q->g        + _k;
+    float * y2p = _q->y2_prime + _k;
+
+    // apply gain and smooth output signal energy estimate
+    *_y  = _x * (*g);
+    *y2p = (1.0f-_q->alpha)*(*y2p) + _q->alpha*crealf((*_y)*conjf(*_y));
+    if (!_q->unlocked[_k])
+        return;
+
+    // update gain according to output energy, clamped to 120 dB
+    if (*y2p > 1e-6f)
+        *g *= expf( -0.5f*_q->alpha*logf(*y2p) );
+    if (*g > 1e6f)
+        *g = 1e6f;
+
+    // apply output scale
+    *_y *= _q->scale;
+}
+
+// update squelch state for all unlocked channels
+void AGCBANK(_squelch_update)(AGCBANK() _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        if (!_q->unlocked[i])
+            continue;
+        int threshold_exceeded = -20*log10f(_q->g[i]) > _q->squelch_threshold;
+        _q->squelch_mode[i] = AGC(_squelch_step)(_q->squelch_mode[i],
+                                                 &_q->squelch_timer[i],
+                                                 _q->squelch_timeout,
+                                                 threshold_exceeded);
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare multi-channel agc against independent agc objects
+void testbench_agcbank_crcf(unsigned int _num_channels,
+                            int          _squelch)
+{
+    unsigned int num_samples = 2400;
+    float        bt          = 0.05f;
+    float        tol         = 1e-3f;
+
+    agcbank_crcf q = agcbank_crcf_create(_num_channels);
+    agcbank_crcf_set_bandwidth(q, bt);
+    agcbank_crcf_set_scale(q, 0.7f);
+    if (_squelch) {
+        agcbank_crcf_squelch_enable(q);
+        agcbank_crcf_squelch_set_threshold(q, -20.0f);
+        agcbank_crcf_squelch_set_timeout(q, 40);
+    }
+
+    agc_crcf agc[_num_channels];
+    unsigned int k;
+    for (k=0; k<_num_channels; k++) {
+        agc[k] = agc_crcf_create();
+        agc_crcf_set_bandwidth(agc[k], bt);
+        agc_crcf_set_scale(agc[k], 0.7f);
+        if (_squelch) {
+            agc_crcf_squelch_enable(agc[k]);
+            agc_crcf_squelch_set_threshold(agc[k], -20.0f);
+            agc_crcf_squelch_set_timeout(agc[k], 40);
+        }
+    }
+
+    float complex x[_num_channels];
+    float complex y[_num_channels];
+    float complex v;
+    unsigned int i;
+    for (i=0; i<num_samples; i++) {
+        // bursts of noise on each channel at different levels
+        for (k=0; k<_num_channels; k++) {
+            int   on    = ((i + 97*k) / 400) % 2;
+            float level = on ? 0.01f + 0.3f*k : 1e-3f;
+            x[k] = level * (randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+        }
+
+        // lock/unlock a channel in the middle of the run
+        if (i == 1000) {
+            agcbank_crcf_lock(q, _num_channels-1);
+            agc_crcf_lock(agc[_num_channels-1]);
+        } else if (i == 1600) {
+            agcbank_crcf_unlock(q, _num_channels-1);
+            agc_crcf_unlock(agc[_num_channels-1]);
+        }
+
+        agcbank_crcf_execute(q, x, y);
+        for (k=0; k<_num_channels; k++) {
+            agc_crcf_execute(agc[k], x[k], &v);
+            CONTEND_DELTA(crealf(y[k]), crealf(v), tol*(1.0f + cabsf(v)));
+            CONTEND_DELTA(cimagf(y[k]), cimagf(v), tol*(1.0f + cabsf(v)));
+            CONTEND_EQUALITY(agcbank_crcf_squelch_get_status(q,k),
+                             agc_crcf_squelch_get_status(agc[k]));
+        }
+    }
+
+    for (k=0; k<_num_channels; k++) {
+        float g0 = agc_crcf_get_gain(agc[k]);
+        CONTEND_DELTA(agcbank_crcf_get_gain(q,k), g0, tol*g0);
+        agc_crcf_destroy(agc[k]);
+    }
+    agcbank_crcf_destroy(q);
+}
+
+void autotest_agcbank_crcf_1()          { testbench_agcbank_crcf( 1, 0); }
+void autotest_agcbank_crcf_8()          { testbench_agcbank_crcf( 8, 0); }
+void autotest_agcbank_crcf_11()         { testbench_agcbank_crcf(11, 0); }
+void autotest_agcbank_crcf_squelch_11() { testbench_agcbank_crcf(11, 1); }
+
+// time-major block execution matches sample-by-sample execution
+void autotest_agcbank_crcf_block()
+{
+    unsigned int num_channels = 6;
+    unsigned int n            = 300;
+    float complex x[n*num_channels];
+    float complex y0[n*num_channels];
+    float complex y1[n*num_channels];
+    unsigned int i;
+    for (i=0; i<n*num_channels; i++)
+        x[i] = 0.1f*(i % num_channels + 1)*(randnf() + _Complex_I*randnf());
+
+    agcbank_crcf q0 = agcbank_crcf_create(num_channels);
+    agcbank_crcf q1 = agcbank_crcf_create(num_channels);
+    for (i=0; i<n; i++)
+        agcbank_crcf_execute(q0, x + i*num_channels, y0 + i*num_channels);
+    agcbank_crcf_execute_block(q1, x, n, y1);
+    CONTEND_SAME_DATA(y0, y1, sizeof(y0));
+    agcbank_crcf_destroy(q0);
+    agcbank_crcf_destroy(q1);
+}
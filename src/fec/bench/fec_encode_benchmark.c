@@ -101,6 +101,12 @@ void fec_encode_bench(
     case LIQUID_FEC_RS_M8:
         *_num_iterations *= 1;
         break;
+    case LIQUID_FEC_LDPC_R12:
+    case LIQUID_FEC_LDPC_R23:
+    case LIQUID_FEC_LDPC_R34:
+    case LIQUID_FEC_LDPC_R56:
+        *_num_iterations /= 2;
+        break;
     default:;
     }
     if (*_num_iterations < 1) *_num_iterations = 1;
@@ -164,3 +170,6 @@ void benchmark_fec_enc_conv27p45_n64    FEC_ENCODE_BENCH_API(LIQUID_FEC_CONV_V27
 
 void benchmark_fec_enc_rs8_n64          FEC_ENCODE_BENCH_API(LIQUID_FEC_RS_M8,     64,  NULL)
 
+void benchmark_fec_enc_ldpc12_n64       FEC_ENCODE_BENCH_API(LIQUID_FEC_LDPC_R12,  64,  NULL)
+void benchmark_fec_enc_ldpc56_n64       FEC_ENCODE_BENCH_API(LIQUID_FEC_LDPC_R56,  64,  NULL)
+
@@ -107,6 +107,12 @@ void fecsoft_decode_bench(
     case LIQUID_FEC_RS_M8:
         *_num_iterations *= 1;
         break;
+    case LIQUID_FEC_LDPC_R12:
+    case LIQUID_FEC_LDPC_R23:
+    case LIQUID_FEC_LDPC_R34:
+    case LIQUID_FEC_LDPC_R56:
+        *_num_iterations /= 20;
+        break;
     default:;
     }
     if (*_num_iterations < 1) *_num_iterations = 1;
@@ -188,3 +194,8 @@ void benchmark_fecsoft_dec_conv29p78_n64  FECSOFT_DECODE_BENCH_API(LIQUID_FEC_CO
 
 void benchmark_fecsoft_dec_rs8_n64        FECSOFT_DECODE_BENCH_API(LIQUID_FEC_RS_M8,      64, NULL)
 
+void benchmark_fecsoft_dec_ldpc12_n64     FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12,   64, NULL)
+void benchmark_fecsoft_dec_ldpc23_n64     FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_R23,   64, NULL)
+void benchmark_fecsoft_dec_ldpc34_n64     FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_R34,   64, NULL)
+void benchmark_fecsoft_dec_ldpc56_n64     FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_R56,   64, NULL)
+
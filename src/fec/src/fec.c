@@ -61,7 +61,11 @@ const char * fec_scheme_str[LIQUID_FEC_NUM_SCHEMES][2] = {
     {"v29p56",      "convolutional r5/6 K=9 (punctured)"},
     {"v29p67",      "convolutional r6/7 K=9 (punctured)"},
     {"v29p78",      "convolutional r7/8 K=9 (punctured)"},
-    {"rs8",         "Reed-Solomon, 223/255"}
+    {"rs8",         "Reed-Solomon, 223/255"},
+    {"ldpc12",      "LDPC r1/2 n=1536"},
+    {"ldpc23",      "LDPC r2/3 n=1536"},
+    {"ldpc34",      "LDPC r3/4 n=1536"},
+    {"ldpc56",      "LDPC r5/6 n=1536"}
 };
 
 // Print compact list of existing and available fec schemes
@@ -187,6 +191,20 @@ int fec_scheme_is_hamming(fec_scheme _scheme)
     return 0;
 }
 
+// is scheme LDPC?
+int fec_scheme_is_ldpc(fec_scheme _scheme)
+{
+    switch (_scheme) {
+    case LIQUID_FEC_LDPC_R12:
+    case LIQUID_FEC_LDPC_R23:
+    case LIQUID_FEC_LDPC_R34:
+    case LIQUID_FEC_LDPC_R56:
+        return 1;
+    default:;
+    }
+    return 0;
+}
+
 // is scheme repeat?
 int fec_scheme_is_repeat(fec_scheme _scheme)
 {
@@ -220,6 +238,12 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
     case LIQUID_FEC_SECDED3932:     return _msg_len + _msg_len/4 + ((_msg_len%4) ? 1 : 0);
     case LIQUID_FEC_SECDED7264:     return _msg_len + _msg_len/8 + ((_msg_len%8) ? 1 : 0);
 
+    // LDPC codes: information/parity bytes per codeword
+    case LIQUID_FEC_LDPC_R12:       return fec_ldpc_get_enc_msg_len(_msg_len, 96, 96);
+    case LIQUID_FEC_LDPC_R23:       return fec_ldpc_get_enc_msg_len(_msg_len,128, 64);
+    case LIQUID_FEC_LDPC_R34:       return fec_ldpc_get_enc_msg_len(_msg_len,144, 48);
+    case LIQUID_FEC_LDPC_R56:       return fec_ldpc_get_enc_msg_len(_msg_len,160, 32);
+
 #if LIBFEC_ENABLED
     // convolutional codes
     case LIQUID_FEC_CONV_V27:       return 2*_msg_len + 2;  // (K-1)/r=12, round up to 2 bytes
@@ -414,6 +438,12 @@ float fec_get_rate(fec_scheme _scheme)
     case LIQUID_FEC_SECDED3932:     return 4./5.;   // ultimately 32/39 ~ 0.82051
     case LIQUID_FEC_SECDED7264:     return 8./9.;
 
+    // LDPC codes
+    case LIQUID_FEC_LDPC_R12:       return 1./2.;
+    case LIQUID_FEC_LDPC_R23:       return 2./3.;
+    case LIQUID_FEC_LDPC_R34:       return 3./4.;
+    case LIQUID_FEC_LDPC_R56:       return 5./6.;
+
     // convolutional codes
 #if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:       return 1./2.;
@@ -502,6 +532,13 @@ fec fec_create(fec_scheme _scheme, void *_opts)
     case LIQUID_FEC_SECDED7264:
         return fec_secded7264_create(_opts);
 
+    // LDPC codes
+    case LIQUID_FEC_LDPC_R12:
+    case LIQUID_FEC_LDPC_R23:
+    case LIQUID_FEC_LDPC_R34:
+    case LIQUID_FEC_LDPC_R56:
+        return fec_ldpc_create(_scheme);
+
     // convolutional codes
 #if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:
@@ -625,6 +662,14 @@ void fec_destroy(fec _q)
         fec_secded7264_destroy(_q);
         return;
 
+    // LDPC codes
+    case LIQUID_FEC_LDPC_R12:
+    case LIQUID_FEC_LDPC_R23:
+    case LIQUID_FEC_LDPC_R34:
+    case LIQUID_FEC_LDPC_R56:
+        fec_ldpc_destroy(_q);
+        return;
+
     // convolutional codes
 #if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:
@@ -342,37 +342,16 @@ void fec_golay2412_decode(fec _q,
 {
     unsigned int i=0;                       // decoded byte counter
     unsigned int j=0;                       // encoded byte counter
-    unsigned int r0, r1, r2, r3, r4, r5;    // six 8-bit bytes
-    unsigned int v0, v1;                    // two 24-bit encoded symbols
-    unsigned int m0_hat, m1_hat;            // two 12-bit decoded symbols
+    unsigned int r0, r1, r2;                // three 8-bit bytes
+    unsigned int s0;                        // syndrome
+    unsigned int m0_hat;                    // 12-bit decoded symbol
     
     // determine remainder of input length / 3
     unsigned int r = _dec_msg_len % 3;
 
-    for (i=0; i<_dec_msg_len-r; i+=3) {
-        // strip six input bytes (two encoded symbols)
-        r0 = _msg_enc[j+0];
-        r1 = _msg_enc[j+1];
-        r2 = _msg_enc[j+2];
-        r3 = _msg_enc[j+3];
-        r4 = _msg_enc[j+4];
-        r5 = _msg_enc[j+5];
-
-        // pack six 8-bit symbols into two 24-bit symbols
-        v0 = ((r0 << 16) & 0xff0000) | ((r1 <<  8) & 0x00ff00) | ((r2     ) & 0x0000ff);
-        v1 = ((r3 << 16) & 0xff0000) | ((r4 <<  8) & 0x00ff00) | ((r5 << 0) & 0x0000ff);
-
-        // decode each symbol into a 12-bit symbol
-        m0_hat = fec_golay2412_decode_symbol(v0);
-        m1_hat = fec_golay2412_decode_symbol(v1);
-
-        // unpack two 12-bit symbols into three 8-bit bytes
-        _msg_dec[i+0] = ((m0_hat >> 4) & 0xff);
-        _msg_dec[i+1] = ((m0_hat << 4) & 0xf0) | ((m1_hat >> 8) & 0x0f);
-        _msg_dec[i+2] = ((m1_hat     ) & 0xff);
-
-        j += 6;
-    }
+    // decode all pairs of symbols at once
+    fec_golay2412_decode_batch(_dec_msg_len/3, _msg_enc, _msg_dec);
+    j = 6*(_dec_msg_len/3);
 
     // if input length isn't divisible by 3, decode last 1 or two bytes
     for (i=_dec_msg_len-r; i<_dec_msg_len; i++) {
@@ -381,11 +360,11 @@ void fec_golay2412_decode(fec _q,
         r1 = _msg_enc[j+1];
         r2 = _msg_enc[j+2];
 
-        // pack three 8-bit symbols into one 24-bit symbol
-        v0 = ((r0 << 16) & 0xff0000) | ((r1 <<  8) & 0x00ff00) | ((r2     ) & 0x0000ff);
-
         // decode into a 12-bit symbol
-        m0_hat = fec_golay2412_decode_symbol(v0);
+        s0 = golay2412_syndrome_gentab[0][r0] ^
+             golay2412_syndrome_gentab[1][r1] ^
+             golay2412_syndrome_gentab[2][r2];
+        m0_hat = (((r1 << 8) & 0x0f00) | r2) ^ golay2412_ehat_gentab[s0];
 
         // retain last 8 bits of 12-bit symbol
         _msg_dec[i] = m0_hat & 0xff;
@@ -399,3 +378,36 @@ void fec_golay2412_decode(fec _q,
     //return num_errors;
 }
 
+// decode pairs of symbols packed into six bytes each using syndrome
+// look-up tables; the estimated error vector only depends upon the
+// syndrome, so this produces exactly the same result as
+// fec_golay2412_decode_symbol() without any searching or branching
+//  _n          :   number of symbol pairs
+//  _msg_enc    :   encoded message [size: 6*_n x 1]
+//  _msg_dec    :   decoded message [size: 3*_n x 1]
+void fec_golay2412_decode_batch(unsigned int    _n,
+                                unsigned char * _msg_enc,
+                                unsigned char * _msg_dec)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        unsigned char * r = &_msg_enc[6*i];
+
+        // compute syndromes
+        unsigned int s0 = golay2412_syndrome_gentab[0][r[0]] ^
+                          golay2412_syndrome_gentab[1][r[1]] ^
+                          golay2412_syndrome_gentab[2][r[2]];
+        unsigned int s1 = golay2412_syndrome_gentab[0][r[3]] ^
+                          golay2412_syndrome_gentab[1][r[4]] ^
+                          golay2412_syndrome_gentab[2][r[5]];
+
+        // correct message bits (last 12 bits of each encoded symbol)
+        unsigned int m0_hat = (((r[1] << 8) & 0x0f00) | r[2]) ^ golay2412_ehat_gentab[s0];
+        unsigned int m1_hat = (((r[4] << 8) & 0x0f00) | r[5]) ^ golay2412_ehat_gentab[s1];
+
+        // unpack two 12-bit symbols into three 8-bit bytes
+        _msg_dec[3*i+0] = ((m0_hat >> 4) & 0xff);
+        _msg_dec[3*i+1] = ((m0_hat << 4) & 0xf0) | ((m1_hat >> 8) & 0x0f);
+        _msg_dec[3*i+2] = ((m1_hat     ) & 0xff);
+    }
+}
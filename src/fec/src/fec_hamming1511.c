@@ -28,6 +28,15 @@
 
 #define DEBUG_FEC_HAMMING1511 0
 
+// use SIMD extensions for batch decoding (PSHUFB requires SSSE3,
+// guaranteed when compiling with SSE4.1)
+#if HAVE_SSE41 && HAVE_SMMINTRIN_H
+#  include <smmintrin.h>
+#  define FEC_HAMMING1511_BATCH_SIMD 1
+#else
+#  define FEC_HAMMING1511_BATCH_SIMD 0
+#endif
+
 //
 // Hamming(15,11) code
 //
@@ -52,6 +61,31 @@
 #define HAMMING_S4   0x0f0f  // .000 1111 0000 1111
 #define HAMMING_S8   0x00ff  // .000 0000 1111 1111
 
+// nibble-wise look-up tables for batch decoding; the syndrome of a
+// 15-bit symbol split into nibbles [n3 n2 n1 n0] (most-significant
+// first) is z = H3[n3] ^ H2[n2] ^ H1[n1] ^ H0[n0], and the bit to flip
+// for syndrome z is FH[z] in the upper byte and FL[z] in the lower
+// byte. Each table has exactly 16 entries so it can be used directly
+// with a byte shuffle instruction.
+static const unsigned char hamming1511_batch_H0[16] = {
+    0x00, 0x0f, 0x0e, 0x01, 0x0d, 0x02, 0x03, 0x0c,
+    0x0c, 0x03, 0x02, 0x0d, 0x01, 0x0e, 0x0f, 0x00};
+static const unsigned char hamming1511_batch_H1[16] = {
+    0x00, 0x0b, 0x0a, 0x01, 0x09, 0x02, 0x03, 0x08,
+    0x08, 0x03, 0x02, 0x09, 0x01, 0x0a, 0x0b, 0x00};
+static const unsigned char hamming1511_batch_H2[16] = {
+    0x00, 0x07, 0x06, 0x01, 0x05, 0x02, 0x03, 0x04,
+    0x04, 0x03, 0x02, 0x05, 0x01, 0x06, 0x07, 0x00};
+static const unsigned char hamming1511_batch_H3[16] = {
+    0x00, 0x03, 0x02, 0x01, 0x01, 0x02, 0x03, 0x00,
+    0x00, 0x03, 0x02, 0x01, 0x01, 0x02, 0x03, 0x00};
+static const unsigned char hamming1511_batch_FL[16] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+static const unsigned char hamming1511_batch_FH[16] = {
+    0x00, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
 unsigned int fec_hamming1511_encode_symbol(unsigned int _sym_dec)
 {
     // validate input
@@ -135,3 +169,80 @@ unsigned int fec_hamming1511_decode_symbol(unsigned int _sym_enc)
     return sym_dec;
 }
 
+// decode many symbols using nibble-wise syndrome look-up tables;
+// produces exactly the same result as fec_hamming1511_decode_symbol()
+// on each symbol (the unused most-significant bit is ignored)
+//  _n          :   number of symbols
+//  _sym_enc    :   encoded symbols [size: _n x 1]
+//  _sym_dec    :   decoded symbols [size: _n x 1]
+void fec_hamming1511_decode_batch(unsigned int         _n,
+                                  unsigned short int * _sym_enc,
+                                  unsigned short int * _sym_dec)
+{
+    unsigned int i=0;
+
+#if FEC_HAMMING1511_BATCH_SIMD
+    // look-up tables
+    const __m128i H0 = _mm_loadu_si128((const __m128i*)hamming1511_batch_H0);
+    const __m128i H1 = _mm_loadu_si128((const __m128i*)hamming1511_batch_H1);
+    const __m128i H2 = _mm_loadu_si128((const __m128i*)hamming1511_batch_H2);
+    const __m128i H3 = _mm_loadu_si128((const __m128i*)hamming1511_batch_H3);
+    const __m128i FL = _mm_loadu_si128((const __m128i*)hamming1511_batch_FL);
+    const __m128i FH = _mm_loadu_si128((const __m128i*)hamming1511_batch_FH);
+    const __m128i mask   = _mm_set1_epi8(0x0f);
+    const __m128i mask3  = _mm_set1_epi8(0x07);
+    const __m128i lsb    = _mm_set1_epi16(0x00ff);
+    const __m128i mask_a = _mm_set1_epi16(0x007f);
+    const __m128i mask_b = _mm_set1_epi16(0x0380);
+    const __m128i mask_c = _mm_set1_epi16(0x0400);
+
+    for (i=0; i+16<=_n; i+=16) {
+        __m128i v0 = _mm_loadu_si128((const __m128i*)(_sym_enc + i + 0));
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(_sym_enc + i + 8));
+
+        // split into lower and upper bytes of each symbol
+        __m128i lo = _mm_packus_epi16(_mm_and_si128(v0,lsb), _mm_and_si128(v1,lsb));
+        __m128i hi = _mm_packus_epi16(_mm_srli_epi16(v0,8),  _mm_srli_epi16(v1,8));
+
+        // split into nibbles and compute syndromes
+        __m128i n0 = _mm_and_si128(lo, mask);
+        __m128i n1 = _mm_and_si128(_mm_srli_epi16(lo,4), mask);
+        __m128i n2 = _mm_and_si128(hi, mask);
+        __m128i n3 = _mm_and_si128(_mm_srli_epi16(hi,4), mask3);
+        __m128i z  = _mm_xor_si128(_mm_xor_si128(_mm_shuffle_epi8(H0,n0), _mm_shuffle_epi8(H1,n1)),
+                                   _mm_xor_si128(_mm_shuffle_epi8(H2,n2), _mm_shuffle_epi8(H3,n3)));
+
+        // flip bit at syndrome position
+        lo = _mm_xor_si128(lo, _mm_shuffle_epi8(FL,z));
+        hi = _mm_xor_si128(hi, _mm_shuffle_epi8(FH,z));
+
+        // re-assemble symbols and strip data bits
+        __m128i e0 = _mm_unpacklo_epi8(lo,hi);
+        __m128i e1 = _mm_unpackhi_epi8(lo,hi);
+        __m128i d0 = _mm_or_si128(_mm_and_si128(e0, mask_a),
+                     _mm_or_si128(_mm_and_si128(_mm_srli_epi16(e0,1), mask_b),
+                                  _mm_and_si128(_mm_srli_epi16(e0,2), mask_c)));
+        __m128i d1 = _mm_or_si128(_mm_and_si128(e1, mask_a),
+                     _mm_or_si128(_mm_and_si128(_mm_srli_epi16(e1,1), mask_b),
+                                  _mm_and_si128(_mm_srli_epi16(e1,2), mask_c)));
+
+        _mm_storeu_si128((__m128i*)(_sym_dec + i + 0), d0);
+        _mm_storeu_si128((__m128i*)(_sym_dec + i + 8), d1);
+    }
+#endif
+
+    // decode remaining symbols
+    for ( ; i<_n; i++) {
+        unsigned int e = _sym_enc[i] & 0x7fff;
+        unsigned int z = hamming1511_batch_H0[(e    ) & 0x0f] ^
+                         hamming1511_batch_H1[(e>> 4) & 0x0f] ^
+                         hamming1511_batch_H2[(e>> 8) & 0x0f] ^
+                         hamming1511_batch_H3[(e>>12)       ];
+        if (z)
+            e ^= 1 << (15-z);
+
+        _sym_dec[i] = ((e & 0x007f)     )   |
+                      ((e & 0x0700) >> 1)   |
+                      ((e & 0x1000) >> 2);
+    }
+}
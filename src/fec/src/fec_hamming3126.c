@@ -27,6 +27,15 @@
 
 #define DEBUG_FEC_HAMMING3126 0
 
+// use SIMD extensions for batch decoding (PSHUFB requires SSSE3,
+// guaranteed when compiling with SSE4.1)
+#if HAVE_SSE41 && HAVE_SMMINTRIN_H
+#  include <smmintrin.h>
+#  define FEC_HAMMING3126_BATCH_SIMD 1
+#else
+#  define FEC_HAMMING3126_BATCH_SIMD 0
+#endif
+
 //
 // (31,26) Hamming code
 //
@@ -64,6 +73,50 @@
 #define HAMMING_S8  0x00ff00ff  //  .000 0000 1111 1111 0000 0000 1111 1111
 #define HAMMING_S16 0x0000ffff  //  .000 0000 0000 0000 1111 1111 1111 1111
 
+// nibble-wise look-up tables for batch decoding; the syndrome of a
+// 31-bit symbol split into nibbles [n7 ... n0] (most-significant
+// first) is z = H7[n7] ^ ... ^ H0[n0]. The bit to flip for syndrome z
+// lies in byte k of the symbol and is Fk[z & 0x0f], where F0 and F1
+// only apply for z >= 16 and F2 and F3 only for z < 16. Each table has
+// exactly 16 entries so it can be used directly with a byte shuffle
+// instruction.
+static const unsigned char hamming3126_batch_H0[16] = {
+    0x00, 0x1f, 0x1e, 0x01, 0x1d, 0x02, 0x03, 0x1c,
+    0x1c, 0x03, 0x02, 0x1d, 0x01, 0x1e, 0x1f, 0x00};
+static const unsigned char hamming3126_batch_H1[16] = {
+    0x00, 0x1b, 0x1a, 0x01, 0x19, 0x02, 0x03, 0x18,
+    0x18, 0x03, 0x02, 0x19, 0x01, 0x1a, 0x1b, 0x00};
+static const unsigned char hamming3126_batch_H2[16] = {
+    0x00, 0x17, 0x16, 0x01, 0x15, 0x02, 0x03, 0x14,
+    0x14, 0x03, 0x02, 0x15, 0x01, 0x16, 0x17, 0x00};
+static const unsigned char hamming3126_batch_H3[16] = {
+    0x00, 0x13, 0x12, 0x01, 0x11, 0x02, 0x03, 0x10,
+    0x10, 0x03, 0x02, 0x11, 0x01, 0x12, 0x13, 0x00};
+static const unsigned char hamming3126_batch_H4[16] = {
+    0x00, 0x0f, 0x0e, 0x01, 0x0d, 0x02, 0x03, 0x0c,
+    0x0c, 0x03, 0x02, 0x0d, 0x01, 0x0e, 0x0f, 0x00};
+static const unsigned char hamming3126_batch_H5[16] = {
+    0x00, 0x0b, 0x0a, 0x01, 0x09, 0x02, 0x03, 0x08,
+    0x08, 0x03, 0x02, 0x09, 0x01, 0x0a, 0x0b, 0x00};
+static const unsigned char hamming3126_batch_H6[16] = {
+    0x00, 0x07, 0x06, 0x01, 0x05, 0x02, 0x03, 0x04,
+    0x04, 0x03, 0x02, 0x05, 0x01, 0x06, 0x07, 0x00};
+static const unsigned char hamming3126_batch_H7[16] = {
+    0x00, 0x03, 0x02, 0x01, 0x01, 0x02, 0x03, 0x00,
+    0x00, 0x03, 0x02, 0x01, 0x01, 0x02, 0x03, 0x00};
+static const unsigned char hamming3126_batch_F0[16] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+static const unsigned char hamming3126_batch_F1[16] = {
+    0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+static const unsigned char hamming3126_batch_F2[16] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+static const unsigned char hamming3126_batch_F3[16] = {
+    0x00, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
 
 
 unsigned int fec_hamming3126_encode_symbol(unsigned int _sym_dec)
@@ -143,3 +196,117 @@ unsigned int fec_hamming3126_decode_symbol(unsigned int _sym_enc)
     return sym_dec;
 }
 
+// decode many symbols using nibble-wise syndrome look-up tables;
+// produces exactly the same result as fec_hamming3126_decode_symbol()
+// on each symbol (the unused most-significant bit is ignored)
+//  _n          :   number of symbols
+//  _sym_enc    :   encoded symbols [size: _n x 1]
+//  _sym_dec    :   decoded symbols [size: _n x 1]
+void fec_hamming3126_decode_batch(unsigned int   _n,
+                                  unsigned int * _sym_enc,
+                                  unsigned int * _sym_dec)
+{
+    unsigned int i=0;
+
+#if FEC_HAMMING3126_BATCH_SIMD
+    // look-up tables
+    const __m128i H0 = _mm_loadu_si128((const __m128i*)hamming3126_batch_H0);
+    const __m128i H1 = _mm_loadu_si128((const __m128i*)hamming3126_batch_H1);
+    const __m128i H2 = _mm_loadu_si128((const __m128i*)hamming3126_batch_H2);
+    const __m128i H3 = _mm_loadu_si128((const __m128i*)hamming3126_batch_H3);
+    const __m128i H4 = _mm_loadu_si128((const __m128i*)hamming3126_batch_H4);
+    const __m128i H5 = _mm_loadu_si128((const __m128i*)hamming3126_batch_H5);
+    const __m128i H6 = _mm_loadu_si128((const __m128i*)hamming3126_batch_H6);
+    const __m128i H7 = _mm_loadu_si128((const __m128i*)hamming3126_batch_H7);
+    const __m128i F0 = _mm_loadu_si128((const __m128i*)hamming3126_batch_F0);
+    const __m128i F1 = _mm_loadu_si128((const __m128i*)hamming3126_batch_F1);
+    const __m128i F2 = _mm_loadu_si128((const __m128i*)hamming3126_batch_F2);
+    const __m128i F3 = _mm_loadu_si128((const __m128i*)hamming3126_batch_F3);
+    const __m128i mask    = _mm_set1_epi8(0x0f);
+    const __m128i mask3   = _mm_set1_epi8(0x07);
+    const __m128i sixteen = _mm_set1_epi8(0x10);
+    const __m128i mask_a  = _mm_set1_epi32(0x00007fff);
+    const __m128i mask_b  = _mm_set1_epi32(0x003f8000);
+    const __m128i mask_c  = _mm_set1_epi32(0x01c00000);
+    const __m128i mask_d  = _mm_set1_epi32(0x02000000);
+
+    // gather bytes [0 1 2 3] of four symbols into consecutive words
+    const __m128i s = _mm_setr_epi8(0, 4, 8,12, 1, 5, 9,13, 2, 6,10,14, 3, 7,11,15);
+
+    for (i=0; i+16<=_n; i+=16) {
+        __m128i v0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(_sym_enc + i +  0)), s);
+        __m128i v1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(_sym_enc + i +  4)), s);
+        __m128i v2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(_sym_enc + i +  8)), s);
+        __m128i v3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(_sym_enc + i + 12)), s);
+
+        // transpose so that b[k] holds byte k of all 16 symbols
+        __m128i t0 = _mm_unpacklo_epi32(v0,v1);
+        __m128i t1 = _mm_unpacklo_epi32(v2,v3);
+        __m128i t2 = _mm_unpackhi_epi32(v0,v1);
+        __m128i t3 = _mm_unpackhi_epi32(v2,v3);
+        __m128i b0 = _mm_unpacklo_epi64(t0,t1);
+        __m128i b1 = _mm_unpackhi_epi64(t0,t1);
+        __m128i b2 = _mm_unpacklo_epi64(t2,t3);
+        __m128i b3 = _mm_unpackhi_epi64(t2,t3);
+
+        // split into nibbles and compute syndromes
+        __m128i z = _mm_xor_si128(
+            _mm_xor_si128(_mm_xor_si128(_mm_shuffle_epi8(H0, _mm_and_si128(b0, mask)),
+                                        _mm_shuffle_epi8(H1, _mm_and_si128(_mm_srli_epi16(b0,4), mask))),
+                          _mm_xor_si128(_mm_shuffle_epi8(H2, _mm_and_si128(b1, mask)),
+                                        _mm_shuffle_epi8(H3, _mm_and_si128(_mm_srli_epi16(b1,4), mask)))),
+            _mm_xor_si128(_mm_xor_si128(_mm_shuffle_epi8(H4, _mm_and_si128(b2, mask)),
+                                        _mm_shuffle_epi8(H5, _mm_and_si128(_mm_srli_epi16(b2,4), mask))),
+                          _mm_xor_si128(_mm_shuffle_epi8(H6, _mm_and_si128(b3, mask)),
+                                        _mm_shuffle_epi8(H7, _mm_and_si128(_mm_srli_epi16(b3,4), mask3)))));
+
+        // flip bit at syndrome position (upper half of syndromes
+        // addresses the two lower bytes)
+        __m128i zh = _mm_cmpeq_epi8(_mm_and_si128(z, sixteen), sixteen);
+        __m128i zl = _mm_and_si128(z, mask);
+        b0 = _mm_xor_si128(b0, _mm_and_si128   (zh, _mm_shuffle_epi8(F0,zl)));
+        b1 = _mm_xor_si128(b1, _mm_and_si128   (zh, _mm_shuffle_epi8(F1,zl)));
+        b2 = _mm_xor_si128(b2, _mm_andnot_si128(zh, _mm_shuffle_epi8(F2,zl)));
+        b3 = _mm_xor_si128(b3, _mm_andnot_si128(zh, _mm_shuffle_epi8(F3,zl)));
+
+        // transpose back into symbols
+        t0 = _mm_unpacklo_epi8(b0,b1);
+        t1 = _mm_unpackhi_epi8(b0,b1);
+        t2 = _mm_unpacklo_epi8(b2,b3);
+        t3 = _mm_unpackhi_epi8(b2,b3);
+        __m128i e[4] = {_mm_unpacklo_epi16(t0,t2), _mm_unpackhi_epi16(t0,t2),
+                        _mm_unpacklo_epi16(t1,t3), _mm_unpackhi_epi16(t1,t3)};
+
+        // strip data bits
+        unsigned int k;
+        for (k=0; k<4; k++) {
+            __m128i d = _mm_or_si128(
+                _mm_or_si128(_mm_and_si128(e[k], mask_a),
+                             _mm_and_si128(_mm_srli_epi32(e[k],1), mask_b)),
+                _mm_or_si128(_mm_and_si128(_mm_srli_epi32(e[k],2), mask_c),
+                             _mm_and_si128(_mm_srli_epi32(e[k],3), mask_d)));
+            _mm_storeu_si128((__m128i*)(_sym_dec + i + 4*k), d);
+        }
+    }
+#endif
+
+    // decode remaining symbols
+    for ( ; i<_n; i++) {
+        unsigned int e = _sym_enc[i] & 0x7fffffff;
+        unsigned int z = hamming3126_batch_H0[(e    ) & 0x0f] ^
+                         hamming3126_batch_H1[(e>> 4) & 0x0f] ^
+                         hamming3126_batch_H2[(e>> 8) & 0x0f] ^
+                         hamming3126_batch_H3[(e>>12) & 0x0f] ^
+                         hamming3126_batch_H4[(e>>16) & 0x0f] ^
+                         hamming3126_batch_H5[(e>>20) & 0x0f] ^
+                         hamming3126_batch_H6[(e>>24) & 0x0f] ^
+                         hamming3126_batch_H7[(e>>28)       ];
+        if (z)
+            e ^= 1 << (31-z);
+
+        _sym_dec[i] = ((e & 0x00007fff)     )   |
+                      ((e & 0x007f0000) >> 1)   |
+                      ((e & 0x07000000) >> 2)   |
+                      ((e & 0x10000000) >> 3);
+    }
+}
@@ -0,0 +1,598 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Quasi-cyclic low-density parity-check (LDPC) codes
+//
+// Codes are defined by a base matrix of circulant shifts (see
+// fec_ldpc_base.c) lifted by a factor Z. Messages longer than a single
+// codeword are split into evenly-sized blocks; unused information bits
+// in each codeword are shortened (known to be zero and not
+// transmitted). Each encoded block consists of the information bytes
+// followed by the parity bytes.
+//
+// Decoding uses a layered normalized min-sum algorithm in which each
+// block row of the base matrix is processed as one layer; the Z check
+// nodes within a layer are independent and are updated in parallel
+// across SIMD lanes. Decoding terminates as soon as all parity checks
+// are satisfied.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <assert.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+#define DEBUG_FEC_LDPC  0
+
+// log-likelihood ratio assigned to shortened (known zero) bits
+#define FEC_LDPC_LLR_SHORTENED  (4096.0f)
+
+// update a single layer of the decoder
+//  _t      :   rotated posterior LLRs for each edge in layer [size: _d*_Z x 1]
+//  _R      :   check-to-variable messages for layer [size: _d*_Z x 1]
+//  _d      :   check node degree (number of edges in layer)
+//  _Z      :   lifting factor
+//  _alpha  :   normalization factor
+void fec_ldpc_layer_update(float *      _t,
+                           float *      _R,
+                           unsigned int _d,
+                           unsigned int _Z,
+                           float        _alpha);
+
+// encode a single codeword from information bits in _q->ldpc_c,
+// writing parity bits into the remainder of _q->ldpc_c
+void fec_ldpc_encode_codeword(fec _q);
+
+// decode all codewords in message, loading channel log-likelihood
+// ratios from either hard-decision bytes (_soft=0) or soft bits
+void fec_ldpc_decode_blocks(fec             _q,
+                            unsigned int    _dec_msg_len,
+                            unsigned char * _msg_enc,
+                            unsigned char * _msg_dec,
+                            int             _soft);
+
+// compute encoded message length for LDPC codes
+//  _dec_msg_len    :   decoded message length (bytes)
+//  _k              :   information bytes per codeword
+//  _p              :   parity bytes per codeword
+unsigned int fec_ldpc_get_enc_msg_len(unsigned int _dec_msg_len,
+                                      unsigned int _k,
+                                      unsigned int _p)
+{
+    if (_dec_msg_len == 0)
+        return 0;
+
+    // compute the number of codewords: ceil(dec_msg_len/k)
+    unsigned int num_blocks = (_dec_msg_len + _k - 1) / _k;
+
+    // each codeword carries its (shortened) information bytes along
+    // with a full set of parity bytes
+    return _dec_msg_len + num_blocks*_p;
+}
+
+// create LDPC codec object
+fec fec_ldpc_create(fec_scheme _fs)
+{
+    fec q = (fec) malloc(sizeof(struct fec_s));
+
+    q->scheme = _fs;
+    q->rate = fec_get_rate(q->scheme);
+
+    q->encode_func      = &fec_ldpc_encode;
+    q->decode_func      = &fec_ldpc_decode;
+    q->decode_soft_func = &fec_ldpc_decode_soft;
+
+    // set base matrix
+    switch (q->scheme) {
+    case LIQUID_FEC_LDPC_R12: q->ldpc_base = fec_ldpc_r12_base; q->ldpc_mb = 12; break;
+    case LIQUID_FEC_LDPC_R23: q->ldpc_base = fec_ldpc_r23_base; q->ldpc_mb =  8; break;
+    case LIQUID_FEC_LDPC_R34: q->ldpc_base = fec_ldpc_r34_base; q->ldpc_mb =  6; break;
+    case LIQUID_FEC_LDPC_R56: q->ldpc_base = fec_ldpc_r56_base; q->ldpc_mb =  4; break;
+    default:
+        fprintf(stderr,"error: fec_ldpc_create(), invalid type\n");
+        exit(1);
+    }
+    q->ldpc_nb = FEC_LDPC_NB;
+    q->ldpc_Z  = FEC_LDPC_Z;
+    q->ldpc_max_iterations = FEC_LDPC_MAX_ITER;
+
+    // build edge list for each layer from base matrix
+    unsigned int i, j;
+    q->ldpc_row_ptr = (unsigned int*) malloc((q->ldpc_mb+1)*sizeof(unsigned int));
+    q->ldpc_col     = (unsigned int*) malloc(q->ldpc_mb*q->ldpc_nb*sizeof(unsigned int));
+    q->ldpc_shift   = (unsigned int*) malloc(q->ldpc_mb*q->ldpc_nb*sizeof(unsigned int));
+    unsigned int num_edges  = 0;
+    unsigned int max_degree = 0;
+    for (i=0; i<q->ldpc_mb; i++) {
+        q->ldpc_row_ptr[i] = num_edges;
+        for (j=0; j<q->ldpc_nb; j++) {
+            int s = q->ldpc_base[i*q->ldpc_nb + j];
+            if (s < 0)
+                continue;
+            q->ldpc_col  [num_edges] = j;
+            q->ldpc_shift[num_edges] = (unsigned int)s;
+            num_edges++;
+        }
+        unsigned int d = num_edges - q->ldpc_row_ptr[i];
+        max_degree = d > max_degree ? d : max_degree;
+    }
+    q->ldpc_row_ptr[q->ldpc_mb] = num_edges;
+    q->ldpc_num_edges = num_edges;
+
+    // allocate memory for decoder state
+    unsigned int n = q->ldpc_nb * q->ldpc_Z;
+    q->ldpc_L = (float*)         malloc(n*sizeof(float));
+    q->ldpc_R = (float*)         malloc(num_edges*q->ldpc_Z*sizeof(float));
+    q->ldpc_t = (float*)         malloc(max_degree*q->ldpc_Z*sizeof(float));
+    q->ldpc_c = (unsigned char*) malloc(n*sizeof(unsigned char));
+
+    // lengths
+    q->num_dec_bytes = 0;
+    q->num_enc_bytes = 0;
+    q->num_blocks    = 0;
+    q->dec_block_len = 0;
+    q->enc_block_len = 0;
+    q->res_block_len = 0;
+
+    return q;
+}
+
+// destroy LDPC codec object
+void fec_ldpc_destroy(fec _q)
+{
+    free(_q->ldpc_row_ptr);
+    free(_q->ldpc_col);
+    free(_q->ldpc_shift);
+    free(_q->ldpc_L);
+    free(_q->ldpc_R);
+    free(_q->ldpc_t);
+    free(_q->ldpc_c);
+    free(_q);
+}
+
+// set message length, computing block sizes
+void fec_ldpc_setlength(fec _q,
+                        unsigned int _dec_msg_len)
+{
+    // return if length has not changed
+    if (_dec_msg_len == _q->num_dec_bytes)
+        return;
+
+    unsigned int kbytes = (_q->ldpc_nb - _q->ldpc_mb)*_q->ldpc_Z / 8;
+    unsigned int pbytes = _q->ldpc_mb*_q->ldpc_Z / 8;
+
+    _q->num_dec_bytes = _dec_msg_len;
+    _q->num_enc_bytes = fec_ldpc_get_enc_msg_len(_dec_msg_len, kbytes, pbytes);
+
+    // spread message evenly across codewords: the last block is
+    // smaller by the residual block length
+    _q->num_blocks    = (_dec_msg_len + kbytes - 1) / kbytes;
+    _q->dec_block_len = _q->num_blocks == 0 ? 0 :
+                        (_dec_msg_len + _q->num_blocks - 1) / _q->num_blocks;
+    _q->res_block_len = _q->num_blocks*_q->dec_block_len - _dec_msg_len;
+    _q->enc_block_len = _q->dec_block_len + pbytes;
+
+#if DEBUG_FEC_LDPC
+    printf("fec_ldpc_setlength(%u)\n", _dec_msg_len);
+    printf("    num blocks      :   %u\n", _q->num_blocks);
+    printf("    dec block len   :   %u\n", _q->dec_block_len);
+    printf("    res block len   :   %u\n", _q->res_block_len);
+    printf("    enc msg len     :   %u\n", _q->num_enc_bytes);
+#endif
+}
+
+// encode a single codeword
+void fec_ldpc_encode_codeword(fec _q)
+{
+    unsigned int mb = _q->ldpc_mb;
+    unsigned int kb = _q->ldpc_nb - mb;
+    unsigned int Z  = _q->ldpc_Z;
+    unsigned char * c = _q->ldpc_c;
+    unsigned int i, e, z;
+
+    // compute partial syndromes of information bits for each layer
+    unsigned char lambda[mb*Z];
+    memset(lambda, 0x00, mb*Z*sizeof(unsigned char));
+    for (i=0; i<mb; i++) {
+        for (e=_q->ldpc_row_ptr[i]; e<_q->ldpc_row_ptr[i+1]; e++) {
+            unsigned int j = _q->ldpc_col[e];
+            unsigned int s = _q->ldpc_shift[e];
+            if (j >= kb)
+                break;
+            for (z=0; z<Z; z++)
+                lambda[i*Z+z] ^= c[j*Z + (z+s)%Z];
+        }
+    }
+
+    // first parity block: summing all layers cancels the staircase
+    // blocks and the two equal shifts of the weight-3 column, leaving
+    // only the middle shift
+    unsigned char * p0 = &c[kb*Z];
+    unsigned int b = 0;
+    for (i=1; i<mb-1; i++) {
+        int s = _q->ldpc_base[i*_q->ldpc_nb + kb];
+        if (s >= 0) b = (unsigned int)s;
+    }
+    for (z=0; z<Z; z++) {
+        unsigned char v = 0;
+        for (i=0; i<mb; i++)
+            v ^= lambda[i*Z+z];
+        p0[(z+b)%Z] = v;
+    }
+
+    // remaining parity blocks by back-substitution along the staircase
+    for (i=0; i<mb-1; i++) {
+        unsigned char * p_prev = &c[(kb+i  )*Z];
+        unsigned char * p_next = &c[(kb+i+1)*Z];
+        int h = _q->ldpc_base[i*_q->ldpc_nb + kb];
+        for (z=0; z<Z; z++) {
+            unsigned char v = lambda[i*Z+z];
+            if (i > 0)  v ^= p_prev[z];
+            if (h >= 0) v ^= p0[(z+h)%Z];
+            p_next[z] = v;
+        }
+    }
+}
+
+// encode block of data using LDPC encoder
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_dec        :   decoded message [size: _dec_msg_len x 1]
+//  _msg_enc        :   encoded message [size: enc_msg_len x 1]
+void fec_ldpc_encode(fec _q,
+                     unsigned int _dec_msg_len,
+                     unsigned char *_msg_dec,
+                     unsigned char *_msg_enc)
+{
+    // re-compute block sizes if necessary
+    fec_ldpc_setlength(_q, _dec_msg_len);
+
+    unsigned int kb     = _q->ldpc_nb - _q->ldpc_mb;
+    unsigned int Z      = _q->ldpc_Z;
+    unsigned int pbytes = _q->ldpc_mb*Z/8;
+    unsigned char * c   = _q->ldpc_c;
+
+    unsigned int i, j;
+    unsigned int n0=0;  // input index
+    unsigned int n1=0;  // output index
+    unsigned int block_size = _q->dec_block_len;
+    for (i=0; i<_q->num_blocks; i++) {
+        // the last block is smaller by the residual block length
+        if (i == _q->num_blocks-1)
+            block_size -= _q->res_block_len;
+
+        // unpack information bits, shortening unused bits with zeros
+        memset(c, 0x00, kb*Z*sizeof(unsigned char));
+        for (j=0; j<8*block_size; j++)
+            c[j] = (_msg_dec[n0 + j/8] >> (7-(j%8))) & 1;
+
+        // compute parity bits
+        fec_ldpc_encode_codeword(_q);
+
+        // copy information bytes followed by packed parity bits
+        memmove(&_msg_enc[n1], &_msg_dec[n0], block_size*sizeof(unsigned char));
+        for (j=0; j<pbytes; j++) {
+            unsigned char * p = &c[kb*Z + 8*j];
+            _msg_enc[n1 + block_size + j] = (p[0] << 7) | (p[1] << 6) |
+                                            (p[2] << 5) | (p[3] << 4) |
+                                            (p[4] << 3) | (p[5] << 2) |
+                                            (p[6] << 1) | (p[7]     );
+        }
+
+        // increment counters
+        n0 += block_size;
+        n1 += block_size + pbytes;
+    }
+
+    // sanity check
+    assert( n0 == _q->num_dec_bytes );
+    assert( n1 == _q->num_enc_bytes );
+}
+
+// decode all codewords in message
+void fec_ldpc_decode_blocks(fec             _q,
+                            unsigned int    _dec_msg_len,
+                            unsigned char * _msg_enc,
+                            unsigned char * _msg_dec,
+                            int             _soft)
+{
+    // re-compute block sizes if necessary
+    fec_ldpc_setlength(_q, _dec_msg_len);
+
+    unsigned int kb     = _q->ldpc_nb - _q->ldpc_mb;
+    unsigned int Z      = _q->ldpc_Z;
+    unsigned int pbytes = _q->ldpc_mb*Z/8;
+    float * L           = _q->ldpc_L;
+
+    unsigned int i, j;
+    unsigned int n0=0;  // output index (bytes)
+    unsigned int n1=0;  // input index (bytes)
+    unsigned int block_size = _q->dec_block_len;
+    for (i=0; i<_q->num_blocks; i++) {
+        // the last block is smaller by the residual block length
+        if (i == _q->num_blocks-1)
+            block_size -= _q->res_block_len;
+
+        // load channel log-likelihood ratios; positive values favor
+        // '0' and shortened bits are known to be zero
+        unsigned int num_info_bits = 8*block_size;
+        unsigned int num_bits      = 8*(block_size + pbytes);
+        for (j=0; j<num_bits; j++) {
+            unsigned int k = j < num_info_bits ? j : kb*Z + j - num_info_bits;
+            unsigned int v = _soft ? _msg_enc[8*n1 + j] :
+                             ((_msg_enc[n1 + j/8] >> (7-(j%8))) & 1) ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
+            L[k] = (float)LIQUID_SOFTBIT_ERASURE - (float)v + 0.5f;
+        }
+        for (j=num_info_bits; j<kb*Z; j++)
+            L[j] = FEC_LDPC_LLR_SHORTENED;
+
+        // run decoder; on failure to converge, the hard decisions
+        // from the final iteration are used
+        int num_iterations = fec_ldpc_decode_codeword(_q);
+#if DEBUG_FEC_LDPC
+        printf("fec_ldpc_decode(), block %u : %d iterations\n", i, num_iterations);
+#else
+        (void)num_iterations;
+#endif
+
+        // pack hard decisions for information bits
+        for (j=0; j<block_size; j++) {
+            float * l = &L[8*j];
+            _msg_dec[n0+j] = (l[0] < 0 ? 0x80 : 0) | (l[1] < 0 ? 0x40 : 0) |
+                             (l[2] < 0 ? 0x20 : 0) | (l[3] < 0 ? 0x10 : 0) |
+                             (l[4] < 0 ? 0x08 : 0) | (l[5] < 0 ? 0x04 : 0) |
+                             (l[6] < 0 ? 0x02 : 0) | (l[7] < 0 ? 0x01 : 0);
+        }
+
+        // increment counters
+        n0 += block_size;
+        n1 += block_size + pbytes;
+    }
+
+    // sanity check
+    assert( n0 == _q->num_dec_bytes );
+    assert( n1 == _q->num_enc_bytes );
+}
+
+// decode block of data using LDPC decoder (hard decision)
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message [size: enc_msg_len x 1]
+//  _msg_dec        :   decoded message [size: _dec_msg_len x 1]
+void fec_ldpc_decode(fec _q,
+                     unsigned int _dec_msg_len,
+                     unsigned char *_msg_enc,
+                     unsigned char *_msg_dec)
+{
+    fec_ldpc_decode_blocks(_q, _dec_msg_len, _msg_enc, _msg_dec, 0);
+}
+
+// decode block of data using LDPC decoder (soft decision)
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message (soft bits) [size: 8*enc_msg_len x 1]
+//  _msg_dec        :   decoded message [size: _dec_msg_len x 1]
+void fec_ldpc_decode_soft(fec _q,
+                          unsigned int _dec_msg_len,
+                          unsigned char *_msg_enc,
+                          unsigned char *_msg_dec)
+{
+    fec_ldpc_decode_blocks(_q, _dec_msg_len, _msg_enc, _msg_dec, 1);
+}
+
+// run layered normalized min-sum decoder on a single codeword
+int fec_ldpc_decode_codeword(fec _q)
+{
+    unsigned int Z = _q->ldpc_Z;
+    float * L = _q->ldpc_L;
+    float * t = _q->ldpc_t;
+
+    // no need to run decoder if hard decisions are already valid
+    if (fec_ldpc_check_parity(_q))
+        return 0;
+
+    // reset check-to-variable messages
+    memset(_q->ldpc_R, 0x00, _q->ldpc_num_edges*Z*sizeof(float));
+
+    unsigned int n, i, e;
+    for (n=0; n<_q->ldpc_max_iterations; n++) {
+        for (i=0; i<_q->ldpc_mb; i++) {
+            unsigned int e0 = _q->ldpc_row_ptr[i];
+            unsigned int d  = _q->ldpc_row_ptr[i+1] - e0;
+
+            // gather posteriors, rotating each block column into
+            // check-node order so that lanes line up across edges
+            for (e=0; e<d; e++) {
+                float *      v = &L[_q->ldpc_col[e0+e]*Z];
+                unsigned int s = _q->ldpc_shift[e0+e];
+                memmove(&t[e*Z],       &v[s], (Z-s)*sizeof(float));
+                memmove(&t[e*Z + Z-s], &v[0],     s*sizeof(float));
+            }
+
+            // update check nodes in this layer
+            fec_ldpc_layer_update(t, &_q->ldpc_R[e0*Z], d, Z, FEC_LDPC_ALPHA);
+
+            // scatter updated posteriors back to variable-node order
+            for (e=0; e<d; e++) {
+                float *      v = &L[_q->ldpc_col[e0+e]*Z];
+                unsigned int s = _q->ldpc_shift[e0+e];
+                memmove(&v[s], &t[e*Z],       (Z-s)*sizeof(float));
+                memmove(&v[0], &t[e*Z + Z-s],     s*sizeof(float));
+            }
+        }
+
+        // early termination
+        if (fec_ldpc_check_parity(_q))
+            return n+1;
+    }
+
+    return -1;
+}
+
+// check parity of hard decisions from posterior LLRs
+int fec_ldpc_check_parity(fec _q)
+{
+    unsigned int Z = _q->ldpc_Z;
+    unsigned int n = _q->ldpc_nb * Z;
+    unsigned char * c = _q->ldpc_c;
+    unsigned int i, j, e, z;
+
+    // hard decisions
+    for (j=0; j<n; j++)
+        c[j] = _q->ldpc_L[j] < 0 ? 1 : 0;
+
+    // compute syndrome for each layer
+    for (i=0; i<_q->ldpc_mb; i++) {
+        unsigned char syndrome[Z];
+        memset(syndrome, 0x00, Z*sizeof(unsigned char));
+        for (e=_q->ldpc_row_ptr[i]; e<_q->ldpc_row_ptr[i+1]; e++) {
+            unsigned char * v = &c[_q->ldpc_col[e]*Z];
+            unsigned int    s = _q->ldpc_shift[e];
+            for (z=0; z<Z-s; z++) syndrome[z]     ^= v[z+s];
+            for (z=0; z<s;   z++) syndrome[Z-s+z] ^= v[z];
+        }
+
+        unsigned char r = 0;
+        for (z=0; z<Z; z++)
+            r |= syndrome[z];
+        if (r)
+            return 0;
+    }
+    return 1;
+}
+
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H
+// the lifting factor is fixed, so the four-wide layer update below never
+// needs to handle a remainder
+#if (FEC_LDPC_Z % 4) != 0
+#  error "fec_ldpc: lifting factor must be a multiple of four"
+#endif
+
+// update a single layer of the decoder (SSE2, four check nodes at a time;
+// _Z must be a multiple of four)
+void fec_ldpc_layer_update(float *      _t,
+                           float *      _R,
+                           unsigned int _d,
+                           unsigned int _Z,
+                           float        _alpha)
+{
+    const __m128 mask_abs = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 mask_sgn = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+    const __m128 alpha    = _mm_set1_ps(_alpha);
+
+    unsigned int z, e;
+    for (z=0; z<_Z; z+=4) {
+        __m128 min1 = _mm_set1_ps(FLT_MAX);
+        __m128 min2 = _mm_set1_ps(FLT_MAX);
+        __m128 idx  = _mm_setzero_ps();
+        __m128 sgn  = _mm_setzero_ps();
+
+        // subtract previous messages from posteriors, tracking the two
+        // smallest magnitudes, index of the smallest, and sign parity
+        for (e=0; e<_d; e++) {
+            __m128 v = _mm_sub_ps(_mm_loadu_ps(&_t[e*_Z+z]), _mm_loadu_ps(&_R[e*_Z+z]));
+            _mm_storeu_ps(&_t[e*_Z+z], v);
+
+            __m128 a  = _mm_and_ps(v, mask_abs);
+            __m128 lt = _mm_cmplt_ps(a, min1);
+            sgn  = _mm_xor_ps(sgn, _mm_and_ps(v, mask_sgn));
+            min2 = _mm_min_ps(min2, _mm_max_ps(min1, a));
+            idx  = _mm_or_ps(_mm_and_ps(lt, _mm_set1_ps((float)e)), _mm_andnot_ps(lt, idx));
+            min1 = _mm_min_ps(min1, a);
+        }
+        min1 = _mm_mul_ps(min1, alpha);
+        min2 = _mm_mul_ps(min2, alpha);
+
+        // compute new messages and update posteriors
+        for (e=0; e<_d; e++) {
+            __m128 v  = _mm_loadu_ps(&_t[e*_Z+z]);
+            __m128 eq = _mm_cmpeq_ps(idx, _mm_set1_ps((float)e));
+            __m128 m  = _mm_or_ps(_mm_and_ps(eq, min2), _mm_andnot_ps(eq, min1));
+            __m128 r  = _mm_xor_ps(m, _mm_xor_ps(sgn, _mm_and_ps(v, mask_sgn)));
+            _mm_storeu_ps(&_R[e*_Z+z], r);
+            _mm_storeu_ps(&_t[e*_Z+z], _mm_add_ps(v, r));
+        }
+    }
+}
+#else
+// update a single layer of the decoder (portable C)
+void fec_ldpc_layer_update(float *      _t,
+                           float *      _R,
+                           unsigned int _d,
+                           unsigned int _Z,
+                           float        _alpha)
+{
+    float        min1[_Z];
+    float        min2[_Z];
+    unsigned int idx [_Z];
+    unsigned int sgn [_Z];
+
+    unsigned int z, e;
+    for (z=0; z<_Z; z++) {
+        min1[z] = FLT_MAX;
+        min2[z] = FLT_MAX;
+        idx [z] = 0;
+        sgn [z] = 0;
+    }
+
+    // subtract previous messages from posteriors, tracking the two
+    // smallest magnitudes, index of the smallest, and sign parity
+    for (e=0; e<_d; e++) {
+        float * t = &_t[e*_Z];
+        float * R = &_R[e*_Z];
+        for (z=0; z<_Z; z++) {
+            float v = t[z] - R[z];
+            float a = fabsf(v);
+            t[z] = v;
+            sgn[z] ^= v < 0;
+            if (a < min1[z]) {
+                min2[z] = min1[z];
+                min1[z] = a;
+                idx [z] = e;
+            } else if (a < min2[z]) {
+                min2[z] = a;
+            }
+        }
+    }
+
+    // compute new messages and update posteriors
+    for (e=0; e<_d; e++) {
+        float * t = &_t[e*_Z];
+        float * R = &_R[e*_Z];
+        for (z=0; z<_Z; z++) {
+            float m = _alpha * (idx[z] == e ? min2[z] : min1[z]);
+            float r = (sgn[z] ^ (t[z] < 0)) ? -m : m;
+            R[z]  = r;
+            t[z] += r;
+        }
+    }
+}
+#endif
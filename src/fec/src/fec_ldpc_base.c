@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Quasi-cyclic LDPC base matrices
+//
+// Each base matrix has 24 block columns and is lifted by a factor
+// Z=64 to yield a code length of n=1536 bits. An entry s >= 0 denotes
+// a Z x Z identity matrix cyclically shifted by s such that check
+// node z in the block row connects to variable node (z+s) mod Z in
+// the block column; an entry of -1 denotes the all-zero block.
+//
+// The parity portion (right-most mb block columns) uses the
+// dual-diagonal structure of IEEE 802.11n which allows for linear-time
+// encoding directly from the parity-check matrix: the first parity
+// column has weight three with equal shifts in the first and last
+// rows, and the remaining columns form a staircase of identities.
+// Shifts in the systematic portion were chosen to avoid all cycles of
+// length four in the lifted graph.
+//
+
+#include "liquid.internal.h"
+
+// rate 1/2 : [12 x 24] base matrix, k=768, n=1536
+const int fec_ldpc_r12_base[12*FEC_LDPC_NB] = {
+     8, 60, -1, -1, 20, -1, 36, -1, 40, 57, -1, -1,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    11, 51, -1, -1, 43, 57, -1, -1, 29, -1, 31, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0, 16, -1, -1, 47, 49, -1, -1,  8, -1, 48, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1,
+    19, 40, -1, -1, 14, 10, -1, 31, -1, 45, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1,
+    34, 37, -1, 51, 50, -1, -1, -1, 48, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1,
+    26,  9, -1, 60, -1, -1, -1, 59, 59, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1,
+    -1, 21, -1, -1, 18, -1, -1, 49, 41, -1, -1, -1,  0, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1,
+    49, 24,  5, -1,  8, -1, -1, -1, 42, -1, -1, 32, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1,
+    55, -1, 54, -1, 15, -1,  8, -1, 47, -1, -1, 51, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1,
+    18, 28, -1, 58, 17, -1, -1, -1, 52, 35, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1,
+    39, 11, -1, -1, 31, -1, 45, -1, 27, -1, -1, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0,
+     1, 43, 62, -1, 47, -1, -1, -1, 12, -1, 47, -1,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,
+};
+
+// rate 2/3 : [8 x 24] base matrix, k=1024, n=1536
+const int fec_ldpc_r23_base[ 8*FEC_LDPC_NB] = {
+    11, 44, 63, 53, 10, -1, -1, -1, 24, -1, 17, 34, -1, -1, 56, -1,  1,  0, -1, -1, -1, -1, -1, -1,
+    33, 27,  2, 54, -1, -1, 16, -1, 26, 37, -1, -1, -1, 45, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1,
+    51,  3, 31, 61, 54, -1, -1, 18, -1, 50, -1, -1, 15, -1, 27, -1, -1, -1,  0,  0, -1, -1, -1, -1,
+    56, 34, 26,  4, -1, 58, -1, -1, 37, -1, -1, 54, -1, 14, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1,
+     8, 55, 22, 45, -1, -1, 35, -1, -1, -1, 56, -1, -1, 60, -1, -1,  0, -1, -1, -1,  0,  0, -1, -1,
+    57, 23, 28, 47, -1, 45, 27, -1, -1, -1, 29, -1, 46, -1, -1, 57, -1, -1, -1, -1, -1,  0,  0, -1,
+    58,  0, 37, 29, -1, 43, -1,  0, -1,  2, -1, -1, -1, -1, 10, 42, -1, -1, -1, -1, -1, -1,  0,  0,
+    29, 18,  5, 49, 39, -1, -1, 48, -1, -1, -1,  7, 31, -1, -1, 49,  1, -1, -1, -1, -1, -1, -1,  0,
+};
+
+// rate 3/4 : [6 x 24] base matrix, k=1152, n=1536
+const int fec_ldpc_r34_base[ 6*FEC_LDPC_NB] = {
+    23, 17, 56, 30,  5,  8, -1, -1, -1, 10, -1, 58, 47, -1, 29, 48, -1, -1,  1,  0, -1, -1, -1, -1,
+    29, 53, 31, 53, 48, -1, -1, 56, 10, -1, -1, 54, 61, 51, -1, -1, -1,  6, -1,  0,  0, -1, -1, -1,
+    49, 17, 29, 31, -1, 56, 39, -1,  5, -1, 16, -1, 43, -1, -1, 61, 53, -1, -1, -1,  0,  0, -1, -1,
+     9, 10, 46, 61, -1, -1,  3, 61, -1, -1, 36,  6, -1, -1, 12, -1, 29, 61,  0, -1, -1,  0,  0, -1,
+    27, 20, 27, 37, -1, 23, 22, -1, 27, 11, -1, -1, -1, 41, -1,  5, 40, -1, -1, -1, -1, -1,  0,  0,
+    42,  7, 34, 48, 14, -1, -1, 16, -1, 24, 13, -1, -1, 20, 14, -1, -1, 56,  1, -1, -1, -1, -1,  0,
+};
+
+// rate 5/6 : [4 x 24] base matrix, k=1280, n=1536
+const int fec_ldpc_r56_base[ 4*FEC_LDPC_NB] = {
+    11, 25, 40, 47, 20, 24, 32, -1, 43, 35, -1, 25,  7, 28, -1, 31, 58, -1,  4,  6,  1,  0, -1, -1,
+    47, 16, 46, 62, 25, 28, -1, 40, 63, -1, 53,  3, 55, 25, 39,  5, -1,  9, 28, 29, -1,  0,  0, -1,
+    19, 46, 20, 39, -1, -1, 30, 39, 46, 44, 57, 47, -1, 30, 55, -1, 19,  1, -1, 58,  0, -1,  0,  0,
+     6, 10, 61,  8, 44, 63, 40,  5, -1, 11, 49, -1, 13, -1, 44, 14, 10, 35, 34, -1,  1, -1, -1,  0,
+};
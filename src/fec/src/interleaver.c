@@ -29,6 +29,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <math.h>
 
 #include "liquid.internal.h"
@@ -37,32 +38,33 @@
 // internal methods
 //
 
-// permute one iteration
-void interleaver_permute(unsigned char * _x,
-                         unsigned int    _n,
-                         unsigned int    _M,
-                         unsigned int    _N);
-
-// permute one iteration (soft bit input)
-void interleaver_permute_soft(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N);
-
-// permute one iteration with mask
-void interleaver_permute_mask(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N,
-                              unsigned char   _mask);
-
-// permute one iteration (soft bit input) with mask
-void interleaver_permute_mask_soft(unsigned char * _x,
-                                   unsigned int    _n,
-                                   unsigned int    _M,
-                                   unsigned int    _N,
-                                   unsigned char   _mask);
-
+// compute block dimensions for current length
+void interleaver_compute_dims(interleaver _q);
+
+// compute permutation maps for current depth
+void interleaver_compute_maps(interleaver _q);
+
+// apply one permutation iteration to per-lane index maps
+//  _map    :   index maps [size: 8 x _n], one for each bit lane
+//  _n      :   number of bytes
+//  _M      :   row dimension
+//  _N      :   col dimension
+//  _mask   :   bit lanes to permute
+void interleaver_permute_map(unsigned int * _map,
+                             unsigned int   _n,
+                             unsigned int   _M,
+                             unsigned int   _N,
+                             unsigned char  _mask);
+
+// gather bytes (hard) or 8-byte soft-bit blocks (soft) using maps
+void interleaver_gather(interleaver     _q,
+                        unsigned int *  _map,
+                        unsigned char * _x,
+                        unsigned char * _y);
+void interleaver_gather_soft(interleaver     _q,
+                             unsigned int *  _map,
+                             unsigned char * _x,
+                             unsigned char * _y);
 
 // structured interleaver object
 struct interleaver_s {
@@ -73,6 +75,23 @@ struct interleaver_s {
 
     // interleaving depth (number of permutations)
     unsigned int depth;
+
+    // Each permutation iteration swaps bytes (or masked bits within
+    // bytes) without moving any bit to a different position within its
+    // byte, so the full interleaver is a separate byte permutation for
+    // each bit lane. Lanes sharing the same permutation are grouped so
+    // that each output byte is assembled from just one masked byte
+    // (or one masked 64-bit word of soft bits) per group.
+    unsigned int    num_groups;     // number of distinct lane groups
+    unsigned char   mask[8];        // bit lanes in each group
+    uint64_t        mask_soft[8];   // soft-bit lanes in each group
+    unsigned int *  map_enc;        // encoder maps [size: n x num_groups]
+    unsigned int *  map_dec;        // decoder maps [size: n x num_groups]
+    unsigned char * buf;            // buffer for in-place operation [size: 8n]
+
+    // memory management
+    unsigned int    n_max;          // maximum length supported by memory
+    int             ext_mem;        // memory provided by caller?
 };
 
 // create interleaver of length _n input/output bytes
@@ -85,10 +104,15 @@ interleaver interleaver_create(unsigned int _n)
     q->depth = 4;   // default depth to maximum 
 
     // compute block dimensions
-    q->M = 1 + (unsigned int) floorf(sqrtf(q->n));
+    interleaver_compute_dims(q);
 
-    q->N = q->n / q->M;
-    while (q->n >= (q->M*q->N)) q->N++;  // ensures M*N >= n
+    // allocate memory for permutation maps and compute them
+    q->n_max   = q->n;
+    q->ext_mem = 0;
+    q->map_enc = (unsigned int *) malloc(8*q->n*sizeof(unsigned int));
+    q->map_dec = (unsigned int *) malloc(8*q->n*sizeof(unsigned int));
+    q->buf     = (unsigned char*) malloc(8*q->n*sizeof(unsigned char));
+    interleaver_compute_maps(q);
 
     return q;
 }
@@ -96,10 +120,72 @@ interleaver interleaver_create(unsigned int _n)
 // destroy interleaver object
 void interleaver_destroy(interleaver _q)
 {
+    // free internal buffers
+    if (!_q->ext_mem) {
+        free(_q->map_enc);
+        free(_q->map_dec);
+        free(_q->buf);
+    }
+
     // free main object memory
     free(_q);
 }
 
+// get size of external workspace (bytes) required for an
+// interleaver of length _n bytes
+unsigned int interleaver_get_workspace_size(unsigned int _n)
+{
+    // encoder/decoder maps and in-place buffer
+    return 2*8*_n*sizeof(unsigned int) + 8*_n*sizeof(unsigned char);
+}
+
+// set interleaver length, keeping current depth
+//  _q          :   interleaver object
+//  _n          :   new length (bytes)
+//  _workspace  :   external memory of at least
+//                  interleaver_get_workspace_size(_n) bytes aligned
+//                  for unsigned int, or NULL to use internal memory
+void interleaver_set_length(interleaver  _q,
+                            unsigned int _n,
+                            void *       _workspace)
+{
+    // check if anything has changed
+    if (_n == _q->n && ((_workspace == NULL && !_q->ext_mem) ||
+                        (_workspace == (void*)_q->map_enc)))
+        return;
+
+    if (_workspace != NULL) {
+        // release internal memory and partition workspace
+        if (!_q->ext_mem) {
+            free(_q->map_enc);
+            free(_q->map_dec);
+            free(_q->buf);
+        }
+        _q->ext_mem = 1;
+        _q->n_max   = _n;
+        _q->map_enc = (unsigned int *) _workspace;
+        _q->map_dec = _q->map_enc + 8*_n;
+        _q->buf     = (unsigned char*) (_q->map_dec + 8*_n);
+    } else if (_q->ext_mem || _n > _q->n_max) {
+        // memory is external or too small; (re-)allocate internally
+        if (!_q->ext_mem) {
+            free(_q->map_enc);
+            free(_q->map_dec);
+            free(_q->buf);
+        }
+        _q->ext_mem = 0;
+        _q->n_max   = _n;
+        _q->map_enc = (unsigned int *) malloc(8*_n*sizeof(unsigned int));
+        _q->map_dec = (unsigned int *) malloc(8*_n*sizeof(unsigned int));
+        _q->buf     = (unsigned char*) malloc(8*_n*sizeof(unsigned char));
+    }
+
+    // update dimensions and re-compute permutation maps
+    _q->n = _n;
+    interleaver_compute_dims(_q);
+    interleaver_compute_maps(_q);
+}
+
 // print interleaver internals
 void interleaver_print(interleaver _q)
 {
@@ -114,6 +200,9 @@ void interleaver_set_depth(interleaver  _q,
                            unsigned int _depth)
 {
     _q->depth = _depth;
+
+    // re-compute permutation maps
+    interleaver_compute_maps(_q);
 }
 
 // execute forward interleaver (encoder)
@@ -124,13 +213,7 @@ void interleaver_encode(interleaver _q,
                         unsigned char * _msg_dec,
                         unsigned char * _msg_enc)
 {
-    // copy data to output
-    memmove(_msg_enc, _msg_dec, _q->n);
-
-    if (_q->depth > 0) interleaver_permute(_msg_enc, _q->n, _q->M, _q->N);
-    if (_q->depth > 1) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 2) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 3) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+8, 0x33);
+    interleaver_gather(_q, _q->map_enc, _msg_dec, _msg_enc);
 }
 
 // execute forward interleaver (encoder) on soft bits
@@ -141,13 +224,7 @@ void interleaver_encode_soft(interleaver _q,
                              unsigned char * _msg_dec,
                              unsigned char * _msg_enc)
 {
-    // copy data to output
-    memmove(_msg_enc, _msg_dec, 8*_q->n);
-
-    if (_q->depth > 0) interleaver_permute_soft(_msg_enc, _q->n, _q->M, _q->N);
-    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+8, 0x33);
+    interleaver_gather_soft(_q, _q->map_enc, _msg_dec, _msg_enc);
 }
 
 // execute reverse interleaver (decoder)
@@ -158,13 +235,7 @@ void interleaver_decode(interleaver _q,
                         unsigned char * _msg_enc,
                         unsigned char * _msg_dec)
 {
-    // copy data to output
-    memmove(_msg_dec, _msg_enc, _q->n);
-
-    if (_q->depth > 3) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+8, 0x33);
-    if (_q->depth > 2) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 1) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 0) interleaver_permute(_msg_dec, _q->n, _q->M, _q->N);
+    interleaver_gather(_q, _q->map_dec, _msg_enc, _msg_dec);
 }
 
 // execute reverse interleaver (decoder) on soft bits
@@ -175,120 +246,92 @@ void interleaver_decode_soft(interleaver _q,
                              unsigned char * _msg_enc,
                              unsigned char * _msg_dec)
 {
-    // copy data to output
-    memmove(_msg_dec, _msg_enc, 8*_q->n);
-
-    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+8, 0x33);
-    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 0) interleaver_permute_soft(_msg_dec, _q->n, _q->M, _q->N);
+    interleaver_gather_soft(_q, _q->map_dec, _msg_enc, _msg_dec);
 }
 
 // 
-// internal permutation methods
+// internal methods
 //
 
-// permute one iteration
-void interleaver_permute(unsigned char * _x,
-                         unsigned int    _n,
-                         unsigned int    _M,
-                         unsigned int    _N)
+// compute block dimensions for current length
+void interleaver_compute_dims(interleaver _q)
 {
-    unsigned int i;
-    unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
-    unsigned char tmp;
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
+    _q->M = 1 + (unsigned int) floorf(sqrtf(_q->n));
 
-        // swap indices
-        tmp = _x[2*j+1];
-        _x[2*j+1] = _x[2*i+0];
-        _x[2*i+0] = tmp;
-    }
+    _q->N = _q->n / _q->M;
+    while (_q->n >= (_q->M*_q->N)) _q->N++;  // ensures M*N >= n
 }
 
-// permute one iteration (soft bit input)
-void interleaver_permute_soft(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N)
+// compute permutation maps for current depth
+void interleaver_compute_maps(interleaver _q)
 {
-    unsigned int i;
-    unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
-    unsigned char tmp[8];
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-    
-        // swap soft bits at indices
-        memmove( tmp,            &_x[8*(2*j+1)], 8);
-        memmove( &_x[8*(2*j+1)], &_x[8*(2*i+0)], 8);
-        memmove( &_x[8*(2*i+0)], tmp,            8);
+    unsigned int n = _q->n;
+    unsigned int i, k, g;
+
+    // per-lane index maps (stored temporarily in decoder map memory)
+    unsigned int * map = _q->map_dec;
+    for (k=0; k<8; k++) {
+        for (i=0; i<n; i++)
+            map[k*n+i] = i;
     }
-    //printf("\n");
-}
 
+    // apply permutation iterations; the output of the forward
+    // interleaver at byte i, lane k is input byte map[k*n+i]
+    if (_q->depth > 0) interleaver_permute_map(map, n, _q->M, _q->N,   0xff);
+    if (_q->depth > 1) interleaver_permute_map(map, n, _q->M, _q->N+2, 0x0f);
+    if (_q->depth > 2) interleaver_permute_map(map, n, _q->M, _q->N+4, 0x55);
+    if (_q->depth > 3) interleaver_permute_map(map, n, _q->M, _q->N+8, 0x33);
+
+    // group lanes with identical maps
+    unsigned int group[8];
+    _q->num_groups = 0;
+    for (k=0; k<8; k++) {
+        for (g=0; g<_q->num_groups; g++) {
+            if (memcmp(&map[k*n], &map[group[g]*n], n*sizeof(unsigned int))==0)
+                break;
+        }
+        if (g == _q->num_groups) {
+            // new group
+            group[g] = k;
+            _q->mask[g] = 0;
+            _q->mask_soft[g] = 0;
+            _q->num_groups++;
+        }
+        // add lane (most-significant bit first) to group
+        unsigned char lane_soft[8] = {0,0,0,0,0,0,0,0};
+        uint64_t lane_mask;
+        lane_soft[k] = 0xff;
+        memmove(&lane_mask, lane_soft, 8);
+        _q->mask[g]      |= 0x80 >> k;
+        _q->mask_soft[g] |= lane_mask;
+    }
 
-// permute one iteration with mask
-void interleaver_permute_mask(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N,
-                              unsigned char   _mask)
-{
-    unsigned int i;
-    unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
-    unsigned char tmp0;
-    unsigned char tmp1;
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
+    // copy encoder maps, interleaving groups so that all indices for
+    // one output byte are adjacent in memory
+    unsigned int G = _q->num_groups;
+    for (i=0; i<n; i++) {
+        for (g=0; g<G; g++)
+            _q->map_enc[i*G+g] = map[group[g]*n + i];
+    }
 
-        // swap indices, applying mask
-        tmp0 = (_x[2*i+0] & (~_mask)) | (_x[2*j+1] & ( _mask));
-        tmp1 = (_x[2*i+0] & ( _mask)) | (_x[2*j+1] & (~_mask));
-        _x[2*i+0] = tmp0;
-        _x[2*j+1] = tmp1;
+    // compute inverse maps for decoder
+    for (i=0; i<n; i++) {
+        for (g=0; g<G; g++)
+            _q->map_dec[_q->map_enc[i*G+g]*G + g] = i;
     }
 }
 
-// permute one iteration (soft bit input)
-void interleaver_permute_mask_soft(unsigned char * _x,
-                                   unsigned int    _n,
-                                   unsigned int    _M,
-                                   unsigned int    _N,
-                                   unsigned char   _mask)
+// apply one permutation iteration to per-lane index maps
+//  _map    :   index maps [size: 8 x _n], one for each bit lane
+//  _n      :   number of bytes
+//  _M      :   row dimension
+//  _N      :   col dimension
+//  _mask   :   bit lanes to permute
+void interleaver_permute_map(unsigned int * _map,
+                             unsigned int   _n,
+                             unsigned int   _M,
+                             unsigned int   _N,
+                             unsigned char  _mask)
 {
     unsigned int i;
     unsigned int j;
@@ -296,7 +339,7 @@ void interleaver_permute_mask_soft(unsigned char * _x,
     unsigned int m=0;
     unsigned int n=_n/3;
     unsigned int n2=_n/2;
-    unsigned char tmp;
+    unsigned int tmp;
     for (i=0; i<n2; i++) {
         //j = m*N + n; // input
         do {
@@ -308,15 +351,93 @@ void interleaver_permute_mask_soft(unsigned char * _x,
             }
         } while (j>=n2);
 
-        // swap bits matching the mask
+        // swap indices for lanes matching the mask
         for (k=0; k<8; k++) {
             if ( (_mask >> (8-k-1)) & 0x01 ) {
-                tmp = _x[8*(2*j+1)+k];
-                _x[8*(2*j+1)+k] = _x[8*(2*i+0)+k];
-                _x[8*(2*i+0)+k] = tmp;
+                tmp = _map[k*_n + 2*j+1];
+                _map[k*_n + 2*j+1] = _map[k*_n + 2*i+0];
+                _map[k*_n + 2*i+0] = tmp;
             }
         }
     }
-    //printf("\n");
 }
 
+// gather bytes using maps
+void interleaver_gather(interleaver     _q,
+                        unsigned int *  _map,
+                        unsigned char * _x,
+                        unsigned char * _y)
+{
+    unsigned int n = _q->n;
+    unsigned int i;
+
+    // operate out of internal buffer if running in place
+    if (_x == _y) {
+        memmove(_q->buf, _x, n);
+        _x = _q->buf;
+    }
+
+    const unsigned char * mask = _q->mask;
+    switch (_q->num_groups) {
+    case 1:
+        for (i=0; i<n; i++)
+            _y[i] = _x[_map[i]];
+        break;
+    case 2:
+        for (i=0; i<n; i++, _map+=2)
+            _y[i] = (_x[_map[0]] & mask[0]) | (_x[_map[1]] & mask[1]);
+        break;
+    case 4:
+        for (i=0; i<n; i++, _map+=4) {
+            _y[i] = (_x[_map[0]] & mask[0]) | (_x[_map[1]] & mask[1]) |
+                    (_x[_map[2]] & mask[2]) | (_x[_map[3]] & mask[3]);
+        }
+        break;
+    case 8:
+        for (i=0; i<n; i++, _map+=8) {
+            _y[i] = (_x[_map[0]] & mask[0]) | (_x[_map[1]] & mask[1]) |
+                    (_x[_map[2]] & mask[2]) | (_x[_map[3]] & mask[3]) |
+                    (_x[_map[4]] & mask[4]) | (_x[_map[5]] & mask[5]) |
+                    (_x[_map[6]] & mask[6]) | (_x[_map[7]] & mask[7]);
+        }
+        break;
+    default:;
+        unsigned int g;
+        unsigned int G = _q->num_groups;
+        for (i=0; i<n; i++, _map+=G) {
+            unsigned char v = 0;
+            for (g=0; g<G; g++)
+                v |= _x[_map[g]] & mask[g];
+            _y[i] = v;
+        }
+    }
+}
+
+// gather 8-byte soft-bit blocks using maps, moving one 64-bit word
+// for each lane group
+void interleaver_gather_soft(interleaver     _q,
+                             unsigned int *  _map,
+                             unsigned char * _x,
+                             unsigned char * _y)
+{
+    unsigned int n = _q->n;
+    unsigned int i;
+    unsigned int g;
+
+    // operate out of internal buffer if running in place
+    if (_x == _y) {
+        memmove(_q->buf, _x, 8*n);
+        _x = _q->buf;
+    }
+
+    unsigned int G = _q->num_groups;
+    uint64_t v, w;
+    for (i=0; i<n; i++, _map+=G) {
+        v = 0;
+        for (g=0; g<G; g++) {
+            memmove(&w, &_x[8*_map[g]], 8);
+            v |= w & _q->mask_soft[g];
+        }
+        memmove(&_y[8*i], &v, 8);
+    }
+}
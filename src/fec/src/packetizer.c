@@ -33,6 +33,15 @@
 // reallocate memory for buffers
 void packetizer_realloc_buffers(packetizer _p, unsigned int _len);
 
+// compute fec/interleaver plan lengths for decoded length _n
+void packetizer_set_lengths(packetizer _p, unsigned int _n);
+
+// assign memory (internal or workspace) for buffers and interleavers
+void packetizer_set_memory(packetizer _p);
+
+// round workspace partition size up to 16-byte boundary
+#define PACKETIZER_ALIGN(n) (((n) + 15) & ~15U)
+
 // computes the number of encoded bytes after packetizing
 //
 //  _n      :   number of uncoded input bytes
@@ -101,6 +110,8 @@ packetizer packetizer_create(unsigned int _n,
     p->packet_len   = packetizer_compute_enc_msg_len(_n, _crc, _fec0, _fec1);
     p->check        = _crc;
     p->crc_length   = crc_get_length(p->check);
+    p->workspace    = NULL;
+    p->workspace_size = 0;
 
     // allocate memory for buffers (scale by 8 for soft decoding)
     p->buffer_len = p->packet_len;
@@ -167,10 +178,84 @@ packetizer packetizer_recreate(packetizer _p,
         return _p;
     }
 
-    // something has changed; destroy old object and create new one
-    // TODO : rather than completely destroying object, only change values that are necessary
-    packetizer_destroy(_p);
-    return packetizer_create(_n,_crc,_fec0,_fec1);
+    // something has changed; re-configure object in place, retaining
+    // memory and fec objects where possible
+    _p->check      = _crc;
+    _p->crc_length = crc_get_length(_p->check);
+
+    unsigned int i;
+    for (i=0; i<_p->plan_len; i++) {
+        fec_scheme fs = (i==0) ? _fec0 : _fec1;
+        if (_p->plan[i].fs == fs)
+            continue;
+
+        // set interleaver depth to zero if no error correction scheme
+        // is applied to this plan
+        if (fs == LIQUID_FEC_NONE)
+            interleaver_set_depth(_p->plan[i].q, 0);
+        else if (_p->plan[i].fs == LIQUID_FEC_NONE)
+            interleaver_set_depth(_p->plan[i].q, 4);
+
+        _p->plan[i].fs = fs;
+        _p->plan[i].f  = fec_recreate(_p->plan[i].f, fs, NULL);
+    }
+
+    // update lengths and memory
+    packetizer_set_lengths(_p, _n);
+    packetizer_set_memory(_p);
+    return _p;
+}
+
+// compute size of workspace (bytes) required to run a packetizer
+// with any decoded length up to _max_len without allocating memory
+//  _max_len:   maximum number of uncoded input bytes
+//  _crc    :   error-detecting scheme
+//  _fec0   :   inner forward error-correction code
+//  _fec1   :   outer forward error-correction code
+unsigned int packetizer_get_workspace_size(unsigned int _max_len,
+                                           int          _crc,
+                                           int          _fec0,
+                                           int          _fec1)
+{
+    unsigned int k  = _max_len + crc_get_length(_crc);
+    unsigned int n0 = fec_get_enc_msg_length(_fec0, k);
+    unsigned int n1 = fec_get_enc_msg_length(_fec1, n0);
+
+    // ping-pong buffers (soft bits) and interleaver for each plan
+    return 2*PACKETIZER_ALIGN(8*n1) +
+           PACKETIZER_ALIGN(interleaver_get_workspace_size(n0)) +
+           PACKETIZER_ALIGN(interleaver_get_workspace_size(n1));
+}
+
+// set external workspace for internal buffers
+//  _p          :   packetizer object
+//  _workspace  :   workspace memory (NULL to revert to internal memory)
+//  _size       :   workspace size (bytes)
+void packetizer_set_workspace(packetizer   _p,
+                              void *       _workspace,
+                              unsigned int _size)
+{
+    if (_workspace == NULL) {
+        if (_p->workspace == NULL)
+            return;
+
+        // revert to internal memory
+        _p->workspace      = NULL;
+        _p->workspace_size = 0;
+        _p->buffer_len     = 0;
+        _p->buffer_0       = NULL;
+        _p->buffer_1       = NULL;
+    } else {
+        // release internal memory
+        if (_p->workspace == NULL) {
+            free(_p->buffer_0);
+            free(_p->buffer_1);
+        }
+        _p->workspace      = (unsigned char*) _workspace;
+        _p->workspace_size = _size;
+    }
+
+    packetizer_set_memory(_p);
 }
 
 // destroy packetizer object
@@ -191,8 +276,10 @@ void packetizer_destroy(packetizer _p)
     free(_p->plan);
 
     // free buffers
-    free(_p->buffer_0);
-    free(_p->buffer_1);
+    if (_p->workspace == NULL) {
+        free(_p->buffer_0);
+        free(_p->buffer_1);
+    }
 
     // free packetizer object
     free(_p);
@@ -278,7 +365,9 @@ void packetizer_encode(packetizer            _p,
 
     // execute fec/interleaver plans
     for (i=0; i<_p->plan_len; i++) {
-        // run the encoder: buffer[0] > buffer[1]
+        // run the encoder: buffer[0] > buffer[1], clearing output first
+        // so that any pad bits do not depend on previous buffer contents
+        memset(_p->buffer_1, 0x00, _p->plan[i].enc_msg_len);
         fec_encode(_p->plan[i].f,
                    _p->plan[i].dec_msg_len,
                    _p->buffer_0,
@@ -419,8 +508,123 @@ void packetizer_set_scheme(packetizer _p, int _fec0, int _fec1)
 
 void packetizer_realloc_buffers(packetizer _p, unsigned int _len)
 {
+    // scale by 8 for soft decoding
     _p->buffer_len = _len;
-    _p->buffer_0 = (unsigned char*) realloc(_p->buffer_0, _p->buffer_len);
-    _p->buffer_1 = (unsigned char*) realloc(_p->buffer_1, _p->buffer_len);
+    _p->buffer_0 = (unsigned char*) realloc(_p->buffer_0, 8*_p->buffer_len);
+    _p->buffer_1 = (unsigned char*) realloc(_p->buffer_1, 8*_p->buffer_len);
+}
+
+// compute fec/interleaver plan lengths for decoded length _n
+void packetizer_set_lengths(packetizer _p, unsigned int _n)
+{
+    _p->msg_len = _n;
+
+    unsigned int i;
+    unsigned int n0 = _n + _p->crc_length;
+    for (i=0; i<_p->plan_len; i++) {
+        _p->plan[i].dec_msg_len = n0;
+        _p->plan[i].enc_msg_len = fec_get_enc_msg_length(_p->plan[i].fs,
+                                                         _p->plan[i].dec_msg_len);
+        n0 = _p->plan[i].enc_msg_len;
+    }
+    _p->packet_len = n0;
 }
 
+// assign memory (internal or workspace) for buffers and interleavers
+void packetizer_set_memory(packetizer _p)
+{
+    unsigned int i;
+    if (_p->workspace == NULL) {
+        // grow internal buffers only when necessary
+        if (_p->packet_len > _p->buffer_len || _p->buffer_0 == NULL)
+            packetizer_realloc_buffers(_p, _p->packet_len);
+
+        for (i=0; i<_p->plan_len; i++)
+            interleaver_set_length(_p->plan[i].q, _p->plan[i].enc_msg_len, NULL);
+        return;
+    }
+
+    // validate workspace size
+    unsigned int size = packetizer_get_workspace_size(_p->msg_len,
+                                                      _p->check,
+                                                      _p->plan[0].fs,
+                                                      _p->plan[1].fs);
+    if (size > _p->workspace_size) {
+        fprintf(stderr,"error: packetizer_set_memory(), workspace too small (%u < %u bytes)\n",
+                _p->workspace_size, size);
+        exit(1);
+    }
+
+    // partition workspace
+    unsigned char * w = _p->workspace;
+    _p->buffer_len = _p->packet_len;
+    _p->buffer_0   = w;     w += PACKETIZER_ALIGN(8*_p->buffer_len);
+    _p->buffer_1   = w;     w += PACKETIZER_ALIGN(8*_p->buffer_len);
+    for (i=0; i<_p->plan_len; i++) {
+        unsigned int n = _p->plan[i].enc_msg_len;
+        interleaver_set_length(_p->plan[i].q, n, w);
+        w += PACKETIZER_ALIGN(interleaver_get_workspace_size(n));
+    }
+}
+
+//
+// packetizer cache
+//
+
+// create packetizer cache
+packetizer_cache packetizer_cache_create()
+{
+    packetizer_cache c = (packetizer_cache) malloc(sizeof(struct packetizer_cache_s));
+
+    unsigned int i;
+    for (i=0; i<PACKETIZER_CACHE_LEN; i++) {
+        c->p[i]     = NULL;
+        c->stamp[i] = 0;
+    }
+    c->counter = 0;
+    return c;
+}
+
+// destroy packetizer cache and all cached objects
+void packetizer_cache_destroy(packetizer_cache _c)
+{
+    unsigned int i;
+    for (i=0; i<PACKETIZER_CACHE_LEN; i++)
+        packetizer_destroy(_c->p[i]);
+    free(_c);
+}
+
+// get packetizer matching configuration, re-configuring the least
+// recently used entry if none is found
+packetizer packetizer_cache_get(packetizer_cache _c,
+                                unsigned int     _n,
+                                int              _crc,
+                                int              _fec0,
+                                int              _fec1)
+{
+    _c->counter++;
+
+    unsigned int i;
+    unsigned int i_lru = 0;
+    for (i=0; i<PACKETIZER_CACHE_LEN; i++) {
+        packetizer p = _c->p[i];
+        if (p != NULL           &&
+            p->msg_len == _n    &&
+            p->check   == _crc  &&
+            p->plan[0].fs == _fec0 &&
+            p->plan[1].fs == _fec1)
+        {
+            _c->stamp[i] = _c->counter;
+            return p;
+        }
+
+        // unused entries have a stamp of zero
+        if (_c->stamp[i] < _c->stamp[i_lru])
+            i_lru = i;
+    }
+
+    // not found; re-configure least recently used entry
+    _c->p[i_lru]     = packetizer_recreate(_c->p[i_lru], _n, _crc, _fec0, _fec1);
+    _c->stamp[i_lru] = _c->counter;
+    return _c->p[i_lru];
+}
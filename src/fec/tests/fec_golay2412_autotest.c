@@ -105,3 +105,36 @@ void autotest_golay2412_codec()
     }
 }
 
+
+//
+// AUTOTEST: Golay(24,12) batch decoder matches symbol decoder
+//
+void autotest_golay2412_decode_batch()
+{
+    unsigned int n = 2000;  // number of symbol pairs
+    unsigned char msg_enc[6*2000];
+    unsigned char msg_dec[3*2000];
+    unsigned int v[2*2000];
+    unsigned int i;
+
+    // encode random symbols and corrupt them with 0 to 5 errors
+    for (i=0; i<2*n; i++) {
+        unsigned int sym_org = rand() % (1<<12);
+        v[i] = fec_golay2412_encode_symbol(sym_org) ^
+               golay2412_generate_error_vector(rand() % 6);
+        msg_enc[3*i+0] = (v[i] >> 16) & 0xff;
+        msg_enc[3*i+1] = (v[i] >>  8) & 0xff;
+        msg_enc[3*i+2] = (v[i]      ) & 0xff;
+    }
+
+    // decode in one batch
+    fec_golay2412_decode_batch(n, msg_enc, msg_dec);
+
+    for (i=0; i<n; i++) {
+        unsigned int m0 = fec_golay2412_decode_symbol(v[2*i+0]);
+        unsigned int m1 = fec_golay2412_decode_symbol(v[2*i+1]);
+        CONTEND_EQUALITY(msg_dec[3*i+0], (m0 >> 4) & 0xff);
+        CONTEND_EQUALITY(msg_dec[3*i+1], ((m0 << 4) & 0xf0) | ((m1 >> 8) & 0x0f));
+        CONTEND_EQUALITY(msg_dec[3*i+2], m1 & 0xff);
+    }
+}
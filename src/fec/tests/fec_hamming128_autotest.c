@@ -103,3 +103,53 @@ void autotest_hamming128_codec_soft()
     }
 }
 
+
+//
+// AUTOTEST: Hamming (12,8) batch decoder matches symbol decoder
+//
+void autotest_hamming128_decode_batch()
+{
+    // decode every possible 12-bit received symbol, paired with a
+    // random second symbol
+    unsigned int n = 4096;
+    unsigned char msg_enc[3*4096];
+    unsigned char msg_dec[2*4096];
+    unsigned int m0[4096], m1[4096];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        m0[i] = i;
+        m1[i] = rand() & 0x0fff;
+        msg_enc[3*i+0] =  (m0[i] >> 4) & 0xff;
+        msg_enc[3*i+1] = ((m0[i] << 4) & 0xf0) | ((m1[i] >> 8) & 0x0f);
+        msg_enc[3*i+2] =  (m1[i]     ) & 0xff;
+    }
+
+    // decode in one batch
+    fec_hamming128_decode_batch(n, msg_enc, msg_dec);
+
+    for (i=0; i<n; i++) {
+        CONTEND_EQUALITY(msg_dec[2*i+0], fec_hamming128_decode_symbol(m0[i]));
+        CONTEND_EQUALITY(msg_dec[2*i+1], fec_hamming128_decode_symbol(m1[i]));
+    }
+}
+
+//
+// AUTOTEST: Hamming (12,8) batch soft decoder matches symbol decoder
+//
+void autotest_hamming128_decode_soft_batch()
+{
+    unsigned int n = 1000;
+    unsigned char soft_bits[12*1000];
+    unsigned char sym_dec[1000];
+    unsigned int i;
+
+    // random soft bits
+    for (i=0; i<12*n; i++)
+        soft_bits[i] = rand() & 0xff;
+
+    // decode in one batch
+    fecsoft_hamming128_decode_batch(n, soft_bits, sym_dec);
+
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY(sym_dec[i], fecsoft_hamming128_decode_n3(&soft_bits[12*i]));
+}
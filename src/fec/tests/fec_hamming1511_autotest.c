@@ -65,3 +65,27 @@ void autotest_hamming1511_codec()
     }
 }
 
+
+//
+// AUTOTEST: Hamming (15,11) batch decoder matches symbol decoder
+//
+void autotest_hamming1511_decode_batch()
+{
+    // decode every possible 15-bit received symbol, followed by a few
+    // random symbols to exercise the remainder of the batch
+    unsigned int n = (1<<15) + 7;
+    unsigned short int * sym_enc = (unsigned short int*) malloc(n*sizeof(unsigned short int));
+    unsigned short int * sym_dec = (unsigned short int*) malloc(n*sizeof(unsigned short int));
+    unsigned int i;
+    for (i=0; i<n; i++)
+        sym_enc[i] = i < (1<<15) ? i : rand() & 0x7fff;
+
+    // decode in one batch
+    fec_hamming1511_decode_batch(n, sym_enc, sym_dec);
+
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY(sym_dec[i], fec_hamming1511_decode_symbol(sym_enc[i]));
+
+    free(sym_enc);
+    free(sym_dec);
+}
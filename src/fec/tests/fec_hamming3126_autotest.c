@@ -65,3 +65,31 @@ void autotest_hamming3126_codec()
     }
 }
 
+
+//
+// AUTOTEST: Hamming (31,26) batch decoder matches symbol decoder
+//
+void autotest_hamming3126_decode_batch()
+{
+    // decode codewords with zero or one bit error as well as arbitrary
+    // 31-bit received symbols; the odd length exercises the remainder
+    // of the batch
+    unsigned int n = 4096 + 7;
+    unsigned int sym_enc[4096 + 7];
+    unsigned int sym_dec[4096 + 7];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        unsigned int sym_org = ((rand() & 0x1fff) << 13) | (rand() & 0x1fff);
+        switch (i % 3) {
+        case 0:  sym_enc[i] = fec_hamming3126_encode_symbol(sym_org); break;
+        case 1:  sym_enc[i] = fec_hamming3126_encode_symbol(sym_org) ^ (1 << (rand() % 31)); break;
+        default: sym_enc[i] = ((rand() & 0xffff) << 15) ^ (rand() & 0x7fff);
+        }
+    }
+
+    // decode in one batch
+    fec_hamming3126_decode_batch(n, sym_enc, sym_dec);
+
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY(sym_dec[i], fec_hamming3126_decode_symbol(sym_enc[i]));
+}
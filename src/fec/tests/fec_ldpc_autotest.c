@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// 
+// AUTOTEST: LDPC encoder output satisfies all parity checks
+//
+void fec_ldpc_test_parity(fec_scheme _fs)
+{
+    // create codec and encode a single full codeword
+    fec q = fec_create(_fs, NULL);
+    unsigned int n = (q->ldpc_nb - q->ldpc_mb)*q->ldpc_Z / 8;
+    unsigned int n_enc = fec_get_enc_msg_length(_fs, n);
+    unsigned char msg_dec[n];
+    unsigned char msg_enc[n_enc];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        msg_dec[i] = rand() & 0xff;
+    fec_encode(q, n, msg_dec, msg_enc);
+
+    // load posterior log-likelihood ratios directly from codeword
+    for (i=0; i<8*n_enc; i++)
+        q->ldpc_L[i] = ((msg_enc[i/8] >> (7-(i%8))) & 1) ? -1.0f : 1.0f;
+    CONTEND_EQUALITY( fec_ldpc_check_parity(q), 1 );
+
+    // flip a single bit and ensure parity fails
+    q->ldpc_L[rand() % (8*n_enc)] *= -1.0f;
+    CONTEND_EQUALITY( fec_ldpc_check_parity(q), 0 );
+
+    fec_destroy(q);
+}
+
+void autotest_fec_ldpc_parity_r12() { fec_ldpc_test_parity(LIQUID_FEC_LDPC_R12); }
+void autotest_fec_ldpc_parity_r23() { fec_ldpc_test_parity(LIQUID_FEC_LDPC_R23); }
+void autotest_fec_ldpc_parity_r34() { fec_ldpc_test_parity(LIQUID_FEC_LDPC_R34); }
+void autotest_fec_ldpc_parity_r56() { fec_ldpc_test_parity(LIQUID_FEC_LDPC_R56); }
+
+// 
+// AUTOTEST: LDPC soft decoding over additive white Gaussian noise
+// channel with BPSK modulation, spanning several codewords
+//
+void fec_ldpc_test_awgn(fec_scheme   _fs,
+                        unsigned int _n,
+                        float        _EbN0dB)
+{
+    fec q = fec_create(_fs, NULL);
+
+    // create arrays
+    unsigned int n_enc = fec_get_enc_msg_length(_fs, _n);
+    unsigned char msg[_n];              // original message
+    unsigned char msg_enc[n_enc];       // encoded message
+    unsigned char msg_soft[8*n_enc];    // received soft bits
+    unsigned char msg_dec[_n];          // decoded message
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        msg[i] = rand() & 0xff;
+    fec_encode(q, _n, msg, msg_enc);
+
+    // add noise and convert to soft bits
+    float SNRdB = _EbN0dB + 10*log10f(fec_get_rate(_fs));
+    float nstd  = powf(10.0f, -SNRdB/20.0f) * M_SQRT1_2;
+    unsigned int num_bit_errors = 0;
+    for (i=0; i<8*n_enc; i++) {
+        unsigned int bit = (msg_enc[i/8] >> (7-(i%8))) & 1;
+        float y = (bit ? -1.0f : 1.0f) + nstd*randnf();
+        float v = 127.5f - 40.0f*y;
+        msg_soft[i] = v < 0 ? 0 : (v > 255 ? 255 : (unsigned char)v);
+        num_bit_errors += (msg_soft[i] > 127) ^ bit;
+    }
+
+    // decode message
+    fec_decode_soft(q, _n, msg_soft, msg_dec);
+
+    if (liquid_autotest_verbose) {
+        printf("  %-24s : %4u bytes, %4u bit errors corrected\n",
+                fec_scheme_str[_fs][1], _n, num_bit_errors);
+    }
+
+    // ensure channel introduced errors and that all were corrected
+    CONTEND_GREATER_THAN( num_bit_errors, 0 );
+    CONTEND_SAME_DATA( msg, msg_dec, _n );
+
+    fec_destroy(q);
+}
+
+void autotest_fec_ldpc_awgn_r12() { fec_ldpc_test_awgn(LIQUID_FEC_LDPC_R12, 400, 4.0f); }
+void autotest_fec_ldpc_awgn_r23() { fec_ldpc_test_awgn(LIQUID_FEC_LDPC_R23, 400, 4.0f); }
+void autotest_fec_ldpc_awgn_r34() { fec_ldpc_test_awgn(LIQUID_FEC_LDPC_R34, 400, 4.5f); }
+void autotest_fec_ldpc_awgn_r56() { fec_ldpc_test_awgn(LIQUID_FEC_LDPC_R56, 400, 5.0f); }
+
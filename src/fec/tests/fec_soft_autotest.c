@@ -137,4 +137,10 @@ void autotest_fecsoft_v29p78() { fec_test_soft_codec(LIQUID_FEC_CONV_V29P78, 64,
 // Reed-Solomon block codes
 void autotest_fecsoft_rs8()    { fec_test_soft_codec(LIQUID_FEC_RS_M8,       64, NULL); }
 
+// LDPC block codes
+void autotest_fecsoft_ldpc12() { fec_test_soft_codec(LIQUID_FEC_LDPC_R12,    64, NULL); }
+void autotest_fecsoft_ldpc23() { fec_test_soft_codec(LIQUID_FEC_LDPC_R23,    64, NULL); }
+void autotest_fecsoft_ldpc34() { fec_test_soft_codec(LIQUID_FEC_LDPC_R34,    64, NULL); }
+void autotest_fecsoft_ldpc56() { fec_test_soft_codec(LIQUID_FEC_LDPC_R56,    64, NULL); }
+
 
@@ -85,3 +85,73 @@ void autotest_interleaver_soft_16()     { interleaver_test_soft(16  ); }
 void autotest_interleaver_soft_64()     { interleaver_test_soft(64  ); }
 void autotest_interleaver_soft_256()    { interleaver_test_soft(256 ); }
 
+// 
+// AUTOTEST: interleaver output is unchanged (compatibility)
+//
+void autotest_interleaver_reference()
+{
+    unsigned int i;
+    unsigned char x[25];
+    unsigned char y[25];
+    unsigned char y_test[25] = {
+        0x05, 0x2c, 0xc3, 0xb8, 0x77, 0x7e, 0x5b, 0x72,
+        0xbd, 0x08, 0x17, 0xc0, 0x25, 0x9e, 0xed, 0x76,
+        0xa1, 0x22, 0x19, 0x44, 0x63, 0x8e, 0x5b, 0x00,
+        0x9b};
+
+    for (i=0; i<25; i++)
+        x[i] = (unsigned char)(17*i + 3);
+
+    // create interleaver object (default depth)
+    interleaver q = interleaver_create(25);
+    interleaver_encode(q,x,y);
+    CONTEND_SAME_DATA(y, y_test, 25);
+
+    // run again in place
+    interleaver_encode(q,x,x);
+    CONTEND_SAME_DATA(x, y_test, 25);
+
+    // destroy interleaver object
+    interleaver_destroy(q);
+}
+
+// 
+// AUTOTEST: soft interleaver matches hard interleaver at every depth
+//
+void autotest_interleaver_soft_depth()
+{
+    unsigned int n = 100;
+    unsigned int i, k, depth;
+    unsigned char x[100], y[100], z[100];
+    unsigned char x_soft[800], y_soft[800];
+
+    for (i=0; i<n; i++)
+        x[i] = rand() & 0xff;
+
+    // expand soft bits
+    for (i=0; i<n; i++) {
+        for (k=0; k<8; k++)
+            x_soft[8*i+k] = (x[i] >> (8-k-1)) & 0x01 ? 255 : 0;
+    }
+
+    interleaver q = interleaver_create(n);
+    for (depth=0; depth<=4; depth++) {
+        interleaver_set_depth(q, depth);
+        interleaver_encode(q,x,y);
+        interleaver_encode_soft(q,x_soft,y_soft);
+
+        // pack soft bits and compare
+        for (i=0; i<n; i++) {
+            z[i] = 0;
+            for (k=0; k<8; k++)
+                z[i] |= y_soft[8*i+k] > 127 ? 0x80 >> k : 0;
+        }
+        CONTEND_SAME_DATA(y, z, n);
+
+        // de-interleave and compare to original
+        interleaver_decode(q,y,z);
+        CONTEND_SAME_DATA(x, z, n);
+    }
+    interleaver_destroy(q);
+}
+
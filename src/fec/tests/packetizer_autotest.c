@@ -20,6 +20,9 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -65,3 +68,96 @@ void autotest_packetizer_n16_0_0()  { packetizer_test_codec(16, LIQUID_CRC_32, L
 void autotest_packetizer_n16_0_1()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_REP3);       }
 void autotest_packetizer_n16_0_2()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_HAMMING74);  }
 
+
+// encode random message with both packetizer under test and a newly
+// created reference object, and validate hard/soft decoding
+void packetizer_test_compare(packetizer _p)
+{
+    unsigned int n    = packetizer_get_dec_msg_len(_p);
+    crc_scheme   crc  = packetizer_get_crc (_p);
+    fec_scheme   fec0 = packetizer_get_fec0(_p);
+    fec_scheme   fec1 = packetizer_get_fec1(_p);
+    unsigned int k    = packetizer_get_enc_msg_len(_p);
+    CONTEND_EQUALITY(k, packetizer_compute_enc_msg_len(n,crc,fec0,fec1));
+
+    unsigned char msg_tx[n];
+    unsigned char msg_rx[n];
+    unsigned char pkt_test[k];
+    unsigned char pkt_ref [k];
+    unsigned char pkt_soft[8*k];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        msg_tx[i] = rand() & 0xff;
+
+    // encode and compare to reference
+    packetizer p_ref = packetizer_create(n,crc,fec0,fec1);
+    packetizer_encode(p_ref, msg_tx, pkt_ref);
+    packetizer_encode(_p,    msg_tx, pkt_test);
+    CONTEND_SAME_DATA(pkt_test, pkt_ref, k);
+    packetizer_destroy(p_ref);
+
+    // decode (hard)
+    memset(msg_rx, 0x00, n);
+    CONTEND_EQUALITY(packetizer_decode(_p, pkt_test, msg_rx), 1);
+    CONTEND_SAME_DATA(msg_tx, msg_rx, n);
+
+    // decode (soft)
+    for (i=0; i<8*k; i++)
+        pkt_soft[i] = ((pkt_test[i/8] >> (7-(i%8))) & 1) ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
+    memset(msg_rx, 0x00, n);
+    CONTEND_EQUALITY(packetizer_decode_soft(_p, pkt_soft, msg_rx), 1);
+    CONTEND_SAME_DATA(msg_tx, msg_rx, n);
+}
+
+// re-configure packetizer in place using external workspace
+void autotest_packetizer_workspace()
+{
+    crc_scheme crc  = LIQUID_CRC_32;
+    fec_scheme fec0 = LIQUID_FEC_HAMMING74;
+    fec_scheme fec1 = LIQUID_FEC_GOLAY2412;
+    unsigned int max_len = 200;
+    unsigned int lengths[6] = {200, 17, 93, 1, 150, 64};
+
+    unsigned int size = packetizer_get_workspace_size(max_len,crc,fec0,fec1);
+    unsigned char * workspace = (unsigned char*) malloc(size);
+
+    packetizer p = packetizer_create(max_len,crc,fec0,fec1);
+    packetizer_set_workspace(p, workspace, size);
+
+    unsigned int i;
+    for (i=0; i<6; i++) {
+        packetizer p_new = packetizer_recreate(p,lengths[i],crc,fec0,fec1);
+        CONTEND_EQUALITY(p_new == p, 1);
+        packetizer_test_compare(p);
+    }
+
+    // revert to internal memory
+    packetizer_set_workspace(p, NULL, 0);
+    packetizer_test_compare(p);
+    packetizer_recreate(p,37,crc,fec0,fec1);
+    packetizer_test_compare(p);
+
+    packetizer_destroy(p);
+    free(workspace);
+}
+
+// re-configure packetizer in place across schemes
+void autotest_packetizer_recreate()
+{
+    struct { unsigned int n; crc_scheme crc; fec_scheme fec0; fec_scheme fec1; } cfg[5] = {
+        { 64, LIQUID_CRC_32,   LIQUID_FEC_NONE,       LIQUID_FEC_NONE      },
+        { 21, LIQUID_CRC_16,   LIQUID_FEC_HAMMING128, LIQUID_FEC_NONE      },
+        {100, LIQUID_CRC_24,   LIQUID_FEC_NONE,       LIQUID_FEC_SECDED7264},
+        {  9, LIQUID_CRC_8,    LIQUID_FEC_REP3,       LIQUID_FEC_HAMMING84 },
+        { 64, LIQUID_CRC_32,   LIQUID_FEC_NONE,       LIQUID_FEC_NONE      },
+    };
+
+    packetizer p = packetizer_create(1,LIQUID_CRC_NONE,LIQUID_FEC_NONE,LIQUID_FEC_NONE);
+    unsigned int i;
+    for (i=0; i<5; i++) {
+        packetizer p_new = packetizer_recreate(p,cfg[i].n,cfg[i].crc,cfg[i].fec0,cfg[i].fec1);
+        CONTEND_EQUALITY(p_new == p, 1);
+        packetizer_test_compare(p);
+    }
+    packetizer_destroy(p);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// helper function to keep code base small
+void spgramcf_bench(struct rusage *     _start,
+                    struct rusage *     _finish,
+                    unsigned long int * _num_iterations,
+                    unsigned int        _nfft,
+                    int                 _block)
+{
+    // normalize number of iterations (one iteration per block of nfft samples)
+    *_num_iterations = *_num_iterations * 20 / (_nfft * (unsigned int)(1+log2f(_nfft)));
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // create object with 50% overlap
+    spgramcf q = spgramcf_create(_nfft, LIQUID_WINDOW_HANN, _nfft, _nfft/2);
+
+    unsigned int i;
+    float complex x[_nfft];
+    for (i=0; i<_nfft; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    unsigned long int n;
+    for (n=0; n<*_num_iterations; n++) {
+        if (_block) {
+            spgramcf_write(q, x, _nfft);
+        } else {
+            for (i=0; i<_nfft; i++)
+                spgramcf_push(q, x[i]);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    spgramcf_destroy(q);
+}
+
+#define SPGRAMCF_BENCH_API(NFFT,BLOCK)      \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ spgramcf_bench(_start, _finish, _num_iterations, NFFT, BLOCK); }
+
+void benchmark_spgramcf_push_n256    SPGRAMCF_BENCH_API( 256, 0)
+void benchmark_spgramcf_push_n4096   SPGRAMCF_BENCH_API(4096, 0)
+void benchmark_spgramcf_write_n256   SPGRAMCF_BENCH_API( 256, 1)
+void benchmark_spgramcf_write_n4096  SPGRAMCF_BENCH_API(4096, 1)
+
+// Welch estimate over large buffer
+void spgramcf_welch_bench(struct rusage *     _start,
+                          struct rusage *     _finish,
+                          unsigned long int * _num_iterations,
+                          unsigned int        _num_threads)
+{
+    // normalize number of iterations (one iteration per buffer)
+    unsigned int nfft = 1024;
+    unsigned int num_samples = 1 << 18;
+    *_num_iterations /= 10000;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned int i;
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+    float psd[nfft];
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    unsigned long int n;
+    for (n=0; n<*_num_iterations; n++) {
+        spgramcf_estimate_psd_welch(nfft, LIQUID_WINDOW_HANN, nfft, nfft/2,
+                                    x, num_samples, -1, _num_threads, psd);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    free(x);
+}
+
+#define SPGRAMCF_WELCH_BENCH_API(NUM_THREADS)   \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ spgramcf_welch_bench(_start, _finish, _num_iterations, NUM_THREADS); }
+
+void benchmark_spgramcf_welch_t1    SPGRAMCF_WELCH_BENCH_API(1)
+void benchmark_spgramcf_welch_t4    SPGRAMCF_WELCH_BENCH_API(4)
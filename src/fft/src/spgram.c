@@ -33,6 +33,31 @@
 #include <complex.h>
 #include "liquid.internal.h"
 
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+#include <xmmintrin.h>
+#endif
+
+#if LIQUID_PTHREADS_ENABLED
+#include <pthread.h>
+#endif
+
+#if HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Welch estimator: the transforms are split into a fixed number of
+// partitions (independent of the number of threads) whose partial sums
+// are reduced in order, giving bit-identical results for any thread count
+#define SPGRAM_WELCH_PARTITIONS     (64)
+
+// Welch estimator: percentile histogram resolution
+#define SPGRAM_WELCH_HIST_MIN       (-160.0f)   // lowest bin [dB]
+#define SPGRAM_WELCH_HIST_RES       (0.25f)     // bin width [dB]
+#define SPGRAM_WELCH_HIST_BINS      (1024)      // number of bins
+
 struct SPGRAM(_s) {
     // options
     unsigned int    nfft;           // FFT length
@@ -70,6 +95,40 @@ struct SPGRAM(_s) {
 // from current buffer contents
 void SPGRAM(_step)(SPGRAM() _q);
 
+// compute transform of contiguous block of samples and accumulate
+// result into PSD estimate
+//  _q      :   spgram object
+//  _x      :   input samples [size: window_len x 1]
+void SPGRAM(_transform)(SPGRAM() _q,
+                        TI *     _x);
+
+// apply window to input: _y[i] = _x[i] * _w[i]
+void SPGRAM(_apply_window)(TI *         _x,
+                           T *          _w,
+                           unsigned int _n,
+                           TC *         _y);
+
+// accumulate power spectral density: _psd[i] = _gamma*_psd[i] + _alpha*|_X[i]|^2
+void SPGRAM(_accumulate)(TC *         _X,
+                         unsigned int _n,
+                         T            _gamma,
+                         T            _alpha,
+                         T *          _psd);
+
+// Welch estimator worker state
+struct SPGRAM(_welch_s) {
+    SPGRAM()        q;              // spgram object (private FFT plan)
+    TI *            x;              // input signal
+    uint64_t        num_transforms; // total number of transforms
+    unsigned int    partition;      // first partition to process
+    unsigned int    stride;         // partition stride (number of workers)
+    double *        sums;           // partition sums [size: partitions x nfft]
+    unsigned int *  hist;           // histogram (NULL if computing mean)
+};
+
+// Welch estimator: process partitions assigned to worker
+void * SPGRAM(_welch_worker)(void * _arg);
+
 // create spgram object
 //  _nfft       : FFT size
 //  _wtype      : window type, e.g. LIQUID_WINDOW_HAMMING
@@ -346,48 +405,133 @@ void SPGRAM(_write)(SPGRAM()     _q,
                     TI *         _x,
                     unsigned int _n)
 {
-#if 0
-    // write a block of samples to the internal window
-    WINDOW(_write)(_q->buffer, _x, _n);
-#else
-    // TODO: be smarter about how to write and execute samples
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        SPGRAM(_push)(_q, _x[i]);
-#endif
-}
+    // Compute each transform due within the block. Whenever the entire
+    // window lies within the input it is read directly from _x;
+    // otherwise the internal window buffer is brought up to date first.
+    // Only the tail of the block needs to be written to the buffer.
+    unsigned int i = 0;     // number of samples processed
+    unsigned int w = 0;     // number of samples written to window buffer
+    while (_n - i >= _q->sample_timer) {
+        // index of first sample after this transform
+        unsigned int k = i + _q->sample_timer;
+
+        if (k >= _q->window_len) {
+            SPGRAM(_transform)(_q, _x + k - _q->window_len);
+        } else {
+            WINDOW(_write)(_q->buffer, _x + w, k - w);
+            w = k;
+            SPGRAM(_step)(_q);
+        }
 
+        i = k;
+        _q->sample_timer = _q->delay;
+    }
+    _q->sample_timer -= _n - i;
+
+    // write tail to internal window buffer
+    if (_n - w > _q->window_len)
+        w = _n - _q->window_len;
+    WINDOW(_write)(_q->buffer, _x + w, _n - w);
+
+    // update counters
+    _q->num_samples       += _n;
+    _q->num_samples_total += _n;
+}
 
 // compute spectral periodogram output from current buffer contents
 //  _q      :   spgram object
 void SPGRAM(_step)(SPGRAM() _q)
 {
-    unsigned int i;
-
-    // read buffer, copy to FFT input (applying window)
-    // TODO: use SIMD extensions to speed this up
+    // read buffer and compute transform
     TI * rc;
     WINDOW(_read)(_q->buffer, &rc);
-    for (i=0; i<_q->window_len; i++)
-        _q->buf_time[i] = rc[i] * _q->w[i];
+    SPGRAM(_transform)(_q, rc);
+}
+
+// compute transform of contiguous block of samples and accumulate
+// result into PSD estimate
+//  _q      :   spgram object
+//  _x      :   input samples [size: window_len x 1]
+void SPGRAM(_transform)(SPGRAM() _q,
+                        TI *     _x)
+{
+    // copy to FFT input (applying window)
+    SPGRAM(_apply_window)(_x, _q->w, _q->window_len, _q->buf_time);
 
     // execute fft on _q->buf_time and store result in _q->buf_freq
     FFT_EXECUTE(_q->fft);
 
-    // accumulate output
-    // TODO: vectorize this operation
-    for (i=0; i<_q->nfft; i++) {
-        T v = crealf( _q->buf_freq[i] * conjf(_q->buf_freq[i]) );
-        if (_q->num_transforms == 0)
-            _q->psd[i] = v;
-        else
-            _q->psd[i] = _q->gamma*_q->psd[i] + _q->alpha*v;
-    }
+    // accumulate output (initialize on first transform)
+    if (_q->num_transforms == 0)
+        SPGRAM(_accumulate)(_q->buf_freq, _q->nfft, 0.0f, 1.0f, _q->psd);
+    else
+        SPGRAM(_accumulate)(_q->buf_freq, _q->nfft, _q->gamma, _q->alpha, _q->psd);
 
     _q->num_transforms++;
     _q->num_transforms_total++;
 }
 
+// apply window to input: _y[i] = _x[i] * _w[i]
+void SPGRAM(_apply_window)(TI *         _x,
+                           T *          _w,
+                           unsigned int _n,
+                           TC *         _y)
+{
+    unsigned int i = 0;
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+    // four samples at a time
+    unsigned int n4 = _n - (_n % 4);
+    for (i=0; i<n4; i+=4) {
+        __m128 w = _mm_loadu_ps(_w + i);
+#if TI_COMPLEX
+        // duplicate window values for real/imaginary components
+        __m128 x0 = _mm_loadu_ps((float*)(_x + i    ));
+        __m128 x1 = _mm_loadu_ps((float*)(_x + i + 2));
+        _mm_storeu_ps((float*)(_y + i    ), _mm_mul_ps(x0, _mm_unpacklo_ps(w, w)));
+        _mm_storeu_ps((float*)(_y + i + 2), _mm_mul_ps(x1, _mm_unpackhi_ps(w, w)));
+#else
+        // interleave zero-valued imaginary components
+        __m128 v = _mm_mul_ps(_mm_loadu_ps(_x + i), w);
+        __m128 z = _mm_setzero_ps();
+        _mm_storeu_ps((float*)(_y + i    ), _mm_unpacklo_ps(v, z));
+        _mm_storeu_ps((float*)(_y + i + 2), _mm_unpackhi_ps(v, z));
+#endif
+    }
+#endif
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _w[i];
+}
+
+// accumulate power spectral density: _psd[i] = _gamma*_psd[i] + _alpha*|_X[i]|^2
+void SPGRAM(_accumulate)(TC *         _X,
+                         unsigned int _n,
+                         T            _gamma,
+                         T            _alpha,
+                         T *          _psd)
+{
+    unsigned int i = 0;
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+    // four bins at a time
+    __m128 g = _mm_set1_ps(_gamma);
+    __m128 a = _mm_set1_ps(_alpha);
+    unsigned int n4 = _n - (_n % 4);
+    for (i=0; i<n4; i+=4) {
+        __m128 x0 = _mm_loadu_ps((float*)(_X + i    ));  // { r0, i0, r1, i1 }
+        __m128 x1 = _mm_loadu_ps((float*)(_X + i + 2));  // { r2, i2, r3, i3 }
+        x0 = _mm_mul_ps(x0, x0);
+        x1 = _mm_mul_ps(x1, x1);
+        __m128 v = _mm_add_ps(_mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2,0,2,0)),
+                              _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3,1,3,1)));
+        __m128 p = _mm_loadu_ps(_psd + i);
+        _mm_storeu_ps(_psd + i, _mm_add_ps(_mm_mul_ps(g, p), _mm_mul_ps(a, v)));
+    }
+#endif
+    for ( ; i<_n; i++) {
+        T v = crealf(_X[i])*crealf(_X[i]) + cimagf(_X[i])*cimagf(_X[i]);
+        _psd[i] = _gamma*_psd[i] + _alpha*v;
+    }
+}
+
 // compute spectral periodogram output (fft-shifted values
 // in dB) from current buffer contents
 //  _q      :   spgram object
@@ -485,3 +629,224 @@ void SPGRAM(_estimate_psd)(unsigned int _nfft,
     // destroy object
     SPGRAM(_destroy)(q);
 }
+
+// estimate spectrum on input signal with Welch's method
+int SPGRAM(_estimate_psd_welch)(unsigned int _nfft,
+                                int          _wtype,
+                                unsigned int _window_len,
+                                unsigned int _delay,
+                                TI *         _x,
+                                uint64_t     _n,
+                                float        _percentile,
+                                unsigned int _num_threads,
+                                T *          _psd)
+{
+    // validate input
+    if (_n < _window_len) {
+        fprintf(stderr,"error: spgram%s_estimate_psd_welch(), input length cannot be less than window size\n", EXTENSION);
+        return -1;
+    } else if (_percentile != -1.0f && (_percentile < 0.0f || _percentile > 1.0f)) {
+        fprintf(stderr,"error: spgram%s_estimate_psd_welch(), percentile must be in [0,1], or -1 for mean\n", EXTENSION);
+        return -1;
+    } else if (_delay == 0) {
+        fprintf(stderr,"error: spgram%s_estimate_psd_welch(), delay must be greater than 0\n", EXTENSION);
+        return -1;
+    }
+
+    unsigned int P = SPGRAM_WELCH_PARTITIONS;
+    uint64_t num_transforms = (_n - _window_len) / _delay + 1;
+    unsigned int num_threads = _num_threads == 0 ? 1 : _num_threads;
+    if (num_threads > P)
+        num_threads = P;
+#if !LIQUID_PTHREADS_ENABLED
+    num_threads = 1;
+#endif
+    int compute_mean = _percentile < 0.0f;
+
+    // create objects on this thread (FFT planning is not re-entrant)
+    struct SPGRAM(_welch_s) * w =
+        (struct SPGRAM(_welch_s)*) malloc(num_threads*sizeof(struct SPGRAM(_welch_s)));
+    double * sums = compute_mean ? (double*) calloc(P*_nfft, sizeof(double)) : NULL;
+    unsigned int i, j;
+    for (i=0; i<num_threads; i++) {
+        w[i].q              = SPGRAM(_create)(_nfft, _wtype, _window_len, _delay);
+        w[i].x              = _x;
+        w[i].num_transforms = num_transforms;
+        w[i].partition      = i;
+        w[i].stride         = num_threads;
+        w[i].sums           = sums;
+        w[i].hist           = compute_mean ? NULL :
+            (unsigned int*) calloc(_nfft*SPGRAM_WELCH_HIST_BINS, sizeof(unsigned int));
+    }
+
+    // run workers
+#if LIQUID_PTHREADS_ENABLED
+    if (num_threads > 1) {
+        pthread_t * threads = (pthread_t*) malloc(num_threads*sizeof(pthread_t));
+        for (i=0; i<num_threads; i++) {
+            if (pthread_create(&threads[i], NULL, SPGRAM(_welch_worker), (void*)&w[i]) != 0) {
+                fprintf(stderr,"error: spgram%s_estimate_psd_welch(), could not create thread\n", EXTENSION);
+                exit(1);
+            }
+        }
+        for (i=0; i<num_threads; i++)
+            pthread_join(threads[i], NULL);
+        free(threads);
+    } else
+#endif
+    {
+        SPGRAM(_welch_worker)((void*)&w[0]);
+    }
+
+    unsigned int nfft_2 = _nfft / 2;
+    if (compute_mean) {
+        // reduce partition sums in fixed order
+        for (i=0; i<_nfft; i++) {
+            unsigned int k = (i + nfft_2) % _nfft;
+            double v = 0.0;
+            for (j=0; j<P; j++)
+                v += sums[j*_nfft + k];
+            _psd[i] = 10*log10f((float)(v / (double)num_transforms) + 1e-12f);
+        }
+    } else {
+        // merge histograms into first worker's
+        unsigned int * hist = w[0].hist;
+        for (j=1; j<num_threads; j++) {
+            for (i=0; i<_nfft*SPGRAM_WELCH_HIST_BINS; i++)
+                hist[i] += w[j].hist[i];
+        }
+
+        // find percentile in each bin, interpolating within histogram bin
+        double target = _percentile * (double)num_transforms;
+        for (i=0; i<_nfft; i++) {
+            unsigned int k = (i + nfft_2) % _nfft;
+            unsigned int * h = hist + k*SPGRAM_WELCH_HIST_BINS;
+            uint64_t count = 0;
+            for (j=0; j<SPGRAM_WELCH_HIST_BINS-1; j++) {
+                if (h[j] > 0 && (double)(count + h[j]) >= target)
+                    break;
+                count += h[j];
+            }
+            float frac = h[j] > 0 ? (float)((target - (double)count) / (double)h[j]) : 0.0f;
+            frac = frac < 0.0f ? 0.0f : (frac > 1.0f ? 1.0f : frac);
+            _psd[i] = SPGRAM_WELCH_HIST_MIN + SPGRAM_WELCH_HIST_RES*((float)j + frac);
+        }
+    }
+
+    // clean up
+    for (i=0; i<num_threads; i++) {
+        SPGRAM(_destroy)(w[i].q);
+        free(w[i].hist);
+    }
+    free(w);
+    free(sums);
+    return 0;
+}
+
+// estimate spectrum of samples stored in a file with Welch's method
+int SPGRAM(_estimate_psd_file)(const char * _filename,
+                               unsigned int _nfft,
+                               int          _wtype,
+                               unsigned int _window_len,
+                               unsigned int _delay,
+                               float        _percentile,
+                               unsigned int _num_threads,
+                               T *          _psd)
+{
+    int rc;
+#if HAVE_SYS_MMAN_H
+    // map file into memory
+    int fd = open(_filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr,"error: spgram%s_estimate_psd_file(), could not open '%s' for reading\n",
+                EXTENSION, _filename);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(TI)) {
+        fprintf(stderr,"error: spgram%s_estimate_psd_file(), could not read '%s'\n",
+                EXTENSION, _filename);
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t)st.st_size;
+    void * p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        fprintf(stderr,"error: spgram%s_estimate_psd_file(), could not map '%s'\n",
+                EXTENSION, _filename);
+        return -1;
+    }
+#ifdef MADV_SEQUENTIAL
+    madvise(p, size, MADV_SEQUENTIAL);
+#endif
+    rc = SPGRAM(_estimate_psd_welch)(_nfft, _wtype, _window_len, _delay,
+            (TI*)p, size / sizeof(TI), _percentile, _num_threads, _psd);
+    munmap(p, size);
+#else
+    // read entire file into memory
+    FILE * fid = fopen(_filename,"rb");
+    if (fid == NULL) {
+        fprintf(stderr,"error: spgram%s_estimate_psd_file(), could not open '%s' for reading\n",
+                EXTENSION, _filename);
+        return -1;
+    }
+    fseek(fid, 0, SEEK_END);
+    long size = ftell(fid);
+    fseek(fid, 0, SEEK_SET);
+    if (size < (long)sizeof(TI)) {
+        fprintf(stderr,"error: spgram%s_estimate_psd_file(), could not read '%s'\n",
+                EXTENSION, _filename);
+        fclose(fid);
+        return -1;
+    }
+    uint64_t n = (uint64_t)size / sizeof(TI);
+    TI * x = (TI*) malloc(n*sizeof(TI));
+    n = fread(x, sizeof(TI), n, fid);
+    fclose(fid);
+    rc = SPGRAM(_estimate_psd_welch)(_nfft, _wtype, _window_len, _delay,
+            x, n, _percentile, _num_threads, _psd);
+    free(x);
+#endif
+    return rc;
+}
+
+// Welch estimator: process partitions assigned to worker
+void * SPGRAM(_welch_worker)(void * _arg)
+{
+    struct SPGRAM(_welch_s) * w = (struct SPGRAM(_welch_s)*) _arg;
+    SPGRAM() q = w->q;
+    unsigned int P    = SPGRAM_WELCH_PARTITIONS;
+    unsigned int nfft = q->nfft;
+    unsigned int p, i;
+    for (p=w->partition; p<P; p+=w->stride) {
+        // range of transforms in this partition
+        uint64_t t0 = (w->num_transforms * p    ) / P;
+        uint64_t t1 = (w->num_transforms * (p+1)) / P;
+        uint64_t t;
+        SPGRAM(_clear)(q);
+        for (t=t0; t<t1; t++) {
+            if (w->hist != NULL) {
+                // compute single transform (overwriting psd) and add to histogram
+                q->num_transforms = 0;
+                SPGRAM(_transform)(q, w->x + t*q->delay);
+                for (i=0; i<nfft; i++) {
+                    float v = (10*log10f(q->psd[i] + 1e-12f) - SPGRAM_WELCH_HIST_MIN) / SPGRAM_WELCH_HIST_RES;
+                    int b = v < 0.0f ? 0 : (int)v;
+                    b = b >= SPGRAM_WELCH_HIST_BINS ? SPGRAM_WELCH_HIST_BINS-1 : b;
+                    w->hist[i*SPGRAM_WELCH_HIST_BINS + b]++;
+                }
+            } else {
+                // accumulate transform into partition sum
+                SPGRAM(_transform)(q, w->x + t*q->delay);
+            }
+        }
+
+        // store partition sum
+        if (w->hist == NULL) {
+            for (i=0; i<nfft; i++)
+                w->sums[p*nfft + i] = t1 > t0 ? (double)q->psd[i] : 0.0;
+        }
+    }
+    return NULL;
+}
@@ -33,6 +33,45 @@
 #include <complex.h>
 #include "liquid.internal.h"
 
+#if HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// number of stream pyramid levels (1x, 2x, 4x, 8x time decimation)
+#define SPWATERFALL_STREAM_LEVELS   (4)
+
+// target size of mapped stream file window [bytes]
+#define SPWATERFALL_STREAM_CHUNK    (1<<20)
+
+// stream export: single pyramid level
+struct SPWATERFALL(_level_s) {
+#if HAVE_SYS_MMAN_H
+    int             fd;             // file descriptor
+    struct spwaterfall_stream_header_s * header; // mapped header
+    float *         chunk;          // mapped window of rows
+    uint64_t        chunk_index;    // index of mapped window
+#else
+    FILE *          fid;            // file pointer
+    struct spwaterfall_stream_header_s header; // file header
+#endif
+    T *             pending;        // linear row waiting for its pair
+    int             has_pending;    // pending row is valid
+};
+
+// stream export state
+struct SPWATERFALL(_stream_s) {
+    unsigned int    decim;          // transforms per base row
+    unsigned int    header_size;    // header size [bytes] (page aligned)
+    unsigned int    chunk_rows;     // rows per mapped window
+    T *             acc;            // linear accumulator for base row
+    unsigned int    acc_count;      // transforms in base row accumulator
+    T *             row;            // output row buffer (dB, fft-shifted)
+    struct SPWATERFALL(_level_s) level[SPWATERFALL_STREAM_LEVELS];
+};
+
 struct SPWATERFALL(_s) {
     // options
     unsigned int    nfft;           // FFT length
@@ -44,6 +83,11 @@ struct SPWATERFALL(_s) {
     unsigned int    index_time;     // time index for writing to buffer
     unsigned int    rollover;       // number of FFTs to take before writing to output
 
+    // streaming export
+    struct SPWATERFALL(_stream_s) * stream; // stream state (NULL if disabled)
+    T *             mem_acc;        // linear accumulator for buffer row (streaming only)
+    unsigned int    mem_count;      // transforms in buffer row accumulator
+
     // parameters for display purposes only
     float           frequency;      // center frequency [Hz]
     float           sample_rate;    // sample rate [Hz]
@@ -62,10 +106,25 @@ void SPWATERFALL(_step)(SPWATERFALL() _q);
 // consolidate buffer by taking log-average of two separate spectral estimates in time
 void SPWATERFALL(_consolidate_buffer)(SPWATERFALL() _q);
 
+// number of transforms periodogram must take before next call to _step
+unsigned long long int SPWATERFALL(_get_num_pending)(SPWATERFALL() _q);
+
+// step method while streaming: accumulate periodogram output into
+// buffer and stream rows, emitting each when complete
+void SPWATERFALL(_step_stream)(SPWATERFALL() _q);
+
 // export files
 int SPWATERFALL(_export_bin)(SPWATERFALL() _q, const char * _base);
 int SPWATERFALL(_export_gnu)(SPWATERFALL() _q, const char * _base);
 
+// stream export: open/close single pyramid level file
+int  SPWATERFALL(_level_open) (SPWATERFALL() _q, unsigned int _index, const char * _filename);
+void SPWATERFALL(_level_close)(SPWATERFALL() _q, unsigned int _index);
+
+// stream export: append linear row to pyramid level, propagating to
+// higher levels as pairs of rows are completed
+int SPWATERFALL(_level_append)(SPWATERFALL() _q, unsigned int _index, T * _row);
+
 // create spwaterfall object
 //  _nfft       : FFT size
 //  _wtype      : window type, e.g. LIQUID_WINDOW_HAMMING
@@ -109,6 +168,9 @@ SPWATERFALL() SPWATERFALL(_create)(unsigned int _nfft,
     q->width        = 800;
     q->height       = 800;
     q->commands     = NULL;
+    q->stream       = NULL;
+    q->mem_acc      = NULL;
+    q->mem_count    = 0;
 
     // create buffer to hold aggregated power spectral density
     // NOTE: the buffer is two-dimensional time/frequency grid that is two times
@@ -145,6 +207,9 @@ SPWATERFALL() SPWATERFALL(_create_default)(unsigned int _nfft,
 // destroy spwaterfall object
 void SPWATERFALL(_destroy)(SPWATERFALL() _q)
 {
+    // close stream export
+    SPWATERFALL(_stream_close)(_q);
+
     // free allocated memory
     free(_q->psd);
     free(_q->commands);
@@ -163,6 +228,17 @@ void SPWATERFALL(_clear)(SPWATERFALL() _q)
     SPGRAM(_clear)(_q->periodogram);
     memset(_q->psd, 0x00, 2*_q->nfft*_q->time*sizeof(T));
     _q->index_time = 0;
+
+    // clear stream accumulators (rows already written are kept)
+    if (_q->stream != NULL) {
+        unsigned int i;
+        memset(_q->mem_acc,     0x00, _q->nfft*sizeof(T));
+        memset(_q->stream->acc, 0x00, _q->nfft*sizeof(T));
+        _q->mem_count         = 0;
+        _q->stream->acc_count = 0;
+        for (i=0; i<SPWATERFALL_STREAM_LEVELS; i++)
+            _q->stream->level[i].has_pending = 0;
+    }
 }
 
 // reset the spwaterfall object to its original state completely
@@ -278,10 +354,21 @@ void SPWATERFALL(_write)(SPWATERFALL() _q,
                          TI *          _x,
                          unsigned int  _n)
 {
-    // TODO: be smarter about how to write and execute samples
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        SPWATERFALL(_push)(_q, _x[i]);
+    // write samples to periodogram in segments ending exactly where the
+    // required number of transforms have been taken
+    SPGRAM() p = _q->periodogram;
+    while (_n > 0) {
+        unsigned long long int r = SPWATERFALL(_get_num_pending)(_q);
+        unsigned long long int n = p->sample_timer + (r-1)*p->delay;
+        if (n > _n)
+            n = _n;
+
+        SPGRAM(_write)(p, _x, n);
+        SPWATERFALL(_step)(_q);
+
+        _x += n;
+        _n -= n;
+    }
 }
 
 // export output files
@@ -295,10 +382,116 @@ int SPWATERFALL(_export)(SPWATERFALL() _q,
     SPWATERFALL(_export_gnu)(_q, _base);
 }
 
+// start streaming export
+//  _q      : spwaterfall object
+//  _base   : base filename
+//  _decim  : number of transforms per base row, _decim > 0
+int SPWATERFALL(_stream_open)(SPWATERFALL() _q,
+                              const char *  _base,
+                              unsigned int  _decim)
+{
+    // validate input
+    if (_decim == 0) {
+        fprintf(stderr,"error: spwaterfall%s_stream_open(), decimation must be greater than zero\n", EXTENSION);
+        return -1;
+    }
+
+    // close existing stream
+    SPWATERFALL(_stream_close)(_q);
+
+    // determine file layout: header and mapped windows are page aligned
+    unsigned int row_size = _q->nfft * sizeof(float);
+    unsigned int page     = 4096;
+#if HAVE_SYS_MMAN_H
+    page = (unsigned int) sysconf(_SC_PAGESIZE);
+#endif
+    unsigned int a = row_size, b = page;
+    while (b != 0) { unsigned int t = a % b; a = b; b = t; }
+    unsigned int chunk_rows = page / a;
+    if (chunk_rows * row_size < SPWATERFALL_STREAM_CHUNK)
+        chunk_rows *= SPWATERFALL_STREAM_CHUNK / (chunk_rows * row_size);
+
+    struct SPWATERFALL(_stream_s) * s =
+        (struct SPWATERFALL(_stream_s)*) malloc(sizeof(struct SPWATERFALL(_stream_s)));
+    s->decim        = _decim;
+    s->header_size  = page;
+    s->chunk_rows   = chunk_rows;
+    s->acc          = (T*) calloc(_q->nfft, sizeof(T));
+    s->acc_count    = 0;
+    s->row          = (T*) malloc(_q->nfft*sizeof(T));
+    _q->stream      = s;
+
+    // open pyramid level files
+    unsigned int i;
+    int n = strlen(_base);
+    char filename[n+16];
+    for (i=0; i<SPWATERFALL_STREAM_LEVELS; i++) {
+        s->level[i].pending     = (T*) malloc(_q->nfft*sizeof(T));
+        s->level[i].has_pending = 0;
+        sprintf(filename,"%s.x%u.lqw", _base, 1U<<i);
+        if (SPWATERFALL(_level_open)(_q, i, filename) != 0) {
+            // close levels already opened and free state
+            while (i-- > 0)
+                SPWATERFALL(_level_close)(_q, i);
+            for (i=0; i<SPWATERFALL_STREAM_LEVELS; i++)
+                free(s->level[i].pending);
+            free(s->acc);
+            free(s->row);
+            free(s);
+            _q->stream = NULL;
+            return -1;
+        }
+    }
+
+    // move partial periodogram output into buffer row accumulator
+    SPGRAM() p = _q->periodogram;
+    _q->mem_acc   = (T*) malloc(_q->nfft*sizeof(T));
+    _q->mem_count = p->num_transforms;
+    memmove(_q->mem_acc, p->psd, _q->nfft*sizeof(T));
+    memset(p->psd, 0x00, _q->nfft*sizeof(T));
+    p->num_transforms = 0;
+    return 0;
+}
+
+// stop streaming export
+//  _q      : spwaterfall object
+int SPWATERFALL(_stream_close)(SPWATERFALL() _q)
+{
+    struct SPWATERFALL(_stream_s) * s = _q->stream;
+    if (s == NULL)
+        return 0;
+
+    // close pyramid level files
+    unsigned int i;
+    for (i=0; i<SPWATERFALL_STREAM_LEVELS; i++) {
+        SPWATERFALL(_level_close)(_q, i);
+        free(s->level[i].pending);
+    }
+    free(s->acc);
+    free(s->row);
+    free(s);
+    _q->stream = NULL;
+
+    // return partial buffer row to periodogram
+    SPGRAM() p = _q->periodogram;
+    for (i=0; i<_q->nfft; i++)
+        p->psd[i] += _q->mem_acc[i];
+    p->num_transforms += _q->mem_count;
+    free(_q->mem_acc);
+    _q->mem_acc   = NULL;
+    _q->mem_count = 0;
+    return 0;
+}
+
 // compute spectral periodogram output from current buffer contents
 //  _q : spwaterfall object
 void SPWATERFALL(_step)(SPWATERFALL() _q)
 {
+    if (_q->stream != NULL) {
+        SPWATERFALL(_step_stream)(_q);
+        return;
+    }
+
     // determine if we need to extract PSD estimate from periodogram
     if (SPGRAM(_get_num_transforms)(_q->periodogram) >= _q->rollover) {
         //printf("index : %u\n", _q->index_time);
@@ -318,6 +511,72 @@ void SPWATERFALL(_step)(SPWATERFALL() _q)
     }
 }
 
+// number of transforms periodogram must take before next call to _step
+//  _q : spwaterfall object
+unsigned long long int SPWATERFALL(_get_num_pending)(SPWATERFALL() _q)
+{
+    unsigned long long int r = _q->rollover;
+    if (_q->stream != NULL) {
+        // nearest of buffer and stream row boundaries
+        r = _q->rollover - _q->mem_count;
+        if (_q->stream->decim - _q->stream->acc_count < r)
+            r = _q->stream->decim - _q->stream->acc_count;
+    }
+    unsigned long long int num_transforms = SPGRAM(_get_num_transforms)(_q->periodogram);
+    return r > num_transforms ? r - num_transforms : 1;
+}
+
+// step method while streaming
+//  _q : spwaterfall object
+void SPWATERFALL(_step_stream)(SPWATERFALL() _q)
+{
+    // wait until nearest of buffer and stream row boundaries is reached
+    struct SPWATERFALL(_stream_s) * s = _q->stream;
+    unsigned int n = SPGRAM(_get_num_transforms)(_q->periodogram);
+    unsigned int r = _q->rollover - _q->mem_count;
+    if (s->decim - s->acc_count < r)
+        r = s->decim - s->acc_count;
+    if (n < r)
+        return;
+
+    // move periodogram output into accumulators
+    unsigned int k;
+    T * psd = _q->periodogram->psd;
+    for (k=0; k<_q->nfft; k++) {
+        _q->mem_acc[k] += psd[k];
+        s->acc[k]      += psd[k];
+    }
+    _q->mem_count += n;
+    s->acc_count  += n;
+    SPGRAM(_clear)(_q->periodogram);
+
+    // buffer row complete
+    unsigned int nfft_2 = _q->nfft / 2;
+    if (_q->mem_count >= _q->rollover) {
+        T scale = -10*log10f(_q->mem_count);
+        T * row = _q->psd + _q->nfft*_q->index_time;
+        for (k=0; k<_q->nfft; k++)
+            row[k] = 10*log10f(_q->mem_acc[(k + nfft_2) % _q->nfft]+1e-12f) + scale;
+        memset(_q->mem_acc, 0x00, _q->nfft*sizeof(T));
+        _q->mem_count = 0;
+
+        // increment buffer counter, consolidating if full
+        _q->index_time++;
+        if (_q->index_time == 2*_q->time)
+            SPWATERFALL(_consolidate_buffer)(_q);
+    }
+
+    // stream row complete
+    if (s->acc_count >= s->decim) {
+        T g = 1.0f / (T)(s->acc_count);
+        for (k=0; k<_q->nfft; k++)
+            s->acc[k] *= g;
+        SPWATERFALL(_level_append)(_q, 0, s->acc);
+        memset(s->acc, 0x00, _q->nfft*sizeof(T));
+        s->acc_count = 0;
+    }
+}
+
 // consolidate buffer by taking log-average of two separate spectral estimates in time
 //  _q : spwaterfall object
 void SPWATERFALL(_consolidate_buffer)(SPWATERFALL() _q)
@@ -490,3 +749,163 @@ int SPWATERFALL(_export_gnu)(SPWATERFALL() _q,
     return 0;
 }
 
+
+// stream export: open single pyramid level file
+//  _q          : spwaterfall object
+//  _index      : pyramid level index
+//  _filename   : output filename
+int SPWATERFALL(_level_open)(SPWATERFALL() _q,
+                             unsigned int  _index,
+                             const char *  _filename)
+{
+    struct SPWATERFALL(_stream_s) * s = _q->stream;
+    struct SPWATERFALL(_level_s)  * l = &s->level[_index];
+    struct spwaterfall_stream_header_s * h;
+#if HAVE_SYS_MMAN_H
+    // create file and map header
+    l->fd = open(_filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (l->fd < 0) {
+        fprintf(stderr,"error: spwaterfall%s_stream_open(), could not open '%s' for writing\n",
+                EXTENSION, _filename);
+        return -1;
+    }
+    void * p = MAP_FAILED;
+    if (ftruncate(l->fd, s->header_size) == 0)
+        p = mmap(NULL, s->header_size, PROT_READ | PROT_WRITE, MAP_SHARED, l->fd, 0);
+    if (p == MAP_FAILED) {
+        fprintf(stderr,"error: spwaterfall%s_stream_open(), could not map '%s'\n",
+                EXTENSION, _filename);
+        close(l->fd);
+        return -1;
+    }
+    l->header      = (struct spwaterfall_stream_header_s *) p;
+    l->chunk       = NULL;
+    l->chunk_index = 0;
+    h = l->header;
+#else
+    l->fid = fopen(_filename,"w+b");
+    if (l->fid == NULL) {
+        fprintf(stderr,"error: spwaterfall%s_stream_open(), could not open '%s' for writing\n",
+                EXTENSION, _filename);
+        return -1;
+    }
+    h = &l->header;
+#endif
+
+    // fill header
+    memset(h, 0x00, sizeof(struct spwaterfall_stream_header_s));
+    memmove(h->magic, "LQWF", 4);
+    h->version          = 1;
+    h->header_size      = s->header_size;
+    h->num_freq         = _q->nfft;
+    h->decim            = 1U << _index;
+    h->num_transforms   = s->decim << _index;
+    h->delay            = SPGRAM(_get_delay)(_q->periodogram);
+    h->frequency        = _q->frequency;
+    h->sample_rate      = _q->sample_rate;
+    h->sample_offset    = SPGRAM(_get_num_samples_total)(_q->periodogram);
+    h->num_rows         = 0;
+#if !HAVE_SYS_MMAN_H
+    // write header, padded to full size
+    unsigned int i;
+    fwrite(h, sizeof(struct spwaterfall_stream_header_s), 1, l->fid);
+    for (i=sizeof(struct spwaterfall_stream_header_s); i<s->header_size; i++)
+        fputc(0, l->fid);
+    fflush(l->fid);
+#endif
+    return 0;
+}
+
+// stream export: close single pyramid level file
+//  _q          : spwaterfall object
+//  _index      : pyramid level index
+void SPWATERFALL(_level_close)(SPWATERFALL() _q,
+                               unsigned int  _index)
+{
+    struct SPWATERFALL(_stream_s) * s = _q->stream;
+    struct SPWATERFALL(_level_s)  * l = &s->level[_index];
+#if HAVE_SYS_MMAN_H
+    // unmap and truncate file to rows written
+    size_t chunk_size = (size_t)s->chunk_rows * _q->nfft * sizeof(float);
+    off_t  file_size  = (off_t)s->header_size +
+                        (off_t)l->header->num_rows * _q->nfft * sizeof(float);
+    if (l->chunk != NULL)
+        munmap(l->chunk, chunk_size);
+    munmap(l->header, s->header_size);
+    if (ftruncate(l->fd, file_size) != 0)
+        fprintf(stderr,"warning: spwaterfall%s_stream_close(), could not truncate file\n", EXTENSION);
+    close(l->fd);
+#else
+    fclose(l->fid);
+#endif
+}
+
+// stream export: append linear row to pyramid level
+//  _q          : spwaterfall object
+//  _index      : pyramid level index
+//  _row        : linear power spectral density (not shifted) [size: nfft x 1]
+int SPWATERFALL(_level_append)(SPWATERFALL() _q,
+                               unsigned int  _index,
+                               T *           _row)
+{
+    struct SPWATERFALL(_stream_s) * s = _q->stream;
+    struct SPWATERFALL(_level_s)  * l = &s->level[_index];
+
+    // convert to dB and apply FFT shift
+    unsigned int k;
+    unsigned int nfft_2 = _q->nfft / 2;
+    for (k=0; k<_q->nfft; k++)
+        s->row[k] = 10*log10f(_row[(k + nfft_2) % _q->nfft] + 1e-12f);
+
+#if HAVE_SYS_MMAN_H
+    // map window holding this row, extending file as necessary
+    uint64_t r = l->header->num_rows;
+    uint64_t c = r / s->chunk_rows;
+    size_t chunk_size = (size_t)s->chunk_rows * _q->nfft * sizeof(float);
+    if (l->chunk == NULL || c != l->chunk_index) {
+        if (l->chunk != NULL)
+            munmap(l->chunk, chunk_size);
+        l->chunk = NULL;
+        off_t offset = (off_t)s->header_size + (off_t)c * chunk_size;
+        void * p = MAP_FAILED;
+        if (ftruncate(l->fd, offset + chunk_size) == 0)
+            p = mmap(NULL, chunk_size, PROT_READ | PROT_WRITE, MAP_SHARED, l->fd, offset);
+        if (p == MAP_FAILED) {
+            fprintf(stderr,"error: spwaterfall%s_step(), could not extend stream file\n", EXTENSION);
+            return -1;
+        }
+        l->chunk       = (float*) p;
+        l->chunk_index = c;
+    }
+    float * dst = l->chunk + (r % s->chunk_rows) * _q->nfft;
+    for (k=0; k<_q->nfft; k++)
+        dst[k] = (float) s->row[k];
+    l->header->num_rows = r + 1;
+#else
+    // append row and update header
+    long offset = (long)s->header_size + (long)l->header.num_rows * _q->nfft * sizeof(float);
+    fseek(l->fid, offset, SEEK_SET);
+    for (k=0; k<_q->nfft; k++) {
+        float v = (float) s->row[k];
+        fwrite(&v, sizeof(float), 1, l->fid);
+    }
+    l->header.num_rows++;
+    fseek(l->fid, 0, SEEK_SET);
+    fwrite(&l->header, sizeof(struct spwaterfall_stream_header_s), 1, l->fid);
+    fflush(l->fid);
+#endif
+
+    // build next pyramid level from pairs of rows
+    if (_index + 1 < SPWATERFALL_STREAM_LEVELS) {
+        if (!l->has_pending) {
+            memmove(l->pending, _row, _q->nfft*sizeof(T));
+            l->has_pending = 1;
+        } else {
+            for (k=0; k<_q->nfft; k++)
+                l->pending[k] = 0.5f*(l->pending[k] + _row[k]);
+            l->has_pending = 0;
+            return SPWATERFALL(_level_append)(_q, _index+1, l->pending);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare writing blocks of random length to pushing one sample at a time
+void testbench_spgramcf_write(unsigned int _nfft,
+                              unsigned int _window_len,
+                              unsigned int _delay,
+                              float        _alpha)
+{
+    unsigned int num_samples = 20*_nfft + 37;
+    float complex x[num_samples];
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    spgramcf q0 = spgramcf_create(_nfft, LIQUID_WINDOW_HAMMING, _window_len, _delay);
+    spgramcf q1 = spgramcf_create(_nfft, LIQUID_WINDOW_HAMMING, _window_len, _delay);
+    spgramcf_set_alpha(q0, _alpha);
+    spgramcf_set_alpha(q1, _alpha);
+
+    for (i=0; i<num_samples; i++)
+        spgramcf_push(q0, x[i]);
+    i = 0;
+    while (i < num_samples) {
+        unsigned int n = rand() % (3*_nfft);
+        if (n > num_samples - i) n = num_samples - i;
+        spgramcf_write(q1, x + i, n);
+        i += n;
+    }
+
+    CONTEND_EQUALITY(spgramcf_get_num_samples    (q0), spgramcf_get_num_samples    (q1));
+    CONTEND_EQUALITY(spgramcf_get_num_transforms (q0), spgramcf_get_num_transforms (q1));
+
+    float psd0[_nfft];
+    float psd1[_nfft];
+    spgramcf_get_psd(q0, psd0);
+    spgramcf_get_psd(q1, psd1);
+    CONTEND_SAME_DATA(psd0, psd1, _nfft*sizeof(float));
+
+    // continue with a few single samples
+    for (i=0; i<2*_delay; i++) {
+        spgramcf_push (q0, x[i]);
+        spgramcf_write(q1, x+i, 1);
+    }
+    spgramcf_get_psd(q0, psd0);
+    spgramcf_get_psd(q1, psd1);
+    CONTEND_SAME_DATA(psd0, psd1, _nfft*sizeof(float));
+
+    spgramcf_destroy(q0);
+    spgramcf_destroy(q1);
+}
+
+void autotest_spgramcf_write_n64_w64_d16()  { testbench_spgramcf_write(  64,  64,  16, -1.0f); }
+void autotest_spgramcf_write_n64_w37_d50()  { testbench_spgramcf_write(  64,  37,  50, -1.0f); }
+void autotest_spgramcf_write_n99_w80_d7()   { testbench_spgramcf_write(  99,  80,   7,  0.1f); }
+void autotest_spgramcf_write_n256_w200_d300() { testbench_spgramcf_write( 256, 200, 300, 0.2f); }
+
+// real-valued input
+void autotest_spgramf_write()
+{
+    unsigned int nfft = 128;
+    unsigned int num_samples = 5000;
+    float x[num_samples];
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf();
+
+    spgramf q0 = spgramf_create(nfft, LIQUID_WINDOW_HANN, 101, 33);
+    spgramf q1 = spgramf_create(nfft, LIQUID_WINDOW_HANN, 101, 33);
+    for (i=0; i<num_samples; i++)
+        spgramf_push(q0, x[i]);
+    spgramf_write(q1, x, 1000);
+    spgramf_write(q1, x + 1000, 7);
+    spgramf_write(q1, x + 1007, num_samples - 1007);
+
+    CONTEND_EQUALITY(spgramf_get_num_transforms(q0), spgramf_get_num_transforms(q1));
+    float psd0[nfft];
+    float psd1[nfft];
+    spgramf_get_psd(q0, psd0);
+    spgramf_get_psd(q1, psd1);
+    CONTEND_SAME_DATA(psd0, psd1, nfft*sizeof(float));
+
+    spgramf_destroy(q0);
+    spgramf_destroy(q1);
+}
+
+// waterfall writing blocks matches pushing one sample at a time
+void autotest_spwaterfallcf_write()
+{
+    unsigned int nfft = 64;
+    unsigned int num_samples = 40000;
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    spwaterfallcf q0 = spwaterfallcf_create(nfft, LIQUID_WINDOW_HAMMING, 48, 24, 8);
+    spwaterfallcf q1 = spwaterfallcf_create(nfft, LIQUID_WINDOW_HAMMING, 48, 24, 8);
+    for (i=0; i<num_samples; i++)
+        spwaterfallcf_push(q0, x[i]);
+    i = 0;
+    while (i < num_samples) {
+        unsigned int n = rand() % 2000;
+        if (n > num_samples - i) n = num_samples - i;
+        spwaterfallcf_write(q1, x + i, n);
+        i += n;
+    }
+
+    CONTEND_EQUALITY(spwaterfallcf_get_num_time(q0), spwaterfallcf_get_num_time(q1));
+    CONTEND_SAME_DATA(spwaterfallcf_get_psd(q0), spwaterfallcf_get_psd(q1),
+                      nfft*spwaterfallcf_get_num_time(q0)*sizeof(float));
+
+    spwaterfallcf_destroy(q0);
+    spwaterfallcf_destroy(q1);
+    free(x);
+}
+
+// Welch estimate is identical for any number of threads
+void autotest_spgramcf_welch_threads()
+{
+    unsigned int nfft = 256;
+    unsigned int num_samples = 100000;
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    float psd0[nfft], psd1[nfft], psd2[nfft];
+    float pct0[nfft], pct1[nfft];
+    CONTEND_EQUALITY(spgramcf_estimate_psd_welch(nfft,LIQUID_WINDOW_HANN,200,50,x,num_samples,-1,1,psd0), 0);
+    CONTEND_EQUALITY(spgramcf_estimate_psd_welch(nfft,LIQUID_WINDOW_HANN,200,50,x,num_samples,-1,3,psd1), 0);
+    CONTEND_EQUALITY(spgramcf_estimate_psd_welch(nfft,LIQUID_WINDOW_HANN,200,50,x,num_samples,-1,8,psd2), 0);
+    CONTEND_SAME_DATA(psd0, psd1, nfft*sizeof(float));
+    CONTEND_SAME_DATA(psd0, psd2, nfft*sizeof(float));
+
+    // percentile estimate
+    CONTEND_EQUALITY(spgramcf_estimate_psd_welch(nfft,LIQUID_WINDOW_HANN,200,50,x,num_samples,0.9f,1,pct0), 0);
+    CONTEND_EQUALITY(spgramcf_estimate_psd_welch(nfft,LIQUID_WINDOW_HANN,200,50,x,num_samples,0.9f,5,pct1), 0);
+    CONTEND_SAME_DATA(pct0, pct1, nfft*sizeof(float));
+
+    // input too short
+    CONTEND_EQUALITY(spgramcf_estimate_psd_welch(nfft,LIQUID_WINDOW_HANN,200,50,x,199,-1,1,psd0), -1);
+    free(x);
+}
+
+// Welch mean with non-overlapping segments matches streaming estimate
+void autotest_spgramcf_welch_mean()
+{
+    unsigned int nfft = 128;
+    unsigned int num_samples = 500*nfft;
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf() + 0.5f*cexpf(_Complex_I*0.7f*i);
+
+    float psd0[nfft], psd1[nfft];
+    spgramcf q = spgramcf_create(nfft, LIQUID_WINDOW_KAISER, nfft, nfft);
+    spgramcf_write(q, x, num_samples);
+    spgramcf_get_psd(q, psd0);
+    spgramcf_destroy(q);
+    spgramcf_estimate_psd_welch(nfft,LIQUID_WINDOW_KAISER,nfft,nfft,x,num_samples,-1,4,psd1);
+    for (i=0; i<nfft; i++)
+        CONTEND_DELTA(psd0[i], psd1[i], 0.01f);
+    free(x);
+}
+
+// median of exponentially-distributed white noise power is mean - 1.59 dB
+void autotest_spgramcf_welch_median()
+{
+    unsigned int nfft = 64;
+    unsigned int num_samples = 200000;
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    float psd_mean[nfft], psd_median[nfft];
+    spgramcf_estimate_psd_welch(nfft,LIQUID_WINDOW_HAMMING,nfft,nfft/2,x,num_samples,-1,  2,psd_mean);
+    spgramcf_estimate_psd_welch(nfft,LIQUID_WINDOW_HAMMING,nfft,nfft/2,x,num_samples,0.5f,2,psd_median);
+    float offset = 10*log10f(logf(2.0f));
+    for (i=0; i<nfft; i++)
+        CONTEND_DELTA(psd_median[i], psd_mean[i] + offset, 0.5f);
+    free(x);
+}
+
+// estimate from file matches estimate from memory
+void autotest_spgramf_welch_file()
+{
+    const char filename[] = "autotest_spgramf_welch.bin";
+    unsigned int nfft = 128;
+    unsigned int num_samples = 20000;
+    float x[num_samples];
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf();
+
+    FILE * fid = fopen(filename,"wb");
+    if (fid == NULL) {
+        AUTOTEST_WARN("could not open file for writing; skipping test\n");
+        return;
+    }
+    fwrite(x, sizeof(float), num_samples, fid);
+    fclose(fid);
+
+    float psd0[nfft], psd1[nfft];
+    CONTEND_EQUALITY(spgramf_estimate_psd_welch(nfft,LIQUID_WINDOW_HANN,100,40,x,num_samples,-1,2,psd0), 0);
+    CONTEND_EQUALITY(spgramf_estimate_psd_file(filename,nfft,LIQUID_WINDOW_HANN,100,40,-1,2,psd1), 0);
+    CONTEND_SAME_DATA(psd0, psd1, nfft*sizeof(float));
+    remove(filename);
+}
+
+// read stream export file, returning rows (allocated) and header
+float * spwaterfall_stream_read(const char *                         _filename,
+                                struct spwaterfall_stream_header_s * _header)
+{
+    FILE * fid = fopen(_filename,"rb");
+    if (fid == NULL)
+        return NULL;
+    if (fread(_header, sizeof(struct spwaterfall_stream_header_s), 1, fid) != 1) {
+        fclose(fid);
+        return NULL;
+    }
+    unsigned int n = _header->num_freq * _header->num_rows;
+    float * rows = (float*) malloc((n+1)*sizeof(float));
+    fseek(fid, _header->header_size, SEEK_SET);
+    if (fread(rows, sizeof(float), n, fid) != n) {
+        free(rows);
+        rows = NULL;
+    }
+    fclose(fid);
+    return rows;
+}
+
+// streaming export: rows, pyramid levels, and in-memory buffer
+void autotest_spwaterfallcf_stream()
+{
+    unsigned int nfft  = 64;
+    unsigned int delay = 32;
+    unsigned int decim = 4;
+    unsigned int num_samples = 300*delay + 17;
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    unsigned int i, k;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf() + cexpf(_Complex_I*0.01f*i*i/num_samples);
+
+    // stream from second object; blocks are written in random sizes
+    spwaterfallcf q0 = spwaterfallcf_create(nfft, LIQUID_WINDOW_HAMMING, 48, delay, 32);
+    spwaterfallcf q1 = spwaterfallcf_create(nfft, LIQUID_WINDOW_HAMMING, 48, delay, 32);
+    if (spwaterfallcf_stream_open(q1, "autotest_spwaterfall", decim) != 0) {
+        AUTOTEST_WARN("could not open stream files; skipping test\n");
+        spwaterfallcf_destroy(q0);
+        spwaterfallcf_destroy(q1);
+        free(x);
+        return;
+    }
+    spwaterfallcf_write(q0, x, num_samples);
+    i = 0;
+    while (i < num_samples) {
+        unsigned int n = rand() % 500;
+        if (n > num_samples - i) n = num_samples - i;
+        spwaterfallcf_write(q1, x + i, n);
+        i += n;
+    }
+    spwaterfallcf_stream_close(q1);
+
+    // in-memory buffer is not affected by streaming
+    unsigned int num_time = spwaterfallcf_get_num_time(q0);
+    CONTEND_EQUALITY(num_time, spwaterfallcf_get_num_time(q1));
+    const float * psd0 = spwaterfallcf_get_psd(q0);
+    const float * psd1 = spwaterfallcf_get_psd(q1);
+    for (i=0; i<num_time*nfft; i++)
+        CONTEND_DELTA(psd0[i], psd1[i], 1e-3f);
+
+    // check levels
+    unsigned int num_transforms = num_samples / delay;
+    struct spwaterfall_stream_header_s h[4];
+    float * rows[4];
+    const char * filenames[4] = {
+        "autotest_spwaterfall.x1.lqw", "autotest_spwaterfall.x2.lqw",
+        "autotest_spwaterfall.x4.lqw", "autotest_spwaterfall.x8.lqw"};
+    for (i=0; i<4; i++) {
+        rows[i] = spwaterfall_stream_read(filenames[i], &h[i]);
+        CONTEND_EXPRESSION(rows[i] != NULL);
+        if (rows[i] == NULL)
+            return;
+        CONTEND_SAME_DATA(h[i].magic, "LQWF", 4);
+        CONTEND_EQUALITY(h[i].num_freq,       nfft);
+        CONTEND_EQUALITY(h[i].decim,          1U<<i);
+        CONTEND_EQUALITY(h[i].num_transforms, decim<<i);
+        CONTEND_EQUALITY(h[i].delay,          delay);
+        CONTEND_EQUALITY(h[i].num_rows,       num_transforms / (decim<<i));
+    }
+
+    // first base row matches log-average of first transforms from the
+    // periodogram, and each level is the log-average of the level below
+    spgramcf p = spgramcf_create(nfft, LIQUID_WINDOW_HAMMING, 48, delay);
+    float row[nfft];
+    spgramcf_write(p, x, decim*delay);
+    spgramcf_get_psd(p, row);
+    for (k=0; k<nfft; k++)
+        CONTEND_DELTA(rows[0][k], row[k], 1e-3f);
+    spgramcf_destroy(p);
+    for (i=1; i<4; i++) {
+        for (k=0; k<nfft*h[i].num_rows; k++) {
+            unsigned int r = k / nfft, c = k % nfft;
+            float v0 = powf(10.0f, 0.1f*rows[i-1][(2*r+0)*nfft + c]);
+            float v1 = powf(10.0f, 0.1f*rows[i-1][(2*r+1)*nfft + c]);
+            CONTEND_DELTA(rows[i][k], 10*log10f(0.5f*(v0+v1)), 1e-3f);
+        }
+    }
+
+    for (i=0; i<4; i++) {
+        free(rows[i]);
+        remove(filenames[i]);
+    }
+    spwaterfallcf_destroy(q0);
+    spwaterfallcf_destroy(q1);
+    free(x);
+}
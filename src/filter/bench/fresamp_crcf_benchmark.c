@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include <math.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+void fresamp_crcf_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _P,
+                        unsigned int        _Q,
+                        unsigned int        _order,
+                        int                 _block)
+{
+    // adjust number of iterations: cycles/trial ~ 500 + 100 Q
+    *_num_iterations /= (500 + 100*_Q);
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // create resampling object; irrational rate is just less than Q/P
+    // (filter parameters match resamp_crcf benchmark)
+    float        rate = (float)_Q/(float)_P*sqrt(3301.0f/3302.0f);
+    unsigned int m    = 12;     // filter semi-length
+    float        bw   = 0.45f;  // filter bandwidth
+    float        As   = 60.0f;  // stop-band attenuation [dB]
+    fresamp_crcf q = fresamp_crcf_create(rate,m,_order,bw,As);
+
+    // buffering
+    float complex buf_0[_P];
+    float complex buf_1[_Q*4];
+    unsigned int num_written;
+    
+    unsigned long int i;
+    unsigned int j;
+    for (i=0; i<_P; i++)
+        buf_0[i] = i % 7 ? 1 : -1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    if (_block) {
+        for (i=0; i<(*_num_iterations); i++) {
+            fresamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
+            fresamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
+            fresamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
+            fresamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
+        }
+    } else {
+        // execute one sample at a time for comparison
+        for (i=0; i<4*(*_num_iterations); i++) {
+            unsigned int ny = 0;
+            for (j=0; j<_P; j++) {
+                fresamp_crcf_execute(q, buf_0[j], buf_1 + ny, &num_written);
+                ny += num_written;
+            }
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    // destroy object
+    fresamp_crcf_destroy(q);
+}
+
+#define FRESAMP_CRCF_BENCHMARK_API(P,Q,ORDER)   \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ fresamp_crcf_bench(_start, _finish, _num_iterations, P, Q, ORDER, 1); }
+
+#define FRESAMP_CRCF_BENCHMARK_LOOP_API(P,Q,ORDER)  \
+(   struct rusage *_start,                          \
+    struct rusage *_finish,                         \
+    unsigned long int *_num_iterations)             \
+{ fresamp_crcf_bench(_start, _finish, _num_iterations, P, Q, ORDER, 0); }
+
+//
+// Farrow resampler benchmarks; compare to resamp_crcf benchmarks
+//
+void benchmark_fresamp_crcf_P256_Q64_loop       FRESAMP_CRCF_BENCHMARK_LOOP_API(256,   64, 3)
+void benchmark_fresamp_crcf_P256_Q64_block      FRESAMP_CRCF_BENCHMARK_API     (256,   64, 3)
+void benchmark_fresamp_crcf_P256_Q256_loop      FRESAMP_CRCF_BENCHMARK_LOOP_API(256,  256, 3)
+void benchmark_fresamp_crcf_P256_Q256_block     FRESAMP_CRCF_BENCHMARK_API     (256,  256, 3)
+void benchmark_fresamp_crcf_P256_Q1024_loop     FRESAMP_CRCF_BENCHMARK_LOOP_API(256, 1024, 3)
+void benchmark_fresamp_crcf_P256_Q1024_block    FRESAMP_CRCF_BENCHMARK_API     (256, 1024, 3)
+
+//
+// Polynomial order
+//
+void benchmark_fresamp_crcf_P256_Q256_order1    FRESAMP_CRCF_BENCHMARK_API     (256,  256, 1)
+void benchmark_fresamp_crcf_P256_Q256_order5    FRESAMP_CRCF_BENCHMARK_API     (256,  256, 5)
+void benchmark_fresamp_crcf_P256_Q256_order7    FRESAMP_CRCF_BENCHMARK_API     (256,  256, 7)
@@ -125,3 +125,76 @@ void benchmark_irfilt_crcf_dcblock(struct rusage *     _start,
     iirfilt_crcf_destroy(q);
 }
 
+
+// Helper function for block execution
+void iirfilt_crcf_block_bench(struct rusage *     _start,
+                              struct rusage *     _finish,
+                              unsigned long int * _num_iterations,
+                              unsigned int        _order)
+{
+    unsigned long int i;
+
+    // scale number of iterations (trials)
+    *_num_iterations *= 800;
+    *_num_iterations /= (unsigned int)(93 + 53.3*_order);
+
+    // create filter object from prototype
+    iirfilt_crcf q = iirfilt_crcf_create_prototype(LIQUID_IIRDES_BUTTER,
+                                                   LIQUID_IIRDES_LOWPASS,
+                                                   LIQUID_IIRDES_SOS,
+                                                   _order,
+                                                   0.2f, 0.0f, 0.1f, 60.0f);
+
+    // initialize input/output
+    unsigned int buf_len = 256;
+    float complex x[buf_len];
+    float complex y[buf_len];
+    for (i=0; i<buf_len; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i+=buf_len)
+        iirfilt_crcf_execute_block(q, x, buf_len, y);
+    getrusage(RUSAGE_SELF, _finish);
+
+    // destroy filter object
+    iirfilt_crcf_destroy(q);
+}
+
+#define IIRFILT_CRCF_BLOCK_BENCHMARK_API(N) \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ iirfilt_crcf_block_bench(_start, _finish, _num_iterations, N); }
+
+// benchmark second-order sections form, block execution
+void benchmark_iirfilt_crcf_sos_block_4  IIRFILT_CRCF_BLOCK_BENCHMARK_API(4)
+void benchmark_iirfilt_crcf_sos_block_8  IIRFILT_CRCF_BLOCK_BENCHMARK_API(8)
+void benchmark_iirfilt_crcf_sos_block_16 IIRFILT_CRCF_BLOCK_BENCHMARK_API(16)
+
+// benchmark DC-blocking filter, block execution
+void benchmark_irfilt_crcf_dcblock_block(struct rusage *     _start,
+                                         struct rusage *     _finish,
+                                         unsigned long int * _num_iterations)
+{
+    unsigned long int i;
+
+    // create filter object
+    iirfilt_crcf q = iirfilt_crcf_create_dc_blocker(0.1f);
+
+    // initialize input/output
+    unsigned int buf_len = 256;
+    float complex x[buf_len];
+    for (i=0; i<buf_len; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i+=buf_len)
+        iirfilt_crcf_execute_block(q, x, buf_len, x);
+    getrusage(RUSAGE_SELF, _finish);
+
+    // destroy filter object
+    iirfilt_crcf_destroy(q);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small; iterations are counted as
+// channel-samples
+void iirfiltbank_crcf_bench(struct rusage *     _start,
+                            struct rusage *     _finish,
+                            unsigned long int * _num_iterations,
+                            unsigned int        _num_channels,
+                            int                 _bank)
+{
+    unsigned long int i;
+    unsigned int k;
+
+    // scale number of iterations (trials)
+    *_num_iterations *= 10;
+
+    // 8th-order low-pass filter
+    unsigned int order = 8;
+    iirfiltbank_crcf q = iirfiltbank_crcf_create_prototype(LIQUID_IIRDES_BUTTER,
+            LIQUID_IIRDES_LOWPASS, order, 0.2f, 0.0f, 0.1f, 60.0f, _num_channels);
+    iirfilt_crcf f[_num_channels];
+    for (k=0; k<_num_channels; k++) {
+        f[k] = iirfilt_crcf_create_prototype(LIQUID_IIRDES_BUTTER,
+                LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_SOS, order, 0.2f, 0.0f, 0.1f, 60.0f);
+    }
+
+    // initialize input/output (time-major)
+    unsigned int n = 64;
+    float complex x[n*_num_channels];
+    float complex y[n*_num_channels];
+    for (i=0; i<n*_num_channels; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i+=n*_num_channels) {
+        if (_bank) {
+            iirfiltbank_crcf_execute_block(q, x, n, y);
+        } else {
+            unsigned int t;
+            for (t=0; t<n; t++) {
+                for (k=0; k<_num_channels; k++)
+                    iirfilt_crcf_execute(f[k], x[t*_num_channels+k], &y[t*_num_channels+k]);
+            }
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    iirfiltbank_crcf_destroy(q);
+    for (k=0; k<_num_channels; k++)
+        iirfilt_crcf_destroy(f[k]);
+}
+
+#define IIRFILTBANK_CRCF_BENCHMARK_API(C,B) \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ iirfiltbank_crcf_bench(_start, _finish, _num_iterations, C, B); }
+
+// independent filters
+void benchmark_iirfiltbank_crcf_ref_c4  IIRFILTBANK_CRCF_BENCHMARK_API(4,  0)
+void benchmark_iirfiltbank_crcf_ref_c16 IIRFILTBANK_CRCF_BENCHMARK_API(16, 0)
+
+// filter bank
+void benchmark_iirfiltbank_crcf_c1      IIRFILTBANK_CRCF_BENCHMARK_API(1,  1)
+void benchmark_iirfiltbank_crcf_c4      IIRFILTBANK_CRCF_BENCHMARK_API(4,  1)
+void benchmark_iirfiltbank_crcf_c16     IIRFILTBANK_CRCF_BENCHMARK_API(16, 1)
+
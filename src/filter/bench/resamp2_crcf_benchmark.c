@@ -25,7 +25,9 @@
 
 typedef enum {
     RESAMP2_DECIM,
-    RESAMP2_INTERP
+    RESAMP2_INTERP,
+    RESAMP2_DECIM_BLOCK,
+    RESAMP2_INTERP_BLOCK,
 } resamp2_type;
 
 // Helper function to keep code base small
@@ -45,8 +47,10 @@ void resamp2_crcf_bench(struct rusage *_start,
 
     resamp2_crcf q = resamp2_crcf_create(_m,0.0f,60.0f);
 
-    float complex x[] = {1.0f, -1.0f};
-    float complex y[] = {1.0f, -1.0f};
+    float complex x[512];
+    float complex y[512];
+    for (i=0; i<512; i++)
+        x[i] = (i % 2) ? -1.0f : 1.0f;
 
     // start trials
     getrusage(RUSAGE_SELF, _start);
@@ -59,7 +63,7 @@ void resamp2_crcf_bench(struct rusage *_start,
             resamp2_crcf_decim_execute(q,x,y);
             resamp2_crcf_decim_execute(q,x,y);
         }
-    } else {
+    } else if (_type == RESAMP2_INTERP) {
 
         // run interpolator
         for (i=0; i<(*_num_iterations); i++) {
@@ -68,6 +72,18 @@ void resamp2_crcf_bench(struct rusage *_start,
             resamp2_crcf_interp_execute(q,x[0],y);
             resamp2_crcf_interp_execute(q,x[0],y);
         }
+    } else if (_type == RESAMP2_DECIM_BLOCK) {
+
+        // run decimator on blocks of 256 outputs
+        *_num_iterations = (*_num_iterations + 63) / 64 * 64;
+        for (i=0; i<(*_num_iterations); i+=64)
+            resamp2_crcf_decim_execute_block(q,x,256,y);
+    } else {
+
+        // run interpolator on blocks of 256 inputs
+        *_num_iterations = (*_num_iterations + 63) / 64 * 64;
+        for (i=0; i<(*_num_iterations); i+=64)
+            resamp2_crcf_interp_execute_block(q,x,256,y);
     }
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
@@ -105,3 +121,13 @@ void benchmark_resamp2_crcf_interp_m64  RESAMP2_CRCF_BENCHMARK_API( 64,RESAMP2_I
 void benchmark_resamp2_crcf_interp_m128 RESAMP2_CRCF_BENCHMARK_API(128,RESAMP2_INTERP)
 void benchmark_resamp2_crcf_interp_m256 RESAMP2_CRCF_BENCHMARK_API(256,RESAMP2_INTERP)
 
+
+//
+// Block decimators/interpolators
+//
+void benchmark_resamp2_crcf_decim_block_m4      RESAMP2_CRCF_BENCHMARK_API(  4,RESAMP2_DECIM_BLOCK)
+void benchmark_resamp2_crcf_decim_block_m16     RESAMP2_CRCF_BENCHMARK_API( 16,RESAMP2_DECIM_BLOCK)
+void benchmark_resamp2_crcf_decim_block_m64     RESAMP2_CRCF_BENCHMARK_API( 64,RESAMP2_DECIM_BLOCK)
+void benchmark_resamp2_crcf_interp_block_m4     RESAMP2_CRCF_BENCHMARK_API(  4,RESAMP2_INTERP_BLOCK)
+void benchmark_resamp2_crcf_interp_block_m16    RESAMP2_CRCF_BENCHMARK_API( 16,RESAMP2_INTERP_BLOCK)
+void benchmark_resamp2_crcf_interp_block_m64    RESAMP2_CRCF_BENCHMARK_API( 64,RESAMP2_INTERP_BLOCK)
@@ -29,10 +29,12 @@ void resamp_crcf_bench(struct rusage *     _start,
                        struct rusage *     _finish,
                        unsigned long int * _num_iterations,
                        unsigned int        _P,
-                       unsigned int        _Q)
+                       unsigned int        _Q,
+                       int                 _block)
 {
     // adjust number of iterations: cycles/trial ~ 500 + 100 Q
     *_num_iterations /= (500 + 100*_Q);
+    if (*_num_iterations < 1) *_num_iterations = 1;
 
     // create resampling object; irrational rate is just less than Q/P
     float        rate = (float)_Q/(float)_P*sqrt(3301.0f/3302.0f);
@@ -48,16 +50,28 @@ void resamp_crcf_bench(struct rusage *     _start,
     unsigned int num_written;
     
     unsigned long int i;
+    unsigned int j;
     for (i=0; i<_P; i++)
         buf_0[i] = i % 7 ? 1 : -1;
 
     // start trials
     getrusage(RUSAGE_SELF, _start);
-    for (i=0; i<(*_num_iterations); i++) {
-        resamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
-        resamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
-        resamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
-        resamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
+    if (_block) {
+        for (i=0; i<(*_num_iterations); i++) {
+            resamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
+            resamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
+            resamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
+            resamp_crcf_execute_block(q, buf_0, _P, buf_1, &num_written);
+        }
+    } else {
+        // execute one sample at a time for comparison
+        for (i=0; i<4*(*_num_iterations); i++) {
+            unsigned int ny = 0;
+            for (j=0; j<_P; j++) {
+                resamp_crcf_execute(q, buf_0[j], buf_1 + ny, &num_written);
+                ny += num_written;
+            }
+        }
     }
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
@@ -70,7 +84,13 @@ void resamp_crcf_bench(struct rusage *     _start,
 (   struct rusage *_start,              \
     struct rusage *_finish,             \
     unsigned long int *_num_iterations) \
-{ resamp_crcf_bench(_start, _finish, _num_iterations, P, Q); }
+{ resamp_crcf_bench(_start, _finish, _num_iterations, P, Q, 1); }
+
+#define RESAMP_CRCF_BENCHMARK_LOOP_API(P,Q) \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ resamp_crcf_bench(_start, _finish, _num_iterations, P, Q, 0); }
 
 //
 // Resampler benchmark prototypes; compare to rational rate resampler
@@ -85,3 +105,13 @@ void benchmark_resamp_crcf_P17_Q64  RESAMP_CRCF_BENCHMARK_API(17,  64)
 void benchmark_resamp_crcf_P17_Q128 RESAMP_CRCF_BENCHMARK_API(17, 128)
 void benchmark_resamp_crcf_P17_Q256 RESAMP_CRCF_BENCHMARK_API(17, 256)
 
+
+//
+// Large blocks, single-sample execution vs. block execution
+//
+void benchmark_resamp_crcf_P256_Q64_loop    RESAMP_CRCF_BENCHMARK_LOOP_API(256,   64)
+void benchmark_resamp_crcf_P256_Q64_block   RESAMP_CRCF_BENCHMARK_API     (256,   64)
+void benchmark_resamp_crcf_P256_Q256_loop   RESAMP_CRCF_BENCHMARK_LOOP_API(256,  256)
+void benchmark_resamp_crcf_P256_Q256_block  RESAMP_CRCF_BENCHMARK_API     (256,  256)
+void benchmark_resamp_crcf_P256_Q1024_loop  RESAMP_CRCF_BENCHMARK_LOOP_API(256, 1024)
+void benchmark_resamp_crcf_P256_Q1024_block RESAMP_CRCF_BENCHMARK_API     (256, 1024)
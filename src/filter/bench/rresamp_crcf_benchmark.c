@@ -65,6 +65,49 @@ void rresamp_crcf_bench(struct rusage *     _start,
     rresamp_crcf_destroy(q);
 }
 
+// Helper function for running many blocks in a single call
+void rresamp_crcf_block_bench(struct rusage *     _start,
+                              struct rusage *     _finish,
+                              unsigned long int * _num_iterations,
+                              unsigned int        _P,
+                              unsigned int        _Q,
+                              unsigned int        _num_blocks)
+{
+    // adjust number of iterations: cycles/trial ~ 40 P per block
+    *_num_iterations /= 40*_P*_num_blocks;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // create resampling object
+    unsigned int m  = 12;
+    float        bw = 0.45f;
+    float        As = 60.0f;
+    rresamp_crcf q = rresamp_crcf_create_kaiser(_P,_Q,m,bw,As);
+
+    // input/output buffers
+    unsigned int    nx = _Q*_num_blocks;
+    unsigned int    ny = _P*_num_blocks;
+    float complex * x  = (float complex*) malloc(nx*sizeof(float complex));
+    float complex * y  = (float complex*) malloc(ny*sizeof(float complex));
+
+    // initialize buffer
+    unsigned long int i;
+    for (i=0; i<nx; i++)
+        x[i] = i==0 ? 1.0 : 0.0;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        rresamp_crcf_execute_block(q, x, _num_blocks, y);
+        x[0] = y[0];
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= _num_blocks;
+
+    free(x);
+    free(y);
+    rresamp_crcf_destroy(q);
+}
+
 #define RRESAMP_CRCF_BENCHMARK_API(P,Q) \
 (   struct rusage *_start,              \
     struct rusage *_finish,             \
@@ -84,3 +127,17 @@ void benchmark_rresamp_crcf_P17_Q64  RRESAMP_CRCF_BENCHMARK_API(17,  64)
 void benchmark_rresamp_crcf_P17_Q128 RRESAMP_CRCF_BENCHMARK_API(17, 128)
 void benchmark_rresamp_crcf_P17_Q256 RRESAMP_CRCF_BENCHMARK_API(17, 256)
 
+
+#define RRESAMP_CRCF_BLOCK_BENCHMARK_API(P,Q,N) \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ rresamp_crcf_block_bench(_start, _finish, _num_iterations, P, Q, N); }
+
+//
+// Common fixed-ratio conversions, many blocks per call
+//
+void benchmark_rresamp_crcf_block_P147_Q160 RRESAMP_CRCF_BLOCK_BENCHMARK_API(147, 160,  16)
+void benchmark_rresamp_crcf_block_P160_Q147 RRESAMP_CRCF_BLOCK_BENCHMARK_API(160, 147,  16)
+void benchmark_rresamp_crcf_block_P24_Q25   RRESAMP_CRCF_BLOCK_BENCHMARK_API( 24,  25, 100)
+void benchmark_rresamp_crcf_block_P3_Q2     RRESAMP_CRCF_BLOCK_BENCHMARK_API(  3,   2, 800)
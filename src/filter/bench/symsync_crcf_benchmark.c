@@ -28,7 +28,8 @@ void symsync_crcf_bench(struct rusage *     _start,
                         struct rusage *     _finish,
                         unsigned long int * _num_iterations,
                         unsigned int        _k,
-                        unsigned int        _m)
+                        unsigned int        _m,
+                        unsigned int        _block_len)
 {
     unsigned long int i;
     unsigned int npfb = 16;     // number of filters in bank
@@ -55,12 +56,16 @@ void symsync_crcf_bench(struct rusage *     _start,
     msequence_destroy(ms);
 
     // start trials
+    unsigned int n;
     getrusage(RUSAGE_SELF, _start);
     for (i=0; i<(*_num_iterations); i++) {
-        symsync_crcf_execute(q, x, num_samples, y, &num_written);
-        symsync_crcf_execute(q, x, num_samples, y, &num_written);
-        symsync_crcf_execute(q, x, num_samples, y, &num_written);
-        symsync_crcf_execute(q, x, num_samples, y, &num_written);
+        // run through input in blocks of specified length
+        for (n=0; n<num_samples; n+=_block_len) {
+            symsync_crcf_execute(q, x+n, _block_len, y, &num_written);
+            symsync_crcf_execute(q, x+n, _block_len, y, &num_written);
+            symsync_crcf_execute(q, x+n, _block_len, y, &num_written);
+            symsync_crcf_execute(q, x+n, _block_len, y, &num_written);
+        }
     }
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4 * num_samples;
@@ -68,17 +73,21 @@ void symsync_crcf_bench(struct rusage *     _start,
     symsync_crcf_destroy(q);
 }
 
-#define SYMSYNC_CRCF_BENCHMARK_API(K,M)     \
+#define SYMSYNC_CRCF_BENCHMARK_API(K,M,B)   \
 (   struct rusage *_start,                  \
     struct rusage *_finish,                 \
     unsigned long int *_num_iterations)     \
-{ symsync_crcf_bench(_start, _finish, _num_iterations, K, M); }
+{ symsync_crcf_bench(_start, _finish, _num_iterations, K, M, B); }
 
 // 
 // BENCHMARKS
 //
-void benchmark_symsync_crcf_k2_m2   SYMSYNC_CRCF_BENCHMARK_API(2, 2)
-void benchmark_symsync_crcf_k2_m4   SYMSYNC_CRCF_BENCHMARK_API(2, 4)
-void benchmark_symsync_crcf_k2_m8   SYMSYNC_CRCF_BENCHMARK_API(2, 8)
-void benchmark_symsync_crcf_k2_m16  SYMSYNC_CRCF_BENCHMARK_API(2, 16)
+void benchmark_symsync_crcf_k2_m2   SYMSYNC_CRCF_BENCHMARK_API(2, 2,  64)
+void benchmark_symsync_crcf_k2_m4   SYMSYNC_CRCF_BENCHMARK_API(2, 4,  64)
+void benchmark_symsync_crcf_k2_m8   SYMSYNC_CRCF_BENCHMARK_API(2, 8,  64)
+void benchmark_symsync_crcf_k2_m16  SYMSYNC_CRCF_BENCHMARK_API(2, 16, 64)
+void benchmark_symsync_crcf_k4_m4   SYMSYNC_CRCF_BENCHMARK_API(4, 4,  64)
+
+// one sample per call (e.g. symtrack)
+void benchmark_symsync_crcf_k2_m4_single SYMSYNC_CRCF_BENCHMARK_API(2, 4, 1)
 
@@ -38,9 +38,11 @@
 #define FIRFILT(name)       LIQUID_CONCAT(firfilt_crcf,name)
 #define FIRINTERP(name)     LIQUID_CONCAT(firinterp_crcf,name)
 #define FIRPFB(name)        LIQUID_CONCAT(firpfb_crcf,name)
+#define FRESAMP(name)       LIQUID_CONCAT(fresamp_crcf,name)
 #define IIRDECIM(name)      LIQUID_CONCAT(iirdecim_crcf,name)
 #define IIRFILT(name)       LIQUID_CONCAT(iirfilt_crcf,name)
 #define IIRFILTSOS(name)    LIQUID_CONCAT(iirfiltsos_crcf,name)
+#define IIRFILTBANK(name)   LIQUID_CONCAT(iirfiltbank_crcf,name)
 #define IIRINTERP(name)     LIQUID_CONCAT(iirinterp_crcf,name)
 #define MSRESAMP(name)      LIQUID_CONCAT(msresamp_crcf,name)
 #define MSRESAMP2(name)     LIQUID_CONCAT(msresamp2_crcf,name)
@@ -74,9 +76,11 @@
 #include "firfilt.c"
 #include "firinterp.c"
 #include "firpfb.c"
+#include "fresamp.c"
 #include "iirdecim.c"
 #include "iirfilt.c"
 #include "iirfiltsos.c"
+#include "iirfiltbank.c"
 #include "iirinterp.c"
 #include "msresamp.c"
 #include "msresamp2.c"
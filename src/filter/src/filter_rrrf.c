@@ -39,9 +39,11 @@
 #define FIRINTERP(name)     LIQUID_CONCAT(firinterp_rrrf,name)
 #define FIRHILB(name)       LIQUID_CONCAT(firhilbf,name)
 #define FIRPFB(name)        LIQUID_CONCAT(firpfb_rrrf,name)
+#define FRESAMP(name)       LIQUID_CONCAT(fresamp_rrrf,name)
 #define IIRDECIM(name)      LIQUID_CONCAT(iirdecim_rrrf,name)
 #define IIRFILT(name)       LIQUID_CONCAT(iirfilt_rrrf,name)
 #define IIRFILTSOS(name)    LIQUID_CONCAT(iirfiltsos_rrrf,name)
+#define IIRFILTBANK(name)   LIQUID_CONCAT(iirfiltbank_rrrf,name)
 #define IIRHILB(name)       LIQUID_CONCAT(iirhilbf,name)
 #define IIRINTERP(name)     LIQUID_CONCAT(iirinterp_rrrf,name)
 #define MSRESAMP(name)      LIQUID_CONCAT(msresamp_rrrf,name)
@@ -77,9 +79,11 @@
 #include "firinterp.c"
 #include "firhilb.c"
 #include "firpfb.c"
+#include "fresamp.c"
 #include "iirdecim.c"
 #include "iirfilt.c"
 #include "iirfiltsos.c"
+#include "iirfiltbank.c"
 #include "iirhilb.c"
 #include "iirinterp.c"
 #include "msresamp.c"
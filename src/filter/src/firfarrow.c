@@ -202,7 +202,7 @@ void FIRFARROW(_set_delay)(FIRFARROW() _q,
     for (i=0; i<_q->h_len; i++) {
         // compute filter tap from polynomial using negative
         // value for _mu
-        _q->h[i] = POLY(_val)(_q->P+n, _q->Q, -_mu);
+        _q->h[i] = POLY(_val)(_q->P+n, _q->Q+1, -_mu);
 
         // normalize filter by inverse of DC response
         _q->h[i] *= _q->gamma;
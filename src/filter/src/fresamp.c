@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Arbitrary resampler (Farrow structure)
+//
+// Each tap of the interpolating filter is a polynomial in the fractional
+// sample offset (from firfarrow); rather than storing a bank of filters,
+// each output is computed as the dot product of the input window with
+// every polynomial coefficient column, combined with Horner's method.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+#include <xmmintrin.h>
+#endif
+
+// maximum polynomial order
+#define FRESAMP_MAX_ORDER   (7)
+
+// number of coefficient values per filter tap in interleaved layout (a
+// multiple of four so each tap is a whole number of SSE registers)
+#if TI_COMPLEX
+#  define FRESAMP_TAP_STRIDE(Q) (4*(((Q)+2)/2))     // (re,im) pairs
+#else
+#  define FRESAMP_TAP_STRIDE(Q) (4*(((Q)+4)/4))
+#endif
+
+// main object
+struct FRESAMP(_s) {
+    // filter design parameters
+    unsigned int    m;      // filter semi-length, h_len = 2*m
+    unsigned int    Q;      // polynomial order
+    float           fc;     // filter cutoff frequency
+    float           As;     // filter stop-band attenuation
+
+    // polynomial coefficients, interleaved by tap (see _eval)
+    unsigned int    h_len;  // filter length
+    unsigned int    stride; // values per tap
+    float *         P;      // coefficients [size: h_len x stride]
+    float           G[FRESAMP_MAX_ORDER+1]; // DC gain polynomial
+
+    // internal state variables
+    float           r;      // resampling rate
+    int64_t         step;   // output stride (fixed point, 2^24 per input sample)
+    int64_t         phase;  // time of next output relative to most recent input
+    float           tau;    // timing phase offset
+    WINDOW()        w;      // input buffer [size: h_len+1]
+};
+
+// compute output at fractional offset from window center
+//  _q      :   resampler object
+//  _r      :   input window, oldest sample first [size: h_len x 1]
+//  _mu     :   polynomial argument, -0.5 <= _mu <= 0.5
+//  _y      :   output sample pointer
+void FRESAMP(_eval)(FRESAMP() _q,
+                    TI *      _r,
+                    float     _mu,
+                    TO *      _y);
+
+// run timing loop for most recent input
+//  _q      :   resampler object
+//  _r      :   input window ending with most recent input, with one
+//              additional sample of history at _r[-1]
+//  _y      :   output array
+//  returns number of samples written
+unsigned int FRESAMP(_step)(FRESAMP() _q,
+                            TI *      _r,
+                            TO *      _y);
+
+// create Farrow arbitrary resampler
+//  _rate   :   resampling rate
+//  _m      :   filter semi-length (delay)
+//  _order  :   polynomial order
+//  _fc     :   filter cutoff frequency, fc in (0, 0.5)
+//  _As     :   filter stop-band attenuation [dB]
+FRESAMP() FRESAMP(_create)(float        _rate,
+                           unsigned int _m,
+                           unsigned int _order,
+                           float        _fc,
+                           float        _As)
+{
+    // validate input
+    if (_rate <= 0) {
+        fprintf(stderr,"error: fresamp_%s_create(), resampling rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_m == 0) {
+        fprintf(stderr,"error: fresamp_%s_create(), filter semi-length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_order < 1 || _order > FRESAMP_MAX_ORDER) {
+        fprintf(stderr,"error: fresamp_%s_create(), polynomial order must be in [1,%u]\n", EXTENSION_FULL, FRESAMP_MAX_ORDER);
+        exit(1);
+    } else if (_fc <= 0.0f || _fc >= 0.5f) {
+        fprintf(stderr,"error: fresamp_%s_create(), filter cutoff must be in (0,0.5)\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_As <= 0.0f) {
+        fprintf(stderr,"error: fresamp_%s_create(), filter stop-band suppression must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // allocate memory for resampler
+    FRESAMP() q = (FRESAMP()) malloc(sizeof(struct FRESAMP(_s)));
+    q->m      = _m;
+    q->Q      = _order;
+    q->fc     = _fc;
+    q->As     = _As;
+    q->h_len  = 2*_m;
+    q->stride = FRESAMP_TAP_STRIDE(q->Q);
+
+    // design polynomials; the DC gain of the filter varies with the
+    // fractional offset so keep its polynomial (the sum of the tap
+    // polynomials) to normalize each output rather than only scaling
+    // by the gain at zero offset
+    FIRFARROW() f = FIRFARROW(_create)(q->h_len, q->Q, q->fc, q->As);
+    q->P = (float*) calloc(q->h_len*q->stride, sizeof(float));
+    unsigned int i, j;
+    for (j=0; j<=q->Q; j++)
+        q->G[j] = 0.0f;
+    for (i=0; i<q->h_len; i++) {
+        for (j=0; j<=q->Q; j++) {
+            float p = f->P[i*(q->Q+1) + j];
+            q->G[j] += p;
+#if TI_COMPLEX
+            q->P[i*q->stride + 2*j + 0] = p;
+            q->P[i*q->stride + 2*j + 1] = p;
+#else
+            q->P[i*q->stride + j] = p;
+#endif
+        }
+    }
+    FIRFARROW(_destroy)(f);
+
+    // create input buffer (with one extra sample of history for
+    // negative timing adjustments)
+    q->w = WINDOW(_create)(q->h_len + 1);
+
+    // set rate and reset object
+    FRESAMP(_set_rate)(q, _rate);
+    FRESAMP(_reset)(q);
+    return q;
+}
+
+// create Farrow arbitrary resampler with default parameters
+//  _rate   :   resampling rate
+FRESAMP() FRESAMP(_create_default)(float _rate)
+{
+    // validate input
+    if (_rate <= 0) {
+        fprintf(stderr,"error: fresamp_%s_create_default(), resampling rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // default parameters
+    unsigned int m     = 8;
+    unsigned int order = 3;
+    float        fc    = _rate < 1.0f ? 0.45f*_rate : 0.45f;
+    float        As    = 60.0f;
+
+    // create and return object
+    return FRESAMP(_create)(_rate, m, order, fc, As);
+}
+
+// free resampler object
+void FRESAMP(_destroy)(FRESAMP() _q)
+{
+    WINDOW(_destroy)(_q->w);
+    free(_q->P);
+    free(_q);
+}
+
+// print resampler object
+void FRESAMP(_print)(FRESAMP() _q)
+{
+    printf("fresamp [rate: %f, m=%u, order=%u, fc=%.3f, As=%.1f dB]\n",
+            _q->r, _q->m, _q->Q, _q->fc, _q->As);
+}
+
+// reset resampler object
+void FRESAMP(_reset)(FRESAMP() _q)
+{
+    WINDOW(_reset)(_q->w);
+    _q->phase = 0;
+    _q->tau   = 0.0f;
+}
+
+// get resampler filter delay (semi-length m)
+unsigned int FRESAMP(_get_delay)(FRESAMP() _q)
+{
+    return _q->m;
+}
+
+// set rate of arbitrary resampler
+//  _q      : resampling object
+//  _rate   : new sampling rate, _rate > 0
+void FRESAMP(_set_rate)(FRESAMP() _q,
+                        float     _rate)
+{
+    if (_rate <= 0) {
+        fprintf(stderr,"error: fresamp_%s_set_rate(), resampling rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // set internal rate and output stride
+    _q->r    = _rate;
+    _q->step = (int64_t)llround((double)(1<<24) / (double)_q->r);
+    if (_q->step < 1)
+        _q->step = 1;
+}
+
+// get rate of arbitrary resampler
+float FRESAMP(_get_rate)(FRESAMP() _q)
+{
+    return _q->r;
+}
+
+// adjust resampling rate
+//  _q      : resampling object
+//  _gamma  : rate adjustment factor: rate <- rate * gamma, _gamma > 0
+void FRESAMP(_adjust_rate)(FRESAMP() _q,
+                           float     _gamma)
+{
+    if (_gamma <= 0) {
+        fprintf(stderr,"error: fresamp_%s_adjust_rate(), resampling adjustment (%12.4e) must be greater than zero\n", EXTENSION_FULL, _gamma);
+        exit(1);
+    }
+    FRESAMP(_set_rate)(_q, _q->r * _gamma);
+}
+
+// set resampling timing phase; positive values delay sampling instants
+//  _q      : resampling object
+//  _tau    : sample timing phase, -1 <= _tau <= 1
+void FRESAMP(_set_timing_phase)(FRESAMP() _q,
+                                float     _tau)
+{
+    if (_tau < -1.0f || _tau > 1.0f) {
+        fprintf(stderr,"error: fresamp_%s_set_timing_phase(), timing phase must be in [-1,1], is %f\n.",
+                EXTENSION_FULL, _tau);
+        exit(1);
+    }
+    FRESAMP(_adjust_timing_phase)(_q, _tau - _q->tau);
+}
+
+// adjust resampling timing phase
+//  _q      : resampling object
+//  _delta  : sample timing adjustment, -1 <= _delta <= 1
+void FRESAMP(_adjust_timing_phase)(FRESAMP() _q,
+                                   float     _delta)
+{
+    if (_delta < -1.0f || _delta > 1.0f) {
+        fprintf(stderr,"error: fresamp_%s_adjust_timing_phase(), timing phase adjustment must be in [-1,1], is %f\n.",
+                EXTENSION_FULL, _delta);
+        exit(1);
+    }
+
+    // shift next sampling instant; instants can be at most one sample
+    // before the most recent input
+    _q->tau   += _delta;
+    _q->phase += (int64_t)llroundf(_delta * (float)(1<<24));
+    if (_q->phase < -(1<<24))
+        _q->phase = -(1<<24);
+}
+
+// get exact number of output samples that will be produced by the
+// next _num_input input samples given the current state
+//  _q          :   resampling object
+//  _num_input  :   number of input samples
+unsigned int FRESAMP(_get_num_output)(FRESAMP()    _q,
+                                      unsigned int _num_input)
+{
+    // outputs are produced at phase + k*step < num_input * 2^24
+    int64_t end = (int64_t)_num_input << 24;
+    if (end <= _q->phase)
+        return 0;
+    return (unsigned int)((end - _q->phase + _q->step - 1) / _q->step);
+}
+
+// run arbitrary resampler on single input
+//  _q          :   resampling object
+//  _x          :   single input sample
+//  _y          :   output array
+//  _num_written:   number of samples written to output
+void FRESAMP(_execute)(FRESAMP()      _q,
+                       TI             _x,
+                       TO *           _y,
+                       unsigned int * _num_written)
+{
+    TI * r;
+    WINDOW(_push)(_q->w, _x);
+    WINDOW(_read)(_q->w, &r);
+    *_num_written = FRESAMP(_step)(_q, r+1, _y);
+}
+
+// execute arbitrary resampler on a block of samples
+//  _q      :   resampling object
+//  _x      :   input buffer [size: _nx x 1]
+//  _nx     :   input buffer size
+//  _y      :   output sample array
+//  _ny     :   number of samples written to _y
+void FRESAMP(_execute_block)(FRESAMP()      _q,
+                             TI *           _x,
+                             unsigned int   _nx,
+                             TO *           _y,
+                             unsigned int * _ny)
+{
+    unsigned int ny = 0;
+    unsigned int num_written;
+    unsigned int L = _q->h_len;
+
+    // fill window from first inputs until a full window (plus one sample
+    // of history) is available in the input buffer itself
+    unsigned int i;
+    unsigned int n0 = _nx < L+1 ? _nx : L+1;
+    for (i=0; i<n0; i++) {
+        FRESAMP(_execute)(_q, _x[i], &_y[ny], &num_written);
+        ny += num_written;
+    }
+
+    if (_nx > n0) {
+        // operate directly on input buffer, then save most recent samples
+        for (i=n0; i<_nx; i++)
+            ny += FRESAMP(_step)(_q, _x + i - L + 1, &_y[ny]);
+        WINDOW(_reset)(_q->w);
+        WINDOW(_write)(_q->w, _x + _nx - L - 1, L + 1);
+    }
+
+    *_ny = ny;
+}
+
+//
+// internal methods
+//
+
+// run timing loop for most recent input
+unsigned int FRESAMP(_step)(FRESAMP() _q,
+                            TI *      _r,
+                            TO *      _y)
+{
+    unsigned int n = 0;
+    float g = 1.0f / (float)(1<<24);
+    while (_q->phase < (1<<24)) {
+        // sampling instant is 'phase' after the sample one filter
+        // semi-length before the most recent input; use previous window
+        // for instants preceding it
+        if (_q->phase < 0)
+            FRESAMP(_eval)(_q, _r-1, 0.5f - g*(float)(_q->phase + (1<<24)), &_y[n++]);
+        else
+            FRESAMP(_eval)(_q, _r,   0.5f - g*(float)(_q->phase),           &_y[n++]);
+        _q->phase += _q->step;
+    }
+    _q->phase -= (1<<24);
+    return n;
+}
+
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+// accumulate polynomial coefficient columns over input window, two taps
+// per iteration (filter length is always even)
+//  _P      :   interleaved coefficients [size: _n x 4*_A]
+//  _r      :   input window [size: _n x 1]
+//  _n      :   filter length
+//  _A      :   number of SSE registers per tap, _A <= 4
+//  _c      :   output column sums [size: 4*_A x 1]
+static inline void FRESAMP(_accumulate_sse)(float *      _P,
+                                            TI *         _r,
+                                            unsigned int _n,
+                                            unsigned int _A,
+                                            float *      _c)
+{
+    unsigned int i, j;
+    __m128 acc0[4], acc1[4];
+    for (j=0; j<_A; j++) {
+        acc0[j] = _mm_setzero_ps();
+        acc1[j] = _mm_setzero_ps();
+    }
+    for (i=0; i<_n; i+=2) {
+#if TI_COMPLEX
+        // { re0, im0, re1, im1 } -> { re0, im0, re0, im0 }, { re1, ... }
+        __m128 v  = _mm_loadu_ps((float*)(_r + i));
+        __m128 v0 = _mm_movelh_ps(v, v);
+        __m128 v1 = _mm_movehl_ps(v, v);
+#else
+        __m128 v0 = _mm_set1_ps(_r[i  ]);
+        __m128 v1 = _mm_set1_ps(_r[i+1]);
+#endif
+        for (j=0; j<_A; j++) {
+            acc0[j] = _mm_add_ps(acc0[j], _mm_mul_ps(_mm_loadu_ps(_P +        4*j), v0));
+            acc1[j] = _mm_add_ps(acc1[j], _mm_mul_ps(_mm_loadu_ps(_P + 4*_A + 4*j), v1));
+        }
+        _P += 8*_A;
+    }
+    for (j=0; j<_A; j++)
+        _mm_storeu_ps(_c + 4*j, _mm_add_ps(acc0[j], acc1[j]));
+}
+#endif
+
+// compute output at fractional offset from window center; the
+// polynomial coefficient columns are accumulated in a single pass over
+// the window, then combined with Horner's method
+void FRESAMP(_eval)(FRESAMP() _q,
+                    TI *      _r,
+                    float     _mu,
+                    TO *      _y)
+{
+    unsigned int j;
+    unsigned int Q = _q->Q;
+    float * P = _q->P;
+    float c[16];    // column sums (at most four SSE registers)
+
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+    // dispatch on number of registers per tap so the accumulators of
+    // the inlined kernel can be kept in registers
+    switch (_q->stride / 4) {
+    case 1: FRESAMP(_accumulate_sse)(P, _r, _q->h_len, 1, c); break;
+    case 2: FRESAMP(_accumulate_sse)(P, _r, _q->h_len, 2, c); break;
+    case 3: FRESAMP(_accumulate_sse)(P, _r, _q->h_len, 3, c); break;
+    default:FRESAMP(_accumulate_sse)(P, _r, _q->h_len, 4, c); break;
+    }
+#else
+    unsigned int i;
+    for (j=0; j<_q->stride; j++)
+        c[j] = 0.0f;
+    for (i=0; i<_q->h_len; i++) {
+#if TI_COMPLEX
+        float vr = crealf(_r[i]);
+        float vi = cimagf(_r[i]);
+        for (j=0; j<=Q; j++) {
+            c[2*j+0] += P[2*j] * vr;
+            c[2*j+1] += P[2*j] * vi;
+        }
+#else
+        for (j=0; j<=Q; j++)
+            c[j] += P[j] * _r[i];
+#endif
+        P += _q->stride;
+    }
+#endif
+
+    // evaluate output and gain polynomials at _mu
+    float g = _q->G[Q];
+#if TI_COMPLEX
+    float yr = c[2*Q+0];
+    float yi = c[2*Q+1];
+    for (j=Q; j>0; j--) {
+        yr = yr*_mu + c[2*(j-1)+0];
+        yi = yi*_mu + c[2*(j-1)+1];
+        g  = g *_mu + _q->G[j-1];
+    }
+    g = 1.0f / g;
+    *_y = yr*g + _Complex_I*yi*g;
+#else
+    float y = c[Q];
+    for (j=Q; j>0; j--) {
+        y = y*_mu + c[j-1];
+        g = g*_mu + _q->G[j-1];
+    }
+    *_y = y / g;
+#endif
+}
@@ -143,16 +143,8 @@ void IIRDECIM(_execute)(IIRDECIM()   _q,
                         TI *         _x,
                         TO *         _y)
 {
-    TO v; // output value
-    unsigned int i;
-    for (i=0; i<_q->M; i++) {
-        // run filter
-        IIRFILT(_execute)(_q->iirfilt, _x[i], &v);
-
-        // save output at appropriate index
-        if (i==0)
-            *_y = v;
-    }
+    // run filter on all _M inputs, retaining first output
+    IIRDECIM(_execute_block)(_q, _x, 1, _y);
 }
 
 // execute decimator on block of _n*_M input samples
@@ -165,10 +157,15 @@ void IIRDECIM(_execute_block)(IIRDECIM()   _q,
                               unsigned int _n,
                               TO *         _y)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++) {
-        // execute _M input samples computing just one output each time
-        IIRDECIM(_execute)(_q, &_x[i*_q->M], &_y[i]);
+    // filter input in chunks, keeping every _M-th output
+    unsigned int num_chunk = _q->M < 256 ? 256 / _q->M : 1;
+    TO buf[num_chunk * _q->M];
+    unsigned int i, j;
+    for (i=0; i<_n; i+=num_chunk) {
+        unsigned int n = _n - i < num_chunk ? _n - i : num_chunk;
+        IIRFILT(_execute_block)(_q->iirfilt, &_x[i*_q->M], n*_q->M, buf);
+        for (j=0; j<n; j++)
+            _y[i+j] = buf[j*_q->M];
     }
 }
 
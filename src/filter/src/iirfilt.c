@@ -590,9 +590,27 @@ void IIRFILT(_execute_block)(IIRFILT()    _q,
                              TO *         _y)
 {
     unsigned int i;
-    for (i=0; i<_n; i++)
-        // compute output sample
-        IIRFILT(_execute)(_q, _x[i], &_y[i]);
+    if (_q->type == IIRFILT_TYPE_SOS) {
+        // run cascade of second-order sections on entire block
+        IIRFILTSOS(_execute_cascade_block)(_q->qsos, _q->nsos, _x, _n, _y);
+    } else if (_q->na == 2 && _q->nb == 2) {
+        // first-order filter (e.g. dc blocker): keep state in registers
+        TC a1 = _q->a[1];
+        TC b0 = _q->b[0];
+        TC b1 = _q->b[1];
+        TI v1 = _q->v[0];
+        for (i=0; i<_n; i++) {
+            TI v0 = _x[i] - a1*v1;
+            _y[i] = b0*v0 + b1*v1;
+            v1 = v0;
+        }
+        // v[1] is overwritten before it is read by the next execute
+        _q->v[0] = v1;
+    } else {
+        for (i=0; i<_n; i++)
+            // compute output sample
+            IIRFILT(_execute)(_q, _x[i], &_y[i]);
+    }
 }
 
 
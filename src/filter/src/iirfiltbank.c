@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// iirfiltbank.c
+//
+// bank of identical infinite impulse response filters operating on
+// independent channels
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+#include <xmmintrin.h>
+#endif
+
+// defined:
+//  IIRFILTBANK()   name-mangling macro
+//  TO              output type
+//  TC              coefficients type
+//  TI              input type
+//  PRINTVAL()      print macro
+
+// Channels are processed in parallel: with real-valued coefficients
+// the state of each channel (and each real/imaginary component) is
+// independent so that adjacent channels occupy adjacent SIMD lanes,
+// each lane performing exactly the same operations as the direct
+// form II second-order section in iirfiltsos.
+#if TC_COMPLEX==0
+#  define IIRFILTBANK_TE        float   // element type
+#  define IIRFILTBANK_WIDTH(C)  ((C)*(TI_COMPLEX ? 2 : 1))
+#else
+#  define IIRFILTBANK_TE        TO
+#  define IIRFILTBANK_WIDTH(C)  (C)
+#endif
+
+struct IIRFILTBANK(_s) {
+    unsigned int num_channels;  // number of channels
+    unsigned int nsos;          // number of second-order sections
+    unsigned int width;         // number of state elements per time step
+    TC * b;                     // feed-forward coefficients [nsos x 3]
+    TC * a;                     // feed-back coefficients    [nsos x 3]
+    IIRFILTBANK_TE * v;         // state, [2*nsos x width]
+};
+
+// execute filter bank on block of samples for elements [_j0,_j1)
+void IIRFILTBANK(_execute_scalar)(IIRFILTBANK()    _q,
+                                  IIRFILTBANK_TE * _x,
+                                  unsigned int     _n,
+                                  IIRFILTBANK_TE * _y,
+                                  unsigned int     _j0,
+                                  unsigned int     _j1);
+
+#if HAVE_SSE && HAVE_XMMINTRIN_H && TC_COMPLEX==0
+// execute filter bank on block of samples for elements [0,_j1) in
+// groups of four
+void IIRFILTBANK(_execute_sse)(IIRFILTBANK()    _q,
+                               IIRFILTBANK_TE * _x,
+                               unsigned int     _n,
+                               IIRFILTBANK_TE * _y,
+                               unsigned int     _j1);
+#endif
+
+// create filter bank from second-order sections
+//  _B              : feed-forward coefficients [size: _nsos x 3]
+//  _A              : feed-back coefficients    [size: _nsos x 3]
+//  _nsos           : number of second-order sections
+//  _num_channels   : number of channels
+IIRFILTBANK() IIRFILTBANK(_create_sos)(TC *         _B,
+                                       TC *         _A,
+                                       unsigned int _nsos,
+                                       unsigned int _num_channels)
+{
+    // validate input
+    if (_nsos == 0) {
+        fprintf(stderr,"error: iirfiltbank_%s_create_sos(), filter must have at least one 2nd-order section\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_num_channels == 0) {
+        fprintf(stderr,"error: iirfiltbank_%s_create_sos(), number of channels must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create structure and initialize
+    IIRFILTBANK() q = (IIRFILTBANK()) malloc(sizeof(struct IIRFILTBANK(_s)));
+    q->num_channels = _num_channels;
+    q->nsos         = _nsos;
+    q->width        = IIRFILTBANK_WIDTH(_num_channels);
+
+    // copy coefficients, normalizing each section to a[0]
+    q->b = (TC *) malloc(3*q->nsos*sizeof(TC));
+    q->a = (TC *) malloc(3*q->nsos*sizeof(TC));
+    unsigned int i, k;
+    for (i=0; i<q->nsos; i++) {
+        TC a0 = _A[3*i];
+        for (k=0; k<3; k++) {
+            q->b[3*i+k] = _B[3*i+k] / a0;
+            q->a[3*i+k] = _A[3*i+k] / a0;
+        }
+    }
+
+    // allocate state and reset
+    q->v = (IIRFILTBANK_TE *) malloc(2*q->nsos*q->width*sizeof(IIRFILTBANK_TE));
+    IIRFILTBANK(_reset)(q);
+    return q;
+}
+
+// create filter bank from design template
+//  _ftype          : filter type (e.g. LIQUID_IIRDES_BUTTER)
+//  _btype          : band type (e.g. LIQUID_IIRDES_BANDPASS)
+//  _order          : filter order
+//  _fc             : low-pass prototype cut-off frequency
+//  _f0             : center frequency (band-pass, band-stop)
+//  _Ap             : pass-band ripple in dB
+//  _As             : stop-band ripple in dB
+//  _num_channels   : number of channels
+IIRFILTBANK() IIRFILTBANK(_create_prototype)(liquid_iirdes_filtertype _ftype,
+                                             liquid_iirdes_bandtype   _btype,
+                                             unsigned int             _order,
+                                             float                    _fc,
+                                             float                    _f0,
+                                             float                    _Ap,
+                                             float                    _As,
+                                             unsigned int             _num_channels)
+{
+    // derived values : compute number of second-order sections
+    unsigned int N = _order; // effective order
+    if (_btype == LIQUID_IIRDES_BANDPASS ||
+        _btype == LIQUID_IIRDES_BANDSTOP)
+    {
+        N *= 2;
+    }
+    unsigned int r = N%2;       // odd/even order
+    unsigned int L = (N-r)/2;   // filter semi-length
+    unsigned int h_len = 3*(L+r);
+
+    // design filter (compute coefficients)
+    float B[h_len];
+    float A[h_len];
+    liquid_iirdes(_ftype, _btype, LIQUID_IIRDES_SOS, _order, _fc, _f0, _Ap, _As, B, A);
+
+    // move coefficients to type-specific arrays (e.g. float complex)
+    TC Bc[h_len];
+    TC Ac[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++) {
+        Bc[i] = B[i];
+        Ac[i] = A[i];
+    }
+
+    return IIRFILTBANK(_create_sos)(Bc, Ac, L+r, _num_channels);
+}
+
+// destroy filter bank object, freeing all internal memory
+void IIRFILTBANK(_destroy)(IIRFILTBANK() _q)
+{
+    free(_q->b);
+    free(_q->a);
+    free(_q->v);
+    free(_q);
+}
+
+// print filter bank object properties
+void IIRFILTBANK(_print)(IIRFILTBANK() _q)
+{
+    printf("iirfiltbank_%s: %u channels, %u second-order sections\n",
+            EXTENSION_FULL, _q->num_channels, _q->nsos);
+    unsigned int i;
+    for (i=0; i<_q->nsos; i++) {
+        printf("  b[%3u] :", i);
+        PRINTVAL_TC(_q->b[3*i+0],%12.8f);
+        PRINTVAL_TC(_q->b[3*i+1],%12.8f);
+        PRINTVAL_TC(_q->b[3*i+2],%12.8f);
+        printf("\n");
+        printf("  a[%3u] :", i);
+        PRINTVAL_TC(_q->a[3*i+0],%12.8f);
+        PRINTVAL_TC(_q->a[3*i+1],%12.8f);
+        PRINTVAL_TC(_q->a[3*i+2],%12.8f);
+        printf("\n");
+    }
+}
+
+// reset internal state of all channels
+void IIRFILTBANK(_reset)(IIRFILTBANK() _q)
+{
+    memset(_q->v, 0x00, 2*_q->nsos*_q->width*sizeof(IIRFILTBANK_TE));
+}
+
+// get number of channels
+unsigned int IIRFILTBANK(_get_num_channels)(IIRFILTBANK() _q)
+{
+    return _q->num_channels;
+}
+
+// execute filter bank on one sample from each channel
+//  _q      : filter bank object
+//  _x      : input array [size: num_channels x 1]
+//  _y      : output array [size: num_channels x 1]
+void IIRFILTBANK(_execute)(IIRFILTBANK() _q,
+                           TI *          _x,
+                           TO *          _y)
+{
+    IIRFILTBANK(_execute_block)(_q, _x, 1, _y);
+}
+
+// execute filter bank on block of samples; the input and output
+// arrays may be the same
+//  _q      : filter bank object
+//  _x      : input array, time-major [size: _n x num_channels]
+//  _n      : number of time steps
+//  _y      : output array, time-major [size: _n x num_channels]
+void IIRFILTBANK(_execute_block)(IIRFILTBANK() _q,
+                                 TI *          _x,
+                                 unsigned int  _n,
+                                 TO *          _y)
+{
+    IIRFILTBANK_TE * x = (IIRFILTBANK_TE *) _x;
+    IIRFILTBANK_TE * y = (IIRFILTBANK_TE *) _y;
+    unsigned int j = 0;
+#if HAVE_SSE && HAVE_XMMINTRIN_H && TC_COMPLEX==0
+    // process groups of four elements in parallel
+    j = _q->width - (_q->width % 4);
+    if (j > 0)
+        IIRFILTBANK(_execute_sse)(_q, x, _n, y, j);
+#endif
+    // process remaining elements
+    if (j < _q->width)
+        IIRFILTBANK(_execute_scalar)(_q, x, _n, y, j, _q->width);
+}
+
+// execute filter bank on block of samples for elements [_j0,_j1)
+void IIRFILTBANK(_execute_scalar)(IIRFILTBANK()    _q,
+                                  IIRFILTBANK_TE * _x,
+                                  unsigned int     _n,
+                                  IIRFILTBANK_TE * _y,
+                                  unsigned int     _j0,
+                                  unsigned int     _j1)
+{
+    unsigned int W = _q->width;
+    unsigned int i, j, k;
+    for (j=_j0; j<_j1; j++) {
+        for (i=0; i<_n; i++) {
+            IIRFILTBANK_TE x = _x[i*W + j];
+            for (k=0; k<_q->nsos; k++) {
+                IIRFILTBANK_TE * v1 = &_q->v[(2*k+0)*W + j];
+                IIRFILTBANK_TE * v2 = &_q->v[(2*k+1)*W + j];
+                IIRFILTBANK_TE v0 = x - _q->a[3*k+1]*(*v1) - _q->a[3*k+2]*(*v2);
+                x = _q->b[3*k+0]*v0 + _q->b[3*k+1]*(*v1) + _q->b[3*k+2]*(*v2);
+                *v2 = *v1;
+                *v1 = v0;
+            }
+            _y[i*W + j] = x;
+        }
+    }
+}
+
+#if HAVE_SSE && HAVE_XMMINTRIN_H && TC_COMPLEX==0
+// execute filter bank on block of samples for elements [0,_j1) in
+// groups of four
+void IIRFILTBANK(_execute_sse)(IIRFILTBANK()    _q,
+                               IIRFILTBANK_TE * _x,
+                               unsigned int     _n,
+                               IIRFILTBANK_TE * _y,
+                               unsigned int     _j1)
+{
+    unsigned int W = _q->width;
+    unsigned int nsos = _q->nsos;
+    unsigned int i, j, k;
+
+    // broadcast coefficients
+    __m128 c[5*nsos];
+    for (k=0; k<nsos; k++) {
+        c[5*k+0] = _mm_set1_ps(_q->a[3*k+1]);
+        c[5*k+1] = _mm_set1_ps(_q->a[3*k+2]);
+        c[5*k+2] = _mm_set1_ps(_q->b[3*k+0]);
+        c[5*k+3] = _mm_set1_ps(_q->b[3*k+1]);
+        c[5*k+4] = _mm_set1_ps(_q->b[3*k+2]);
+    }
+
+    __m128 s[2*nsos];
+    for (j=0; j<_j1; j+=4) {
+        // load state for this group of lanes
+        for (k=0; k<2*nsos; k++)
+            s[k] = _mm_loadu_ps(&_q->v[k*W + j]);
+
+        for (i=0; i<_n; i++) {
+            __m128 x = _mm_loadu_ps(&_x[i*W + j]);
+            for (k=0; k<nsos; k++) {
+                __m128 v1 = s[2*k+0];
+                __m128 v2 = s[2*k+1];
+                __m128 v0 = _mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(c[5*k+0], v1)),
+                                                     _mm_mul_ps(c[5*k+1], v2));
+                x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c[5*k+2], v0),
+                                          _mm_mul_ps(c[5*k+3], v1)),
+                                          _mm_mul_ps(c[5*k+4], v2));
+                s[2*k+1] = v1;
+                s[2*k+0] = v0;
+            }
+            _mm_storeu_ps(&_y[i*W + j], x);
+        }
+
+        // save state
+        for (k=0; k<2*nsos; k++)
+            _mm_storeu_ps(&_q->v[k*W + j], s[k]);
+    }
+}
+#endif
+
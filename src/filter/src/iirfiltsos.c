@@ -28,6 +28,10 @@
 #include <string.h>
 #include <stdlib.h>
 
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H
+#include <emmintrin.h>
+#endif
+
 // defined:
 //  IIRFILTSOS()    name-mangling macro
 //  TO              output type
@@ -250,3 +254,168 @@ float IIRFILTSOS(_groupdelay)(IIRFILTSOS() _q,
     }
     return iir_group_delay(b, 3, a, 3, _fc) + 2.0;
 }
+
+//
+// cascade block execution
+//
+// Each second-order section depends only on its own state and on the
+// output of the previous section, so consecutive sections can run at the
+// same time on consecutive samples: section k operates on sample t-k
+// while section 0 operates on sample t. The sections of a group occupy
+// SIMD lanes and the output of each lane shifts into the next lane as
+// input at the following step. Every lane performs exactly the same
+// operations as IIRFILTSOS(_execute_df2) so results are bit-exact.
+//
+
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H && TC_COMPLEX==0
+#  if TI_COMPLEX
+#    define IIRFILTSOS_LANES    (2) // sections per register (re,im each)
+#  else
+#    define IIRFILTSOS_LANES    (4) // sections per register
+#  endif
+#else
+#  define IIRFILTSOS_LANES      (1) // scalar, section by section
+#endif
+
+#if IIRFILTSOS_LANES > 1
+// run group of up to IIRFILTSOS_LANES sections over block of samples;
+// input and output arrays may be the same
+//  _q      :   array of second-order sections [size: _g x 1]
+//  _g      :   number of sections in group
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of samples
+//  _y      :   output array [size: _n x 1]
+void IIRFILTSOS(_execute_group_sse)(IIRFILTSOS() * _q,
+                                    unsigned int   _g,
+                                    TI *           _x,
+                                    unsigned int   _n,
+                                    TO *           _y)
+{
+    // load coefficients and state; unused lanes pass input through
+    float a1[4] = {0,0,0,0}, a2[4] = {0,0,0,0};
+    float b0[4] = {1,1,1,1}, b1[4] = {0,0,0,0}, b2[4] = {0,0,0,0};
+    float v1[4] = {0,0,0,0}, v2[4] = {0,0,0,0};
+    unsigned int k, j, w = 4 / IIRFILTSOS_LANES;
+    for (k=0; k<_g; k++) {
+        for (j=0; j<w; j++) {
+            a1[w*k+j] = _q[k]->a[1];
+            a2[w*k+j] = _q[k]->a[2];
+            b0[w*k+j] = _q[k]->b[0];
+            b1[w*k+j] = _q[k]->b[1];
+            b2[w*k+j] = _q[k]->b[2];
+        }
+#if TI_COMPLEX
+        v1[2*k+0] = crealf(_q[k]->v[0]); v1[2*k+1] = cimagf(_q[k]->v[0]);
+        v2[2*k+0] = crealf(_q[k]->v[1]); v2[2*k+1] = cimagf(_q[k]->v[1]);
+#else
+        v1[k] = _q[k]->v[0];
+        v2[k] = _q[k]->v[1];
+#endif
+    }
+    __m128 A1 = _mm_loadu_ps(a1), A2 = _mm_loadu_ps(a2);
+    __m128 B0 = _mm_loadu_ps(b0), B1 = _mm_loadu_ps(b1), B2 = _mm_loadu_ps(b2);
+    __m128 V1 = _mm_loadu_ps(v1), V2 = _mm_loadu_ps(v2);
+    __m128 Y  = _mm_setzero_ps();
+    float  out[4];
+
+    // step through samples; lane k handles sample t-k and only updates
+    // its state while that sample is within the block
+    unsigned int t, d = _g - 1;
+    for (t=0; t<_n+d; t++) {
+        // next input: new sample in first lane, previous outputs shifted up
+#if TI_COMPLEX
+        __m128 X = t < _n ? _mm_loadl_pi(_mm_setzero_ps(), (__m64*)(_x + t)) : _mm_setzero_ps();
+        __m128 U = _mm_movelh_ps(X, Y);
+#else
+        __m128 U = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(Y), 4));
+        U = _mm_move_ss(U, _mm_set_ss(t < _n ? _x[t] : 0.0f));
+#endif
+        __m128 V0 = _mm_sub_ps(_mm_sub_ps(U, _mm_mul_ps(A1, V1)), _mm_mul_ps(A2, V2));
+        Y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(B0, V0), _mm_mul_ps(B1, V1)), _mm_mul_ps(B2, V2));
+
+        if (t >= d && t < _n) {
+            // all lanes active
+            V2 = V1;
+            V1 = V0;
+        } else {
+            // filling or draining pipeline: update active lanes only
+            for (k=0; k<_g; k++) {
+                if (t < k || t >= _n + k) continue;
+                _mm_storeu_ps(v1, V1); _mm_storeu_ps(v2, V2); _mm_storeu_ps(out, V0);
+                for (j=0; j<w; j++) {
+                    v2[w*k+j] = v1[w*k+j];
+                    v1[w*k+j] = out[w*k+j];
+                }
+                V1 = _mm_loadu_ps(v1);
+                V2 = _mm_loadu_ps(v2);
+            }
+        }
+
+        // output of last section in group
+        if (t >= d) {
+            _mm_storeu_ps(out, Y);
+#if TI_COMPLEX
+            _y[t-d] = out[2*d] + _Complex_I*out[2*d+1];
+#else
+            _y[t-d] = out[d];
+#endif
+        }
+    }
+
+    // save state
+    _mm_storeu_ps(v1, V1);
+    _mm_storeu_ps(v2, V2);
+    for (k=0; k<_g; k++) {
+#if TI_COMPLEX
+        _q[k]->v[0] = v1[2*k] + _Complex_I*v1[2*k+1];
+        _q[k]->v[1] = v2[2*k] + _Complex_I*v2[2*k+1];
+#else
+        _q[k]->v[0] = v1[k];
+        _q[k]->v[1] = v2[k];
+#endif
+    }
+}
+#endif
+
+// run cascade of second-order sections over block of samples; the
+// input and output arrays may be the same
+//  _q      :   array of second-order sections [size: _nsos x 1]
+//  _nsos   :   number of sections
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of samples
+//  _y      :   output array [size: _n x 1]
+void IIRFILTSOS(_execute_cascade_block)(IIRFILTSOS() * _q,
+                                        unsigned int   _nsos,
+                                        TI *           _x,
+                                        unsigned int   _n,
+                                        TO *           _y)
+{
+    unsigned int i, k;
+#if IIRFILTSOS_LANES > 1
+    // pipeline sections across lanes when block is long enough to
+    // amortize filling and draining
+    if (_nsos > 1 && _n >= 4*IIRFILTSOS_LANES) {
+        for (k=0; k<_nsos; k+=IIRFILTSOS_LANES) {
+            unsigned int g = _nsos - k < IIRFILTSOS_LANES ? _nsos - k : IIRFILTSOS_LANES;
+            IIRFILTSOS(_execute_group_sse)(_q + k, g, k==0 ? _x : _y, _n, _y);
+        }
+        return;
+    }
+#endif
+
+    // section by section over entire block, keeping state in registers
+    for (k=0; k<_nsos; k++) {
+        IIRFILTSOS() q = _q[k];
+        TI * x  = k==0 ? _x : _y;
+        TO   v1 = q->v[0];
+        TO   v2 = q->v[1];
+        for (i=0; i<_n; i++) {
+            TO v0 = x[i] - q->a[1]*v1 - q->a[2]*v2;
+            _y[i] = q->b[0]*v0 + q->b[1]*v1 + q->b[2]*v2;
+            v2 = v1;
+            v1 = v0;
+        }
+        q->v[0] = v1;
+        q->v[1] = v2;
+    }
+}
@@ -253,10 +253,26 @@ void IIRHILB(_decim_execute_block)(IIRHILB()    _q,
                                    unsigned int _n,
                                    T complex *  _y)
 {
-    unsigned int i;
-
-    for (i=0; i<_n; i++)
-        IIRHILB(_decim_execute)(_q, &_x[2*i], &_y[i]);
+    // mix down by Fs/4 and split into zero-stuffed branch inputs, then
+    // filter each branch as a block (in chunks)
+    T buf_0[256];
+    T buf_1[256];
+    unsigned int i, j;
+    for (i=0; i<_n; i+=128) {
+        unsigned int n = _n - i < 128 ? _n - i : 128;
+        for (j=0; j<n; j++) {
+            int state = (_q->state + j) & 1;
+            buf_0[2*j+0] = state ? -_x[2*(i+j)+0] :  _x[2*(i+j)+0];
+            buf_0[2*j+1] = 0;
+            buf_1[2*j+0] = 0;
+            buf_1[2*j+1] = state ?  _x[2*(i+j)+1] : -_x[2*(i+j)+1];
+        }
+        IIRFILT(_execute_block)(_q->filt_0, buf_0, 2*n, buf_0);
+        IIRFILT(_execute_block)(_q->filt_1, buf_1, 2*n, buf_1);
+        for (j=0; j<n; j++)
+            _y[i+j] = 2*(buf_0[2*j] + _Complex_I*buf_1[2*j]);
+        _q->state = (_q->state + n) & 1;
+    }
 }
 
 // execute Hilbert transform interpolator (complex to real)
@@ -299,8 +315,26 @@ void IIRHILB(_interp_execute_block)(IIRHILB()    _q,
                                     unsigned int _n,
                                     T *          _y)
 {
-    unsigned int i;
-
-    for (i=0; i<_n; i++)
-        IIRHILB(_interp_execute)(_q, _x[i], &_y[2*i]);
+    // split into zero-stuffed branch inputs, filter each branch as a
+    // block (in chunks), and mix up by Fs/4 retaining real component
+    T buf_0[256];
+    T buf_1[256];
+    unsigned int i, j;
+    for (i=0; i<_n; i+=128) {
+        unsigned int n = _n - i < 128 ? _n - i : 128;
+        for (j=0; j<n; j++) {
+            buf_0[2*j+0] = crealf(_x[i+j]);
+            buf_0[2*j+1] = 0;
+            buf_1[2*j+0] = cimagf(_x[i+j]);
+            buf_1[2*j+1] = 0;
+        }
+        IIRFILT(_execute_block)(_q->filt_0, buf_0, 2*n, buf_0);
+        IIRFILT(_execute_block)(_q->filt_1, buf_1, 2*n, buf_1);
+        for (j=0; j<n; j++) {
+            int state = (_q->state + j) & 1;
+            _y[2*(i+j)+0] = 2*(state ? -buf_0[2*j+0] :  buf_0[2*j+0]);
+            _y[2*(i+j)+1] = 2*(state ?  buf_1[2*j+1] : -buf_1[2*j+1]);
+        }
+        _q->state = (_q->state + n) & 1;
+    }
 }
@@ -141,9 +141,7 @@ void IIRINTERP(_execute)(IIRINTERP() _q,
                          TO *        _y)
 {
     // TODO: use iirpfb
-    unsigned int i;
-    for (i=0; i<_q->M; i++)
-        IIRFILT(_execute)(_q->iirfilt, i==0 ? _x : 0.0f, &_y[i]);
+    IIRINTERP(_execute_block)(_q, &_x, 1, _y);
 }
 
 // execute interpolation on block of input samples
@@ -156,11 +154,16 @@ void IIRINTERP(_execute_block)(IIRINTERP()  _q,
                                unsigned int _n,
                                TO *         _y)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++) {
-        // execute one input at a time with an output stride _M
-        IIRINTERP(_execute)(_q, _x[i], &_y[i*_q->M]);
+    // zero-stuff input into output array (in reverse so that
+    // input and output may overlap) and filter in place
+    unsigned int i, j;
+    for (i=_n; i>0; i--) {
+        TI x = _x[i-1];
+        for (j=1; j<_q->M; j++)
+            _y[(i-1)*_q->M + j] = 0.0f;
+        _y[(i-1)*_q->M] = x;
     }
+    IIRFILT(_execute_block)(_q->iirfilt, _y, _n*_q->M, _y);
 }
 
 // get system group delay at frequency _fc
@@ -31,6 +31,9 @@
 
 #include "liquid.internal.h"
 
+// target number of samples in internal buffers for block execution
+#define MSRESAMP2_BLOCK_LEN (1024)
+
 // 
 // forward declaration of internal methods
 //
@@ -54,6 +57,7 @@ struct MSRESAMP2(_s) {
     RESAMP2() *     resamp2;    // array of half-band resamplers
     T *             buffer0;    // buffer[0]
     T *             buffer1;    // buffer[1]
+    unsigned int    buffer_len; // buffer length (multiple of M)
     unsigned int    buffer_index;  // index of buffer
     float           zeta;       // scaling factor
 };
@@ -74,6 +78,26 @@ void MSRESAMP2(_decim_execute)(MSRESAMP2() _q,
                                TI *        _x,
                                TO *        _y);
 
+// execute multi-stage resampler as interpolator on a block of samples
+//  _q      : msresamp object
+//  _x      : input sample array  [size: _n x 1]
+//  _n      : number of input samples, _n*M <= buffer_len
+//  _y      : output sample array [size: _n*2^_num_stages x 1]
+void MSRESAMP2(_interp_execute_block)(MSRESAMP2()  _q,
+                                      TI *         _x,
+                                      unsigned int _n,
+                                      TO *         _y);
+
+// execute multi-stage resampler as decimator on a block of samples
+//  _q      : msresamp object
+//  _x      : input sample array  [size: _n*2^_num_stages x 1]
+//  _n      : number of output samples, _n*M <= buffer_len
+//  _y      : output sample array [size: _n x 1]
+void MSRESAMP2(_decim_execute_block)(MSRESAMP2()  _q,
+                                     TI *         _x,
+                                     unsigned int _n,
+                                     TO *         _y);
+
 // create multi-stage half-band resampler
 //  _type       : resampler type (e.g. LIQUID_RESAMP_DECIM)
 //  _num_stages : number of resampling stages
@@ -124,9 +148,10 @@ MSRESAMP2() MSRESAMP2(_create)(int          _type,
     q->M    = 1 << q->num_stages;
     q->zeta = 1.0f / (float)(q->M);
 
-    // allocate memory for buffers
-    q->buffer0 = (T*) malloc( q->M * sizeof(T) );
-    q->buffer1 = (T*) malloc( q->M * sizeof(T) );
+    // allocate memory for buffers (large enough for block execution)
+    q->buffer_len = q->M < MSRESAMP2_BLOCK_LEN ? MSRESAMP2_BLOCK_LEN : q->M;
+    q->buffer0 = (T*) malloc( q->buffer_len * sizeof(T) );
+    q->buffer1 = (T*) malloc( q->buffer_len * sizeof(T) );
 
     // allocate arrays for half-band resampler parameters
     q->fc_stage = (float*)        malloc(q->num_stages*sizeof(float)       );
@@ -303,6 +328,39 @@ void MSRESAMP2(_execute)(MSRESAMP2() _q,
     }
 }
 
+// execute multi-stage resampler on a block of samples
+//  _q      : msresamp object
+//  _x      : input sample array
+//  _n      : number of executions
+//  _y      : output sample array
+void MSRESAMP2(_execute_block)(MSRESAMP2()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
+{
+    if (_q->num_stages == 0) {
+        // pass through
+        memmove(_y, _x, _n*sizeof(T));
+        return;
+    }
+
+    // run in groups of executions that fit internal buffers
+    unsigned int c = _q->buffer_len / _q->M;
+    while (_n > 0) {
+        unsigned int n = _n < c ? _n : c;
+        if (_q->type == LIQUID_RESAMP_INTERP) {
+            MSRESAMP2(_interp_execute_block)(_q, _x, n, _y);
+            _x += n;
+            _y += n * _q->M;
+        } else {
+            MSRESAMP2(_decim_execute_block)(_q, _x, n, _y);
+            _x += n * _q->M;
+            _y += n;
+        }
+        _n -= n;
+    }
+}
+
 //
 // internal methods
 //
@@ -376,3 +434,65 @@ void MSRESAMP2(_decim_execute)(MSRESAMP2() _q,
     *_y = b0[0] * _q->zeta;
 }
 
+
+// execute multi-stage resampler as interpolator on a block of samples
+//  _q      : msresamp object
+//  _x      : input sample array  [size: _n x 1]
+//  _n      : number of input samples
+//  _y      : output sample array [size: _n*2^_num_stages x 1]
+void MSRESAMP2(_interp_execute_block)(MSRESAMP2()  _q,
+                                      TI *         _x,
+                                      unsigned int _n,
+                                      TO *         _y)
+{
+    T * b0 = _x;            // input buffer pointer
+    T * b1 = _q->buffer1;   // output buffer pointer
+
+    unsigned int s;
+    for (s=0; s<_q->num_stages; s++) {
+        // set final stage output as supplied output pointer
+        if (s == _q->num_stages-1)
+            b1 = _y;
+
+        // run entire block through half-band stage
+        RESAMP2(_interp_execute_block)(_q->resamp2[s], b0, _n << s, b1);
+
+        // toggle output buffer pointers
+        b0 = (s % 2) == 0 ? _q->buffer1 : _q->buffer0;
+        b1 = (s % 2) == 0 ? _q->buffer0 : _q->buffer1;
+    }
+}
+
+// execute multi-stage resampler as decimator on a block of samples
+//  _q      : msresamp object
+//  _x      : input sample array  [size: _n*2^_num_stages x 1]
+//  _n      : number of output samples
+//  _y      : output sample array [size: _n x 1]
+void MSRESAMP2(_decim_execute_block)(MSRESAMP2()  _q,
+                                     TI *         _x,
+                                     unsigned int _n,
+                                     TO *         _y)
+{
+    T * b0 = _x;            // input buffer pointer
+    T * b1 = _q->buffer1;   // output buffer pointer
+
+    unsigned int s;
+    for (s=0; s<_q->num_stages; s++) {
+        // set final stage output as supplied output pointer
+        if (s == _q->num_stages-1)
+            b1 = _y;
+
+        // run entire block through half-band stage (reversed index)
+        unsigned int g = _q->num_stages-s-1;
+        RESAMP2(_decim_execute_block)(_q->resamp2[g], b0, _n << g, b1);
+
+        // toggle output buffer pointers
+        b0 = (s % 2) == 0 ? _q->buffer1 : _q->buffer0;
+        b1 = (s % 2) == 0 ? _q->buffer0 : _q->buffer1;
+    }
+
+    // scale output appropriately
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] *= _q->zeta;
+}
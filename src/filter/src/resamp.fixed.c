@@ -31,6 +31,9 @@
 
 #define DEBUG_RESAMP_PRINT  0
 
+// maximum number of input samples buffered per block iteration
+#define RESAMP_BLOCK_LEN    (512)
+
 // main object
 struct RESAMP(_s) {
     // filter design parameters
@@ -44,6 +47,9 @@ struct RESAMP(_s) {
     uint32_t        phase;  // sampling phase
     unsigned int    npfb;   // 256
     FIRPFB()        pfb;    // filter bank
+
+    // block processing
+    TI *            buf;    // contiguous input [size: h_sub_len-1+RESAMP_BLOCK_LEN x 1]
 };
 
 // create arbitrary resampler
@@ -109,6 +115,9 @@ RESAMP() RESAMP(_create)(float        _rate,
         h[i] = hf[i]*gain;
     q->pfb = FIRPFB(_create)(q->npfb,h,n-1);
 
+    // allocate contiguous input buffer for block processing
+    q->buf = (TI*) malloc((q->pfb->h_sub_len + RESAMP_BLOCK_LEN)*sizeof(TI));
+
     // reset object and return
     RESAMP(_reset)(q);
     return q;
@@ -141,8 +150,9 @@ RESAMP() RESAMP(_create_default)(float _rate)
 // free arbitrary resampler object
 void RESAMP(_destroy)(RESAMP() _q)
 {
-    // free polyphase filterbank
+    // free polyphase filterbank and block buffer
     FIRPFB(_destroy)(_q->pfb);
+    free(_q->buf);
 
     // free main object memory
     free(_q);
@@ -241,6 +251,20 @@ void RESAMP(_adjust_timing_phase)(RESAMP() _q,
     //_q->tau += _delta;
 }
 
+// get exact number of output samples that will be produced by the
+// next _num_input input samples given the current state
+//  _q          :   resampling object
+//  _num_input  :   number of input samples
+unsigned int RESAMP(_get_num_output)(RESAMP()     _q,
+                                     unsigned int _num_input)
+{
+    // outputs are produced at phase + k*step < num_input * 2^24
+    uint64_t end = (uint64_t)_num_input << 24;
+    if (end <= _q->phase)
+        return 0;
+    return (unsigned int)((end - _q->phase + _q->step - 1) / _q->step);
+}
+
 // run arbitrary resampler
 //  _q          :   resampling object
 //  _x          :   single input sample
@@ -282,23 +306,43 @@ void RESAMP(_execute_block)(RESAMP()       _q,
                             TO *           _y,
                             unsigned int * _ny)
 {
-    // initialize number of output samples to zero
+    FIRPFB()     pfb = _q->pfb;
+    unsigned int L   = pfb->h_sub_len;
+    uint32_t     phase = _q->phase;
+    uint32_t     step  = _q->step;
     unsigned int ny = 0;
-
-    // number of samples written for each individual iteration
-    unsigned int num_written;
-
-    // iterate over each input sample
-    unsigned int i;
-    for (i=0; i<_nx; i++) {
-        // run resampler on single input
-        RESAMP(_execute)(_q, _x[i], &_y[ny], &num_written);
-
-        // update output counter
-        ny += num_written;
+    TI * r;
+
+    while (_nx > 0) {
+        unsigned int n = _nx < RESAMP_BLOCK_LEN ? _nx : RESAMP_BLOCK_LEN;
+
+        // filterbank history followed by new input samples, so the
+        // window for input i starts at buf[i]
+        WINDOW(_read)(pfb->w, &r);
+        memmove(_q->buf,     r+1, (L-1)*sizeof(TI));
+        memmove(_q->buf+L-1, _x,  n    *sizeof(TI));
+
+        // walk timing accumulator over block, computing outputs in place
+        unsigned int i;
+        for (i=0; i<n; i++) {
+            while (phase <= 0x00ffffff) {
+                DOTPROD(_execute)(pfb->dp[phase >> 16], _q->buf + i, &_y[ny]);
+                _y[ny++] *= pfb->scale;
+                phase += step;
+            }
+            phase -= (1<<24);
+        }
+
+        // update filterbank window with most recent samples
+        WINDOW(_reset)(pfb->w);
+        WINDOW(_write)(pfb->w, _q->buf + n - 1, L);
+
+        _x  += n;
+        _nx -= n;
     }
 
-    // set return value for number of output samples written
+    // save state and set return value for number of output samples written
+    _q->phase = phase;
     *_ny = ny;
 }
 
@@ -29,6 +29,13 @@
 #include <stdlib.h>
 #include <math.h>
 
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+#include <xmmintrin.h>
+#endif
+
+// maximum number of outputs (filter branch) computed per block iteration
+#define RESAMP2_BLOCK_LEN   (256)
+
 // defined:
 //  RESAMP2()       name-mangling macro
 //  TO              output data type
@@ -56,8 +63,44 @@ struct RESAMP2(_s) {
 
     // halfband filter operation
     unsigned int toggle;
+
+    // block processing
+    TC * hf;                // folded filter branch coefficients [size: 2*m x 1]
+    TI * buf0;              // contiguous delay branch input  [size: 2*m+RESAMP2_BLOCK_LEN x 1]
+    TI * buf1;              // contiguous filter branch input [size: 2*m+RESAMP2_BLOCK_LEN x 1]
 };
 
+// compute folded filter branch coefficients for block kernel
+void RESAMP2(_fold)(RESAMP2() _q);
+
+// compute filter branch output on block of contiguous inputs
+//  _q      :   resamp2 object
+//  _x      :   filter branch input [size: 2*m-1+_n x 1]
+//  _n      :   number of outputs
+//  _y      :   output array, stride 2 for interpolator [size: _stride*_n x 1]
+//  _stride :   output stride
+void RESAMP2(_filter_block)(RESAMP2()    _q,
+                            TI *         _x,
+                            unsigned int _n,
+                            TO *         _y,
+                            unsigned int _stride);
+
+// load windows and new inputs into contiguous block buffers
+//  _q      :   resamp2 object
+//  _x0     :   delay branch input, stride _stride [size: _n x 1]
+//  _x1     :   filter branch input, stride _stride [size: _n x 1]
+//  _n      :   number of new inputs
+//  _stride :   input stride
+void RESAMP2(_block_load)(RESAMP2()    _q,
+                          TI *         _x0,
+                          TI *         _x1,
+                          unsigned int _n,
+                          unsigned int _stride);
+
+// update windows from contiguous block buffers after processing _n inputs
+void RESAMP2(_block_store)(RESAMP2()    _q,
+                           unsigned int _n);
+
 // create a resamp2 object
 //  _m      :   filter semi-length (effective length: 4*_m+1)
 //  _f0     :   center frequency of half-band filter
@@ -119,6 +162,12 @@ RESAMP2() RESAMP2(_create)(unsigned int _m,
     q->w0 = WINDOW(_create)(2*(q->m));
     q->w1 = WINDOW(_create)(2*(q->m));
 
+    // create block processing buffers
+    q->hf   = (TC *) malloc((q->h1_len)*sizeof(TC));
+    q->buf0 = (TI *) malloc((q->h1_len + RESAMP2_BLOCK_LEN)*sizeof(TI));
+    q->buf1 = (TI *) malloc((q->h1_len + RESAMP2_BLOCK_LEN)*sizeof(TI));
+    RESAMP2(_fold)(q);
+
     RESAMP2(_reset)(q);
 
     return q;
@@ -165,6 +214,7 @@ RESAMP2() RESAMP2(_recreate)(RESAMP2()    _q,
 
         // create dotprod object
         _q->dp = DOTPROD(_recreate)(_q->dp, _q->h1, 2*_q->m);
+        RESAMP2(_fold)(_q);
     }
     return _q;
 }
@@ -182,6 +232,9 @@ void RESAMP2(_destroy)(RESAMP2() _q)
     // free arrays
     free(_q->h);
     free(_q->h1);
+    free(_q->hf);
+    free(_q->buf0);
+    free(_q->buf1);
 
     // free main object memory
     free(_q);
@@ -360,3 +413,215 @@ void RESAMP2(_interp_execute)(RESAMP2() _q,
     DOTPROD(_execute)(_q->dp, r, &_y[1]);
 }
 
+
+// execute half-band decimation on a block of samples
+//  _q      :   resamp2 object
+//  _x      :   input array [size: 2*_n x 1]
+//  _n      :   number of output samples
+//  _y      :   output array [size: _n x 1]
+void RESAMP2(_decim_execute_block)(RESAMP2()    _q,
+                                   TI *         _x,
+                                   unsigned int _n,
+                                   TO *         _y)
+{
+    unsigned int i;
+    while (_n > 0) {
+        unsigned int n = _n < RESAMP2_BLOCK_LEN ? _n : RESAMP2_BLOCK_LEN;
+
+        // de-interleave: even samples feed filter branch, odd feed delay
+        RESAMP2(_block_load)(_q, _x+1, _x, n, 2);
+
+        // compute filter branch, then add delay branch
+        RESAMP2(_filter_block)(_q, _q->buf1, n, _y, 1);
+        for (i=0; i<n; i++)
+            _y[i] += _q->buf0[_q->m + i];
+
+        RESAMP2(_block_store)(_q, n);
+        _x += 2*n;
+        _y += n;
+        _n -= n;
+    }
+}
+
+// execute half-band interpolation on a block of samples
+//  _q      :   resamp2 object
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of input samples
+//  _y      :   output array [size: 2*_n x 1]
+void RESAMP2(_interp_execute_block)(RESAMP2()    _q,
+                                    TI *         _x,
+                                    unsigned int _n,
+                                    TO *         _y)
+{
+    unsigned int i;
+    while (_n > 0) {
+        unsigned int n = _n < RESAMP2_BLOCK_LEN ? _n : RESAMP2_BLOCK_LEN;
+
+        // both branches see the same input
+        RESAMP2(_block_load)(_q, _x, _x, n, 1);
+
+        // delay branch on even outputs, filter branch on odd outputs
+        for (i=0; i<n; i++)
+            _y[2*i] = _q->buf0[_q->m + i];
+        RESAMP2(_filter_block)(_q, _q->buf1, n, _y+1, 2);
+
+        RESAMP2(_block_store)(_q, n);
+        _x += n;
+        _y += 2*n;
+        _n -= n;
+    }
+}
+
+//
+// internal methods
+//
+
+// compute folded filter branch coefficients for block kernel; for real
+// coefficients the branch is symmetric (h1[i] = h1[2m-1-i]) so only the
+// first m taps are needed, duplicated for complex inputs to match the
+// interleaved real/imaginary layout
+void RESAMP2(_fold)(RESAMP2() _q)
+{
+    unsigned int i;
+#if TC_COMPLEX == 0 && TI_COMPLEX == 1
+    for (i=0; i<_q->m; i++) {
+        _q->hf[2*i+0] = _q->h1[i];
+        _q->hf[2*i+1] = _q->h1[i];
+    }
+#else
+    for (i=0; i<_q->h1_len; i++)
+        _q->hf[i] = _q->h1[i];
+#endif
+}
+
+// load windows and new inputs into contiguous block buffers
+void RESAMP2(_block_load)(RESAMP2()    _q,
+                          TI *         _x0,
+                          TI *         _x1,
+                          unsigned int _n,
+                          unsigned int _stride)
+{
+    unsigned int i;
+    TI * r;
+
+    // delay branch: full window followed by new samples
+    WINDOW(_read)(_q->w0, &r);
+    memmove(_q->buf0, r, _q->h1_len*sizeof(TI));
+    for (i=0; i<_n; i++)
+        _q->buf0[_q->h1_len + i] = _x0[_stride*i];
+
+    // filter branch: most recent 2m-1 samples followed by new samples
+    WINDOW(_read)(_q->w1, &r);
+    memmove(_q->buf1, r+1, (_q->h1_len-1)*sizeof(TI));
+    for (i=0; i<_n; i++)
+        _q->buf1[_q->h1_len - 1 + i] = _x1[_stride*i];
+}
+
+// update windows from contiguous block buffers after processing _n inputs
+void RESAMP2(_block_store)(RESAMP2()    _q,
+                           unsigned int _n)
+{
+    WINDOW(_reset)(_q->w0);
+    WINDOW(_write)(_q->w0, _q->buf0 + _n,     _q->h1_len);
+    WINDOW(_reset)(_q->w1);
+    WINDOW(_write)(_q->w1, _q->buf1 + _n - 1, _q->h1_len);
+}
+
+// compute filter branch output on block of contiguous inputs
+void RESAMP2(_filter_block)(RESAMP2()    _q,
+                            TI *         _x,
+                            unsigned int _n,
+                            TO *         _y,
+                            unsigned int _stride)
+{
+    unsigned int i;
+#if TC_COMPLEX == 0
+    unsigned int j;
+    unsigned int m = _q->m;
+    unsigned int L = _q->h1_len;
+#endif
+#if TC_COMPLEX == 0 && TI_COMPLEX == 1
+    // real symmetric coefficients, complex input: fold symmetric taps
+    // y = sum_{j<m} h1[j] * (x[j] + x[2m-1-j])
+    for (i=0; i<_n; i++) {
+        float * v = (float*)(_x + i);
+        j = 0;
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+        // four complex samples from each end per iteration using two
+        // accumulators, then two at a time
+        __m128 acc  = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        for ( ; j+4<=m; j+=4) {
+            __m128 a0 = _mm_loadu_ps(v + 2*j);              // x[j],   x[j+1]
+            __m128 a1 = _mm_loadu_ps(v + 2*j + 4);          // x[j+2], x[j+3]
+            __m128 b0 = _mm_loadu_ps(v + 2*(L-2-j));        // x[L-2-j], x[L-1-j]
+            __m128 b1 = _mm_loadu_ps(v + 2*(L-4-j));        // x[L-4-j], x[L-3-j]
+            b0 = _mm_shuffle_ps(b0, b0, _MM_SHUFFLE(1,0,3,2));
+            b1 = _mm_shuffle_ps(b1, b1, _MM_SHUFFLE(1,0,3,2));
+            acc  = _mm_add_ps(acc,  _mm_mul_ps(_mm_loadu_ps(_q->hf + 2*j    ), _mm_add_ps(a0, b0)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(_q->hf + 2*j + 4), _mm_add_ps(a1, b1)));
+        }
+        for ( ; j+2<=m; j+=2) {
+            __m128 a = _mm_loadu_ps(v + 2*j);               // x[j], x[j+1]
+            __m128 b = _mm_loadu_ps(v + 2*(L-2-j));         // x[L-2-j], x[L-1-j]
+            b = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1,0,3,2)); // x[L-1-j], x[L-2-j]
+            __m128 h = _mm_loadu_ps(_q->hf + 2*j);
+            acc = _mm_add_ps(acc, _mm_mul_ps(h, _mm_add_ps(a, b)));
+        }
+        float t[4];
+        _mm_storeu_ps(t, _mm_add_ps(acc, acc1));
+        float yr = t[0] + t[2];
+        float yi = t[1] + t[3];
+#else
+        float yr = 0.0f;
+        float yi = 0.0f;
+#endif
+        for ( ; j<m; j++) {
+            yr += _q->hf[2*j] * (v[2*j  ] + v[2*(L-1-j)  ]);
+            yi += _q->hf[2*j] * (v[2*j+1] + v[2*(L-1-j)+1]);
+        }
+        _y[_stride*i] = yr + _Complex_I*yi;
+    }
+#elif TC_COMPLEX == 0 && TI_COMPLEX == 0
+    // real symmetric coefficients, real input: fold symmetric taps
+    for (i=0; i<_n; i++) {
+        float * v = _x + i;
+        j = 0;
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+        // eight samples from each end per iteration using two
+        // accumulators, then four at a time
+        __m128 acc  = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        for ( ; j+8<=m; j+=8) {
+            __m128 a0 = _mm_loadu_ps(v + j);
+            __m128 a1 = _mm_loadu_ps(v + j + 4);
+            __m128 b0 = _mm_loadu_ps(v + L-4-j);
+            __m128 b1 = _mm_loadu_ps(v + L-8-j);
+            b0 = _mm_shuffle_ps(b0, b0, _MM_SHUFFLE(0,1,2,3));
+            b1 = _mm_shuffle_ps(b1, b1, _MM_SHUFFLE(0,1,2,3));
+            acc  = _mm_add_ps(acc,  _mm_mul_ps(_mm_loadu_ps(_q->hf + j    ), _mm_add_ps(a0, b0)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(_q->hf + j + 4), _mm_add_ps(a1, b1)));
+        }
+        for ( ; j+4<=m; j+=4) {
+            __m128 a = _mm_loadu_ps(v + j);
+            __m128 b = _mm_loadu_ps(v + L-4-j);
+            b = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0,1,2,3));
+            __m128 h = _mm_loadu_ps(_q->hf + j);
+            acc = _mm_add_ps(acc, _mm_mul_ps(h, _mm_add_ps(a, b)));
+        }
+        float t[4];
+        _mm_storeu_ps(t, _mm_add_ps(acc, acc1));
+        float y = (t[0] + t[1]) + (t[2] + t[3]);
+#else
+        float y = 0.0f;
+#endif
+        for ( ; j<m; j++)
+            y += _q->hf[j] * (v[j] + v[L-1-j]);
+        _y[_stride*i] = y;
+    }
+#else
+    // complex coefficients are not symmetric; use regular dot product
+    for (i=0; i<_n; i++)
+        DOTPROD(_execute)(_q->dp, _x + i, &_y[_stride*i]);
+#endif
+}
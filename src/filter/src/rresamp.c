@@ -29,6 +29,9 @@
 #include <string.h>
 #include <math.h>
 
+// target number of input samples held in the internal buffer
+#define RRESAMP_BUFFER_LEN (1024)
+
 struct RRESAMP(_s) {
     // filter design parameters
     unsigned int    P;          // interpolation factor
@@ -36,15 +39,26 @@ struct RRESAMP(_s) {
     unsigned int    m;          // filter semi-length, h_len = 2*m + 1
     unsigned int    block_len;  // number of blocks to run in execute()
 
-    // polyphase filterbank properties/object
-    FIRPFB()        pfb;    // filterbank object (interpolator), Q filters in bank
+    // output schedule, precomputed for one primitive block of P outputs
+    unsigned int    h_sub_len;  // sub-filter length, 2*m
+    DOTPROD() *     dp;         // sub-filter for each output, [size: P x 1]
+    unsigned int *  offset;     // input offset for each output, [size: P x 1]
+    TC              scale;      // output scaling factor
+
+    // linear input buffer: filter history followed by new input samples
+    unsigned int    num_blocks; // maximum number of primitive blocks per pass
+    unsigned int    buf_len;    // buffer length, h_sub_len-1 + num_blocks*Q
+    unsigned int    buf_index;  // start of filter history within buffer
+    TI *            buf;        // input buffer, [size: buf_len x 1]
 };
 
-// internal: execute rational-rate resampler on a primitive-length block of
-// input samples and store the resulting samples in the output array.
-void RRESAMP(_execute_primitive)(RRESAMP() _q,
-                                 TI *      _x,
-                                 TO *      _y);
+// internal: execute rational-rate resampler on _n primitive-length blocks
+// of input samples, reading from buffer _r which holds the filter history
+// followed by the input samples
+void RRESAMP(_execute_primitive)(RRESAMP()    _q,
+                                 TI *         _r,
+                                 unsigned int _n,
+                                 TO *         _y);
 
 // Create rational-rate resampler object from external coefficients
 //  _P      : interpolation factor,                     P > 0
@@ -77,8 +91,27 @@ RRESAMP() RRESAMP(_create)(unsigned int _P,
     q->m         = _m;
     q->block_len =  1;
 
-    // create poly-phase filter bank
-    q->pfb = FIRPFB(_create)(q->P, _h, 2*q->P*q->m);
+    // Pre-compute schedule: output n of each primitive block uses polyphase
+    // sub-filter (n*Q) mod P after input floor(n*Q/P) has been pushed; each
+    // output is realized as a dot product against the linear input buffer
+    q->h_sub_len = 2*q->m;
+    q->dp        = (DOTPROD()*)    malloc(q->P*sizeof(DOTPROD()));
+    q->offset    = (unsigned int*) malloc(q->P*sizeof(unsigned int));
+    TC h_sub[q->h_sub_len];
+    unsigned int i, n;
+    for (n=0; n<q->P; n++) {
+        unsigned int phase = (n*q->Q) % q->P;
+        for (i=0; i<q->h_sub_len; i++)
+            h_sub[q->h_sub_len-i-1] = _h[phase + i*q->P];   // load in reverse order
+        q->dp[n]     = DOTPROD(_create)(h_sub, q->h_sub_len);
+        q->offset[n] = (n*q->Q) / q->P;
+    }
+    q->scale = 1;
+
+    // allocate input buffer
+    q->num_blocks = q->Q < RRESAMP_BUFFER_LEN ? RRESAMP_BUFFER_LEN / q->Q : 1;
+    q->buf_len    = q->h_sub_len - 1 + q->num_blocks*q->Q;
+    q->buf        = (TI*) malloc(q->buf_len*sizeof(TI));
 
     // reset object and return
     RRESAMP(_reset)(q);
@@ -191,8 +224,15 @@ RRESAMP() RRESAMP(_create_default)(unsigned int _P,
 // free resampler object
 void RRESAMP(_destroy)(RRESAMP() _q)
 {
-    // free polyphase filterbank
-    FIRPFB(_destroy)(_q->pfb);
+    // free sub-filters and schedule
+    unsigned int i;
+    for (i=0; i<_q->P; i++)
+        DOTPROD(_destroy)(_q->dp[i]);
+    free(_q->dp);
+    free(_q->offset);
+
+    // free input buffer
+    free(_q->buf);
 
     // free main object memory
     free(_q);
@@ -208,8 +248,9 @@ void RRESAMP(_print)(RRESAMP() _q)
 // reset resampler object
 void RRESAMP(_reset)(RRESAMP() _q)
 {
-    // clear filterbank
-    FIRPFB(_reset)(_q->pfb);
+    // clear filter history
+    _q->buf_index = 0;
+    memset(_q->buf, 0x00, (_q->h_sub_len-1)*sizeof(TI));
 }
 
 // Set output scaling for filter, default: \( 2 w \sqrt{P/Q} \)
@@ -218,7 +259,7 @@ void RRESAMP(_reset)(RRESAMP() _q)
 void RRESAMP(_set_scale)(RRESAMP() _q,
                          TC        _scale)
 {
-    FIRPFB(_set_scale)(_q->pfb, _scale);
+    _q->scale = _scale;
 }
 
 // Get output scaling for filter
@@ -227,7 +268,7 @@ void RRESAMP(_set_scale)(RRESAMP() _q,
 void RRESAMP(_get_scale)(RRESAMP() _q,
                          TC *      _scale)
 {
-    FIRPFB(_get_scale)(_q->pfb, _scale);
+    *_scale = _q->scale;
 }
 
 // get resampler filter delay (semi-length m)
@@ -281,43 +322,66 @@ void RRESAMP(_execute)(RRESAMP() _q,
                        TI *      _x,
                        TO *      _y)
 {
-    // run in blocks
-    unsigned int i;
-    for (i=0; i<_q->block_len; i++) {
-        // compute P outputs for Q inputs
-        RRESAMP(_execute_primitive)(_q, _x, _y);
+    RRESAMP(_execute_block)(_q, _x, 1, _y);
+}
 
-        // update input pointers accordingly
-        _x += _q->Q;
-        _y += _q->P;
+// Execute rational-rate resampler on many blocks of input samples and
+// store the resulting samples in the output array.
+//  _q  : resamp object
+//  _x  : input sample array, [size: Q*_n x 1]
+//  _n  : number of blocks
+//  _y  : output sample array [size: P*_n x 1]
+void RRESAMP(_execute_block)(RRESAMP()    _q,
+                             TI *         _x,
+                             unsigned int _n,
+                             TO *         _y)
+{
+    unsigned int hist_len = _q->h_sub_len - 1;
+
+    // run in groups of primitive blocks
+    unsigned int num_primitive = _n * _q->block_len;
+    while (num_primitive > 0) {
+        unsigned int num_blocks = num_primitive < _q->num_blocks ?
+                                  num_primitive : _q->num_blocks;
+        unsigned int num_input  = num_blocks * _q->Q;
+
+        // move filter history to front of buffer when out of space
+        if (_q->buf_index + hist_len + num_input > _q->buf_len) {
+            memmove(_q->buf, &_q->buf[_q->buf_index], hist_len*sizeof(TI));
+            _q->buf_index = 0;
+        }
+
+        // append input samples to filter history
+        TI * r = &_q->buf[_q->buf_index];
+        memmove(&r[hist_len], _x, num_input*sizeof(TI));
+
+        // compute P outputs for every Q inputs
+        RRESAMP(_execute_primitive)(_q, r, num_blocks, _y);
+        _q->buf_index += num_input;
+
+        // update pointers accordingly
+        _x += num_input;
+        _y += num_blocks * _q->P;
+        num_primitive -= num_blocks;
     }
 }
 
 // internal
-void RRESAMP(_execute_primitive)(RRESAMP() _q,
-                                 TI *      _x,
-                                 TO *      _y)
+void RRESAMP(_execute_primitive)(RRESAMP()    _q,
+                                 TI *         _r,
+                                 unsigned int _n,
+                                 TO *         _y)
 {
-    unsigned int index = 0; // filterbank index
-    unsigned int i, n=0;
-    for (i=0; i<_q->Q; i++) {
-        // push input
-        FIRPFB(_push)(_q->pfb, _x[i]);
-
-        // continue to produce output
-        while (index < _q->P) {
-            FIRPFB(_execute)(_q->pfb, index, &_y[n++]);
-            index += _q->Q;
+    unsigned int i, b;
+    for (b=0; b<_n; b++) {
+        // output i ends its window at input offset[i] of this block
+        for (i=0; i<_q->P; i++) {
+            DOTPROD(_execute)(_q->dp[i], &_r[_q->offset[i]], &_y[i]);
+            _y[i] *= _q->scale;
         }
 
-        // decrement filter-bank index by output rate
-        index -= _q->P;
+        // advance by one primitive block
+        _r += _q->Q;
+        _y += _q->P;
     }
-
-#if 0
-    // error checking for now
-    assert(index == 0);
-    assert(n == _q->P);
-#endif
 }
-
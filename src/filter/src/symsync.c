@@ -39,24 +39,49 @@
 #include <string.h>
 #include <math.h>
 
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+#include <xmmintrin.h>
+#endif
+
 #define DEBUG_SYMSYNC           0
 #define DEBUG_SYMSYNC_PRINT     0
 #define DEBUG_SYMSYNC_FILENAME  "symsync_internal_debug.m"
 #define DEBUG_BUFFER_LEN        (1024)
 
+// number of input samples copied into history buffer at a time
+#define SYMSYNC_BUFFER_LEN      (256)
+
+// number of filter taps per group of four floats in the interleaved
+// matched/derivative-matched filter bank
+#define SYMSYNC_GROUP_LEN       (TI_COMPLEX ? 2 : 4)
+
 //
 // forward declaration of internal methods
 //
 
-// step synchronizer
+// step synchronizer over block of input samples, returning number of
+// output samples written
 //  _q      : symsync object
-//  _x      : input sample
+//  _w      : input history [size: h_pad-1+_n x 1]
+//  _n      : number of input samples
 //  _y      : output sample array pointer
-//  _ny     : number of output samples written
-void SYMSYNC(_step)(SYMSYNC()      _q,
-                    TI             _x,
-                    TO *           _y,
-                    unsigned int * _ny);
+unsigned int SYMSYNC(_step)(SYMSYNC()    _q,
+                            TI *         _w,
+                            unsigned int _n,
+                            TO *         _y);
+
+// compute matched filter (and optionally derivative matched filter)
+// output from input window in a single pass
+//  _q      : symsync object
+//  _w      : input window [size: h_pad x 1]
+//  _b      : filterbank index
+//  _mf     : matched filter output
+//  _dmf    : derivative matched filter output (ignored if NULL)
+static inline void SYMSYNC(_execute_mf)(SYMSYNC()    _q,
+                                        TI *         _w,
+                                        unsigned int _b,
+                                        TO *         _mf,
+                                        TO *         _dmf);
 
 // advance synchronizer's internal loop filter
 //  _q      : synchronizer object
@@ -99,8 +124,11 @@ struct SYMSYNC(_s) {
     float rate_adjustment;      // internal rate adjustment factor
 
     unsigned int npfb;          // number of filters in the bank
-    FIRPFB()      mf;           // matched filter
-    FIRPFB()     dmf;           // derivative matched filter
+    unsigned int h_pad;         // sub-filter length padded to group length
+    float *      hp;            // interleaved filter bank, each group of
+                                // taps holds four floats of matched filter
+                                // followed by four of derivative filter
+    TI *         buf;           // shared input history [h_pad-1 + buffer]
 
 #if DEBUG_SYMSYNC
     windowf debug_rate;
@@ -172,8 +200,28 @@ SYMSYNC() SYMSYNC(_create)(unsigned int _k,
     for (i=0; i<_h_len; i++)
         dh[i] *= 0.06f / hdh_max;
 
-    q->mf  = FIRPFB(_create)(q->npfb, _h, _h_len);
-    q->dmf = FIRPFB(_create)(q->npfb, dh, _h_len);
+    // create interleaved filter bank; each sub-filter is stored in
+    // reverse order and padded with zeros at the front to a multiple
+    // of the group length (real coefficients are repeated across the
+    // real and imaginary components for complex input)
+    unsigned int L = SYMSYNC_GROUP_LEN;
+    unsigned int r = 4 / L;
+    q->h_pad = ((q->h_len + L - 1) / L) * L;
+    q->hp    = (float*) calloc(q->npfb * q->h_pad * 2 * r, sizeof(float));
+    unsigned int b, n, j;
+    for (b=0; b<q->npfb; b++) {
+        float * c = q->hp + b * q->h_pad * 2 * r;
+        for (n=0; n<q->h_len; n++) {
+            unsigned int t = q->h_pad - n - 1;  // tap index in window
+            for (j=0; j<r; j++) {
+                c[8*(t/L) + r*(t%L) + j    ] = _h[b + n*q->npfb];
+                c[8*(t/L) + r*(t%L) + j + 4] = dh[b + n*q->npfb];
+            }
+        }
+    }
+
+    // create input history buffer
+    q->buf = (TI*) malloc((q->h_pad - 1 + SYMSYNC_BUFFER_LEN)*sizeof(TI));
 
     // reset state and initialize loop filter
     q->A[0] = 1.0f;     q->B[0] = 0.0f;
@@ -307,9 +355,9 @@ void SYMSYNC(_destroy)(SYMSYNC() _q)
     windowf_destroy(_q->debug_q_hat);
 #endif
 
-    // destroy filterbank objects
-    FIRPFB(_destroy)(_q->mf);
-    FIRPFB(_destroy)(_q->dmf);
+    // free filterbank and input history
+    free(_q->hp);
+    free(_q->buf);
 
     // destroy timing phase-locked loop filter
     iirfiltsos_rrrf_destroy(_q->pll);
@@ -322,14 +370,16 @@ void SYMSYNC(_destroy)(SYMSYNC() _q)
 void SYMSYNC(_print)(SYMSYNC() _q)
 {
     printf("symsync_%s [rate: %f]\n", EXTENSION_FULL, _q->rate);
-    FIRPFB(_print)(_q->mf);
+    printf("    samples/symbol  :   %u\n", _q->k);
+    printf("    filters in bank :   %u\n", _q->npfb);
+    printf("    sub-filter len  :   %u\n", _q->h_len);
 }
 
 // reset symsync internal state
 void SYMSYNC(_reset)(SYMSYNC() _q)
 {
-    // reset polyphase filterbank
-    FIRPFB(_reset)(_q->mf);
+    // clear input history
+    memset(_q->buf, 0x00, (_q->h_pad - 1)*sizeof(TI));
 
     // reset counters, etc.
     _q->rate          = (float)_q->k / (float)_q->k_out;
@@ -428,11 +478,17 @@ void SYMSYNC(_execute)(SYMSYNC()      _q,
                        TO *           _y,
                        unsigned int * _ny)
 {
-    unsigned int i, ny=0, k=0;
-    for (i=0; i<_nx; i++) {
-        SYMSYNC(_step)(_q, _x[i], &_y[ny], &k);
-        ny += k;
-        //printf("%u\n",k);
+    // copy input into shared history buffer in chunks, stepping the
+    // synchronizer over consecutive windows without per-sample pushes
+    unsigned int h = _q->h_pad - 1;
+    unsigned int i, ny=0;
+    for (i=0; i<_nx; i+=SYMSYNC_BUFFER_LEN) {
+        unsigned int n = _nx - i < SYMSYNC_BUFFER_LEN ? _nx - i : SYMSYNC_BUFFER_LEN;
+        memmove(_q->buf + h, _x + i, n*sizeof(TI));
+        ny += SYMSYNC(_step)(_q, _q->buf, n, _y + ny);
+
+        // retain most recent samples as history
+        memmove(_q->buf, _q->buf + n, h*sizeof(TI));
     }
     *_ny = ny;
 }
@@ -441,83 +497,172 @@ void SYMSYNC(_execute)(SYMSYNC()      _q,
 // internal methods
 //
 
-// step synchronizer with single input sample
+// step synchronizer over block of input samples, returning number of
+// output samples written
 //  _q      : symsync object
-//  _x      : input sample
+//  _w      : input history [size: h_pad-1+_n x 1]; window for input i
+//            spans _w[i] through _w[i+h_pad-1]
+//  _n      : number of input samples
 //  _y      : output sample array pointer
-//  _ny     : number of output samples written
-void SYMSYNC(_step)(SYMSYNC()      _q,
-                    TI             _x,
-                    TO *           _y,
-                    unsigned int * _ny)
+unsigned int SYMSYNC(_step)(SYMSYNC()    _q,
+                            TI *         _w,
+                            unsigned int _n,
+                            TO *         _y)
 {
-    // push sample into MF and dMF filterbanks
-    FIRPFB(_push)(_q->mf,  _x);
-    FIRPFB(_push)(_q->dmf, _x);
-
     // matched and derivative matched-filter outputs
     TO  mf; // matched filter output
     TO dmf; // derivative matched filter output
 
-    unsigned int n=0;
+    // keep timing state local while stepping through block
+    float        tau   = _q->tau;
+    float        bf    = _q->bf;
+    int          b     = _q->b;
+    unsigned int decim = _q->decim_counter;
+    unsigned int npfb  = _q->npfb;
+    float        k     = (float)(_q->k);
 
-    // continue loop until filterbank index rolls over
-    while (_q->b < _q->npfb) {
+    unsigned int i, n=0;
+    for (i=0; i<_n; i++) {
+        // continue loop until filterbank index rolls over
+        while (b < npfb) {
 
 #if DEBUG_SYMSYNC_PRINT
-        printf("  [%2u] : tau : %12.8f, b : %4u (%12.8f)\n", n, _q->tau, _q->b, _q->bf);
+            printf("  [%2u] : tau : %12.8f, b : %4u (%12.8f)\n", n, tau, b, bf);
 #endif
 
-        // compute filterbank output
-        FIRPFB(_execute)(_q->mf, _q->b, &mf);
+            // compute filterbank output, along with derivative output
+            // when needed to update the timing loop
+            int update = decim == _q->k_out && !_q->is_locked;
+            SYMSYNC(_execute_mf)(_q, _w + i, b, &mf, update ? &dmf : NULL);
 
-        // scale output by samples/symbol
-        _y[n] = mf / (float)(_q->k);
+            // scale output by samples/symbol
+            _y[n] = mf / k;
 
-        // check output count and determine if this is 'ideal' timing output
-        if (_q->decim_counter == _q->k_out) {
-            // reset counter
-            _q->decim_counter = 0;
+            // check output count and determine if this is 'ideal' timing output
+            if (decim == _q->k_out) {
+                // reset counter
+                decim = 0;
 
 #if DEBUG_SYMSYNC
-            // save debugging variables
-            windowf_push(_q->debug_rate,   _q->rate);
-            windowf_push(_q->debug_del,    _q->del);
-            windowf_push(_q->debug_tau,    _q->tau);
-            windowf_push(_q->debug_bsoft,  _q->bf);
-            windowf_push(_q->debug_b,      _q->b);
-            windowf_push(_q->debug_q_hat,  _q->q_hat);
+                // save debugging variables
+                windowf_push(_q->debug_rate,   _q->rate);
+                windowf_push(_q->debug_del,    _q->del);
+                windowf_push(_q->debug_tau,    tau);
+                windowf_push(_q->debug_bsoft,  bf);
+                windowf_push(_q->debug_b,      b);
+                windowf_push(_q->debug_q_hat,  _q->q_hat);
 #endif
 
-            // if synchronizer is locked, don't update internal timing offset
-            if (_q->is_locked)
-                continue;
-
-            // compute dMF output
-            FIRPFB(_execute)(_q->dmf, _q->b, &dmf);
-
-            // update internal state
-            SYMSYNC(_advance_internal_loop)(_q, mf, dmf);
-            _q->tau_decim = _q->tau;    // save return value
+                // update internal timing offset unless synchronizer is locked
+                if (update) {
+                    SYMSYNC(_advance_internal_loop)(_q, mf, dmf);
+                    _q->tau_decim = tau;    // save return value
+                }
+            }
+
+            // increment decimation counter
+            decim++;
+
+            // update states
+            tau += _q->del;                 // instantaneous fractional offset
+            bf   = tau * (float)npfb;       // filterbank index (soft)
+            b    = (int)roundf(bf);         // filterbank index
+            n++;                            // number of output samples
         }
 
-        // increment decimation counter
-        _q->decim_counter++;
-
-        // update states
-        _q->tau += _q->del;                     // instantaneous fractional offset
-        _q->bf  = _q->tau * (float)(_q->npfb);  // filterbank index (soft)
-        _q->b   = (int)roundf(_q->bf);          // filterbank index
-        n++;                                    // number of output samples
+        // filterbank index rolled over; update states
+        tau -= 1.0f;                // instantaneous fractional offset
+        bf  -= (float)npfb;         // filterbank index (soft)
+        b   -= npfb;                // filterbank index
     }
 
-    // filterbank index rolled over; update states
-    _q->tau -= 1.0f;                // instantaneous fractional offset
-    _q->bf  -= (float)(_q->npfb);   // filterbank index (soft)
-    _q->b   -= _q->npfb;            // filterbank index
+    // save state
+    _q->tau           = tau;
+    _q->bf            = bf;
+    _q->b             = b;
+    _q->decim_counter = decim;
+    return n;
+}
+
+// compute matched filter (and optionally derivative matched filter)
+// output from input window in a single pass
+//  _q      : symsync object
+//  _w      : input window [size: h_pad x 1]
+//  _b      : filterbank index
+//  _mf     : matched filter output
+//  _dmf    : derivative matched filter output (ignored if NULL)
+static inline void SYMSYNC(_execute_mf)(SYMSYNC()    _q,
+                                        TI *         _w,
+                                        unsigned int _b,
+                                        TO *         _mf,
+                                        TO *         _dmf)
+{
+    unsigned int num_groups = _q->h_pad / SYMSYNC_GROUP_LEN;
+    float * c = _q->hp + _b * num_groups * 8;
+    float * x = (float*) _w;
+    unsigned int g;
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+    // the timing loop makes each output depend on the previous one, so
+    // split accumulation across even and odd groups to shorten latency
+    __m128 am0 = _mm_setzero_ps(), am1 = _mm_setzero_ps();
+    __m128 ad0 = _mm_setzero_ps(), ad1 = _mm_setzero_ps();
+    if (_dmf != NULL) {
+        for (g=0; g+1<num_groups; g+=2) {
+            __m128 v0 = _mm_loadu_ps(x + 4*g);
+            __m128 v1 = _mm_loadu_ps(x + 4*g + 4);
+            am0 = _mm_add_ps(am0, _mm_mul_ps(v0, _mm_loadu_ps(c + 8*g     )));
+            ad0 = _mm_add_ps(ad0, _mm_mul_ps(v0, _mm_loadu_ps(c + 8*g +  4)));
+            am1 = _mm_add_ps(am1, _mm_mul_ps(v1, _mm_loadu_ps(c + 8*g +  8)));
+            ad1 = _mm_add_ps(ad1, _mm_mul_ps(v1, _mm_loadu_ps(c + 8*g + 12)));
+        }
+        if (g < num_groups) {
+            __m128 v0 = _mm_loadu_ps(x + 4*g);
+            am0 = _mm_add_ps(am0, _mm_mul_ps(v0, _mm_loadu_ps(c + 8*g    )));
+            ad0 = _mm_add_ps(ad0, _mm_mul_ps(v0, _mm_loadu_ps(c + 8*g + 4)));
+        }
+    } else {
+        for (g=0; g+1<num_groups; g+=2) {
+            am0 = _mm_add_ps(am0, _mm_mul_ps(_mm_loadu_ps(x + 4*g    ), _mm_loadu_ps(c + 8*g    )));
+            am1 = _mm_add_ps(am1, _mm_mul_ps(_mm_loadu_ps(x + 4*g + 4), _mm_loadu_ps(c + 8*g + 8)));
+        }
+        if (g < num_groups)
+            am0 = _mm_add_ps(am0, _mm_mul_ps(_mm_loadu_ps(x + 4*g), _mm_loadu_ps(c + 8*g)));
+    }
 
-    // set output number of samples written
-    *_ny = n;
+    // combine accumulators and fold upper half onto lower half
+    __m128 am = _mm_add_ps(am0, am1);
+    __m128 ad = _mm_add_ps(ad0, ad1);
+    am = _mm_add_ps(am, _mm_movehl_ps(am, am));
+    ad = _mm_add_ps(ad, _mm_movehl_ps(ad, ad));
+    float sm[4], sd[4];
+    _mm_storeu_ps(sm, am);
+    _mm_storeu_ps(sd, ad);
+#  if TI_COMPLEX
+    *_mf = sm[0] + _Complex_I*sm[1];
+    if (_dmf != NULL) *_dmf = sd[0] + _Complex_I*sd[1];
+#  else
+    *_mf = sm[0] + sm[1];
+    if (_dmf != NULL) *_dmf = sd[0] + sd[1];
+#  endif
+#else
+    // accumulate each of four lanes separately
+    float sm[4] = {0,0,0,0};
+    float sd[4] = {0,0,0,0};
+    unsigned int j;
+    for (g=0; g<num_groups; g++) {
+        for (j=0; j<4; j++) {
+            sm[j] += x[4*g+j] * c[8*g+j];
+            sd[j] += x[4*g+j] * c[8*g+j+4];
+        }
+    }
+#  if TI_COMPLEX
+    *_mf = (sm[0] + sm[2]) + _Complex_I*(sm[1] + sm[3]);
+    if (_dmf != NULL) *_dmf = (sd[0] + sd[2]) + _Complex_I*(sd[1] + sd[3]);
+#  else
+    *_mf = (sm[0] + sm[2]) + (sm[1] + sm[3]);
+    if (_dmf != NULL) *_dmf = (sd[0] + sd[2]) + (sd[1] + sd[3]);
+#  endif
+#endif
 }
 
 // advance synchronizer's internal loop filter
@@ -529,11 +674,12 @@ void SYMSYNC(_advance_internal_loop)(SYMSYNC() _q,
                                      TO        _dmf)
 {
     //  1. compute timing error signal, clipping large levels
-#if 0
+    // real component of conj(mf)*dmf, [Mengali:1997] Eq.~(8.3.5),
+    // computed directly to avoid full complex multiplication
+#if TI_COMPLEX
     _q->q = crealf(_mf)*crealf(_dmf) + cimagf(_mf)*cimagf(_dmf);
 #else
-    // TODO : use more efficient method to compute this
-    _q->q = crealf( conjf(_mf)*_dmf );  // [Mengali:1997] Eq.~(8.3.5)
+    _q->q = _mf*_dmf;
 #endif
     // constrain timing error
     if      (_q->q >  1.0f) _q->q =  1.0f;  // clip large positive values
@@ -541,7 +687,9 @@ void SYMSYNC(_advance_internal_loop)(SYMSYNC() _q,
 
     //  2. filter error signal through timing loop filter: retain large
     //     portion of old estimate and small percent of new estimate
-    iirfiltsos_rrrf_execute(_q->pll, _q->q, &_q->q_hat);
+    float q_hat;
+    iirfiltsos_rrrf_execute(_q->pll, _q->q, &q_hat);
+    _q->q_hat = q_hat;
 
     // 3. update rate and timing phase
     _q->rate += _q->rate_adjustment * _q->q_hat;
@@ -578,20 +726,14 @@ void SYMSYNC(_output_debug_file)(SYMSYNC()    _q,
     unsigned int i;
 
     // save filter responses
-    FIRPFB(_reset)(_q->mf);
-    FIRPFB(_reset)(_q->dmf);
+    TI w[_q->h_pad];
     fprintf(fid,"h = [];\n");
     fprintf(fid,"dh = [];\n");
     fprintf(fid,"h_len = %u;\n", _q->h_len);
     for (i=0; i<_q->h_len; i++) {
-        // push impulse
-        if (i==0) {
-            FIRPFB(_push)(_q->mf,  1.0f);
-            FIRPFB(_push)(_q->dmf, 1.0f);
-        } else {
-            FIRPFB(_push)(_q->mf,  0.0f);
-            FIRPFB(_push)(_q->dmf, 0.0f);
-        }
+        // window with impulse delayed by i samples
+        memset(w, 0x00, _q->h_pad*sizeof(TI));
+        w[_q->h_pad - 1 - i] = 1.0f;
 
         // compute output for all filters
         TO  mf;     // matched filter output
@@ -599,8 +741,7 @@ void SYMSYNC(_output_debug_file)(SYMSYNC()    _q,
 
         unsigned int n;
         for (n=0; n<_q->npfb; n++) {
-            FIRPFB(_execute)(_q->mf,  n, &mf);
-            FIRPFB(_execute)(_q->dmf, n, &dmf);
+            SYMSYNC(_execute_mf)(_q, w, n, &mf, &dmf);
 
             fprintf(fid,"h(%4u) = %12.8f; dh(%4u) = %12.8f;\n", i*_q->npfb+n+1, crealf(mf), i*_q->npfb+n+1, crealf(dmf));
         }
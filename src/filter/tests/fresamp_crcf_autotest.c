@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// resample complex sinusoid and compare to ideal (delayed) output
+void testbench_fresamp_crcf(float _rate,
+                            float _tau)
+{
+    unsigned int n  = 1200;     // number of input samples
+    float        fx = 0.05f;    // input sinusoid frequency
+    float        tol = 0.002f;  // error tolerance (about -54 dB)
+
+    fresamp_crcf q = fresamp_crcf_create_default(_rate);
+    fresamp_crcf_set_timing_phase(q, _tau);
+    float delay = (float)fresamp_crcf_get_delay(q) - _tau;
+
+    unsigned int ny_max = (unsigned int)(n*_rate) + 4;
+    float complex * y = (float complex*) malloc(ny_max*sizeof(float complex));
+
+    unsigned int i, ny=0, nw;
+    for (i=0; i<n; i++) {
+        fresamp_crcf_execute(q, cexpf(_Complex_I*2*M_PI*fx*i), &y[ny], &nw);
+        ny += nw;
+    }
+    CONTEND_DELTA((float)ny, n*_rate, 2.0f);
+
+    // compare after filter transient
+    float rmse = 0.0f;
+    unsigned int num_compared = 0;
+    for (i=(unsigned int)(40*_rate); i<ny; i++) {
+        float t = (float)i / _rate - delay;
+        float complex e = y[i] - cexpf(_Complex_I*2*M_PI*fx*t);
+        rmse += crealf(e * conjf(e));
+        num_compared++;
+    }
+    rmse = sqrtf(rmse / (float)num_compared);
+    if (liquid_autotest_verbose)
+        printf("  rate=%8.5f, tau=%6.3f, rmse=%12.4e (%6.1f dB)\n", _rate, _tau, rmse, 20*log10f(rmse));
+    CONTEND_LESS_THAN(rmse, tol);
+
+    fresamp_crcf_destroy(q);
+    free(y);
+}
+
+void autotest_fresamp_crcf_0p73()       { testbench_fresamp_crcf(0.73120542f,  0.00f); }
+void autotest_fresamp_crcf_1p0()        { testbench_fresamp_crcf(1.0f,         0.00f); }
+void autotest_fresamp_crcf_1p37()       { testbench_fresamp_crcf(1.3715f,      0.00f); }
+void autotest_fresamp_crcf_3p7()        { testbench_fresamp_crcf(3.71234f,     0.00f); }
+void autotest_fresamp_crcf_tau_p25()    { testbench_fresamp_crcf(1.0f,         0.25f); }
+void autotest_fresamp_crcf_tau_m75()    { testbench_fresamp_crcf(1.0f,        -0.75f); }
+
+// block execution matches single-sample execution and output count query
+void testbench_fresamp_crcf_block(float _rate)
+{
+    unsigned int n = 3000;
+    float complex x[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    fresamp_crcf q0 = fresamp_crcf_create(_rate, 11, 3, 0.4f, 60.0f);
+    fresamp_crcf q1 = fresamp_crcf_create(_rate, 11, 3, 0.4f, 60.0f);
+    unsigned int ny_max = (unsigned int)(n*_rate) + 4;
+    float complex * y0 = (float complex*) malloc(ny_max*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(ny_max*sizeof(float complex));
+
+    // single-sample execution
+    unsigned int ny0 = 0, num_written;
+    for (i=0; i<n; i++) {
+        fresamp_crcf_execute(q0, x[i], &y0[ny0], &num_written);
+        ny0 += num_written;
+    }
+
+    // blocks of random length, checking output count query
+    unsigned int ny1 = 0;
+    for (i=0; i<n; ) {
+        unsigned int k = rand() % 100 == 0 ? 1 : rand() % 1200;
+        if (k > n - i) k = n - i;
+        unsigned int num_expected = fresamp_crcf_get_num_output(q1, k);
+        fresamp_crcf_execute_block(q1, x + i, k, y1 + ny1, &num_written);
+        CONTEND_EQUALITY(num_written, num_expected);
+        ny1 += num_written;
+        i   += k;
+    }
+
+    CONTEND_EQUALITY(ny0, ny1);
+    CONTEND_SAME_DATA(y0, y1, ny0*sizeof(float complex));
+
+    fresamp_crcf_destroy(q0);
+    fresamp_crcf_destroy(q1);
+    free(y0);
+    free(y1);
+}
+
+void autotest_fresamp_crcf_block_0p1()  { testbench_fresamp_crcf_block(0.1f       ); }
+void autotest_fresamp_crcf_block_0p73() { testbench_fresamp_crcf_block(0.73120542f); }
+void autotest_fresamp_crcf_block_1p0()  { testbench_fresamp_crcf_block(1.0f       ); }
+void autotest_fresamp_crcf_block_3p7()  { testbench_fresamp_crcf_block(3.71234f   ); }
@@ -24,6 +24,7 @@
 // iirfilt_xxxf_autotest.c : test floating-point filters
 //
 
+#include <string.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -108,3 +109,83 @@ void autotest_iirfilt_cccf_h7x64()
 }
 
 
+
+// 
+// AUTOTEST: block execution matches sample-by-sample execution
+//
+void autotest_iirfilt_rrrf_sos_block()
+{
+    unsigned int n = 97;
+    unsigned int order;
+    for (order=1; order<=11; order++) {
+        iirfilt_rrrf q0 = iirfilt_rrrf_create_prototype(LIQUID_IIRDES_ELLIP,
+            LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_SOS, order, 0.1f, 0.0f, 1.0f, 60.0f);
+        iirfilt_rrrf q1 = iirfilt_rrrf_create_prototype(LIQUID_IIRDES_ELLIP,
+            LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_SOS, order, 0.1f, 0.0f, 1.0f, 60.0f);
+
+        float x[n], y0[n], y1[n];
+        unsigned int i;
+        for (i=0; i<n; i++) {
+            x[i] = randnf();
+            iirfilt_rrrf_execute(q0, x[i], &y0[i]);
+        }
+
+        // run block in two parts, second one in place
+        iirfilt_rrrf_execute_block(q1, x, 3, y1);
+        memmove(y1+3, x+3, (n-3)*sizeof(float));
+        iirfilt_rrrf_execute_block(q1, y1+3, n-3, y1+3);
+        CONTEND_SAME_DATA(y0, y1, n*sizeof(float));
+
+        iirfilt_rrrf_destroy(q0);
+        iirfilt_rrrf_destroy(q1);
+    }
+}
+
+void autotest_iirfilt_crcf_sos_block()
+{
+    unsigned int n = 97;
+    unsigned int order;
+    for (order=1; order<=7; order++) {
+        iirfilt_crcf q0 = iirfilt_crcf_create_prototype(LIQUID_IIRDES_CHEBY1,
+            LIQUID_IIRDES_BANDPASS, LIQUID_IIRDES_SOS, order, 0.1f, 0.25f, 1.0f, 60.0f);
+        iirfilt_crcf q1 = iirfilt_crcf_create_prototype(LIQUID_IIRDES_CHEBY1,
+            LIQUID_IIRDES_BANDPASS, LIQUID_IIRDES_SOS, order, 0.1f, 0.25f, 1.0f, 60.0f);
+
+        float complex x[n], y0[n], y1[n];
+        unsigned int i;
+        for (i=0; i<n; i++) {
+            x[i] = randnf() + _Complex_I*randnf();
+            iirfilt_crcf_execute(q0, x[i], &y0[i]);
+        }
+        iirfilt_crcf_execute_block(q1, x, 40, y1);
+        iirfilt_crcf_execute_block(q1, x+40, n-40, y1+40);
+        CONTEND_SAME_DATA(y0, y1, n*sizeof(float complex));
+
+        iirfilt_crcf_destroy(q0);
+        iirfilt_crcf_destroy(q1);
+    }
+}
+
+void autotest_iirfilt_crcf_dcblock_block()
+{
+    unsigned int n = 200;
+    iirfilt_crcf q0 = iirfilt_crcf_create_dc_blocker(0.1f);
+    iirfilt_crcf q1 = iirfilt_crcf_create_dc_blocker(0.1f);
+
+    float complex x[n], y0[n], y1[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        x[i] = 1.0f + 0.1f*(randnf() + _Complex_I*randnf());
+        iirfilt_crcf_execute(q0, x[i], &y0[i]);
+    }
+    iirfilt_crcf_execute_block(q1, x, n/2, y1);
+    iirfilt_crcf_execute_block(q1, x+n/2, n/2, y1+n/2);
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA(crealf(y0[i]), crealf(y1[i]), 1e-6f);
+        CONTEND_DELTA(cimagf(y0[i]), cimagf(y1[i]), 1e-6f);
+    }
+
+    iirfilt_crcf_destroy(q0);
+    iirfilt_crcf_destroy(q1);
+}
+
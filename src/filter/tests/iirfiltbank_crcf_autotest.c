@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare multi-channel filter bank against independent iirfilt
+// objects; results should be identical
+void testbench_iirfiltbank_crcf(unsigned int _num_channels,
+                                unsigned int _order,
+                                unsigned int _block_len)
+{
+    unsigned int num_blocks = 8;
+
+    iirfiltbank_crcf q = iirfiltbank_crcf_create_prototype(
+            LIQUID_IIRDES_ELLIP, LIQUID_IIRDES_BANDPASS,
+            _order, 0.1f, 0.2f, 1.0f, 60.0f, _num_channels);
+    CONTEND_EQUALITY(iirfiltbank_crcf_get_num_channels(q), _num_channels);
+
+    iirfilt_crcf filt[_num_channels];
+    unsigned int i, k, b;
+    for (k=0; k<_num_channels; k++) {
+        filt[k] = iirfilt_crcf_create_prototype(
+                LIQUID_IIRDES_ELLIP, LIQUID_IIRDES_BANDPASS, LIQUID_IIRDES_SOS,
+                _order, 0.1f, 0.2f, 1.0f, 60.0f);
+    }
+
+    float complex x[_block_len*_num_channels];
+    float complex y[_block_len*_num_channels];
+    float complex y_test[_block_len*_num_channels];
+    for (b=0; b<num_blocks; b++) {
+        for (i=0; i<_block_len*_num_channels; i++)
+            x[i] = randnf() + _Complex_I*randnf();
+
+        // run filter bank (alternating between single-step and block)
+        if (b % 2) {
+            for (i=0; i<_block_len; i++)
+                iirfiltbank_crcf_execute(q, &x[i*_num_channels], &y[i*_num_channels]);
+        } else {
+            iirfiltbank_crcf_execute_block(q, x, _block_len, y);
+        }
+
+        // run individual filters
+        for (i=0; i<_block_len; i++) {
+            for (k=0; k<_num_channels; k++) {
+                iirfilt_crcf_execute(filt[k], x[i*_num_channels+k],
+                                     &y_test[i*_num_channels+k]);
+            }
+        }
+
+        CONTEND_SAME_DATA(y, y_test, _block_len*_num_channels*sizeof(float complex));
+    }
+
+    iirfiltbank_crcf_destroy(q);
+    for (k=0; k<_num_channels; k++)
+        iirfilt_crcf_destroy(filt[k]);
+}
+
+void autotest_iirfiltbank_crcf_c1_o3()  { testbench_iirfiltbank_crcf( 1, 3, 40); }
+void autotest_iirfiltbank_crcf_c2_o4()  { testbench_iirfiltbank_crcf( 2, 4, 40); }
+void autotest_iirfiltbank_crcf_c3_o5()  { testbench_iirfiltbank_crcf( 3, 5, 40); }
+void autotest_iirfiltbank_crcf_c8_o4()  { testbench_iirfiltbank_crcf( 8, 4, 40); }
+void autotest_iirfiltbank_crcf_c13_o7() { testbench_iirfiltbank_crcf(13, 7, 40); }
+
+// in-place operation on real-valued bank
+void autotest_iirfiltbank_rrrf_inplace()
+{
+    unsigned int num_channels = 7;
+    unsigned int n            = 50;
+
+    iirfiltbank_rrrf q = iirfiltbank_rrrf_create_prototype(
+            LIQUID_IIRDES_CHEBY2, LIQUID_IIRDES_LOWPASS,
+            5, 0.15f, 0.0f, 1.0f, 50.0f, num_channels);
+    iirfilt_rrrf filt = iirfilt_rrrf_create_prototype(
+            LIQUID_IIRDES_CHEBY2, LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_SOS,
+            5, 0.15f, 0.0f, 1.0f, 50.0f);
+
+    // only last channel is non-zero
+    float buf[n*num_channels];
+    float y_test[n];
+    unsigned int i;
+    memset(buf, 0x00, sizeof(buf));
+    for (i=0; i<n; i++) {
+        buf[i*num_channels + num_channels-1] = randnf();
+        iirfilt_rrrf_execute(filt, buf[i*num_channels + num_channels-1], &y_test[i]);
+    }
+
+    iirfiltbank_rrrf_execute_block(q, buf, n, buf);
+    for (i=0; i<n; i++) {
+        CONTEND_EQUALITY(buf[i*num_channels + 0], 0.0f);
+        CONTEND_EQUALITY(buf[i*num_channels + num_channels-1], y_test[i]);
+    }
+
+    iirfiltbank_rrrf_destroy(q);
+    iirfilt_rrrf_destroy(filt);
+}
+
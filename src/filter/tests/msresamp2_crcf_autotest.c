@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare block execution to single execution
+void testbench_msresamp2_crcf_block(int          _type,
+                                    unsigned int _num_stages)
+{
+    float tol = 1e-4f;
+    unsigned int M = 1 << _num_stages;
+    unsigned int n = 2000 / M + 3;   // number of executions
+    int interp = _type == LIQUID_RESAMP_INTERP;
+    unsigned int nx = interp ? n : n*M;
+    unsigned int ny = interp ? n*M : n;
+    float complex * x  = (float complex*) malloc(nx*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(ny*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(ny*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<nx; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    msresamp2_crcf q0 = msresamp2_crcf_create(_type, _num_stages, 0.4f, 0.0f, 60.0f);
+    msresamp2_crcf q1 = msresamp2_crcf_create(_type, _num_stages, 0.4f, 0.0f, 60.0f);
+    unsigned int mx = interp ? 1 : M;
+    unsigned int my = interp ? M : 1;
+    for (i=0; i<n; i++)
+        msresamp2_crcf_execute(q0, x + i*mx, y0 + i*my);
+    for (i=0; i<n; ) {
+        unsigned int k = 1 + rand() % (4096/M + 1);
+        if (k > n - i) k = n - i;
+        msresamp2_crcf_execute_block(q1, x + i*mx, k, y1 + i*my);
+        i += k;
+    }
+    for (i=0; i<ny; i++) {
+        CONTEND_DELTA(crealf(y0[i]), crealf(y1[i]), tol);
+        CONTEND_DELTA(cimagf(y0[i]), cimagf(y1[i]), tol);
+    }
+
+    msresamp2_crcf_destroy(q0);
+    msresamp2_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_msresamp2_crcf_decim_block_s1()  { testbench_msresamp2_crcf_block(LIQUID_RESAMP_DECIM,  1); }
+void autotest_msresamp2_crcf_decim_block_s4()  { testbench_msresamp2_crcf_block(LIQUID_RESAMP_DECIM,  4); }
+void autotest_msresamp2_crcf_decim_block_s11() { testbench_msresamp2_crcf_block(LIQUID_RESAMP_DECIM, 11); }
+void autotest_msresamp2_crcf_interp_block_s1() { testbench_msresamp2_crcf_block(LIQUID_RESAMP_INTERP, 1); }
+void autotest_msresamp2_crcf_interp_block_s4() { testbench_msresamp2_crcf_block(LIQUID_RESAMP_INTERP, 4); }
+void autotest_msresamp2_crcf_interp_block_s11(){ testbench_msresamp2_crcf_block(LIQUID_RESAMP_INTERP,11); }
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -173,3 +174,88 @@ void autotest_resamp2_synthesis()
     printf("results written to '%s'\n","resamp2_test.m");
 #endif
 }
+
+// compare block decimator/interpolator to single-sample execution
+void autotest_resamp2_crcf_block()
+{
+    unsigned int m = 7;
+    unsigned int n = 700;
+    float tol = 1e-5f;
+    float complex x[2*n];
+    float complex y0[2*n];
+    float complex y1[2*n];
+    unsigned int i;
+    for (i=0; i<2*n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // decimator, processing blocks of random size
+    resamp2_crcf q0 = resamp2_crcf_create(m, 0.0f, 60.0f);
+    resamp2_crcf q1 = resamp2_crcf_create(m, 0.0f, 60.0f);
+    for (i=0; i<n; i++)
+        resamp2_crcf_decim_execute(q0, &x[2*i], &y0[i]);
+    for (i=0; i<n; ) {
+        unsigned int k = rand() % 300;
+        if (k > n - i) k = n - i;
+        resamp2_crcf_decim_execute_block(q1, &x[2*i], k, &y1[i]);
+        i += k;
+    }
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA(crealf(y0[i]), crealf(y1[i]), tol);
+        CONTEND_DELTA(cimagf(y0[i]), cimagf(y1[i]), tol);
+    }
+
+    // interpolator, mixing block and single-sample calls
+    resamp2_crcf_reset(q0);
+    resamp2_crcf_reset(q1);
+    for (i=0; i<n; i++)
+        resamp2_crcf_interp_execute(q0, x[i], &y0[2*i]);
+    resamp2_crcf_interp_execute_block(q1, x, 300, y1);
+    resamp2_crcf_interp_execute(q1, x[300], &y1[600]);
+    resamp2_crcf_interp_execute_block(q1, x+301, n-301, y1+602);
+    for (i=0; i<2*n; i++) {
+        CONTEND_DELTA(crealf(y0[i]), crealf(y1[i]), tol);
+        CONTEND_DELTA(cimagf(y0[i]), cimagf(y1[i]), tol);
+    }
+
+    resamp2_crcf_destroy(q0);
+    resamp2_crcf_destroy(q1);
+}
+
+// real and complex-coefficient block kernels
+void autotest_resamp2_rrrf_cccf_block()
+{
+    unsigned int m = 9;
+    unsigned int n = 400;
+    float tol = 1e-5f;
+    unsigned int i;
+
+    // real
+    float x[2*n], y0[n], y1[n];
+    for (i=0; i<2*n; i++)
+        x[i] = randnf();
+    resamp2_rrrf r0 = resamp2_rrrf_create(m, 0.0f, 60.0f);
+    resamp2_rrrf r1 = resamp2_rrrf_create(m, 0.0f, 60.0f);
+    for (i=0; i<n; i++)
+        resamp2_rrrf_decim_execute(r0, &x[2*i], &y0[i]);
+    resamp2_rrrf_decim_execute_block(r1, x, n, y1);
+    for (i=0; i<n; i++)
+        CONTEND_DELTA(y0[i], y1[i], tol);
+    resamp2_rrrf_destroy(r0);
+    resamp2_rrrf_destroy(r1);
+
+    // complex coefficients (shifted center frequency)
+    float complex v[n], z0[2*n], z1[2*n];
+    for (i=0; i<n; i++)
+        v[i] = randnf() + _Complex_I*randnf();
+    resamp2_cccf c0 = resamp2_cccf_create(m, 0.1f, 60.0f);
+    resamp2_cccf c1 = resamp2_cccf_create(m, 0.1f, 60.0f);
+    for (i=0; i<n; i++)
+        resamp2_cccf_interp_execute(c0, v[i], &z0[2*i]);
+    resamp2_cccf_interp_execute_block(c1, v, n, z1);
+    for (i=0; i<2*n; i++) {
+        CONTEND_DELTA(crealf(z0[i]), crealf(z1[i]), tol);
+        CONTEND_DELTA(cimagf(z0[i]), cimagf(z1[i]), tol);
+    }
+    resamp2_cccf_destroy(c0);
+    resamp2_cccf_destroy(c1);
+}
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -165,3 +166,51 @@ void autotest_resamp_crcf()
     printf("results written to %s\n",filename);
 #endif
 }
+
+// block execution matches single-sample execution and output count query
+void testbench_resamp_crcf_block(float _rate)
+{
+    unsigned int n = 3000;
+    float complex x[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    resamp_crcf q0 = resamp_crcf_create(_rate, 11, 0.4f, 60.0f, 64);
+    resamp_crcf q1 = resamp_crcf_create(_rate, 11, 0.4f, 60.0f, 64);
+    unsigned int ny_max = (unsigned int)(n*_rate) + 4;
+    float complex * y0 = (float complex*) malloc(ny_max*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(ny_max*sizeof(float complex));
+
+    // single-sample execution
+    unsigned int ny0 = 0, num_written;
+    for (i=0; i<n; i++) {
+        resamp_crcf_execute(q0, x[i], &y0[ny0], &num_written);
+        ny0 += num_written;
+    }
+
+    // blocks of random length, checking output count query
+    unsigned int ny1 = 0;
+    for (i=0; i<n; ) {
+        unsigned int k = rand() % 1200;
+        if (k > n - i) k = n - i;
+        unsigned int num_expected = resamp_crcf_get_num_output(q1, k);
+        resamp_crcf_execute_block(q1, x + i, k, y1 + ny1, &num_written);
+        CONTEND_EQUALITY(num_written, num_expected);
+        ny1 += num_written;
+        i   += k;
+    }
+
+    CONTEND_EQUALITY(ny0, ny1);
+    CONTEND_SAME_DATA(y0, y1, ny0*sizeof(float complex));
+
+    resamp_crcf_destroy(q0);
+    resamp_crcf_destroy(q1);
+    free(y0);
+    free(y1);
+}
+
+void autotest_resamp_crcf_block_0p1()   { testbench_resamp_crcf_block(0.1f       ); }
+void autotest_resamp_crcf_block_0p73()  { testbench_resamp_crcf_block(0.73120542f); }
+void autotest_resamp_crcf_block_1p0()   { testbench_resamp_crcf_block(1.0f       ); }
+void autotest_resamp_crcf_block_3p7()   { testbench_resamp_crcf_block(3.71234f   ); }
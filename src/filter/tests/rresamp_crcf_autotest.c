@@ -192,3 +192,64 @@ void autotest_rresamp_crcf_P6_Q5() { test_harness_rresamp_crcf( 6, 5, 15, 0.4f,
 void autotest_rresamp_crcf_P8_Q5() { test_harness_rresamp_crcf( 8, 5, 15, 0.4f, 60.0f); }
 void autotest_rresamp_crcf_P9_Q5() { test_harness_rresamp_crcf( 9, 5, 15, 0.4f, 60.0f); }
 
+
+// compare block execution against polyphase filterbank reference
+void test_harness_rresamp_crcf_block(unsigned int _P,
+                                     unsigned int _Q,
+                                     unsigned int _m,
+                                     unsigned int _num_blocks)
+{
+    unsigned int  nx = _num_blocks * _Q;    // number of input samples
+    unsigned int  ny = _num_blocks * _P;    // number of output samples
+    unsigned int  h_len = 2*_P*_m;          // filter length
+    unsigned int  i;
+
+    // random filter coefficients and input
+    float h[h_len];
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+    float complex x[nx];
+    for (i=0; i<nx; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // create objects
+    rresamp_crcf q   = rresamp_crcf_create(_P, _Q, _m, h);
+    firpfb_crcf  pfb = firpfb_crcf_create(_P, h, h_len);
+    rresamp_crcf_set_scale(q,   0.7f);
+    firpfb_crcf_set_scale (pfb, 0.7f);
+
+    // reference: push each input and produce outputs at schedule index
+    float complex y_ref[ny];
+    unsigned int index = 0, n = 0;
+    for (i=0; i<nx; i++) {
+        firpfb_crcf_push(pfb, x[i]);
+        while (index < _P) {
+            firpfb_crcf_execute(pfb, index, &y_ref[n++]);
+            index += _Q;
+        }
+        index -= _P;
+    }
+
+    // run all blocks at once
+    float complex y_block[ny];
+    rresamp_crcf_execute_block(q, x, _num_blocks, y_block);
+
+    // run one block at a time
+    float complex y_single[ny];
+    rresamp_crcf_reset(q);
+    for (i=0; i<_num_blocks; i++)
+        rresamp_crcf_execute(q, &x[i*_Q], &y_single[i*_P]);
+
+    CONTEND_EQUALITY(n, ny);
+    CONTEND_SAME_DATA(y_block,  y_ref, ny*sizeof(float complex));
+    CONTEND_SAME_DATA(y_single, y_ref, ny*sizeof(float complex));
+
+    // clean up allocated objects
+    rresamp_crcf_destroy(q);
+    firpfb_crcf_destroy(pfb);
+}
+
+void autotest_rresamp_crcf_block_P1_Q1()   { test_harness_rresamp_crcf_block(  1,   1, 7, 1200); }
+void autotest_rresamp_crcf_block_P3_Q2()   { test_harness_rresamp_crcf_block(  3,   2, 5,  700); }
+void autotest_rresamp_crcf_block_P24_Q25() { test_harness_rresamp_crcf_block( 24,  25, 9,  100); }
+void autotest_rresamp_crcf_block_P17_Q256(){ test_harness_rresamp_crcf_block( 17, 256, 4,   10); }
@@ -171,3 +171,80 @@ void autotest_symsync_rrrf_scenario_1() { symsync_rrrf_test(2, 7, 0.35, -0.25, 1
 void autotest_symsync_rrrf_scenario_2() { symsync_rrrf_test(2, 7, 0.35, -0.25, 1.0001f ); }
 void autotest_symsync_rrrf_scenario_3() { symsync_rrrf_test(2, 7, 0.35, -0.25, 0.9999f ); }
 
+
+// test that running the synchronizer in blocks of arbitrary size (in
+// particular across internal buffer boundaries) gives exactly the same
+// result as running it one sample at a time
+void symsync_rrrf_test_block(unsigned int _k,
+                             unsigned int _m,
+                             unsigned int _block_len)
+{
+    unsigned int k           = _k;      // samples/symbol
+    unsigned int m           = _m;      // filter delay (symbols)
+    float        beta        = 0.35f;   // filter excess bandwidth factor
+    unsigned int num_filters = 32;      // number of filters in the bank
+    unsigned int num_symbols = 1200;    // number of data symbols
+    unsigned int num_samples = k*num_symbols;
+
+    unsigned int i;
+    float s[num_symbols];               // data symbols
+    float x[num_samples];               // interpolated samples
+    float y0[num_samples+64];           // output (one sample at a time)
+    float y1[num_samples+64];           // output (blocks)
+    float tau0[num_samples];            // timing phase after each sample
+
+    // generate BPSK symbols, interpolate with a fractional offset, and
+    // add noise so the timing loop keeps moving
+    for (i=0; i<num_symbols; i++)
+        s[i] = randf() < 0.5f ? 1.0f : -1.0f;
+    firinterp_rrrf interp = firinterp_rrrf_create_prototype(LIQUID_FIRFILT_ARKAISER,k,m,beta,0.3f);
+    firinterp_rrrf_execute_block(interp, s, num_symbols, x);
+    firinterp_rrrf_destroy(interp);
+    for (i=0; i<num_samples; i++)
+        x[i] += 0.05f*randnf();
+
+    // run synchronizer one sample at a time
+    symsync_rrrf sync = symsync_rrrf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, k, m, beta, num_filters);
+    symsync_rrrf_set_lf_bw(sync, 0.02f);
+    unsigned int n0 = 0;
+    for (i=0; i<num_samples; i++) {
+        unsigned int nw;
+        symsync_rrrf_execute(sync, &x[i], 1, &y0[n0], &nw);
+        n0 += nw;
+        tau0[i] = symsync_rrrf_get_tau(sync);
+    }
+
+    // reset and run synchronizer in blocks
+    symsync_rrrf_reset(sync);
+    unsigned int n1 = 0;
+    unsigned int num_consumed = 0;
+    while (num_consumed < num_samples) {
+        unsigned int num_remaining = num_samples - num_consumed;
+        unsigned int num_block     = num_remaining < _block_len ? num_remaining : _block_len;
+        unsigned int nw;
+        symsync_rrrf_execute(sync, &x[num_consumed], num_block, &y1[n1], &nw);
+        n1 += nw;
+        num_consumed += num_block;
+
+        // timing phase must match at every block boundary
+        CONTEND_EQUALITY( symsync_rrrf_get_tau(sync), tau0[num_consumed-1] );
+    }
+    symsync_rrrf_destroy(sync);
+
+    if (liquid_autotest_verbose)
+        printf("symsync_rrrf_test_block(%u), %u / %u symbols\n", _block_len, n1, n0);
+
+    // outputs must be identical
+    CONTEND_GREATER_THAN( n0, num_symbols/2 );
+    CONTEND_EQUALITY( n1, n0 );
+    for (i=0; i<n0 && i<n1; i++)
+        CONTEND_EQUALITY( y1[i], y0[i] );
+}
+
+// block sizes below, at, and above the internal buffer length (256)
+void autotest_symsync_rrrf_block_1()    { symsync_rrrf_test_block(2, 7,    1); }
+void autotest_symsync_rrrf_block_255()  { symsync_rrrf_test_block(2, 7,  255); }
+void autotest_symsync_rrrf_block_256()  { symsync_rrrf_test_block(2, 7,  256); }
+void autotest_symsync_rrrf_block_257()  { symsync_rrrf_test_block(2, 7,  257); }
+void autotest_symsync_rrrf_block_1000() { symsync_rrrf_test_block(2, 7, 1000); }
+void autotest_symsync_rrrf_block_all()  { symsync_rrrf_test_block(2, 7, 2400); }
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <math.h>
+#include "liquid.h"
+
+// receive chain: mix down, decimate by 2, agc, framesync64
+typedef struct {
+    float complex * x;          // received samples
+    unsigned int    n;          // number of samples
+    unsigned int    index;      // read index
+    unsigned int    num_valid;  // number of valid frames
+} flowgraph_bench_data;
+
+static int flowgraph_bench_callback(unsigned char *  _header,
+                                    int              _header_valid,
+                                    unsigned char *  _payload,
+                                    unsigned int     _payload_len,
+                                    int              _payload_valid,
+                                    framesyncstats_s _stats,
+                                    void *           _userdata)
+{
+    ((flowgraph_bench_data*)_userdata)->num_valid += _payload_valid ? 1 : 0;
+    return 0;
+}
+
+static unsigned int flowgraph_bench_source(void * _userdata, void * _x, unsigned int _nx, void * _y)
+{
+    flowgraph_bench_data * d = (flowgraph_bench_data*) _userdata;
+    unsigned int n = d->n - d->index < _nx ? d->n - d->index : _nx;
+    memmove(_y, d->x + d->index, n*sizeof(float complex));
+    d->index += n;
+    return n;
+}
+
+// Helper function to keep code base small
+//  _num_threads    :   number of threads (0: hand-written loop)
+void flowgraph_rx_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _num_threads)
+{
+    unsigned long int i;
+    unsigned int num_frames = 16;
+    unsigned int block_len  = 1024;
+    *_num_iterations /= 256*num_frames;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // generate frames, interpolate by 2 and shift in frequency
+    unsigned int frame_len   = LIQUID_FRAME64_LEN;
+    unsigned int num_samples = 2*num_frames*frame_len;
+    float complex * frame = (float complex*) malloc(frame_len*sizeof(float complex));
+    float complex * x     = (float complex*) malloc(num_samples*sizeof(float complex));
+    framegen64     fg     = framegen64_create();
+    firinterp_crcf interp = firinterp_crcf_create_prototype(LIQUID_FIRFILT_ARKAISER, 2, 7, 0.3f, 0);
+    for (i=0; i<num_frames; i++) {
+        framegen64_execute(fg, NULL, NULL, frame);
+        firinterp_crcf_execute_block(interp, frame, frame_len, x + 2*i*frame_len);
+    }
+    for (i=0; i<num_samples; i++) {
+        x[i] *= cexpf(_Complex_I*0.05f*i);
+        x[i] += 0.01f*(randnf() + _Complex_I*randnf());
+    }
+    framegen64_destroy(fg);
+    firinterp_crcf_destroy(interp);
+
+    // receiver objects
+    flowgraph_bench_data d = {x, num_samples, 0, 0};
+    nco_crcf      nco   = nco_crcf_create(LIQUID_VCO);
+    firdecim_crcf decim = firdecim_crcf_create_kaiser(2, 7, 60.0f);
+    agc_crcf      agc   = agc_crcf_create();
+    framesync64   fs    = framesync64_create(flowgraph_bench_callback, &d);
+    nco_crcf_set_frequency(nco, 0.05f);
+    agc_crcf_set_bandwidth(agc, 1e-3f);
+
+    // build graph
+    flowgraph g = flowgraph_create(block_len);
+    unsigned int n0 = flowgraph_add_node(g, "source", LIQUID_FLOWGRAPH_NONE, LIQUID_FLOWGRAPH_CFLOAT,
+                                         1, 1, flowgraph_bench_source, &d);
+    unsigned int n1 = flowgraph_add_nco_crcf_mix_down(g, nco);
+    unsigned int n2 = flowgraph_add_firdecim_crcf(g, decim, 2);
+    unsigned int n3 = flowgraph_add_agc_crcf(g, agc);
+    unsigned int n4 = flowgraph_add_framesync64(g, fs);
+    flowgraph_connect(g, n0, n1);
+    flowgraph_connect(g, n1, n2);
+    flowgraph_connect(g, n2, n3);
+    flowgraph_connect(g, n3, n4);
+
+    float complex buf_0[block_len];
+    float complex buf_1[block_len];
+    struct timeval t0, t1;
+    gettimeofday(&t0, NULL);
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        d.index = 0;
+        if (_num_threads == 0) {
+            // hand-written loop
+            unsigned int n;
+            for (n=0; n<num_samples; n+=block_len) {
+                unsigned int nx = num_samples - n < block_len ? num_samples - n : block_len;
+                nco_crcf_mix_block_down(nco, x + n, buf_0, nx);
+                firdecim_crcf_execute_block(decim, buf_0, nx/2, buf_1);
+                agc_crcf_execute_block(agc, buf_1, nx/2, buf_0);
+                framesync64_execute(fs, buf_0, nx/2);
+            }
+        } else {
+            flowgraph_run(g, _num_threads);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    gettimeofday(&t1, NULL);
+    *_num_iterations *= num_frames;
+
+    printf("  frames valid/transmitted : %6u / %6lu, wall time %.3f s\n",
+            d.num_valid, *_num_iterations,
+            (t1.tv_sec - t0.tv_sec) + 1e-6f*(t1.tv_usec - t0.tv_usec));
+
+    flowgraph_destroy(g);
+    nco_crcf_destroy(nco);
+    firdecim_crcf_destroy(decim);
+    agc_crcf_destroy(agc);
+    framesync64_destroy(fs);
+    free(frame);
+    free(x);
+}
+
+#define FLOWGRAPH_BENCH_API(NUM_THREADS)        \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ flowgraph_rx_bench(_start, _finish, _num_iterations, NUM_THREADS); }
+
+// reported time is processor time summed across threads
+void benchmark_flowgraph_rx_loop     FLOWGRAPH_BENCH_API(0)
+void benchmark_flowgraph_rx_graph_t1 FLOWGRAPH_BENCH_API(1)
+void benchmark_flowgraph_rx_graph_t4 FLOWGRAPH_BENCH_API(4)
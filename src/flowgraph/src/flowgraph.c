@@ -0,0 +1,553 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// flowgraph : streaming processing graph
+//
+// Nodes wrap a block-processing callback and are connected through
+// fixed-size sample buffers. A node is ready to run once its input
+// buffer holds a full block (or its source has finished) and each of
+// its output buffers has room for the largest block it can produce;
+// the latter provides back-pressure on upstream nodes. Each node runs
+// on at most one thread at a time, and so with several worker threads
+// different nodes of a chain run concurrently (pipelining). Samples
+// are copied into and out of per-node buffers while holding the graph
+// lock so that callbacks run without it.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_PTHREADS_ENABLED
+#include <pthread.h>
+#endif
+
+#define FLOWGRAPH_NAME_LEN  (32)
+
+// connection between nodes
+struct flowgraph_fifo_s {
+    unsigned int    src;            // source node index
+    unsigned int    dst;            // destination node index
+    unsigned int    capacity;       // buffer capacity (samples)
+    unsigned int    read_index;     // index of oldest sample
+    unsigned int    count;          // number of samples in buffer
+    unsigned char * buf;            // sample buffer
+};
+
+// processing node
+struct flowgraph_node_s {
+    char                  name[FLOWGRAPH_NAME_LEN];
+    liquid_flowgraph_type type_in;  // input port type
+    liquid_flowgraph_type type_out; // output port type
+    unsigned int          interp;   // output samples per _decim inputs
+    unsigned int          decim;    // input sample granularity
+    flowgraph_callback    callback; // execution callback
+    void *                userdata; // user data passed to callback
+    void *                adapter;  // adapter state owned by graph (or NULL)
+
+    int             input;          // index of input connection (-1 if none)
+    unsigned int    max_in;         // maximum input samples per execution
+    unsigned int    max_out;        // maximum output samples per execution
+    unsigned char * buf_in;         // input block
+    unsigned char * buf_out;        // output block
+    unsigned int    nx;             // number of samples in input block
+    int             busy;           // node is being executed
+    int             done;           // node has finished
+    unsigned int    num_executions; // execution counter
+};
+
+struct flowgraph_s {
+    unsigned int              block_len;    // nominal block length
+    struct flowgraph_node_s * nodes;        // nodes
+    unsigned int              num_nodes;    // number of nodes
+    struct flowgraph_fifo_s * fifos;        // connections
+    unsigned int              num_fifos;    // number of connections
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_t           mutex;        // graph lock
+    pthread_cond_t            cond;         // signaled on node completion
+#endif
+};
+
+//
+// internal methods
+//
+
+// get size of a single sample of type _type (bytes)
+unsigned int flowgraph_type_size(liquid_flowgraph_type _type);
+
+// compute block sizes, allocate buffers and reset run state
+void flowgraph_prepare(flowgraph _g);
+
+// update node completion flags, returning number of active nodes
+unsigned int flowgraph_update(flowgraph _g);
+
+// find node ready to run, setting its input length; returns -1 if none
+int flowgraph_select(flowgraph _g);
+
+// pop input block from connection (locked)
+void flowgraph_begin(flowgraph _g, unsigned int _i);
+
+// push output block to connections and release node (locked)
+void flowgraph_commit(flowgraph _g, unsigned int _i, unsigned int _ny);
+
+#if LIQUID_PTHREADS_ENABLED
+// worker thread
+void * flowgraph_worker(void * _g);
+#endif
+
+// create flowgraph object
+//  _block_len  :   maximum number of input samples per node execution
+flowgraph flowgraph_create(unsigned int _block_len)
+{
+    // validate input
+    if (_block_len == 0) {
+        fprintf(stderr,"error: flowgraph_create(), block length must be greater than zero\n");
+        exit(1);
+    }
+
+    flowgraph g = (flowgraph) malloc(sizeof(struct flowgraph_s));
+    g->block_len = _block_len;
+    g->nodes     = NULL;
+    g->num_nodes = 0;
+    g->fifos     = NULL;
+    g->num_fifos = 0;
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_init(&g->mutex, NULL);
+    pthread_cond_init (&g->cond,  NULL);
+#endif
+    return g;
+}
+
+// destroy flowgraph object, freeing all internal memory; objects
+// wrapped by nodes are not destroyed
+void flowgraph_destroy(flowgraph _g)
+{
+    unsigned int i;
+    for (i=0; i<_g->num_nodes; i++) {
+        free(_g->nodes[i].adapter);
+        free(_g->nodes[i].buf_in);
+        free(_g->nodes[i].buf_out);
+    }
+    for (i=0; i<_g->num_fifos; i++)
+        free(_g->fifos[i].buf);
+    free(_g->nodes);
+    free(_g->fifos);
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_destroy(&_g->mutex);
+    pthread_cond_destroy (&_g->cond);
+#endif
+    free(_g);
+}
+
+// print flowgraph object
+void flowgraph_print(flowgraph _g)
+{
+    printf("flowgraph [block: %u, %u nodes, %u connections]:\n",
+            _g->block_len, _g->num_nodes, _g->num_fifos);
+    unsigned int i;
+    for (i=0; i<_g->num_nodes; i++) {
+        struct flowgraph_node_s * node = &_g->nodes[i];
+        printf("  %3u : %-24s rate %u/%u", i, node->name, node->interp, node->decim);
+        if (node->input >= 0)
+            printf(", input from %u", _g->fifos[node->input].src);
+        printf("\n");
+    }
+}
+
+// add generic node to graph, returning node index
+unsigned int flowgraph_add_node(flowgraph             _g,
+                                const char *          _name,
+                                liquid_flowgraph_type _type_in,
+                                liquid_flowgraph_type _type_out,
+                                unsigned int          _interp,
+                                unsigned int          _decim,
+                                flowgraph_callback    _callback,
+                                void *                _userdata)
+{
+    // validate input
+    if (_interp == 0 || _decim == 0) {
+        fprintf(stderr,"error: flowgraph_add_node(), rate parameters must be greater than zero\n");
+        exit(1);
+    } else if (_callback == NULL) {
+        fprintf(stderr,"error: flowgraph_add_node(), callback cannot be NULL\n");
+        exit(1);
+    } else if (_type_in == LIQUID_FLOWGRAPH_NONE && _type_out == LIQUID_FLOWGRAPH_NONE) {
+        fprintf(stderr,"error: flowgraph_add_node(), node must have at least one port\n");
+        exit(1);
+    }
+
+    _g->num_nodes++;
+    _g->nodes = (struct flowgraph_node_s*) realloc(_g->nodes,
+                            _g->num_nodes*sizeof(struct flowgraph_node_s));
+    struct flowgraph_node_s * node = &_g->nodes[_g->num_nodes-1];
+    memset(node, 0x00, sizeof(struct flowgraph_node_s));
+
+    strncpy(node->name, _name == NULL ? "node" : _name, FLOWGRAPH_NAME_LEN-1);
+    node->type_in  = _type_in;
+    node->type_out = _type_out;
+    node->interp   = _interp;
+    node->decim    = _decim;
+    node->callback = _callback;
+    node->userdata = _userdata;
+    node->adapter  = NULL;
+    node->input    = -1;
+    return _g->num_nodes-1;
+}
+
+// connect output of node _src to input of node _dst
+void flowgraph_connect(flowgraph    _g,
+                       unsigned int _src,
+                       unsigned int _dst)
+{
+    // validate input
+    if (_src >= _g->num_nodes || _dst >= _g->num_nodes) {
+        fprintf(stderr,"error: flowgraph_connect(), node index out of range\n");
+        exit(1);
+    } else if (_g->nodes[_src].type_out == LIQUID_FLOWGRAPH_NONE) {
+        fprintf(stderr,"error: flowgraph_connect(), node '%s' has no output port\n", _g->nodes[_src].name);
+        exit(1);
+    } else if (_g->nodes[_dst].type_in == LIQUID_FLOWGRAPH_NONE) {
+        fprintf(stderr,"error: flowgraph_connect(), node '%s' has no input port\n", _g->nodes[_dst].name);
+        exit(1);
+    } else if (_g->nodes[_src].type_out != _g->nodes[_dst].type_in) {
+        fprintf(stderr,"error: flowgraph_connect(), port types of '%s' and '%s' do not match\n",
+                _g->nodes[_src].name, _g->nodes[_dst].name);
+        exit(1);
+    } else if (_g->nodes[_dst].input >= 0) {
+        fprintf(stderr,"error: flowgraph_connect(), input of node '%s' is already connected\n", _g->nodes[_dst].name);
+        exit(1);
+    }
+
+    _g->num_fifos++;
+    _g->fifos = (struct flowgraph_fifo_s*) realloc(_g->fifos,
+                            _g->num_fifos*sizeof(struct flowgraph_fifo_s));
+    struct flowgraph_fifo_s * fifo = &_g->fifos[_g->num_fifos-1];
+    fifo->src        = _src;
+    fifo->dst        = _dst;
+    fifo->capacity   = 0;
+    fifo->read_index = 0;
+    fifo->count      = 0;
+    fifo->buf        = NULL;
+    _g->nodes[_dst].input = _g->num_fifos-1;
+}
+
+// run graph until all sources are exhausted and all buffers drained
+void flowgraph_run(flowgraph    _g,
+                   unsigned int _num_threads)
+{
+    flowgraph_prepare(_g);
+
+#if LIQUID_PTHREADS_ENABLED
+    // no benefit in having more threads than nodes
+    unsigned int num_threads = _num_threads < _g->num_nodes ? _num_threads : _g->num_nodes;
+    if (num_threads > 1) {
+        pthread_t threads[num_threads];
+        unsigned int i;
+        for (i=0; i<num_threads; i++) {
+            if (pthread_create(&threads[i], NULL, flowgraph_worker, (void*)_g) != 0) {
+                fprintf(stderr,"error: flowgraph_run(), could not create thread\n");
+                exit(1);
+            }
+        }
+        for (i=0; i<num_threads; i++)
+            pthread_join(threads[i], NULL);
+        return;
+    }
+#endif
+
+    // run on calling thread
+    while (flowgraph_update(_g) > 0) {
+        int i = flowgraph_select(_g);
+        if (i < 0) {
+            fprintf(stderr,"error: flowgraph_run(), graph stalled\n");
+            exit(1);
+        }
+        struct flowgraph_node_s * node = &_g->nodes[i];
+        flowgraph_begin(_g, i);
+        unsigned int ny = node->callback(node->userdata,
+                                         node->input < 0 ? NULL : node->buf_in,
+                                         node->nx,
+                                         node->buf_out);
+        flowgraph_commit(_g, i, ny);
+    }
+}
+
+// get number of times node has been executed during last run
+unsigned int flowgraph_get_num_executions(flowgraph    _g,
+                                          unsigned int _node)
+{
+    if (_node >= _g->num_nodes) {
+        fprintf(stderr,"error: flowgraph_get_num_executions(), node index out of range\n");
+        exit(1);
+    }
+    return _g->nodes[_node].num_executions;
+}
+
+// add node with adapter state owned by the graph; the callback is
+// invoked with a pointer to the adapter state
+unsigned int flowgraph_add_adapter(flowgraph             _g,
+                                   const char *          _name,
+                                   liquid_flowgraph_type _type_in,
+                                   liquid_flowgraph_type _type_out,
+                                   unsigned int          _interp,
+                                   unsigned int          _decim,
+                                   flowgraph_callback    _callback,
+                                   void *                _object,
+                                   unsigned int          _M)
+{
+    struct flowgraph_adapter_s * a = (struct flowgraph_adapter_s*)
+        malloc(sizeof(struct flowgraph_adapter_s));
+    a->q = _object;
+    a->M = _M;
+    unsigned int id = flowgraph_add_node(_g, _name, _type_in, _type_out,
+                                         _interp, _decim, _callback, a);
+    _g->nodes[id].adapter = a;
+    return id;
+}
+
+//
+// internal methods
+//
+
+// get size of a single sample of type _type (bytes)
+unsigned int flowgraph_type_size(liquid_flowgraph_type _type)
+{
+    switch (_type) {
+    case LIQUID_FLOWGRAPH_NONE:   return 0;
+    case LIQUID_FLOWGRAPH_FLOAT:  return sizeof(float);
+    case LIQUID_FLOWGRAPH_CFLOAT: return sizeof(float complex);
+    case LIQUID_FLOWGRAPH_BYTE:   return sizeof(unsigned char);
+    default:;
+    }
+    fprintf(stderr,"error: flowgraph_type_size(), invalid type\n");
+    exit(1);
+    return 0;
+}
+
+// compute block sizes, allocate buffers and reset run state
+void flowgraph_prepare(flowgraph _g)
+{
+    unsigned int i;
+
+    // block sizes
+    for (i=0; i<_g->num_nodes; i++) {
+        struct flowgraph_node_s * node = &_g->nodes[i];
+        if (node->type_in == LIQUID_FLOWGRAPH_NONE) {
+            // source: generate up to one block per execution
+            node->max_in  = 0;
+            node->max_out = _g->block_len;
+        } else {
+            if (node->input < 0) {
+                fprintf(stderr,"error: flowgraph_run(), input of node '%s' is not connected\n", node->name);
+                exit(1);
+            }
+            // whole multiple of decimation rate, with margin on output
+            // for timing recovery and arbitrary-rate resampling
+            unsigned int n = _g->block_len / node->decim;
+            if (n == 0) n = 1;
+            node->max_in  = n * node->decim;
+            node->max_out = node->type_out == LIQUID_FLOWGRAPH_NONE ? 0 :
+                            (n + 2) * node->interp + 4;
+        }
+        node->buf_in  = (unsigned char*) realloc(node->buf_in,
+                            node->max_in  * flowgraph_type_size(node->type_in));
+        node->buf_out = (unsigned char*) realloc(node->buf_out,
+                            node->max_out * flowgraph_type_size(node->type_out));
+        node->nx   = 0;
+        node->busy = 0;
+        node->done = 0;
+        node->num_executions = 0;
+    }
+
+    // connection buffers: large enough for the producer to write a
+    // full block while a block waits for the consumer
+    for (i=0; i<_g->num_fifos; i++) {
+        struct flowgraph_fifo_s * fifo = &_g->fifos[i];
+        struct flowgraph_node_s * src  = &_g->nodes[fifo->src];
+        struct flowgraph_node_s * dst  = &_g->nodes[fifo->dst];
+        fifo->capacity   = 2*(src->max_out + dst->max_in);
+        fifo->read_index = 0;
+        fifo->count      = 0;
+        fifo->buf = (unsigned char*) realloc(fifo->buf,
+                        fifo->capacity * flowgraph_type_size(src->type_out));
+    }
+}
+
+// update node completion flags, returning number of active nodes
+unsigned int flowgraph_update(flowgraph _g)
+{
+    unsigned int i;
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (i=0; i<_g->num_nodes; i++) {
+            struct flowgraph_node_s * node = &_g->nodes[i];
+            if (node->done || node->busy || node->input < 0)
+                continue;
+
+            // finished once upstream is done and no whole block remains;
+            // any remainder smaller than the input granularity is dropped
+            struct flowgraph_fifo_s * fifo = &_g->fifos[node->input];
+            if (_g->nodes[fifo->src].done && fifo->count < node->decim) {
+                fifo->count = 0;
+                node->done  = 1;
+                changed     = 1;
+            }
+        }
+    }
+
+    unsigned int num_active = 0;
+    for (i=0; i<_g->num_nodes; i++)
+        num_active += _g->nodes[i].done ? 0 : 1;
+    return num_active;
+}
+
+// find node ready to run, setting its input length; returns -1 if none
+int flowgraph_select(flowgraph _g)
+{
+    unsigned int i, j;
+
+    // search downstream nodes first to keep buffers drained
+    for (i=_g->num_nodes; i>0; i--) {
+        struct flowgraph_node_s * node = &_g->nodes[i-1];
+        if (node->done || node->busy)
+            continue;
+
+        // check input
+        unsigned int nx = node->max_out;
+        if (node->input >= 0) {
+            struct flowgraph_fifo_s * fifo = &_g->fifos[node->input];
+            nx = fifo->count < node->max_in ? fifo->count : node->max_in;
+            nx -= nx % node->decim;
+            if (nx == 0 || (nx < node->max_in && !_g->nodes[fifo->src].done))
+                continue;
+        }
+
+        // check room on outputs (back-pressure)
+        int ready = 1;
+        for (j=0; j<_g->num_fifos && ready; j++) {
+            struct flowgraph_fifo_s * fifo = &_g->fifos[j];
+            if (fifo->src == i-1 && fifo->capacity - fifo->count < node->max_out)
+                ready = 0;
+        }
+        if (!ready)
+            continue;
+
+        node->nx = nx;
+        return i-1;
+    }
+    return -1;
+}
+
+// pop input block from connection (locked)
+void flowgraph_begin(flowgraph _g, unsigned int _i)
+{
+    struct flowgraph_node_s * node = &_g->nodes[_i];
+    node->busy = 1;
+    if (node->input < 0)
+        return;
+
+    // copy from circular buffer
+    struct flowgraph_fifo_s * fifo = &_g->fifos[node->input];
+    unsigned int s  = flowgraph_type_size(node->type_in);
+    unsigned int n0 = fifo->capacity - fifo->read_index;
+    if (n0 > node->nx) n0 = node->nx;
+    memmove(node->buf_in,        fifo->buf + s*fifo->read_index, s*n0);
+    memmove(node->buf_in + s*n0, fifo->buf,                      s*(node->nx - n0));
+    fifo->read_index = (fifo->read_index + node->nx) % fifo->capacity;
+    fifo->count     -= node->nx;
+}
+
+// push output block to connections and release node (locked)
+void flowgraph_commit(flowgraph _g, unsigned int _i, unsigned int _ny)
+{
+    struct flowgraph_node_s * node = &_g->nodes[_i];
+    if (_ny > node->max_out) {
+        fprintf(stderr,"error: flowgraph_commit(), node '%s' wrote %u samples (maximum %u)\n",
+                node->name, _ny, node->max_out);
+        exit(1);
+    }
+
+    // copy to each circular buffer driven by this node
+    unsigned int j;
+    unsigned int s = flowgraph_type_size(node->type_out);
+    for (j=0; j<_g->num_fifos; j++) {
+        struct flowgraph_fifo_s * fifo = &_g->fifos[j];
+        if (fifo->src != _i)
+            continue;
+        unsigned int w  = (fifo->read_index + fifo->count) % fifo->capacity;
+        unsigned int n0 = fifo->capacity - w;
+        if (n0 > _ny) n0 = _ny;
+        memmove(fifo->buf + s*w, node->buf_out,        s*n0);
+        memmove(fifo->buf,       node->buf_out + s*n0, s*(_ny - n0));
+        fifo->count += _ny;
+    }
+
+    // sources finish when they produce no samples
+    if (node->input < 0 && _ny == 0)
+        node->done = 1;
+
+    node->busy = 0;
+    node->num_executions++;
+}
+
+#if LIQUID_PTHREADS_ENABLED
+// worker thread
+void * flowgraph_worker(void * _g)
+{
+    flowgraph g = (flowgraph) _g;
+    pthread_mutex_lock(&g->mutex);
+    while (flowgraph_update(g) > 0) {
+        int i = flowgraph_select(g);
+        if (i < 0) {
+            // wait for another node to finish
+            unsigned int j, num_busy = 0;
+            for (j=0; j<g->num_nodes; j++)
+                num_busy += g->nodes[j].busy ? 1 : 0;
+            if (num_busy == 0) {
+                fprintf(stderr,"error: flowgraph_worker(), graph stalled\n");
+                exit(1);
+            }
+            pthread_cond_wait(&g->cond, &g->mutex);
+            continue;
+        }
+
+        // run node without holding lock
+        struct flowgraph_node_s * node = &g->nodes[i];
+        flowgraph_begin(g, i);
+        pthread_mutex_unlock(&g->mutex);
+        unsigned int ny = node->callback(node->userdata,
+                                         node->input < 0 ? NULL : node->buf_in,
+                                         node->nx,
+                                         node->buf_out);
+        pthread_mutex_lock(&g->mutex);
+        flowgraph_commit(g, i, ny);
+        pthread_cond_broadcast(&g->cond);
+    }
+    pthread_cond_broadcast(&g->cond);
+    pthread_mutex_unlock(&g->mutex);
+    return NULL;
+}
+#endif
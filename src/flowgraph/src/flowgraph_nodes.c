@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// flowgraph node adapters for common objects
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// adapter callbacks
+unsigned int flowgraph_nco_crcf_mix_down_callback(void * _a, void * _x, unsigned int _nx, void * _y);
+unsigned int flowgraph_firfilt_crcf_callback     (void * _a, void * _x, unsigned int _nx, void * _y);
+unsigned int flowgraph_agc_crcf_callback         (void * _a, void * _x, unsigned int _nx, void * _y);
+unsigned int flowgraph_resamp_crcf_callback      (void * _a, void * _x, unsigned int _nx, void * _y);
+unsigned int flowgraph_firdecim_crcf_callback    (void * _a, void * _x, unsigned int _nx, void * _y);
+unsigned int flowgraph_firinterp_crcf_callback   (void * _a, void * _x, unsigned int _nx, void * _y);
+unsigned int flowgraph_symsync_crcf_callback     (void * _a, void * _x, unsigned int _nx, void * _y);
+unsigned int flowgraph_framesync64_callback      (void * _a, void * _x, unsigned int _nx, void * _y);
+unsigned int flowgraph_flexframesync_callback    (void * _a, void * _x, unsigned int _nx, void * _y);
+
+#define FG_CF LIQUID_FLOWGRAPH_CFLOAT
+#define FG_NONE LIQUID_FLOWGRAPH_NONE
+
+unsigned int flowgraph_add_nco_crcf_mix_down(flowgraph _g, nco_crcf _q)
+{
+    return flowgraph_add_adapter(_g, "nco_crcf_mix_down", FG_CF, FG_CF, 1, 1,
+                                 flowgraph_nco_crcf_mix_down_callback, _q, 1);
+}
+
+unsigned int flowgraph_add_firfilt_crcf(flowgraph _g, firfilt_crcf _q)
+{
+    return flowgraph_add_adapter(_g, "firfilt_crcf", FG_CF, FG_CF, 1, 1,
+                                 flowgraph_firfilt_crcf_callback, _q, 1);
+}
+
+unsigned int flowgraph_add_agc_crcf(flowgraph _g, agc_crcf _q)
+{
+    return flowgraph_add_adapter(_g, "agc_crcf", FG_CF, FG_CF, 1, 1,
+                                 flowgraph_agc_crcf_callback, _q, 1);
+}
+
+unsigned int flowgraph_add_resamp_crcf(flowgraph _g, resamp_crcf _q)
+{
+    // output length for arbitrary rate is bounded by ceil(rate) per input
+    unsigned int interp = (unsigned int) ceilf(resamp_crcf_get_rate(_q));
+    return flowgraph_add_adapter(_g, "resamp_crcf", FG_CF, FG_CF, interp, 1,
+                                 flowgraph_resamp_crcf_callback, _q, 1);
+}
+
+unsigned int flowgraph_add_firdecim_crcf(flowgraph     _g,
+                                         firdecim_crcf _q,
+                                         unsigned int  _M)
+{
+    return flowgraph_add_adapter(_g, "firdecim_crcf", FG_CF, FG_CF, 1, _M,
+                                 flowgraph_firdecim_crcf_callback, _q, _M);
+}
+
+unsigned int flowgraph_add_firinterp_crcf(flowgraph      _g,
+                                          firinterp_crcf _q,
+                                          unsigned int   _M)
+{
+    return flowgraph_add_adapter(_g, "firinterp_crcf", FG_CF, FG_CF, _M, 1,
+                                 flowgraph_firinterp_crcf_callback, _q, _M);
+}
+
+unsigned int flowgraph_add_symsync_crcf(flowgraph    _g,
+                                        symsync_crcf _q,
+                                        unsigned int _k,
+                                        unsigned int _k_out)
+{
+    return flowgraph_add_adapter(_g, "symsync_crcf", FG_CF, FG_CF, _k_out, _k,
+                                 flowgraph_symsync_crcf_callback, _q, _k);
+}
+
+unsigned int flowgraph_add_framesync64(flowgraph _g, framesync64 _q)
+{
+    return flowgraph_add_adapter(_g, "framesync64", FG_CF, FG_NONE, 1, 1,
+                                 flowgraph_framesync64_callback, _q, 1);
+}
+
+unsigned int flowgraph_add_flexframesync(flowgraph _g, flexframesync _q)
+{
+    return flowgraph_add_adapter(_g, "flexframesync", FG_CF, FG_NONE, 1, 1,
+                                 flowgraph_flexframesync_callback, _q, 1);
+}
+
+//
+// adapter callbacks
+//
+
+unsigned int flowgraph_nco_crcf_mix_down_callback(void * _a, void * _x, unsigned int _nx, void * _y)
+{
+    struct flowgraph_adapter_s * a = (struct flowgraph_adapter_s*) _a;
+    nco_crcf_mix_block_down((nco_crcf)a->q, (float complex*)_x, (float complex*)_y, _nx);
+    return _nx;
+}
+
+unsigned int flowgraph_firfilt_crcf_callback(void * _a, void * _x, unsigned int _nx, void * _y)
+{
+    struct flowgraph_adapter_s * a = (struct flowgraph_adapter_s*) _a;
+    firfilt_crcf_execute_block((firfilt_crcf)a->q, (float complex*)_x, _nx, (float complex*)_y);
+    return _nx;
+}
+
+unsigned int flowgraph_agc_crcf_callback(void * _a, void * _x, unsigned int _nx, void * _y)
+{
+    struct flowgraph_adapter_s * a = (struct flowgraph_adapter_s*) _a;
+    agc_crcf_execute_block((agc_crcf)a->q, (float complex*)_x, _nx, (float complex*)_y);
+    return _nx;
+}
+
+unsigned int flowgraph_resamp_crcf_callback(void * _a, void * _x, unsigned int _nx, void * _y)
+{
+    struct flowgraph_adapter_s * a = (struct flowgraph_adapter_s*) _a;
+    unsigned int ny = 0;
+    resamp_crcf_execute_block((resamp_crcf)a->q, (float complex*)_x, _nx, (float complex*)_y, &ny);
+    return ny;
+}
+
+unsigned int flowgraph_firdecim_crcf_callback(void * _a, void * _x, unsigned int _nx, void * _y)
+{
+    // input length is always a multiple of the decimation rate
+    struct flowgraph_adapter_s * a = (struct flowgraph_adapter_s*) _a;
+    firdecim_crcf_execute_block((firdecim_crcf)a->q, (float complex*)_x, _nx/a->M, (float complex*)_y);
+    return _nx / a->M;
+}
+
+unsigned int flowgraph_firinterp_crcf_callback(void * _a, void * _x, unsigned int _nx, void * _y)
+{
+    struct flowgraph_adapter_s * a = (struct flowgraph_adapter_s*) _a;
+    firinterp_crcf_execute_block((firinterp_crcf)a->q, (float complex*)_x, _nx, (float complex*)_y);
+    return _nx * a->M;
+}
+
+unsigned int flowgraph_symsync_crcf_callback(void * _a, void * _x, unsigned int _nx, void * _y)
+{
+    struct flowgraph_adapter_s * a = (struct flowgraph_adapter_s*) _a;
+    unsigned int ny = 0;
+    symsync_crcf_execute((symsync_crcf)a->q, (float complex*)_x, _nx, (float complex*)_y, &ny);
+    return ny;
+}
+
+unsigned int flowgraph_framesync64_callback(void * _a, void * _x, unsigned int _nx, void * _y)
+{
+    struct flowgraph_adapter_s * a = (struct flowgraph_adapter_s*) _a;
+    framesync64_execute((framesync64)a->q, (float complex*)_x, _nx);
+    return 0;
+}
+
+unsigned int flowgraph_flexframesync_callback(void * _a, void * _x, unsigned int _nx, void * _y)
+{
+    struct flowgraph_adapter_s * a = (struct flowgraph_adapter_s*) _a;
+    flexframesync_execute((flexframesync)a->q, (float complex*)_x, _nx);
+    return 0;
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// source reading from buffer
+typedef struct {
+    float complex * x;      // samples
+    unsigned int    n;      // number of samples
+    unsigned int    index;  // read index
+} flowgraph_test_buffer;
+
+unsigned int flowgraph_test_source(void * _userdata, void * _x, unsigned int _nx, void * _y)
+{
+    flowgraph_test_buffer * b = (flowgraph_test_buffer*) _userdata;
+    unsigned int n = b->n - b->index < _nx ? b->n - b->index : _nx;
+    memmove(_y, b->x + b->index, n*sizeof(float complex));
+    b->index += n;
+    return n;
+}
+
+// sink writing to buffer
+unsigned int flowgraph_test_sink(void * _userdata, void * _x, unsigned int _nx, void * _y)
+{
+    flowgraph_test_buffer * b = (flowgraph_test_buffer*) _userdata;
+    if (b->index + _nx > b->n) {
+        AUTOTEST_FAIL("sink buffer overflow");
+        return 0;
+    }
+    memmove(b->x + b->index, _x, _nx*sizeof(float complex));
+    b->index += _nx;
+    return 0;
+}
+
+// run chain of rate-changing blocks as a graph, comparing the result
+// with running the same blocks by hand
+void flowgraph_test_chain(unsigned int _block_len,
+                          unsigned int _num_threads)
+{
+    unsigned int num_samples = 4000;
+    unsigned int ny_max      = 4000;
+    float complex x [num_samples];
+    float complex y0[ny_max];
+    float complex y1[ny_max];
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = cexpf(_Complex_I*0.02f*i*i) + 0.1f*randnf();
+
+    // objects for hand-written loop (0) and graph (1)
+    nco_crcf       nco[2];
+    firfilt_crcf   filt[2];
+    firdecim_crcf  decim[2];
+    resamp_crcf    resamp[2];
+    for (i=0; i<2; i++) {
+        nco[i]    = nco_crcf_create(LIQUID_VCO);
+        nco_crcf_set_frequency(nco[i], 0.1f);
+        filt[i]   = firfilt_crcf_create_kaiser(31, 0.2f, 60.0f, 0.0f);
+        decim[i]  = firdecim_crcf_create_kaiser(2, 7, 60.0f);
+        resamp[i] = resamp_crcf_create(0.7071f, 7, 0.4f, 60.0f, 64);
+    }
+
+    // run by hand
+    float complex buf_0[num_samples];
+    float complex buf_1[num_samples];
+    nco_crcf_mix_block_down(nco[0], x, buf_0, num_samples);
+    firfilt_crcf_execute_block(filt[0], buf_0, num_samples, buf_1);
+    firdecim_crcf_execute_block(decim[0], buf_1, num_samples/2, buf_0);
+    unsigned int ny0 = 0;
+    resamp_crcf_execute_block(resamp[0], buf_0, num_samples/2, y0, &ny0);
+
+    // run graph
+    flowgraph_test_buffer src  = {x,  num_samples, 0};
+    flowgraph_test_buffer sink = {y1, ny_max,      0};
+    flowgraph g = flowgraph_create(_block_len);
+    unsigned int n0 = flowgraph_add_node(g, "source", LIQUID_FLOWGRAPH_NONE, LIQUID_FLOWGRAPH_CFLOAT,
+                                         1, 1, flowgraph_test_source, &src);
+    unsigned int n1 = flowgraph_add_nco_crcf_mix_down(g, nco[1]);
+    unsigned int n2 = flowgraph_add_firfilt_crcf(g, filt[1]);
+    unsigned int n3 = flowgraph_add_firdecim_crcf(g, decim[1], 2);
+    unsigned int n4 = flowgraph_add_resamp_crcf(g, resamp[1]);
+    unsigned int n5 = flowgraph_add_node(g, "sink", LIQUID_FLOWGRAPH_CFLOAT, LIQUID_FLOWGRAPH_NONE,
+                                         1, 1, flowgraph_test_sink, &sink);
+    flowgraph_connect(g, n0, n1);
+    flowgraph_connect(g, n1, n2);
+    flowgraph_connect(g, n2, n3);
+    flowgraph_connect(g, n3, n4);
+    flowgraph_connect(g, n4, n5);
+    if (liquid_autotest_verbose)
+        flowgraph_print(g);
+    flowgraph_run(g, _num_threads);
+
+    // compare results
+    CONTEND_EQUALITY(sink.index, ny0);
+    CONTEND_SAME_DATA(y0, y1, ny0*sizeof(float complex));
+    CONTEND_GREATER_THAN(flowgraph_get_num_executions(g, n5) + 1, ny0 / _block_len);
+
+    // clean up
+    flowgraph_destroy(g);
+    for (i=0; i<2; i++) {
+        nco_crcf_destroy(nco[i]);
+        firfilt_crcf_destroy(filt[i]);
+        firdecim_crcf_destroy(decim[i]);
+        resamp_crcf_destroy(resamp[i]);
+    }
+}
+
+void autotest_flowgraph_chain_b64_t1()  { flowgraph_test_chain(  64, 1); }
+void autotest_flowgraph_chain_b97_t1()  { flowgraph_test_chain(  97, 1); }
+void autotest_flowgraph_chain_b64_t4()  { flowgraph_test_chain(  64, 4); }
+void autotest_flowgraph_chain_b256_t3() { flowgraph_test_chain( 256, 3); }
+
+// one output driving several inputs
+void autotest_flowgraph_fanout()
+{
+    unsigned int num_samples = 1000;
+    float complex x [num_samples];
+    float complex y0[num_samples];
+    float complex y1[num_samples];
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    flowgraph_test_buffer src   = {x,  num_samples, 0};
+    flowgraph_test_buffer sink0 = {y0, num_samples, 0};
+    flowgraph_test_buffer sink1 = {y1, num_samples, 0};
+    flowgraph g = flowgraph_create(50);
+    unsigned int n0 = flowgraph_add_node(g, "source", LIQUID_FLOWGRAPH_NONE, LIQUID_FLOWGRAPH_CFLOAT,
+                                         1, 1, flowgraph_test_source, &src);
+    unsigned int n1 = flowgraph_add_node(g, "sink0", LIQUID_FLOWGRAPH_CFLOAT, LIQUID_FLOWGRAPH_NONE,
+                                         1, 1, flowgraph_test_sink, &sink0);
+    unsigned int n2 = flowgraph_add_node(g, "sink1", LIQUID_FLOWGRAPH_CFLOAT, LIQUID_FLOWGRAPH_NONE,
+                                         1, 1, flowgraph_test_sink, &sink1);
+    flowgraph_connect(g, n0, n1);
+    flowgraph_connect(g, n0, n2);
+    flowgraph_run(g, 2);
+
+    CONTEND_EQUALITY(sink0.index, num_samples);
+    CONTEND_EQUALITY(sink1.index, num_samples);
+    CONTEND_SAME_DATA(x, y0, num_samples*sizeof(float complex));
+    CONTEND_SAME_DATA(x, y1, num_samples*sizeof(float complex));
+    CONTEND_EQUALITY(flowgraph_get_num_executions(g, n1), 20);
+    flowgraph_destroy(g);
+}
+
+// frame synchronizer driven through graph
+static int flowgraph_test_callback(unsigned char *  _header,
+                                   int              _header_valid,
+                                   unsigned char *  _payload,
+                                   unsigned int     _payload_len,
+                                   int              _payload_valid,
+                                   framesyncstats_s _stats,
+                                   void *           _userdata)
+{
+    if (_header_valid && _payload_valid)
+        (*(unsigned int*)_userdata)++;
+    return 0;
+}
+
+void autotest_flowgraph_framesync64()
+{
+    unsigned int num_frames = 4;
+    unsigned int frame_len  = LIQUID_FRAME64_LEN;
+    unsigned int num_samples = num_frames*frame_len + 200;
+    float complex x[num_samples];
+    unsigned int i;
+
+    framegen64 fg = framegen64_create();
+    memset(x, 0x00, sizeof(x));
+    for (i=0; i<num_frames; i++)
+        framegen64_execute(fg, NULL, NULL, x + 100 + i*frame_len);
+    framegen64_destroy(fg);
+
+    unsigned int num_valid = 0;
+    framesync64 fs = framesync64_create(flowgraph_test_callback, &num_valid);
+
+    flowgraph_test_buffer src = {x, num_samples, 0};
+    flowgraph g = flowgraph_create(256);
+    unsigned int n0 = flowgraph_add_node(g, "source", LIQUID_FLOWGRAPH_NONE, LIQUID_FLOWGRAPH_CFLOAT,
+                                         1, 1, flowgraph_test_source, &src);
+    unsigned int n1 = flowgraph_add_framesync64(g, fs);
+    flowgraph_connect(g, n0, n1);
+    flowgraph_run(g, 2);
+
+    CONTEND_EQUALITY(num_valid, num_frames);
+    flowgraph_destroy(g);
+    framesync64_destroy(fs);
+}
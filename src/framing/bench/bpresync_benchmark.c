@@ -91,3 +91,8 @@ void benchmark_bpresync_cccf_64   BPRESYNC_CCCF_BENCHMARK_API(64,   6);
 void benchmark_bpresync_cccf_128  BPRESYNC_CCCF_BENCHMARK_API(128,  6);
 void benchmark_bpresync_cccf_256  BPRESYNC_CCCF_BENCHMARK_API(256,  6);
 
+
+// many frequency hypotheses
+void benchmark_bpresync_cccf_64_m16  BPRESYNC_CCCF_BENCHMARK_API(64,  16);
+void benchmark_bpresync_cccf_256_m16 BPRESYNC_CCCF_BENCHMARK_API(256, 16);
+void benchmark_bpresync_cccf_1024_m16 BPRESYNC_CCCF_BENCHMARK_API(1024,16);
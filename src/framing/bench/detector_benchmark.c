@@ -81,6 +81,61 @@ void detector_cccf_bench(struct rusage *     _start,
     detector_cccf_destroy(q);
 }
 
+// Helper function for block correlation (overlap-save when less expensive)
+void detector_cccf_block_bench(struct rusage *     _start,
+                               struct rusage *     _finish,
+                               unsigned long int * _num_iterations,
+                               unsigned int        _n)
+{
+    // adjust number of iterations
+    *_num_iterations *= 4;
+    *_num_iterations /= _n;
+
+    // generate sequence (random)
+    float complex h[_n];
+    unsigned long int i;
+    for (i=0; i<_n; i++) {
+        h[i] = (rand() % 2 ? 1.0f : -1.0f) +
+               (rand() % 2 ? 1.0f : -1.0f)*_Complex_I;
+    }
+
+    // generate synchronizer
+    float threshold = 0.5f;
+    float dphi_max  = 0.07f;
+    detector_cccf q = detector_cccf_create(h, _n, threshold, dphi_max);
+
+    // input block (random)
+    unsigned int    buf_len = 4096;
+    float complex * buf     = (float complex*) malloc(buf_len*sizeof(float complex));
+    for (i=0; i<buf_len; i++) {
+        buf[i] = (rand() % 2 ? 1.0f : -1.0f) +
+                 (rand() % 2 ? 1.0f : -1.0f)*_Complex_I;
+    }
+
+    float tau_hat;
+    float dphi_hat;
+    float gamma_hat;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    int detected = 0;
+    unsigned long int num_samples = 0;
+    while (num_samples < *_num_iterations) {
+        unsigned int num_consumed = 0;
+        while (num_consumed < buf_len) {
+            num_consumed += detector_cccf_correlate_block(q, &buf[num_consumed],
+                    buf_len - num_consumed, &detected, &tau_hat, &dphi_hat, &gamma_hat);
+        }
+        num_samples += buf_len;
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = num_samples;
+
+    // clean up allocated objects
+    free(buf);
+    detector_cccf_destroy(q);
+}
+
 #define DETECTOR_CCCF_BENCHMARK_API(N)      \
 (   struct rusage *     _start,             \
     struct rusage *     _finish,            \
@@ -93,3 +148,16 @@ void benchmark_detector_cccf_64   DETECTOR_CCCF_BENCHMARK_API(64);
 void benchmark_detector_cccf_128  DETECTOR_CCCF_BENCHMARK_API(128);
 void benchmark_detector_cccf_256  DETECTOR_CCCF_BENCHMARK_API(256);
 
+
+#define DETECTOR_CCCF_BLOCK_BENCHMARK_API(N)    \
+(   struct rusage *     _start,                 \
+    struct rusage *     _finish,                \
+    unsigned long int * _num_iterations)        \
+{ detector_cccf_block_bench(_start, _finish, _num_iterations, N); }
+
+// compare direct (above) to block correlation
+void benchmark_detector_cccf_block_16   DETECTOR_CCCF_BLOCK_BENCHMARK_API(16);
+void benchmark_detector_cccf_block_64   DETECTOR_CCCF_BLOCK_BENCHMARK_API(64);
+void benchmark_detector_cccf_block_256  DETECTOR_CCCF_BLOCK_BENCHMARK_API(256);
+void benchmark_detector_cccf_1024       DETECTOR_CCCF_BENCHMARK_API(1024);
+void benchmark_detector_cccf_block_1024 DETECTOR_CCCF_BLOCK_BENCHMARK_API(1024);
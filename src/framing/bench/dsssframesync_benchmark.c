@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <math.h>
+#include "liquid.h"
+
+// defined in benchmark driver
+double calculate_execution_time(struct rusage, struct rusage);
+
+typedef struct {
+    unsigned int num_frames_tx;         // number of transmitted frames
+    unsigned int num_frames_detected;   // number of received frames (detected)
+    unsigned int num_frames_valid;      // number of valid payloads
+} framedata;
+
+static int callback(unsigned char *  _header,
+                    int              _header_valid,
+                    unsigned char *  _payload,
+                    unsigned int     _payload_len,
+                    int              _payload_valid,
+                    framesyncstats_s _stats,
+                    void *           _userdata)
+{
+    framedata * fd = (framedata*) _userdata;
+    fd->num_frames_detected += 1;
+    fd->num_frames_valid    += _payload_valid ? 1 : 0;
+    return 0;
+}
+
+// Helper function to keep code base small
+void dsssframesync_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         unsigned int        _payload_len)
+{
+    // normalize number of iterations (frames are very long)
+    *_num_iterations /= 32*(16 + _payload_len);
+    if (*_num_iterations < 1) *_num_iterations = 1;
+    unsigned long int i;
+
+    // create frame generator
+    dsssframegenprops_s fgprops = {LIQUID_CRC_16, LIQUID_FEC_NONE, LIQUID_FEC_NONE};
+    dsssframegen fg = dsssframegen_create(&fgprops);
+
+    // frame data
+    unsigned char payload[_payload_len];
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+    framedata fd = {0, 0, 0};
+
+    // create frame synchronizer
+    dsssframesync fs = dsssframesync_create(callback,(void*)&fd);
+
+    // generate the frame, with a few samples of padding on either end
+    dsssframegen_assemble(fg, NULL, payload, _payload_len);
+    unsigned int frame_len = dsssframegen_getframelen(fg) + 256;
+    float complex * frame = (float complex*) malloc(frame_len*sizeof(float complex));
+    for (i=0; i<128; i++)
+        frame[i] = 0.0f;
+    dsssframegen_write_samples(fg, frame + 128, frame_len - 256);
+    for (i=frame_len-128; i<frame_len; i++)
+        frame[i] = 0.0f;
+
+    // add some noise
+    for (i=0; i<frame_len; i++)
+        frame[i] += 0.01f*(randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+
+    // 
+    // start trials
+    //
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        dsssframesync_execute(fs, frame, frame_len);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    fd.num_frames_tx = *_num_iterations;
+    printf("  frames detected/valid/transmitted  :   %6u / %6u / %6u\n",
+            fd.num_frames_detected,
+            fd.num_frames_valid,
+            fd.num_frames_tx);
+    double extime = calculate_execution_time(*_start, *_finish);
+    printf("  frames/s                           :   %12.1f\n",
+            extime > 0 ? (double)fd.num_frames_tx / extime : 0.0);
+
+    free(frame);
+    dsssframegen_destroy(fg);
+    dsssframesync_destroy(fs);
+}
+
+#define DSSSFRAMESYNC_BENCHMARK_API(PAYLOAD_LEN)    \
+(   struct rusage *_start,                          \
+    struct rusage *_finish,                         \
+    unsigned long int *_num_iterations)             \
+{ dsssframesync_bench(_start, _finish, _num_iterations, PAYLOAD_LEN); }
+
+void benchmark_dsssframesync_n8   DSSSFRAMESYNC_BENCHMARK_API(8)
+void benchmark_dsssframesync_n64  DSSSFRAMESYNC_BENCHMARK_API(64)
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+void flexframegen_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _payload_len)
+{
+    *_num_iterations /= 1000;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+    unsigned long int i;
+
+    // create frame generator
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme = LIQUID_MODEM_QPSK;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // batch of payloads
+    unsigned int num_frames = 32;
+    unsigned char payload[_payload_len];
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+    const unsigned char * payloads[num_frames];
+    unsigned int          lens    [num_frames];
+    for (i=0; i<num_frames; i++) {
+        payloads[i] = payload;
+        lens[i]     = _payload_len;
+    }
+
+    // output buffer (large enough for uncoded QPSK frames)
+    unsigned int buf_len = num_frames*(8*_payload_len + 1024);
+    float complex * buf = (float complex*) malloc(buf_len*sizeof(float complex));
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        payload[0] = i & 0xff;
+        flexframegen_generate_batch(fg, NULL, payloads, lens, num_frames, 64, buf, buf_len, NULL);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= num_frames;
+
+    flexframegen_destroy(fg);
+    free(buf);
+}
+
+#define FLEXFRAMEGEN_BENCHMARK_API(PAYLOAD_LEN) \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ flexframegen_bench(_start, _finish, _num_iterations, PAYLOAD_LEN); }
+
+void benchmark_flexframegen_batch_n16   FLEXFRAMEGEN_BENCHMARK_API(16)
+void benchmark_flexframegen_batch_n64   FLEXFRAMEGEN_BENCHMARK_API(64)
+void benchmark_flexframegen_batch_n256  FLEXFRAMEGEN_BENCHMARK_API(256)
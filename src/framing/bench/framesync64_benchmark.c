@@ -26,6 +26,9 @@
 #include <math.h>
 #include "liquid.h"
 
+// defined in benchmark driver
+double calculate_execution_time(struct rusage, struct rusage);
+
 typedef struct {
     unsigned int num_frames_tx;         // number of transmitted frames
     unsigned int num_frames_detected;   // number of received frames (detected)
@@ -96,6 +99,9 @@ void benchmark_framesync64(
             fd.num_frames_detected,
             fd.num_frames_valid,
             fd.num_frames_tx);
+    double extime = calculate_execution_time(*_start, *_finish);
+    printf("  frames/s                           :   %12.1f\n",
+            extime > 0 ? (double)fd.num_frames_tx / extime : 0.0);
 
     framegen64_destroy(fg);
     framesync64_destroy(fs);
@@ -27,6 +27,9 @@
 #include <assert.h>
 #include "liquid.h"
 
+// defined in benchmark driver
+double calculate_execution_time(struct rusage, struct rusage);
+
 typedef struct {
     unsigned char * header;
     unsigned char * payload;
@@ -176,3 +179,98 @@ void benchmark_gmskframesync_noise(struct rusage *     _start,
     gmskframesync_destroy(fs);
 }
 
+
+// Helper function to keep code base small: benchmark receive throughput on
+// a stream of frames separated by noise, pushed through the synchronizer
+// in blocks of _block_len samples
+void gmskframesync_stream_bench(struct rusage *     _start,
+                                struct rusage *     _finish,
+                                unsigned long int * _num_iterations,
+                                unsigned int        _block_len)
+{
+    unsigned long int i;
+
+    // options
+    unsigned int payload_len = 64;      // length of payload (bytes)
+    unsigned int num_frames  = 8;       // number of frames in stream
+    unsigned int gap_len     = 400;     // noise samples between frames
+    float        nstd        = 0.05f;   // noise standard deviation
+
+    // create frame generator
+    gmskframegen fg = gmskframegen_create();
+    unsigned char header[8];
+    unsigned char payload[payload_len];
+    for (i=0; i<8; i++)
+        header[i] = i;
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+    gmskframegen_assemble(fg, header, payload, payload_len,
+                          LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+
+    // generate stream of frames (frame length is a multiple of 2 samples)
+    unsigned int frame_len  = gmskframegen_getframelen(fg);
+    unsigned int stream_len = num_frames*(frame_len + gap_len);
+    float complex * stream = (float complex*) malloc(stream_len*sizeof(float complex));
+    unsigned int n = 0;
+    unsigned int j;
+    for (j=0; j<num_frames; j++) {
+        for (i=0; i<gap_len; i++)
+            stream[n++] = 0.0f;
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = gmskframegen_write_samples(fg, &stream[n]);
+            n += 2;
+        }
+        gmskframegen_assemble(fg, header, payload, payload_len,
+                              LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+    }
+    for (i=0; i<stream_len; i++)
+        stream[i] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+
+    // create frame synchronizer
+    framedata fd = {header, payload, 0, 0, 0, 0};
+    gmskframesync fs = gmskframesync_create(callback,(void*)&fd);
+
+    // normalize number of iterations to number of samples
+    *_num_iterations /= stream_len/16;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // 
+    // start trials
+    //
+    getrusage(RUSAGE_SELF, _start);
+    for (j=0; j<(*_num_iterations); j++) {
+        for (i=0; i<stream_len; i+=_block_len) {
+            unsigned int num_samples = stream_len - i < _block_len ? stream_len - i : _block_len;
+            gmskframesync_execute(fs, &stream[i], num_samples);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    // print results
+    fd.num_frames_tx = num_frames * (*_num_iterations);
+    printf("  frames detected/payload/transmitted:   %6u / %6u / %6u\n",
+            fd.num_frames_detected,
+            fd.num_payloads_valid,
+            fd.num_frames_tx);
+    double extime = calculate_execution_time(*_start, *_finish);
+    printf("  samples/s                          :   %12.1f\n",
+            extime > 0 ? (double)stream_len * (*_num_iterations) / extime : 0.0);
+
+    // scale result by number of samples in stream
+    *_num_iterations *= stream_len;
+
+    free(stream);
+    gmskframegen_destroy(fg);
+    gmskframesync_destroy(fs);
+}
+
+#define GMSKFRAMESYNC_STREAM_BENCHMARK_API(BLOCK_LEN)   \
+(   struct rusage *_start,                              \
+    struct rusage *_finish,                             \
+    unsigned long int *_num_iterations)                 \
+{ gmskframesync_stream_bench(_start, _finish, _num_iterations, BLOCK_LEN); }
+
+void benchmark_gmskframesync_stream_b1    GMSKFRAMESYNC_STREAM_BENCHMARK_API(1)
+void benchmark_gmskframesync_stream_b64   GMSKFRAMESYNC_STREAM_BENCHMARK_API(64)
+void benchmark_gmskframesync_stream_b1024 GMSKFRAMESYNC_STREAM_BENCHMARK_API(1024)
@@ -34,28 +34,32 @@
 struct BPRESYNC(_s) {
     unsigned int n;     // sequence length
     unsigned int m;     // number of binary synchronizers
-    
-    bsequence rx_i;     // received pattern (in-phase)
-    bsequence rx_q;     // received pattern (quadrature)
+
+    // sequences are packed into 64-bit words, most recent bit in the
+    // least-significant position of the last word
+    unsigned int num_words; // number of words in each sequence
+    uint64_t mask_msb;      // bit mask for most-significant word
+
+    uint64_t * rx_i;    // received pattern (in-phase)
+    uint64_t * rx_q;    // received pattern (quadrature)
     
     float * dphi;       // array of frequency offsets [size: m x 1]
-    bsequence * sync_i; // synchronization pattern (in-phase)
-    bsequence * sync_q; // synchronization pattern (quadrature)
+    uint64_t * sync;    // synchronization patterns, in-phase and quadrature
+                        // for each frequency offset [size: 2 m x num_words]
 
-    float * rxy;        // output correlation [size: m x 1]
+    unsigned int * d_i; // bit differences against rx_i [size: 2 m x 1]
+    unsigned int * d_q; // bit differences against rx_q [size: 2 m x 1]
 
     float n_inv;        // 1/n (pre-computed for speed)
 };
 
-// correlate input sequence with particular sequence index
+// push bit into packed sequence
 //  _q      : pre-demod synchronizer object
-//  _id     : sequence index
-//  _rxy0   : positive frequency correlation output (non-conjugated)
-//  _rxy1   : negative frequency correlation output (conjugated)
-void BPRESYNC(_correlatex)(BPRESYNC()      _q,
-                           unsigned int    _id,
-                           float complex * _rxy0,
-                           float complex * _rxy1);
+//  _s      : packed sequence [size: num_words x 1]
+//  _bit    : input bit
+void BPRESYNC(_push_bit)(BPRESYNC()   _q,
+                         uint64_t *   _s,
+                         unsigned int _bit);
 
 // create binary pre-demod synchronizer
 //  _v          :   baseband sequence
@@ -83,36 +87,39 @@ BPRESYNC() BPRESYNC(_create)(TC *         _v,
 
     _q->n_inv = 1.0f / (float)(_q->n);
 
+    // packed sequence dimensions
+    _q->num_words = (_q->n + 63) / 64;
+    _q->mask_msb  = (_q->n % 64) == 0 ? ~(uint64_t)0 : ((uint64_t)1 << (_q->n % 64)) - 1;
+
     unsigned int i;
 
     // create internal receive buffers
-    _q->rx_i = bsequence_create(_q->n);
-    _q->rx_q = bsequence_create(_q->n);
+    _q->rx_i = (uint64_t*) malloc( _q->num_words*sizeof(uint64_t) );
+    _q->rx_q = (uint64_t*) malloc( _q->num_words*sizeof(uint64_t) );
 
     // create internal array of frequency offsets
     _q->dphi = (float*) malloc( _q->m*sizeof(float) );
 
     // create internal synchronizers
-    _q->sync_i = (bsequence*) malloc( _q->m*sizeof(bsequence) );
-    _q->sync_q = (bsequence*) malloc( _q->m*sizeof(bsequence) );
+    _q->sync = (uint64_t*) calloc( 2*_q->m*_q->num_words, sizeof(uint64_t) );
 
     for (i=0; i<_q->m; i++) {
-
-        _q->sync_i[i] = bsequence_create(_q->n);
-        _q->sync_q[i] = bsequence_create(_q->n);
+        uint64_t * sync_i = &_q->sync[(2*i+0)*_q->num_words];
+        uint64_t * sync_q = &_q->sync[(2*i+1)*_q->num_words];
 
         // generate signal with frequency offset
         _q->dphi[i] = (float)i / (float)(_q->m-1)*_dphi_max;
         unsigned int k;
         for (k=0; k<_q->n; k++) {
             TC v_prime = _v[k] * cexpf(-_Complex_I*k*_q->dphi[i]);
-            bsequence_push(_q->sync_i[i], crealf(v_prime)>0);
-            bsequence_push(_q->sync_q[i], cimagf(v_prime)>0);
+            BPRESYNC(_push_bit)(_q, sync_i, crealf(v_prime)>0);
+            BPRESYNC(_push_bit)(_q, sync_q, cimagf(v_prime)>0);
         }
     }
 
-    // allocate memory for cross-correlation
-    _q->rxy = (float*) malloc( _q->m*sizeof(float) );
+    // allocate memory for bit differences
+    _q->d_i = (unsigned int*) malloc( 2*_q->m*sizeof(unsigned int) );
+    _q->d_q = (unsigned int*) malloc( 2*_q->m*sizeof(unsigned int) );
 
     // reset object
     BPRESYNC(_reset)(_q);
@@ -122,25 +129,19 @@ BPRESYNC() BPRESYNC(_create)(TC *         _v,
 
 void BPRESYNC(_destroy)(BPRESYNC() _q)
 {
-    unsigned int i;
-
     // free received symbol buffers
     free(_q->rx_i);
     free(_q->rx_q);
 
-    // free internal syncrhonizer objects
-    for (i=0; i<_q->m; i++) {
-        bsequence_destroy(_q->sync_i[i]);
-        bsequence_destroy(_q->sync_q[i]);
-    }
-    free(_q->sync_i);
-    free(_q->sync_q);
+    // free internal syncrhonizer patterns
+    free(_q->sync);
 
     // free internal frequency offset array
     free(_q->dphi);
 
-    // free internal cross-correlation array
-    free(_q->rxy);
+    // free internal bit difference arrays
+    free(_q->d_i);
+    free(_q->d_q);
 
     // free main object memory
     free(_q);
@@ -155,8 +156,8 @@ void BPRESYNC(_reset)(BPRESYNC() _q)
 {
     unsigned int i;
     for (i=0; i<_q->n; i++) {
-        bsequence_push(_q->rx_i, (i+0) % 2);
-        bsequence_push(_q->rx_q, (i+1) % 2);
+        BPRESYNC(_push_bit)(_q, _q->rx_i, (i+0) % 2);
+        BPRESYNC(_push_bit)(_q, _q->rx_q, (i+1) % 2);
     }
 }
 
@@ -167,8 +168,8 @@ void BPRESYNC(_push)(BPRESYNC() _q,
                      TI         _x)
 {
     // push symbol into buffers
-    bsequence_push(_q->rx_i, REAL(_x)>0);
-    bsequence_push(_q->rx_q, IMAG(_x)>0);
+    BPRESYNC(_push_bit)(_q, _q->rx_i, REAL(_x)>0);
+    BPRESYNC(_push_bit)(_q, _q->rx_q, IMAG(_x)>0);
 }
 
 /* correlate input sequence                                 */
@@ -179,32 +180,49 @@ void BPRESYNC(_execute)(BPRESYNC() _q,
                         TO *       _rxy,
                         float *    _dphi_hat)
 {
+    // count bit differences between each received pattern and all
+    // synchronization patterns (every frequency offset) in one pass
+    liquid_count_bit_errors_bank64(_q->rx_i, _q->sync, _q->num_words, 2*_q->m, _q->d_i);
+    liquid_count_bit_errors_bank64(_q->rx_q, _q->sync, _q->num_words, 2*_q->m, _q->d_q);
+
+    // find strongest correlation, comparing integer squared magnitudes
     unsigned int i;
-    float complex rxy_max = 0;  // maximum cross-correlation
-    float abs_rxy_max = 0;      // absolute value of rxy_max
-    float complex rxy0;
-    float complex rxy1;
-    float dphi_hat = 0.0f;
+    int          n       = (int)(_q->n);
+    int          rxy_i   = 0;   // maximum cross-correlation (in-phase)
+    int          rxy_q   = 0;   // maximum cross-correlation (quadrature)
+    long int     e2_max  = 0;   // squared magnitude of maximum
+    float        dphi_hat = 0.0f;
     for (i=0; i<_q->m; i++)  {
-
-        BPRESYNC(_correlatex)(_q, i, &rxy0, &rxy1);
+        // compute correlations: (matching bits) - (differing bits)
+        int rxy_ii = n - 2*(int)(_q->d_i[2*i+0]);
+        int rxy_qi = n - 2*(int)(_q->d_i[2*i+1]);
+        int rxy_iq = n - 2*(int)(_q->d_q[2*i+0]);
+        int rxy_qq = n - 2*(int)(_q->d_q[2*i+1]);
 
         // check non-conjugated value
-        if ( ABS(rxy0) > abs_rxy_max ) {
-            rxy_max     = rxy0;
-            abs_rxy_max = ABS(rxy0);
-            dphi_hat    = _q->dphi[i];
+        int      rxy_i0 = rxy_ii - rxy_qq;
+        int      rxy_q0 = rxy_iq + rxy_qi;
+        long int e2_0   = (long int)rxy_i0*rxy_i0 + (long int)rxy_q0*rxy_q0;
+        if (e2_0 > e2_max) {
+            rxy_i    = rxy_i0;
+            rxy_q    = rxy_q0;
+            e2_max   = e2_0;
+            dphi_hat = _q->dphi[i];
         }
 
         // check conjugated value
-        if ( ABS(rxy1) > abs_rxy_max ) {
-            rxy_max     = rxy1;
-            abs_rxy_max = ABS(rxy1);
-            dphi_hat    = -_q->dphi[i];
+        int      rxy_i1 = rxy_ii + rxy_qq;
+        int      rxy_q1 = rxy_iq - rxy_qi;
+        long int e2_1   = (long int)rxy_i1*rxy_i1 + (long int)rxy_q1*rxy_q1;
+        if (e2_1 > e2_max) {
+            rxy_i    = rxy_i1;
+            rxy_q    = rxy_q1;
+            e2_max   = e2_1;
+            dphi_hat = -_q->dphi[i];
         }
     }
 
-    *_rxy      = rxy_max;
+    *_rxy      = (rxy_i + rxy_q * _Complex_I) * _q->n_inv;
     *_dphi_hat = dphi_hat;
 }
 
@@ -212,36 +230,20 @@ void BPRESYNC(_execute)(BPRESYNC() _q,
 // internal methods
 //
 
-// correlate input sequence with particular sequence index
+// push bit into packed sequence
 //  _q      : pre-demod synchronizer object
-//  _id     : sequence index
-//  _rxy0   : positive frequency correlation output (non-conjugated)
-//  _rxy1   : negative frequency correlation output (conjugated)
-void BPRESYNC(_correlatex)(BPRESYNC()      _q,
-                           unsigned int    _id,
-                           float complex * _rxy0,
-                           float complex * _rxy1)
+//  _s      : packed sequence [size: num_words x 1]
+//  _bit    : input bit
+void BPRESYNC(_push_bit)(BPRESYNC()   _q,
+                         uint64_t *   _s,
+                         unsigned int _bit)
 {
-    // validate input...
-    if (_id >= _q->m) {
-        fprintf(stderr,"error: bpresync_%s_correlatex(), invalid id\n", EXTENSION_FULL);
-        exit(1);
-    }
+    // shift each word, carrying in most-significant bit of next word
+    unsigned int i;
+    for (i=0; i<_q->num_words-1; i++)
+        _s[i] = (_s[i] << 1) | (_s[i+1] >> 63);
 
-    // compute correlations
-    int rxy_ii = 2*bsequence_correlate(_q->sync_i[_id], _q->rx_i) - (int)(_q->n);
-    int rxy_qq = 2*bsequence_correlate(_q->sync_q[_id], _q->rx_q) - (int)(_q->n);
-    int rxy_iq = 2*bsequence_correlate(_q->sync_i[_id], _q->rx_q) - (int)(_q->n);
-    int rxy_qi = 2*bsequence_correlate(_q->sync_q[_id], _q->rx_i) - (int)(_q->n);
-
-    // non-conjugated
-    int rxy_i0 = rxy_ii - rxy_qq;
-    int rxy_q0 = rxy_iq + rxy_qi;
-    *_rxy0 = (rxy_i0 + rxy_q0 * _Complex_I) * _q->n_inv;
-
-    // conjugated
-    int rxy_i1 = rxy_ii + rxy_qq;
-    int rxy_q1 = rxy_iq - rxy_qi;
-    *_rxy1 = (rxy_i1 + rxy_q1 * _Complex_I) * _q->n_inv;
+    // append input bit and clear unused bits of most-significant word
+    _s[_q->num_words-1] = (_s[_q->num_words-1] << 1) | (_bit & 1);
+    _s[0] &= _q->mask_msb;
 }
-
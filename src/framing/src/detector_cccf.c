@@ -51,6 +51,27 @@ void detector_cccf_update_sumsq(detector_cccf _q,
 // compute all dot product outputs
 void detector_cccf_compute_dotprods(detector_cccf _q);
 
+// compute correlator magnitudes for a block of input samples in the
+// frequency domain (overlap-save), storing in rxy_block
+//  _q      :   detector object
+//  _x      :   input samples, [size: _n x 1]
+//  _n      :   number of samples, _n <= block_len
+void detector_cccf_compute_block(detector_cccf   _q,
+                                 float complex * _x,
+                                 unsigned int    _n);
+
+// scale correlator magnitudes and find index of maximum
+//  _q      :   detector object
+//  _rxy    :   correlator magnitudes, [size: m x 1]
+void detector_cccf_normalize(detector_cccf _q,
+                             float *       _rxy);
+
+// run detection state machine on latest correlator outputs
+int detector_cccf_detect(detector_cccf _q,
+                         float *       _tau_hat,
+                         float *       _dphi_hat,
+                         float *       _gamma_hat);
+
 // estimate carrier and timing offsets
 void detector_cccf_estimate_offsets(detector_cccf _q,
                                     float *       _tau_hat,
@@ -82,6 +103,19 @@ struct detector_cccf_s {
     unsigned int imax;      // index of maximum
     unsigned int idetect;   // index of detection
 
+    // overlap-save block correlation (frequency domain)
+    unsigned int    nfft;       // transform size
+    unsigned int    block_len;  // outputs per transform, nfft - n + 1
+    float complex * buf_time_0; // transform input: history, new samples
+    float complex * buf_freq_0; // transform of input
+    float complex * buf_freq_1; // product with sequence template
+    float complex * buf_time_1; // correlator outputs
+    fftplan         fft;        // forward transform
+    fftplan         ifft;       // inverse transform
+    float complex * S;          // pre-spun templates, [size: m x nfft]
+    float *         rxy_block;  // correlator magnitudes, [size: block_len x m]
+    float           fft_cost;   // cost of one block, multiply-accumulates
+
     // estimation of E{|x|^2}
     wdelayf x2;             // buffer of |x|^2 values
     float x2_sum;           // sum{ |x|^2 }
@@ -167,6 +201,35 @@ detector_cccf detector_cccf_create(float complex * _s,
         q->dp[k] = dotprod_cccf_create(sconj, q->n);
     }
 
+    // prepare transforms for block correlation; each template is the
+    // conjugated transform of the (conjugated) pre-spun sequence, with
+    // the inverse transform scaling included
+    q->nfft       = 1 << liquid_nextpow2( 2*q->n );
+    q->block_len  = q->nfft - q->n + 1;
+    q->buf_time_0 = (float complex*) malloc(q->nfft * sizeof(float complex));
+    q->buf_freq_0 = (float complex*) malloc(q->nfft * sizeof(float complex));
+    q->buf_freq_1 = (float complex*) malloc(q->nfft * sizeof(float complex));
+    q->buf_time_1 = (float complex*) malloc(q->nfft * sizeof(float complex));
+    q->fft  = fft_create_plan(q->nfft, q->buf_time_0, q->buf_freq_0, LIQUID_FFT_FORWARD,  0);
+    q->ifft = fft_create_plan(q->nfft, q->buf_freq_1, q->buf_time_1, LIQUID_FFT_BACKWARD, 0);
+    q->S    = (float complex*) malloc(q->m * q->nfft * sizeof(float complex));
+    for (k=0; k<q->m; k++) {
+        memset(q->buf_time_0, 0x00, q->nfft*sizeof(float complex));
+        for (i=0; i<q->n; i++)
+            q->buf_time_0[i] = q->s[i] * cexpf(_Complex_I*q->dphi[k]*i);
+        fft_execute(q->fft);
+        for (i=0; i<q->nfft; i++)
+            q->S[k*q->nfft + i] = conjf(q->buf_freq_0[i]) / (float)(q->nfft);
+    }
+    q->rxy_block = (float*) malloc(q->block_len * q->m * sizeof(float));
+
+    // Cost of block correlation relative to direct method, counted in
+    // multiply-accumulate operations: one forward transform, and one
+    // product and inverse transform per correlator. Each transform costs
+    // roughly 5*nfft*log2(nfft) operations of the (SIMD) dot product.
+    float log2_nfft = (float)liquid_nextpow2(q->nfft);
+    q->fft_cost = (q->m+1)*5.0f*q->nfft*log2_nfft + 2.0f*q->m*q->nfft;
+
     // reset state
     detector_cccf_reset(q);
 
@@ -200,6 +263,16 @@ void detector_cccf_destroy(detector_cccf _q)
     free(_q->rxy0);
     free(_q->rxy1);
 
+    // destroy block correlation objects
+    fft_destroy_plan(_q->fft);
+    fft_destroy_plan(_q->ifft);
+    free(_q->buf_time_0);
+    free(_q->buf_freq_0);
+    free(_q->buf_freq_1);
+    free(_q->buf_time_1);
+    free(_q->S);
+    free(_q->rxy_block);
+
     // destroy |x|^2 buffer
     wdelayf_destroy(_q->x2);
 
@@ -279,6 +352,127 @@ int detector_cccf_correlate(detector_cccf _q,
     // compute vector dot products
     detector_cccf_compute_dotprods(_q);
 
+    // run detection
+    return detector_cccf_detect(_q, _tau_hat, _dphi_hat, _gamma_hat);
+}
+
+// Run block of samples through pre-demod detector's correlator, stopping
+// after the first sample on which a signal is detected. Approximately
+// equivalent to calling detector_cccf_correlate() on each sample in turn
+// (frequency-domain rounding may change marginal detections), but
+// computes correlator outputs over whole blocks in the frequency domain
+// (overlap-save) when this is less expensive. Returns the number of
+// samples consumed.
+//  _q          :   pre-demod detector
+//  _x          :   input samples, [size: _n x 1]
+//  _n          :   number of input samples
+//  _detected   :   set to '1' if signal was detected on the last
+//                  consumed sample, '0' otherwise
+//  _tau_hat    :   fractional sample offset estimate (set when detected)
+//  _dphi_hat   :   carrier frequency offset estimate (set when detected)
+//  _gamma_hat  :   channel gain estimate (set when detected)
+unsigned int detector_cccf_correlate_block(detector_cccf   _q,
+                                           float complex * _x,
+                                           unsigned int    _n,
+                                           int *           _detected,
+                                           float *         _tau_hat,
+                                           float *         _dphi_hat,
+                                           float *         _gamma_hat)
+{
+    unsigned int i, j;
+    unsigned int num_consumed = 0;
+    *_detected = 0;
+    while (num_consumed < _n) {
+        // samples while timer is running require no correlation
+        if (_q->timer) {
+            detector_cccf_correlate(_q, _x[num_consumed++], _tau_hat, _dphi_hat, _gamma_hat);
+            continue;
+        }
+
+        // choose direct or block correlation for this chunk
+        unsigned int num_remaining = _n - num_consumed;
+        unsigned int num_samples   = num_remaining < _q->block_len ? num_remaining : _q->block_len;
+        // (direct cost includes overhead of about 32 operations per output)
+        if ((float)(num_samples*_q->m*(_q->n+32)) < _q->fft_cost) {
+            // direct: run sample by sample
+            for (i=0; i<num_samples; i++) {
+                *_detected = detector_cccf_correlate(_q, _x[num_consumed++],
+                                                     _tau_hat, _dphi_hat, _gamma_hat);
+                if (*_detected)
+                    return num_consumed;
+            }
+            continue;
+        }
+
+        // block: compute correlator magnitudes for all samples at once
+        float complex * x = &_x[num_consumed];
+        detector_cccf_compute_block(_q, x, num_samples);
+
+        for (i=0; i<num_samples; i++) {
+            // update sum{|x|^2}
+            detector_cccf_update_sumsq(_q, x[i]);
+#if DEBUG_DETECTOR
+            windowcf_push(_q->debug_x, x[i]);
+            windowf_push(_q->debug_x2, _q->x2_hat);
+#endif
+
+            // save previous correlator outputs and load new ones
+            memmove(_q->rxy0, _q->rxy1, _q->m*sizeof(float));
+            memmove(_q->rxy1, _q->rxy,  _q->m*sizeof(float));
+            detector_cccf_normalize(_q, &_q->rxy_block[i*_q->m]);
+
+            // run detection; stop at detection as this restarts the timer
+            *_detected = detector_cccf_detect(_q, _tau_hat, _dphi_hat, _gamma_hat);
+            if (*_detected) {
+                i++;
+                break;
+            }
+        }
+
+        // push consumed samples into buffer
+        for (j=0; j<i; j++)
+            windowcf_push(_q->buffer, x[j]);
+        num_consumed += i;
+
+        if (*_detected)
+            break;
+    }
+    return num_consumed;
+}
+
+// 
+// internal methods
+//
+
+// compute sum{ |x|^2 }
+void detector_cccf_update_sumsq(detector_cccf _q,
+                                float complex _x)
+{
+    // update estimate of signal magnitude
+    float x2_n = crealf(_x * conjf(_x));    // |x[n-1]|^2 (input sample)
+    float x2_0;                             // |x[0]  |^2 (oldest sample)
+    wdelayf_push(_q->x2, x2_n);             // push newest sample
+    wdelayf_read(_q->x2, &x2_0);            // read oldest sample
+    _q->x2_sum = _q->x2_sum + x2_n - x2_0;  // update sum( |x|^2 ) of last 'n' input samples
+    if (_q->x2_sum < FLT_EPSILON) {
+        _q->x2_sum = FLT_EPSILON;
+    }
+#if 0
+    // filtered estimate of E{ |x|^2 }
+    _q->x2_hat = 0.8f*_q->x2_hat + 0.2f*_q->x2_sum*_q->n_inv;
+#else
+    // unfiltered estimate of E{ |x|^2 }
+    _q->x2_hat = _q->x2_sum * _q->n_inv;
+#endif
+
+}
+
+// run detection state machine on latest correlator outputs
+int detector_cccf_detect(detector_cccf _q,
+                         float *       _tau_hat,
+                         float *       _dphi_hat,
+                         float *       _gamma_hat)
+{
     // find max{rxy}
     float rxy_abs = _q->rxy[ _q->imax ];
 
@@ -323,40 +517,13 @@ int detector_cccf_correlate(detector_cccf _q,
             return 1;
         }
     } else {
-        fprintf(stderr,"error: detector_cccf_correlate(), unknown/unsupported internal state\n");
+        fprintf(stderr,"error: detector_cccf_detect(), unknown/unsupported internal state\n");
         exit(1);
     }
 
     return 0;
 }
 
-// 
-// internal methods
-//
-
-// compute sum{ |x|^2 }
-void detector_cccf_update_sumsq(detector_cccf _q,
-                                float complex _x)
-{
-    // update estimate of signal magnitude
-    float x2_n = crealf(_x * conjf(_x));    // |x[n-1]|^2 (input sample)
-    float x2_0;                             // |x[0]  |^2 (oldest sample)
-    wdelayf_push(_q->x2, x2_n);             // push newest sample
-    wdelayf_read(_q->x2, &x2_0);            // read oldest sample
-    _q->x2_sum = _q->x2_sum + x2_n - x2_0;  // update sum( |x|^2 ) of last 'n' input samples
-    if (_q->x2_sum < FLT_EPSILON) {
-        _q->x2_sum = FLT_EPSILON;
-    }
-#if 0
-    // filtered estimate of E{ |x|^2 }
-    _q->x2_hat = 0.8f*_q->x2_hat + 0.2f*_q->x2_sum*_q->n_inv;
-#else
-    // unfiltered estimate of E{ |x|^2 }
-    _q->x2_hat = _q->x2_sum * _q->n_inv;
-#endif
-
-}
-
 // compute all dot product outputs
 void detector_cccf_compute_dotprods(detector_cccf _q)
 {
@@ -368,19 +535,66 @@ void detector_cccf_compute_dotprods(detector_cccf _q)
     // TODO: compute conjugate as well
     unsigned int k;
     float complex rxy;
+    for (k=0; k<_q->m; k++) {
+        // execute vector dot product
+        dotprod_cccf_execute(_q->dp[k], r, &rxy);
+
+        // save magnitude
+        _q->rxy[k] = cabsf(rxy);
+    }
+
+    // scale and find index of maximum
+    detector_cccf_normalize(_q, _q->rxy);
+}
+
+// compute correlator magnitudes for a block of input samples in the
+// frequency domain (overlap-save), storing in rxy_block
+//  _q      :   detector object
+//  _x      :   input samples, [size: _n x 1]
+//  _n      :   number of samples, _n <= block_len
+void detector_cccf_compute_block(detector_cccf   _q,
+                                 float complex * _x,
+                                 unsigned int    _n)
+{
+    // transform input: last n-1 samples of history followed by new samples
+    float complex * r;
+    windowcf_read(_q->buffer, &r);
+    memmove(_q->buf_time_0, &r[1], (_q->n-1)*sizeof(float complex));
+    memmove(&_q->buf_time_0[_q->n-1], _x, _n*sizeof(float complex));
+    memset(&_q->buf_time_0[_q->n-1+_n], 0x00, (_q->block_len-_n)*sizeof(float complex));
+    fft_execute(_q->fft);
+
+    // correlate with each pre-spun template
+    unsigned int i, k;
+    for (k=0; k<_q->m; k++) {
+        float complex * S = &_q->S[k*_q->nfft];
+        for (i=0; i<_q->nfft; i++)
+            _q->buf_freq_1[i] = _q->buf_freq_0[i] * S[i];
+        fft_execute(_q->ifft);
+
+        // output i corresponds to window ending at input sample i
+        for (i=0; i<_n; i++)
+            _q->rxy_block[i*_q->m + k] = cabsf(_q->buf_time_1[i]);
+    }
+}
+
+// scale correlator magnitudes and find index of maximum
+//  _q      :   detector object
+//  _rxy    :   correlator magnitudes, [size: m x 1]
+void detector_cccf_normalize(detector_cccf _q,
+                             float *       _rxy)
+{
 #if DEBUG_DETECTOR_PRINT
     printf("  rxy : ");
 #endif
+    unsigned int k;
     float rxy_max = 0;
     // TODO: peridically re-compute scaling factor)
     for (k=0; k<_q->m; k++) {
-        // execute vector dot product
-        dotprod_cccf_execute(_q->dp[k], r, &rxy);
-
         // save scaled magnitude
         // TODO: compute scaled squared magnitude so as not to have
         //       to compute square root
-        _q->rxy[k] = cabsf(rxy) * _q->n_inv / sqrtf(_q->x2_hat);
+        _q->rxy[k] = _rxy[k] * _q->n_inv / sqrtf(_q->x2_hat);
 #if DEBUG_DETECTOR_PRINT
         printf("%6.4f (%6.4f) ", _q->rxy[k], _q->dphi[k]);
 #endif
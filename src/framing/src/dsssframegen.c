@@ -185,6 +185,10 @@ void dsssframegen_reset(dsssframegen _q)
     _q->frame_assembled = 0;
     _q->frame_complete  = 0;
     _q->state           = STATE_PREAMBLE;
+
+    // re-align spreading codes with start of frame
+    synth_crcf_set_phase(_q->header_synth, 0.0f);
+    synth_crcf_set_phase(_q->payload_synth, 0.0f);
 }
 
 int dsssframegen_is_assembled(dsssframegen _q)
@@ -67,6 +67,7 @@ struct dsssframesync_s {
     void *             userdata;
     framesyncstats_s   framesyncstats;
     framedatastats_s   framedatastats;
+    frameprofile_s     profile;
 
     unsigned int   k;
     unsigned int   m;
@@ -166,6 +167,8 @@ dsssframesync dsssframesync_create(framesync_callback _callback, void * _userdat
         = (liquid_float_complex *)malloc(q->payload_spread_len * sizeof(liquid_float_complex));
 
     dsssframesync_reset_framedatastats(q);
+    q->profile.enabled = 0;
+    dsssframesync_reset_profile(q);
     dsssframesync_reset(q);
 
     return q;
@@ -211,6 +214,10 @@ void dsssframesync_reset(dsssframesync _q)
 
     firpfb_crcf_reset(_q->mf);
 
+    // re-align spreading codes with start of frame
+    synth_crcf_set_phase(_q->header_synth, 0.0f);
+    synth_crcf_set_phase(_q->payload_synth, 0.0f);
+
     _q->state            = DSSSFRAMESYNC_STATE_DETECTFRAME;
     _q->preamble_counter = 0;
     _q->symbol_counter   = 0;
@@ -276,10 +283,19 @@ int dsssframesync_set_header_props(dsssframesync _q, dsssframegenprops_s * _prop
     return 0;
 }
 
+// profiling stage for each internal state
+static const int dsssframesync_profile_stage[4] = {
+    LIQUID_FRAMEPROFILE_DETECT,   // DSSSFRAMESYNC_STATE_DETECTFRAME
+    LIQUID_FRAMEPROFILE_PREAMBLE, // DSSSFRAMESYNC_STATE_RXPREAMBLE
+    LIQUID_FRAMEPROFILE_HEADER,   // DSSSFRAMESYNC_STATE_RXHEADER
+    LIQUID_FRAMEPROFILE_PAYLOAD,  // DSSSFRAMESYNC_STATE_RXPAYLOAD
+};
+
 void dsssframesync_execute(dsssframesync _q, liquid_float_complex * _x, unsigned int _n)
 {
     unsigned int i;
     for (i = 0; i < _n; i++) {
+        frameprofile_switch(&_q->profile, dsssframesync_profile_stage[_q->state]);
         switch (_q->state) {
         case DSSSFRAMESYNC_STATE_DETECTFRAME:
             // detect frame (look for p/n sequence)
@@ -302,6 +318,7 @@ void dsssframesync_execute(dsssframesync _q, liquid_float_complex * _x, unsigned
             exit(1);
         }
     }
+    frameprofile_stop(&_q->profile);
 }
 
 // execute synchronizer, seeking p/n sequence
@@ -356,16 +373,15 @@ int dsssframesync_step(dsssframesync _q, float complex _x, float complex * _y)
 
     // push sample into filterbank
     firpfb_crcf_push(_q->mf, v);
-    firpfb_crcf_execute(_q->mf, _q->pfb_index, &v);
 
     // increment counter to determine if sample is available
     _q->mf_counter++;
     int sample_available = (_q->mf_counter >= 1) ? 1 : 0;
 
-    // set output sample if available
+    // compute and set output sample only if available
     if (sample_available) {
         // set output
-        *_y = v;
+        firpfb_crcf_execute(_q->mf, _q->pfb_index, _y);
 
         // decrement counter by k=2 samples/symbol
         _q->mf_counter -= _q->k;
@@ -444,6 +460,7 @@ void dsssframesync_execute_rxheader(dsssframesync _q, liquid_float_complex _x)
         _q->framesyncstats.fec0          = LIQUID_FEC_UNKNOWN;
         _q->framesyncstats.fec1          = LIQUID_FEC_UNKNOWN;
 
+        frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
         _q->callback(
             _q->header_dec, _q->header_valid, NULL, 0, 0, _q->framesyncstats, _q->userdata);
     }
@@ -453,10 +470,11 @@ void dsssframesync_execute_rxheader(dsssframesync _q, liquid_float_complex _x)
 
 int dsssframesync_decode_header(dsssframesync _q)
 {
-    liquid_float_complex prev_corr, corr, next_corr;
+    // de-rotate and despread symbol (only punctual correlation is used)
+    liquid_float_complex corr;
     nco_crcf_mix_block_down(
         _q->pll, _q->header_spread, _q->header_spread, synth_crcf_get_length(_q->header_synth));
-    synth_crcf_despread_triple(_q->header_synth, _q->header_spread, &prev_corr, &corr, &next_corr);
+    synth_crcf_despread(_q->header_synth, _q->header_spread, &corr);
 
     int   complete    = qpacketmodem_decode_soft_sym(_q->header_decoder, corr);
     float phase_error = qpacketmodem_get_demodulator_phase_error(_q->header_decoder);
@@ -552,6 +570,7 @@ void dsssframesync_execute_rxpayload(dsssframesync _q, liquid_float_complex _x)
     _q->framesyncstats.fec1  = qpacketmodem_get_fec1(_q->payload_decoder);
 
     if (_q->callback != NULL) {
+        frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
         _q->callback(_q->header_dec,
                      _q->header_valid,
                      _q->payload_dec,
@@ -566,11 +585,11 @@ void dsssframesync_execute_rxpayload(dsssframesync _q, liquid_float_complex _x)
 
 int dsssframesync_decode_payload(dsssframesync _q)
 {
-    liquid_float_complex prev_corr, corr, next_corr;
+    // de-rotate and despread symbol (only punctual correlation is used)
+    liquid_float_complex corr;
     nco_crcf_mix_block_down(
         _q->pll, _q->payload_spread, _q->payload_spread, synth_crcf_get_length(_q->payload_synth));
-    synth_crcf_despread_triple(
-        _q->payload_synth, _q->payload_spread, &prev_corr, &corr, &next_corr);
+    synth_crcf_despread(_q->payload_synth, _q->payload_spread, &corr);
 
     int   complete    = qpacketmodem_decode_soft_sym(_q->payload_decoder, corr);
     float phase_error = qpacketmodem_get_demodulator_phase_error(_q->payload_decoder);
@@ -581,6 +600,7 @@ int dsssframesync_decode_payload(dsssframesync _q)
         return 0;
     }
 
+    frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
     _q->payload_valid = qpacketmodem_decode_soft_payload(_q->payload_decoder, _q->payload_dec);
 
     return 1;
@@ -596,6 +616,27 @@ framedatastats_s dsssframesync_get_framedatastats(dsssframesync _q)
     return _q->framedatastats;
 }
 
+void dsssframesync_profile_enable(dsssframesync _q)
+{
+    _q->profile.enabled = 1;
+}
+
+void dsssframesync_profile_disable(dsssframesync _q)
+{
+    frameprofile_stop(&_q->profile);
+    _q->profile.enabled = 0;
+}
+
+void dsssframesync_reset_profile(dsssframesync _q)
+{
+    frameprofile_reset(&_q->profile);
+}
+
+frameprofile_s dsssframesync_get_profile(dsssframesync _q)
+{
+    return _q->profile;
+}
+
 void dsssframesync_debug_enable(dsssframesync _q)
 {
 }
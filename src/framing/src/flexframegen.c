@@ -37,13 +37,20 @@
 
 #define DEBUG_FLEXFRAMEGEN 1
 
+// number of header waveforms to keep in cache
+#define FLEXFRAMEGEN_HEADER_CACHE_LEN (8)
+
 // reconfigure internal properties
-void          flexframegen_reconfigure      (flexframegen _q);
-float complex flexframegen_generate_symbol  (flexframegen _q);
-float complex flexframegen_generate_preamble(flexframegen _q);
-float complex flexframegen_generate_header  (flexframegen _q);
-float complex flexframegen_generate_payload (flexframegen _q);
-float complex flexframegen_generate_tail    (flexframegen _q);
+void flexframegen_reconfigure(flexframegen _q);
+
+// find header in cache, encoding and interpolating it on a miss
+unsigned int flexframegen_encode_header(flexframegen _q);
+
+// write samples [_n0, _n0+_n) of assembled frame to output buffer
+void flexframegen_write_frame(flexframegen    _q,
+                              unsigned int    _n0,
+                              unsigned int    _n,
+                              float complex * _buffer);
 
 // default flexframegen properties
 static flexframegenprops_s flexframegenprops_default = {
@@ -70,14 +77,15 @@ struct flexframegen_s {
     unsigned int    k;                  // interp samples/symbol (fixed at 2)
     unsigned int    m;                  // interp filter delay (symbols)
     float           beta;               // excess bandwidth factor
-    firinterp_crcf  interp;             // interpolator object
-    float complex   buf_interp[2];      // output interpolator buffer [size: k x 1]
+    unsigned int    h_sub_len;          // sub-filter length (2m+1)
+    dotprod_crcf    dp[2];              // polyphase pulse-shaping filters [size: k x 1]
 
     flexframegenprops_s props;          // payload properties
     flexframegenprops_s header_props;   // header properties
 
     // preamble
     float complex * preamble_pn;        // p/n sequence
+    float complex * preamble_wave;      // interpolated p/n sequence [size: 64k x 1]
 
     // header
     unsigned char * header;             // header data
@@ -88,37 +96,58 @@ struct flexframegen_s {
     float complex * header_mod;         // header symbols (encoded/modulated)
     qpilotgen       header_pilotgen;    // header pilot symbol generator
     unsigned int    header_sym_len;     // header length (pilots added)
-    float complex * header_sym;         // header symbols (pilots added)
+
+    // header cache: decoded header, symbols (pilots added), and
+    // interpolated waveform of recently encoded headers
+    unsigned char * cache_dec;          // [size: FLEXFRAMEGEN_HEADER_CACHE_LEN x header_dec_len]
+    float complex * cache_sym;          // [size: FLEXFRAMEGEN_HEADER_CACHE_LEN x header_sym_len]
+    float complex * cache_wave;         // [size: FLEXFRAMEGEN_HEADER_CACHE_LEN x k*header_sym_len]
+    unsigned int    cache_num;          // number of valid entries
+    unsigned int    cache_next;         // next entry to replace
+    unsigned int    cache_index;        // entry used by assembled frame
 
     // payload
     unsigned int    payload_dec_len;    // length of decoded
     qpacketmodem    payload_encoder;    // packet encoder/modulator
     unsigned int    payload_sym_len;    // length of encoded/modulated payload
-    float complex * payload_sym;        // encoded payload symbols
+
+    // frame symbols: 2m zeros (filter history), preamble, header,
+    // payload, and 2m zeros (tail)
+    unsigned int    frame_sym_len;      // length of frame symbol buffer
+    float complex * frame_sym;          // frame symbol buffer
+    float complex * payload_sym;        // payload symbols (pointer into frame_sym)
 
     // counters/states
-    unsigned int    symbol_counter;     // output symbol number
+    unsigned int    frame_len;          // number of samples in frame
     unsigned int    sample_counter;     // output sample number
     int             frame_assembled;    // frame assembled flag
     int             frame_complete;     // frame completed flag
-    enum {
-                    STATE_PREAMBLE=0,   // write preamble p/n sequence
-                    STATE_HEADER,       // write header symbols
-                    STATE_PAYLOAD,      // write payload symbols
-                    STATE_TAIL,         // tail symbols
-    }               state;              // write state
 };
 
 flexframegen flexframegen_create(flexframegenprops_s * _fgprops)
 {
     flexframegen q = (flexframegen) malloc(sizeof(struct flexframegen_s));
     unsigned int i;
-
-    // create pulse-shaping filter
-    q->k      = 2;
-    q->m      = 7;
-    q->beta   = 0.25f;
-    q->interp = firinterp_crcf_create_prototype(LIQUID_FIRFILT_ARKAISER,q->k,q->m,q->beta,0);
+    unsigned int n;
+
+    // create pulse-shaping filter, realized as one dot product per
+    // output phase operating directly on the frame symbol buffer
+    q->k         = 2;
+    q->m         = 7;
+    q->beta      = 0.25f;
+    q->h_sub_len = 2*q->m + 1;
+    unsigned int h_len = 2*q->k*q->m + 1;
+    float h[q->k*q->h_sub_len];
+    liquid_firdes_prototype(LIQUID_FIRFILT_ARKAISER,q->k,q->m,q->beta,0,h);
+    for (i=h_len; i<q->k*q->h_sub_len; i++)
+        h[i] = 0.0f;
+    float h_sub[q->h_sub_len];
+    for (i=0; i<q->k; i++) {
+        // load sub-filter in reverse order
+        for (n=0; n<q->h_sub_len; n++)
+            h_sub[q->h_sub_len-n-1] = h[i + n*q->k];
+        q->dp[i] = dotprod_crcf_create(h_sub, q->h_sub_len);
+    }
 
     // generate pn sequence
     q->preamble_pn = (float complex *) malloc(64*sizeof(float complex));
@@ -129,22 +158,33 @@ flexframegen flexframegen_create(flexframegenprops_s * _fgprops)
     }
     msequence_destroy(ms);
 
-    // reset object
-    flexframegen_reset(q);
+    // interpolate preamble once; the filter history is always zero at
+    // the start of the frame
+    float complex preamble_buf[2*q->m + 64];
+    memset(preamble_buf, 0x00, 2*q->m*sizeof(float complex));
+    memmove(&preamble_buf[2*q->m], q->preamble_pn, 64*sizeof(float complex));
+    q->preamble_wave = (float complex *) malloc(64*q->k*sizeof(float complex));
+    for (i=0; i<64*q->k; i++)
+        dotprod_crcf_execute(q->dp[i % q->k], &preamble_buf[i / q->k], &q->preamble_wave[i]);
 
     // create header encoder/modulator
     q->header = NULL;
     q->header_mod = NULL;
-    q->header_sym = NULL;
     q->header_encoder = NULL;
     q->header_pilotgen = NULL;
     q->header_user_len = FLEXFRAME_H_USER_DEFAULT;
+    q->header_sym_len  = 0;
+    q->cache_dec  = NULL;
+    q->cache_sym  = NULL;
+    q->cache_wave = NULL;
 
     // payload encoder/modulator (initialize with default parameters to be reconfigured later)
     q->payload_encoder = qpacketmodem_create();
     q->payload_dec_len = 64;
-    q->payload_sym_len = qpacketmodem_get_frame_len(q->payload_encoder);
-    q->payload_sym     = (float complex *) malloc( q->payload_sym_len*sizeof(float complex));
+    q->frame_sym       = NULL;
+
+    // reset object
+    flexframegen_reset(q);
 
     // set payload properties
     flexframegen_setprops(q, _fgprops);
@@ -157,17 +197,21 @@ flexframegen flexframegen_create(flexframegenprops_s * _fgprops)
 void flexframegen_destroy(flexframegen _q)
 {
     // destroy internal objects
-    firinterp_crcf_destroy(_q->interp);
-    qpacketmodem_destroy  (_q->header_encoder);
-    qpilotgen_destroy     (_q->header_pilotgen);
-    qpacketmodem_destroy  (_q->payload_encoder);
+    dotprod_crcf_destroy(_q->dp[0]);
+    dotprod_crcf_destroy(_q->dp[1]);
+    qpacketmodem_destroy(_q->header_encoder);
+    qpilotgen_destroy   (_q->header_pilotgen);
+    qpacketmodem_destroy(_q->payload_encoder);
 
     // free buffers/arrays
     free(_q->preamble_pn);  // preamble symbols
+    free(_q->preamble_wave);// interpolated preamble
     free(_q->header);       // header bytes
     free(_q->header_mod);   // encoded/modulated header symbols 
-    free(_q->header_sym);
-    free(_q->payload_sym);  // encoded/modulated payload symbols
+    free(_q->cache_dec);    // header cache
+    free(_q->cache_sym);
+    free(_q->cache_wave);
+    free(_q->frame_sym);    // frame symbols
 
     // destroy frame generator
     free(_q);
@@ -202,11 +246,10 @@ void flexframegen_print(flexframegen _q)
 void flexframegen_reset(flexframegen _q)
 {
     // reset internal counters and state
-    _q->symbol_counter  = 0;
+    _q->frame_len       = 0;
     _q->sample_counter  = 0;
     _q->frame_assembled = 0;
     _q->frame_complete  = 0;
-    _q->state           = STATE_PREAMBLE;
 }
 
 // is frame assembled?
@@ -298,8 +341,18 @@ void flexframegen_set_header_len(flexframegen   _q,
     }
     _q->header_pilotgen = qpilotgen_create(_q->header_mod_len, 16);
     _q->header_sym_len  = qpilotgen_get_frame_len(_q->header_pilotgen);
-    _q->header_sym      = (float complex *) realloc(_q->header_sym, _q->header_sym_len*sizeof(float complex));
     //printf("header: %u bytes > %u mod > %u sym\n", 64, _q->header_mod_len, _q->header_sym_len);
+
+    // re-allocate (and invalidate) header cache
+    unsigned int n = FLEXFRAMEGEN_HEADER_CACHE_LEN;
+    _q->cache_dec  = (unsigned char *) realloc(_q->cache_dec,  n*_q->header_dec_len*sizeof(unsigned char));
+    _q->cache_sym  = (float complex *) realloc(_q->cache_sym,  n*_q->header_sym_len*sizeof(float complex));
+    _q->cache_wave = (float complex *) realloc(_q->cache_wave, n*_q->header_sym_len*_q->k*sizeof(float complex));
+    _q->cache_num  = 0;
+    _q->cache_next = 0;
+
+    // re-allocate frame buffer for new header length
+    flexframegen_reconfigure(_q);
 }
 
 int flexframegen_set_header_props(flexframegen          _q,
@@ -343,13 +396,7 @@ unsigned int flexframegen_getframelen(flexframegen _q)
         fprintf(stderr,"warning: flexframegen_getframelen(), frame not assembled!\n");
         return 0;
     }
-    unsigned int num_frame_symbols =
-            64 +                    // preamble p/n sequence length
-            _q->header_sym_len +    // header symbols
-            _q->payload_sym_len +   // number of modulation symbols
-            2*_q->m;                // number of tail symbols
-
-    return num_frame_symbols*_q->k; // k samples/symbol
+    return _q->frame_len;
 }
 
 // exectue frame generator (create the frame)
@@ -395,25 +442,31 @@ void flexframegen_assemble(flexframegen          _q,
     _q->header[n+4] |= (_q->props.fec0) & 0x1f;
     _q->header[n+5]  = (_q->props.fec1) & 0x1f;
 
-    // encode/modulate header
-    qpacketmodem_encode(_q->header_encoder, _q->header, _q->header_mod);
-
-    // add pilots
-    qpilotgen_execute(_q->header_pilotgen, _q->header_mod, _q->header_sym);
-
-    // reconfigure payload
+    // reconfigure payload, frame buffer
     flexframegen_reconfigure(_q);
 
-    // encode/modulate payload
+    // encode/modulate header (or retrieve from cache) and copy to frame
+    _q->cache_index = flexframegen_encode_header(_q);
+    memmove(&_q->frame_sym[2*_q->m + 64],
+            &_q->cache_sym[_q->cache_index*_q->header_sym_len],
+            _q->header_sym_len*sizeof(float complex));
+
+    // encode/modulate payload directly into frame buffer
     qpacketmodem_encode(_q->payload_encoder, _payload, _q->payload_sym);
 
+    // set frame length (k samples/symbol)
+    _q->frame_len = _q->k * (64 +                   // preamble p/n sequence length
+                             _q->header_sym_len +   // header symbols
+                             _q->payload_sym_len +  // number of modulation symbols
+                             2*_q->m);              // number of tail symbols
+
     // set assembled flag
     _q->frame_assembled = 1;
 }
 
-// write samples of assembled frame, two samples at a time, returning
-// '1' when frame is complete, '0' otherwise. Zeros will be written
-// to the buffer if the frame is not assembled
+// write samples of assembled frame, returning '1' when frame is
+// complete, '0' otherwise. Zeros will be written to the buffer if
+// the frame is not assembled
 //  _q          :   frame generator object
 //  _buffer     :   output buffer [size: _buffer_len x 1]
 //  _buffer_len :   output buffer length
@@ -421,27 +474,79 @@ int flexframegen_write_samples(flexframegen    _q,
                                float complex * _buffer,
                                unsigned int    _buffer_len)
 {
-    unsigned int i;
-    for (i=0; i<_buffer_len; i++) {
-        // determine if new sample needs to be written
-        if (_q->sample_counter == 0) {
-            // generate new symbol
-            float complex sym = flexframegen_generate_symbol(_q);
-
-            // interpolate result
-            firinterp_crcf_execute(_q->interp, sym, _q->buf_interp);
+    unsigned int n = 0;
+    if (_q->frame_assembled) {
+        // write as much of the remaining frame as possible
+        n = _q->frame_len - _q->sample_counter;
+        n = n < _buffer_len ? n : _buffer_len;
+        flexframegen_write_frame(_q, _q->sample_counter, n, _buffer);
+        _q->sample_counter += n;
+
+        // check state
+        if (_q->sample_counter == _q->frame_len) {
+            _q->frame_complete  = 1;
+            _q->frame_assembled = 0;
         }
-        
-        // write output sample from interpolator buffer
-        _buffer[i] = _q->buf_interp[_q->sample_counter];
-            
-        // adjust sample counter
-        _q->sample_counter = (_q->sample_counter + 1) % _q->k;
     }
 
+    // fill remainder of buffer with zeros
+    memset(&_buffer[n], 0x00, (_buffer_len-n)*sizeof(float complex));
+
     return _q->frame_complete;
 }
 
+// assemble and write a batch of frames with a common header to one
+// contiguous buffer, separated by _gap zero-valued samples; stops at the
+// first frame which does not fit in the remaining buffer. Any frame
+// currently assembled is discarded. Returns the number of frames written.
+//  _q          :   frame generator object
+//  _header     :   user-defined header (NULL for zeros)
+//  _payloads   :   payload for each frame [size: _n x 1]
+//  _lens       :   payload length for each frame [size: _n x 1]
+//  _n          :   number of frames
+//  _gap        :   number of zero-valued samples between frames
+//  _buffer     :   output buffer [size: _buffer_len x 1]
+//  _buffer_len :   output buffer length
+//  _num_written:   number of samples written (ignored if NULL)
+unsigned int flexframegen_generate_batch(flexframegen            _q,
+                                         const unsigned char *   _header,
+                                         const unsigned char * * _payloads,
+                                         const unsigned int *    _lens,
+                                         unsigned int            _n,
+                                         unsigned int            _gap,
+                                         float complex *         _buffer,
+                                         unsigned int            _buffer_len,
+                                         unsigned int *          _num_written)
+{
+    unsigned int i;
+    unsigned int num_written = 0;
+    for (i=0; i<_n; i++) {
+        // determine frame length before encoding anything
+        _q->payload_dec_len = _lens[i];
+        flexframegen_reconfigure(_q);
+        unsigned int gap = i == 0 ? 0 : _gap;
+        unsigned int frame_len = _q->k * (64 + _q->header_sym_len + _q->payload_sym_len + 2*_q->m);
+        if (num_written + gap + frame_len > _buffer_len)
+            break;
+
+        // write gap
+        memset(&_buffer[num_written], 0x00, gap*sizeof(float complex));
+        num_written += gap;
+
+        // assemble and write frame
+        flexframegen_assemble(_q, _header, _payloads[i], _lens[i]);
+        flexframegen_write_frame(_q, 0, _q->frame_len, &_buffer[num_written]);
+        num_written += _q->frame_len;
+    }
+
+    // frames have been written in their entirety
+    flexframegen_reset(_q);
+
+    if (_num_written != NULL)
+        *_num_written = num_written;
+    return i;
+}
+
 //
 // internal
 //
@@ -456,91 +561,98 @@ void flexframegen_reconfigure(flexframegen _q)
                            _q->props.fec0,
                            _q->props.fec1,
                            _q->props.mod_scheme);
-
-    // re-allocate memory for encoded message
     _q->payload_sym_len = qpacketmodem_get_frame_len(_q->payload_encoder);
-    _q->payload_sym = (float complex*) realloc(_q->payload_sym,
-                                               _q->payload_sym_len*sizeof(float complex));
 
-    // ensure payload was reallocated appropriately
-    if (_q->payload_sym == NULL) {
-        fprintf(stderr,"error: flexframegen_reconfigure(), could not re-allocate payload array\n");
-        exit(1);
-    }
-}
+    // re-allocate memory for frame symbols as necessary
+    unsigned int frame_sym_len = 2*_q->m + 64 + _q->header_sym_len + _q->payload_sym_len + 2*_q->m;
+    if (_q->frame_sym == NULL || frame_sym_len > _q->frame_sym_len) {
+        _q->frame_sym = (float complex*) realloc(_q->frame_sym,
+                                                 frame_sym_len*sizeof(float complex));
 
-// fill interpolator buffer
-float complex flexframegen_generate_symbol(flexframegen _q)
-{
-    // write zeros to buffer if frame is not assembled
-    if (!_q->frame_assembled)
-        return 0.0f;
-
-    switch (_q->state) {
-    case STATE_PREAMBLE: return flexframegen_generate_preamble(_q); break;
-    case STATE_HEADER:   return flexframegen_generate_header  (_q); break;
-    case STATE_PAYLOAD:  return flexframegen_generate_payload (_q); break;
-    case STATE_TAIL:     return flexframegen_generate_tail    (_q); break;
-    default:
-        fprintf(stderr,"error: flexframegen_generate_symbol(), unknown/unsupported internal state\n");
-        exit(1);
+        // ensure frame buffer was reallocated appropriately
+        if (_q->frame_sym == NULL) {
+            fprintf(stderr,"error: flexframegen_reconfigure(), could not re-allocate frame array\n");
+            exit(1);
+        }
+
+        // filter history and preamble never change
+        memset (_q->frame_sym, 0x00, 2*_q->m*sizeof(float complex));
+        memmove(&_q->frame_sym[2*_q->m], _q->preamble_pn, 64*sizeof(float complex));
     }
+    _q->frame_sym_len = frame_sym_len;
+    _q->payload_sym   = &_q->frame_sym[2*_q->m + 64 + _q->header_sym_len];
 
-    return 0.0f;
+    // tail symbols
+    memset(&_q->payload_sym[_q->payload_sym_len], 0x00, 2*_q->m*sizeof(float complex));
 }
 
-// generate preamble
-float complex flexframegen_generate_preamble(flexframegen _q)
+// find header in cache, encoding and interpolating it on a miss;
+// returns index of cache entry
+unsigned int flexframegen_encode_header(flexframegen _q)
 {
-    float complex symbol = _q->preamble_pn[_q->symbol_counter++];
-
-    // check state
-    if (_q->symbol_counter == 64) {
-        _q->symbol_counter = 0;
-        _q->state = STATE_HEADER;
+    unsigned int i;
+    for (i=0; i<_q->cache_num; i++) {
+        if (memcmp(&_q->cache_dec[i*_q->header_dec_len], _q->header, _q->header_dec_len) == 0)
+            return i;
     }
-    return symbol;
-}
 
-// generate header
-float complex flexframegen_generate_header(flexframegen _q)
-{
-    float complex symbol = _q->header_sym[_q->symbol_counter++];
+    // replace entry
+    i = _q->cache_next;
+    _q->cache_next = (_q->cache_next + 1) % FLEXFRAMEGEN_HEADER_CACHE_LEN;
+    if (_q->cache_num < FLEXFRAMEGEN_HEADER_CACHE_LEN)
+        _q->cache_num++;
+    memmove(&_q->cache_dec[i*_q->header_dec_len], _q->header, _q->header_dec_len);
 
-    // check state
-    if (_q->symbol_counter == _q->header_sym_len) {
-        _q->symbol_counter = 0;
-        _q->state = STATE_PAYLOAD;
-    }
-    return symbol;
+    // encode/modulate header, add pilots
+    float complex * sym = &_q->cache_sym[i*_q->header_sym_len];
+    qpacketmodem_encode(_q->header_encoder, _q->header, _q->header_mod);
+    qpilotgen_execute(_q->header_pilotgen, _q->header_mod, sym);
+
+    // interpolate header following preamble (depends on no other symbols)
+    float complex buf[2*_q->m + _q->header_sym_len];
+    memmove(buf, &_q->preamble_pn[64-2*_q->m], 2*_q->m*sizeof(float complex));
+    memmove(&buf[2*_q->m], sym, _q->header_sym_len*sizeof(float complex));
+    float complex * wave = &_q->cache_wave[i*_q->header_sym_len*_q->k];
+    unsigned int n;
+    for (n=0; n<_q->header_sym_len*_q->k; n++)
+        dotprod_crcf_execute(_q->dp[n % _q->k], &buf[n / _q->k], &wave[n]);
+    return i;
 }
 
-// generate payload
-float complex flexframegen_generate_payload(flexframegen _q)
+// write samples [_n0, _n0+_n) of assembled frame to output buffer
+void flexframegen_write_frame(flexframegen    _q,
+                              unsigned int    _n0,
+                              unsigned int    _n,
+                              float complex * _buffer)
 {
-    float complex symbol = _q->payload_sym[_q->symbol_counter++];
-
-    // check state
-    if (_q->symbol_counter == _q->payload_sym_len) {
-        _q->symbol_counter = 0;
-        _q->state = STATE_TAIL;
+    unsigned int n1 = _n0 + _n;
+
+    // preamble, header: copy from cached waveforms
+    unsigned int preamble_len = 64*_q->k;
+    unsigned int header_len   = _q->header_sym_len*_q->k;
+    unsigned int i = _n0;
+    if (i < preamble_len) {
+        unsigned int n = (n1 < preamble_len ? n1 : preamble_len) - i;
+        memmove(_buffer, &_q->preamble_wave[i], n*sizeof(float complex));
+        i += n;
     }
-    return symbol;
-}
-
-// generate tail
-float complex flexframegen_generate_tail(flexframegen _q)
-{
-    // increment symbol counter
-    _q->symbol_counter++;
-
-    // check state
-    if (_q->symbol_counter == 2*_q->m) {
-        _q->symbol_counter  = 0;
-        _q->frame_complete  = 1;
-        _q->frame_assembled = 0;
+    if (i < n1 && i < preamble_len + header_len) {
+        unsigned int n = (n1 < preamble_len + header_len ? n1 : preamble_len + header_len) - i;
+        memmove(&_buffer[i-_n0],
+                &_q->cache_wave[_q->cache_index*header_len + i - preamble_len],
+                n*sizeof(float complex));
+        i += n;
     }
 
-    return 0.0f;
+    // payload, tail: interpolate from frame symbols; window for symbol
+    // j is frame_sym[j, j+2m] (preceded by 2m zeros of filter history)
+    unsigned int s = i / _q->k;
+    unsigned int p = i % _q->k;
+    for ( ; i<n1; i++) {
+        dotprod_crcf_execute(_q->dp[p], &_q->frame_sym[s], &_buffer[i-_n0]);
+        if (++p == _q->k) {
+            p = 0;
+            s++;
+        }
+    }
 }
-
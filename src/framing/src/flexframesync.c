@@ -42,6 +42,9 @@
 
 #define FLEXFRAMESYNC_ENABLE_EQ     0
 
+// number of pooled frames per decoder thread
+#define FLEXFRAMESYNC_DECODE_FRAMES_PER_THREAD  (2)
+
 // push samples through detection stage
 void flexframesync_execute_seekpn(flexframesync _q,
                                   float complex _x);
@@ -83,6 +86,7 @@ struct flexframesync_s {
     void *              userdata;       // user-defined data structure
     framesyncstats_s    framesyncstats; // frame statistic object (synchronizer)
     framedatastats_s    framedatastats; // frame statistic object (packet statistics)
+    frameprofile_s      profile;        // execution time of internal stages
     
     // synchronizer objects
     unsigned int    m;                  // filter delay (symbols)
@@ -132,6 +136,10 @@ struct flexframesync_s {
     unsigned char * payload_dec;        // payload data (bytes)
     unsigned int    payload_dec_len;    // payload data (length)
     int             payload_valid;      // payload CRC flag
+
+    // asynchronous payload decoding
+    framedecpool    decpool;            // payload decoder pool (NULL: decode in place)
+    framedecpool_frame decframe;        // pooled frame being received
     
     // status variables
     unsigned int    preamble_counter;   // counter: num of p/n syms received
@@ -226,8 +234,14 @@ flexframesync flexframesync_create(framesync_callback _callback,
     q->payload_dec = (unsigned char*) malloc(q->payload_dec_len*sizeof(unsigned char));
     q->payload_soft = 0;
 
-    // reset global data counters
+    // payload is decoded in place by default
+    q->decpool  = NULL;
+    q->decframe = NULL;
+
+    // reset global data counters, profiling disabled
     flexframesync_reset_framedatastats(q);
+    q->profile.enabled = 0;
+    flexframesync_reset_profile(q);
 
 #if DEBUG_FLEXFRAMESYNC
     // set debugging flags, objects to NULL
@@ -245,6 +259,9 @@ flexframesync flexframesync_create(framesync_callback _callback,
 // destroy frame synchronizer object, freeing all internal memory
 void flexframesync_destroy(flexframesync _q)
 {
+    // deliver outstanding frames and stop decoder threads
+    flexframesync_set_decode_threads(_q, 0);
+
 #if DEBUG_FLEXFRAMESYNC
     // clean up debug objects (if created)
     if (_q->debug_objects_created)
@@ -296,6 +313,12 @@ void flexframesync_reset(flexframesync _q)
 
     // reset symbol timing recovery state
     firpfb_crcf_reset(_q->mf);
+
+    // return partially-received frame to decoder pool
+    if (_q->decframe != NULL) {
+        framedecpool_release(_q->decpool, _q->decframe);
+        _q->decframe = NULL;
+    }
         
     // reset state
     _q->state           = FLEXFRAMESYNC_STATE_DETECTFRAME;
@@ -351,6 +374,35 @@ void flexframesync_decode_payload_soft(flexframesync _q,
     _q->payload_soft = _soft;
 }
 
+void flexframesync_set_decode_threads(flexframesync _q,
+                                      unsigned int  _num_threads)
+{
+    // abandon partially-received frame
+    if (_q->decframe != NULL)
+        flexframesync_reset(_q);
+
+    // deliver outstanding frames and stop existing threads
+    if (_q->decpool != NULL) {
+        framedecpool_destroy(_q->decpool);
+        _q->decpool = NULL;
+    }
+
+    if (_num_threads == 0)
+        return;
+
+    _q->decpool = framedecpool_create(_num_threads,
+                                      _num_threads*FLEXFRAMESYNC_DECODE_FRAMES_PER_THREAD,
+                                      _q->callback,
+                                      _q->userdata,
+                                      &_q->framedatastats);
+}
+
+void flexframesync_drain(flexframesync _q)
+{
+    if (_q->decpool != NULL)
+        framedecpool_drain(_q->decpool);
+}
+
 int flexframesync_set_header_props(flexframesync          _q,
                                    flexframegenprops_s * _props)
 {
@@ -379,6 +431,14 @@ int flexframesync_set_header_props(flexframesync          _q,
     return 0;
 }
 
+// profiling stage for each internal state
+static const int flexframesync_profile_stage[4] = {
+    LIQUID_FRAMEPROFILE_DETECT,     // FLEXFRAMESYNC_STATE_DETECTFRAME
+    LIQUID_FRAMEPROFILE_PREAMBLE,   // FLEXFRAMESYNC_STATE_RXPREAMBLE
+    LIQUID_FRAMEPROFILE_HEADER,     // FLEXFRAMESYNC_STATE_RXHEADER
+    LIQUID_FRAMEPROFILE_PAYLOAD,    // FLEXFRAMESYNC_STATE_RXPAYLOAD
+};
+
 // execute frame synchronizer
 //  _q  :   frame synchronizer object
 //  _x  :   input sample array [size: _n x 1]
@@ -389,6 +449,7 @@ void flexframesync_execute(flexframesync   _q,
 {
     unsigned int i;
     for (i=0; i<_n; i++) {
+        frameprofile_switch(&_q->profile, flexframesync_profile_stage[_q->state]);
 #if DEBUG_FLEXFRAMESYNC
         // write samples to debug buffer
         // NOTE: the debug_qdetector_flush prevents samples from being written twice
@@ -417,6 +478,7 @@ void flexframesync_execute(flexframesync   _q,
             exit(1);
         }
     }
+    frameprofile_stop(&_q->profile);
 }
 
 // 
@@ -437,11 +499,42 @@ void flexframesync_execute_seekpn(flexframesync _q,
     if (v == NULL)
         return;
 
-    // get estimates
-    _q->tau_hat   = qdetector_cccf_get_tau  (_q->detector);
-    _q->gamma_hat = qdetector_cccf_get_gamma(_q->detector);
-    _q->dphi_hat  = qdetector_cccf_get_dphi (_q->detector);
-    _q->phi_hat   = qdetector_cccf_get_phi  (_q->detector);
+    // set estimates and start receiving frame
+    flexframesync_start_frame(_q,
+                              qdetector_cccf_get_tau  (_q->detector),
+                              qdetector_cccf_get_dphi (_q->detector),
+                              qdetector_cccf_get_phi  (_q->detector),
+                              qdetector_cccf_get_gamma(_q->detector));
+
+#if DEBUG_FLEXFRAMESYNC
+    // the debug_qdetector_flush prevents samples from being written twice
+    _q->debug_qdetector_flush = 1;
+#endif
+    // run buffered samples through synchronizer
+    unsigned int buf_len = qdetector_cccf_get_buf_len(_q->detector);
+    flexframesync_execute(_q, v, buf_len);
+#if DEBUG_FLEXFRAMESYNC
+    _q->debug_qdetector_flush = 0;
+#endif
+}
+
+// start receiving frame from detector estimates; the next sample pushed
+// through the synchronizer is the first sample of the detector buffer
+//  _q      :   frame synchronizer object
+//  _tau    :   fractional timing offset estimate
+//  _dphi   :   carrier frequency offset estimate
+//  _phi    :   carrier phase offset estimate
+//  _gamma  :   channel gain estimate
+void flexframesync_start_frame(flexframesync _q,
+                               float         _tau,
+                               float         _dphi,
+                               float         _phi,
+                               float         _gamma)
+{
+    _q->tau_hat   = _tau;
+    _q->dphi_hat  = _dphi;
+    _q->phi_hat   = _phi;
+    _q->gamma_hat = _gamma;
 
 #if DEBUG_FLEXFRAMESYNC_PRINT
     printf("***** frame detected! tau-hat:%8.4f, dphi-hat:%8.4f, gamma:%8.2f dB\n",
@@ -466,17 +559,32 @@ void flexframesync_execute_seekpn(flexframesync _q,
 
     // update state
     _q->state = FLEXFRAMESYNC_STATE_RXPREAMBLE;
+}
 
-#if DEBUG_FLEXFRAMESYNC
-    // the debug_qdetector_flush prevents samples from being written twice
-    _q->debug_qdetector_flush = 1;
-#endif
-    // run buffered samples through synchronizer
-    unsigned int buf_len = qdetector_cccf_get_buf_len(_q->detector);
-    flexframesync_execute(_q, v, buf_len);
-#if DEBUG_FLEXFRAMESYNC
-    _q->debug_qdetector_flush = 0;
-#endif
+// push samples through synchronizer for a frame started externally with
+// flexframesync_start_frame(), stopping once the frame is complete;
+// returns number of samples consumed
+unsigned int flexframesync_execute_frame(flexframesync   _q,
+                                         float complex * _x,
+                                         unsigned int    _n)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        frameprofile_switch(&_q->profile, flexframesync_profile_stage[_q->state]);
+        switch (_q->state) {
+        case FLEXFRAMESYNC_STATE_DETECTFRAME:
+            frameprofile_stop(&_q->profile);
+            return i;
+        case FLEXFRAMESYNC_STATE_RXPREAMBLE:  flexframesync_execute_rxpreamble(_q, _x[i]); break;
+        case FLEXFRAMESYNC_STATE_RXHEADER:    flexframesync_execute_rxheader  (_q, _x[i]); break;
+        case FLEXFRAMESYNC_STATE_RXPAYLOAD:   flexframesync_execute_rxpayload (_q, _x[i]); break;
+        default:
+            fprintf(stderr,"error: flexframesync_execute_frame(), unknown/unsupported state\n");
+            exit(1);
+        }
+    }
+    frameprofile_stop(&_q->profile);
+    return _n;
 }
 
 // step receiver mixer, matched filter, decimator
@@ -587,12 +695,40 @@ void flexframesync_execute_rxheader(flexframesync _q,
             flexframesync_decode_header(_q);
 
             if (_q->header_valid) {
+                // capture payload symbols directly into pooled frame
+                if (_q->decpool != NULL) {
+                    // waiting for a free frame is counted as decoding
+                    frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
+                    _q->decframe = framedecpool_acquire(_q->decpool, _q->header_dec_len, _q->payload_sym_len);
+                    memmove(_q->decframe->header, _q->header_dec, _q->header_dec_len*sizeof(unsigned char));
+                }
+
                 // continue on to decoding payload
                 _q->symbol_counter = 0;
                 _q->state = FLEXFRAMESYNC_STATE_RXPAYLOAD;
                 return;
             }
 
+            // header invalid: hand off to decoder pool to preserve frame order
+            if (_q->decpool != NULL) {
+                frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
+                framedecpool_frame f = framedecpool_acquire(_q->decpool, _q->header_dec_len, 0);
+                memmove(f->header, _q->header_dec, _q->header_dec_len*sizeof(unsigned char));
+                f->header_valid       = 0;
+                f->stats              = _q->framesyncstats;
+                f->stats.evm          = 0.0f;
+                f->stats.rssi         = 20*log10f(_q->gamma_hat);
+                f->stats.cfo          = nco_crcf_get_frequency(_q->mixer);
+                f->stats.mod_scheme   = LIQUID_MODEM_UNKNOWN;
+                f->stats.mod_bps      = 0;
+                f->stats.check        = LIQUID_CRC_UNKNOWN;
+                f->stats.fec0         = LIQUID_FEC_UNKNOWN;
+                f->stats.fec1         = LIQUID_FEC_UNKNOWN;
+                framedecpool_submit(_q->decpool, f);
+                flexframesync_reset(_q);
+                return;
+            }
+
             // update statistics
             _q->framedatastats.num_frames_detected++;
 
@@ -611,6 +747,7 @@ void flexframesync_execute_rxheader(flexframesync _q,
                 _q->framesyncstats.fec1          = LIQUID_FEC_UNKNOWN;
 
                 // invoke callback method
+                frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
                 _q->callback(_q->header_dec,
                              _q->header_valid,
                              NULL,  // payload
@@ -764,13 +901,42 @@ void flexframesync_execute_rxpayload(flexframesync _q,
         _q->framesyncstats.evm += evm*evm;
 
         // save payload symbols (modem input/output)
-        _q->payload_sym[_q->symbol_counter] = mf_out;
+        if (_q->decframe != NULL)
+            _q->decframe->payload_sym[_q->symbol_counter] = mf_out;
+        else
+            _q->payload_sym[_q->symbol_counter] = mf_out;
 
         // increment counter
         _q->symbol_counter++;
 
-        if (_q->symbol_counter == _q->payload_sym_len) {
+        if (_q->symbol_counter == _q->payload_sym_len && _q->decframe != NULL) {
+            // hand off to decoder pool
+            frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
+            framedecpool_frame f = _q->decframe;
+            int ms = qpacketmodem_get_modscheme(_q->payload_decoder);
+            f->header_valid     = 1;
+            f->payload_len      = _q->payload_dec_len;
+            f->check            = qpacketmodem_get_crc (_q->payload_decoder);
+            f->fec0             = qpacketmodem_get_fec0(_q->payload_decoder);
+            f->fec1             = qpacketmodem_get_fec1(_q->payload_decoder);
+            f->mod_scheme       = ms;
+            f->soft             = _q->payload_soft;
+            f->stats            = _q->framesyncstats;
+            f->stats.evm        = 10*log10f(_q->framesyncstats.evm / (float)_q->payload_sym_len);
+            f->stats.rssi       = 20*log10f(_q->gamma_hat);
+            f->stats.cfo        = nco_crcf_get_frequency(_q->mixer);
+            f->stats.mod_scheme = ms;
+            f->stats.mod_bps    = modulation_types[ms].bps;
+            f->stats.check      = f->check;
+            f->stats.fec0       = f->fec0;
+            f->stats.fec1       = f->fec1;
+            _q->decframe = NULL;
+            framedecpool_submit(_q->decpool, f);
+            flexframesync_reset(_q);
+            return;
+        } else if (_q->symbol_counter == _q->payload_sym_len) {
             // decode payload
+            frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
             if (_q->payload_soft) {
                 _q->payload_valid = qpacketmodem_decode_soft(_q->payload_decoder,
                                                              _q->payload_sym,
@@ -803,6 +969,7 @@ void flexframesync_execute_rxpayload(flexframesync _q,
                 _q->framesyncstats.fec1          = qpacketmodem_get_fec1(_q->payload_decoder);
 
                 // invoke callback method
+                frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
                 _q->callback(_q->header_dec,
                              _q->header_valid,
                              _q->payload_dec,
@@ -822,15 +989,45 @@ void flexframesync_execute_rxpayload(flexframesync _q,
 // reset frame data statistics
 void flexframesync_reset_framedatastats(flexframesync _q)
 {
+    // statistics are updated on delivery
+    flexframesync_drain(_q);
     framedatastats_reset(&_q->framedatastats);
 }
 
 // retrieve frame data statistics
 framedatastats_s flexframesync_get_framedatastats(flexframesync _q)
 {
+    // statistics are updated on delivery
+    flexframesync_drain(_q);
     return _q->framedatastats;
 }
 
+// enable profiling of internal stages
+void flexframesync_profile_enable(flexframesync _q)
+{
+    _q->profile.enabled = 1;
+}
+
+// disable profiling of internal stages
+void flexframesync_profile_disable(flexframesync _q)
+{
+    frameprofile_stop(&_q->profile);
+    _q->profile.enabled = 0;
+}
+
+// reset profiling counters
+void flexframesync_reset_profile(flexframesync _q)
+{
+    frameprofile_reset(&_q->profile);
+}
+
+// retrieve profiling counters; time spent waiting on a full decoder
+// pool is counted as decoding
+frameprofile_s flexframesync_get_profile(flexframesync _q)
+{
+    return _q->profile;
+}
+
 // enable debugging
 void flexframesync_debug_enable(flexframesync _q)
 {
@@ -0,0 +1,540 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// flexframesyncbank.c
+//
+// flexframe receiver for overlapping frames
+//
+// A single detector runs continuously over the input. Each detection
+// claims an idle per-frame context (a flexframesync object started from
+// the detector estimates) which is fed from a shared ring of input
+// samples, beginning at the start of the detector buffer. Contexts return
+// to the pool once their frame is complete, so a frame arriving while
+// another is still being received is not lost. Input is processed in
+// chunks: detection runs over the chunk first, then every active context
+// consumes the chunk (optionally on multiple threads), then callbacks for
+// frames completed within the chunk are invoked on the calling thread in
+// order of frame arrival.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_PTHREADS_ENABLED
+#include <pthread.h>
+#endif
+
+// per-frame receiver context
+struct flexframesyncbank_context_s {
+    flexframesync       fs;             // frame synchronizer
+    int                 active;         // receiving frame?
+    uint64_t            start;          // absolute index of first frame sample
+    uint64_t            pos;            // absolute index of next sample to push
+
+    // frame completed in current chunk (pointers are owned by 'fs' and
+    // remain valid until the context is started again)
+    int                 complete;       // frame completed flag
+    unsigned char *     header;         // decoded header
+    int                 header_valid;   // header valid flag
+    unsigned char *     payload;        // decoded payload
+    unsigned int        payload_len;    // decoded payload length
+    int                 payload_valid;  // payload valid flag
+    framesyncstats_s    stats;          // frame statistics
+};
+
+struct flexframesyncbank_s {
+    // callback
+    framesync_callback  callback;       // user-defined callback function
+    void *              userdata;       // user-defined data structure
+    framedatastats_s    framedatastats; // frame statistic object (packet statistics)
+
+    // detection
+    float complex *     preamble_pn;    // known 64-symbol p/n sequence
+    qdetector_cccf      detector;       // pre-demod detector
+    unsigned int        buf_len;        // detector buffer length
+
+    // shared sample history
+    float complex *     ring;           // input samples [size: ring_len]
+    unsigned int        ring_len;       // ring length (power of 2)
+    unsigned int        chunk_len;      // maximum number of samples per chunk
+    uint64_t            num_samples;    // total number of samples received
+
+    // context pool
+    unsigned int        num_contexts;   // number of per-frame contexts
+    struct flexframesyncbank_context_s * contexts;
+    unsigned int *      order;          // delivery order scratch [size: num_contexts]
+    unsigned int        num_dropped;    // detections without an idle context
+
+#if LIQUID_PTHREADS_ENABLED
+    // worker threads: contexts are processed in parallel within a chunk
+    unsigned int        num_threads;    // number of worker threads
+    pthread_t *         threads;        // worker threads
+    pthread_mutex_t     mutex;          // pool lock
+    pthread_cond_t      cond_work;      // signaled when a chunk is ready
+    pthread_cond_t      cond_done;      // signaled when a chunk is complete
+    unsigned int        generation;     // chunk counter
+    unsigned int        next_context;   // next context to process
+    unsigned int        num_done;       // number of contexts processed
+    int                 shutdown;       // workers exit when set
+#endif
+};
+
+// internal callback (one per context)
+int flexframesyncbank_context_callback(unsigned char *  _header,
+                                       int              _header_valid,
+                                       unsigned char *  _payload,
+                                       unsigned int     _payload_len,
+                                       int              _payload_valid,
+                                       framesyncstats_s _stats,
+                                       void *           _userdata);
+
+// process a chunk of at most chunk_len samples
+void flexframesyncbank_execute_chunk(flexframesyncbank _q,
+                                     float complex *   _x,
+                                     unsigned int      _n);
+
+// push buffered samples through a context up to the current sample
+void flexframesyncbank_process_context(flexframesyncbank _q,
+                                       unsigned int      _i);
+
+// invoke callbacks for frames completed in the current chunk
+void flexframesyncbank_deliver(flexframesyncbank _q);
+
+#if LIQUID_PTHREADS_ENABLED
+void * flexframesyncbank_worker(void * _q);
+#endif
+
+// create flexframesyncbank object
+//  _num_contexts   :   number of frames which can be received at once, > 0
+//  _callback       :   callback function invoked when frame is received
+//  _userdata       :   user-defined data object passed to callback
+flexframesyncbank flexframesyncbank_create(unsigned int       _num_contexts,
+                                           framesync_callback _callback,
+                                           void *             _userdata)
+{
+    if (_num_contexts == 0) {
+        fprintf(stderr,"error: flexframesyncbank_create(), number of contexts must be greater than zero\n");
+        exit(1);
+    }
+
+    flexframesyncbank q = (flexframesyncbank) malloc(sizeof(struct flexframesyncbank_s));
+    q->callback = _callback;
+    q->userdata = _userdata;
+
+    // generate p/n sequence (same as flexframesync)
+    unsigned int i;
+    q->preamble_pn = (float complex*) malloc(64*sizeof(float complex));
+    msequence ms = msequence_create(7, 0x0089, 1);
+    for (i=0; i<64; i++) {
+        q->preamble_pn[i] = (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2);
+        q->preamble_pn[i] += (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2) * _Complex_I;
+    }
+    msequence_destroy(ms);
+
+    // create frame detector (k=2 samples/symbol, m=7, beta=0.3)
+    q->detector = qdetector_cccf_create_linear(q->preamble_pn, 64, LIQUID_FIRFILT_ARKAISER, 2, 7, 0.3f);
+    qdetector_cccf_set_threshold(q->detector, 0.5f);
+    q->buf_len = qdetector_cccf_get_buf_len(q->detector);
+
+    // sample ring must hold the detector buffer behind a full chunk
+    q->ring_len    = 1 << liquid_nextpow2(4*q->buf_len);
+    q->chunk_len   = q->ring_len - q->buf_len;
+    q->ring        = (float complex*) calloc(q->ring_len, sizeof(float complex));
+    q->num_samples = 0;
+
+    // create per-frame contexts
+    q->num_contexts = _num_contexts;
+    q->contexts = (struct flexframesyncbank_context_s*) calloc(q->num_contexts, sizeof(struct flexframesyncbank_context_s));
+    q->order    = (unsigned int*) malloc(q->num_contexts*sizeof(unsigned int));
+    for (i=0; i<q->num_contexts; i++)
+        q->contexts[i].fs = flexframesync_create(flexframesyncbank_context_callback, (void*)&q->contexts[i]);
+    q->num_dropped = 0;
+
+#if LIQUID_PTHREADS_ENABLED
+    q->num_threads  = 0;
+    q->threads      = NULL;
+    q->generation   = 0;
+    q->next_context = 0;
+    q->num_done     = 0;
+    q->shutdown     = 0;
+    pthread_mutex_init(&q->mutex,     NULL);
+    pthread_cond_init (&q->cond_work, NULL);
+    pthread_cond_init (&q->cond_done, NULL);
+#endif
+
+    // reset global data counters
+    flexframesyncbank_reset_framedatastats(q);
+
+    // reset state and return
+    flexframesyncbank_reset(q);
+    return q;
+}
+
+// destroy object, freeing all internal memory
+void flexframesyncbank_destroy(flexframesyncbank _q)
+{
+    // stop worker threads
+    flexframesyncbank_set_num_threads(_q, 1);
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_destroy(&_q->mutex);
+    pthread_cond_destroy (&_q->cond_work);
+    pthread_cond_destroy (&_q->cond_done);
+#endif
+
+    unsigned int i;
+    for (i=0; i<_q->num_contexts; i++)
+        flexframesync_destroy(_q->contexts[i].fs);
+    free(_q->contexts);
+    free(_q->order);
+    free(_q->ring);
+    free(_q->preamble_pn);
+    qdetector_cccf_destroy(_q->detector);
+    free(_q);
+}
+
+// print object internals
+void flexframesyncbank_print(flexframesyncbank _q)
+{
+    printf("flexframesyncbank:\n");
+    printf("    contexts        : %u (%u active)\n", _q->num_contexts,
+            flexframesyncbank_get_num_active(_q));
+    printf("    dropped         : %u\n", _q->num_dropped);
+    framedatastats_print(&_q->framedatastats);
+}
+
+// reset object, abandoning any frames being received
+void flexframesyncbank_reset(flexframesyncbank _q)
+{
+    qdetector_cccf_reset(_q->detector);
+
+    unsigned int i;
+    for (i=0; i<_q->num_contexts; i++) {
+        flexframesync_reset(_q->contexts[i].fs);
+        _q->contexts[i].active   = 0;
+        _q->contexts[i].complete = 0;
+    }
+}
+
+// set number of threads used to run per-frame contexts (including the
+// calling thread); callbacks are always invoked on the calling thread
+void flexframesyncbank_set_num_threads(flexframesyncbank _q,
+                                       unsigned int      _num_threads)
+{
+#if LIQUID_PTHREADS_ENABLED
+    unsigned int i;
+
+    // stop existing workers
+    if (_q->num_threads > 0) {
+        pthread_mutex_lock(&_q->mutex);
+        _q->shutdown = 1;
+        pthread_cond_broadcast(&_q->cond_work);
+        pthread_mutex_unlock(&_q->mutex);
+        for (i=0; i<_q->num_threads; i++)
+            pthread_join(_q->threads[i], NULL);
+        free(_q->threads);
+        _q->threads     = NULL;
+        _q->num_threads = 0;
+        _q->shutdown    = 0;
+    }
+
+    // no benefit in having more workers than contexts
+    unsigned int num_threads = _num_threads < _q->num_contexts ? _num_threads : _q->num_contexts;
+    if (num_threads <= 1)
+        return;
+
+    _q->num_threads = num_threads - 1;
+    _q->threads = (pthread_t*) malloc(_q->num_threads*sizeof(pthread_t));
+    for (i=0; i<_q->num_threads; i++) {
+        if (pthread_create(&_q->threads[i], NULL, flexframesyncbank_worker, (void*)_q) != 0) {
+            fprintf(stderr,"error: flexframesyncbank_set_num_threads(), could not create thread\n");
+            exit(1);
+        }
+    }
+#endif
+}
+
+// get number of contexts currently receiving a frame
+unsigned int flexframesyncbank_get_num_active(flexframesyncbank _q)
+{
+    unsigned int i, n = 0;
+    for (i=0; i<_q->num_contexts; i++)
+        n += _q->contexts[i].active;
+    return n;
+}
+
+// get number of detections dropped because all contexts were busy
+unsigned int flexframesyncbank_get_num_dropped(flexframesyncbank _q)
+{
+    return _q->num_dropped;
+}
+
+void flexframesyncbank_set_header_len(flexframesyncbank _q,
+                                      unsigned int      _len)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_contexts; i++)
+        flexframesync_set_header_len(_q->contexts[i].fs, _len);
+}
+
+void flexframesyncbank_decode_header_soft(flexframesyncbank _q,
+                                          int               _soft)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_contexts; i++)
+        flexframesync_decode_header_soft(_q->contexts[i].fs, _soft);
+}
+
+void flexframesyncbank_decode_payload_soft(flexframesyncbank _q,
+                                           int               _soft)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_contexts; i++)
+        flexframesync_decode_payload_soft(_q->contexts[i].fs, _soft);
+}
+
+int flexframesyncbank_set_header_props(flexframesyncbank     _q,
+                                       flexframegenprops_s * _props)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_contexts; i++)
+        flexframesync_set_header_props(_q->contexts[i].fs, _props);
+    return 0;
+}
+
+// execute frame receiver
+//  _q  :   frame receiver object
+//  _x  :   input sample array [size: _n x 1]
+//  _n  :   number of input samples
+void flexframesyncbank_execute(flexframesyncbank _q,
+                               float complex *   _x,
+                               unsigned int      _n)
+{
+    while (_n > 0) {
+        unsigned int n = _n < _q->chunk_len ? _n : _q->chunk_len;
+        flexframesyncbank_execute_chunk(_q, _x, n);
+        _x += n;
+        _n -= n;
+    }
+}
+
+// reset frame data statistics
+void flexframesyncbank_reset_framedatastats(flexframesyncbank _q)
+{
+    framedatastats_reset(&_q->framedatastats);
+}
+
+// retrieve frame data statistics
+framedatastats_s flexframesyncbank_get_framedatastats(flexframesyncbank _q)
+{
+    return _q->framedatastats;
+}
+
+//
+// internal methods
+//
+
+// internal callback: record frame for delivery at the end of the chunk
+int flexframesyncbank_context_callback(unsigned char *  _header,
+                                       int              _header_valid,
+                                       unsigned char *  _payload,
+                                       unsigned int     _payload_len,
+                                       int              _payload_valid,
+                                       framesyncstats_s _stats,
+                                       void *           _userdata)
+{
+    struct flexframesyncbank_context_s * c = (struct flexframesyncbank_context_s*) _userdata;
+    c->complete      = 1;
+    c->header        = _header;
+    c->header_valid  = _header_valid;
+    c->payload       = _payload;
+    c->payload_len   = _payload_len;
+    c->payload_valid = _payload_valid;
+    c->stats         = _stats;
+    return 0;
+}
+
+// process a chunk of at most chunk_len samples
+void flexframesyncbank_execute_chunk(flexframesyncbank _q,
+                                     float complex *   _x,
+                                     unsigned int      _n)
+{
+    unsigned int i;
+    uint64_t base = _q->num_samples;
+
+    // append samples to ring
+    unsigned int w  = (unsigned int)(base & (_q->ring_len-1));
+    unsigned int n0 = _q->ring_len - w < _n ? _q->ring_len - w : _n;
+    memmove(_q->ring + w, _x,      n0*sizeof(float complex));
+    memmove(_q->ring,     _x + n0, (_n-n0)*sizeof(float complex));
+    _q->num_samples += _n;
+
+    // run detector continuously, claiming an idle context on each detection
+    for (i=0; i<_n; i++) {
+        if (qdetector_cccf_execute(_q->detector, _x[i]) == NULL)
+            continue;
+
+        unsigned int k;
+        for (k=0; k<_q->num_contexts && _q->contexts[k].active; k++);
+        if (k == _q->num_contexts) {
+            _q->num_dropped++;
+            continue;
+        }
+
+        // detector buffer ends with the current sample
+        struct flexframesyncbank_context_s * c = &_q->contexts[k];
+        flexframesync_start_frame(c->fs,
+                                  qdetector_cccf_get_tau  (_q->detector),
+                                  qdetector_cccf_get_dphi (_q->detector),
+                                  qdetector_cccf_get_phi  (_q->detector),
+                                  qdetector_cccf_get_gamma(_q->detector));
+        c->active = 1;
+        c->start  = base + i + 1 - _q->buf_len;
+        c->pos    = c->start;
+    }
+
+    // run active contexts up to the end of the chunk
+    unsigned int num_active = flexframesyncbank_get_num_active(_q);
+#if LIQUID_PTHREADS_ENABLED
+    if (_q->num_threads > 0 && num_active > 1) {
+        pthread_mutex_lock(&_q->mutex);
+        _q->next_context = 0;
+        _q->num_done     = 0;
+        _q->generation++;
+        pthread_cond_broadcast(&_q->cond_work);
+        while (_q->next_context < _q->num_contexts) {
+            i = _q->next_context++;
+            pthread_mutex_unlock(&_q->mutex);
+            flexframesyncbank_process_context(_q, i);
+            pthread_mutex_lock(&_q->mutex);
+            _q->num_done++;
+        }
+        while (_q->num_done < _q->num_contexts)
+            pthread_cond_wait(&_q->cond_done, &_q->mutex);
+        pthread_mutex_unlock(&_q->mutex);
+    } else
+#endif
+    if (num_active > 0) {
+        for (i=0; i<_q->num_contexts; i++)
+            flexframesyncbank_process_context(_q, i);
+    }
+
+    // invoke callbacks for completed frames
+    flexframesyncbank_deliver(_q);
+}
+
+// push buffered samples through a context up to the current sample
+void flexframesyncbank_process_context(flexframesyncbank _q,
+                                       unsigned int      _i)
+{
+    struct flexframesyncbank_context_s * c = &_q->contexts[_i];
+    while (c->active && c->pos < _q->num_samples) {
+        // contiguous section of ring
+        unsigned int r = (unsigned int)(c->pos & (_q->ring_len-1));
+        uint64_t     m = _q->num_samples - c->pos;
+        unsigned int n = (unsigned int)(m < _q->ring_len - r ? m : _q->ring_len - r);
+
+        unsigned int num_consumed = flexframesync_execute_frame(c->fs, _q->ring + r, n);
+        c->pos += num_consumed;
+        if (num_consumed < n)
+            c->active = 0;
+    }
+    // frame may also complete on the very last sample of the chunk
+    if (!flexframesync_is_frame_open(c->fs))
+        c->active = 0;
+}
+
+// invoke callbacks for frames completed in the current chunk, in order
+// of arrival
+void flexframesyncbank_deliver(flexframesyncbank _q)
+{
+    unsigned int i, j, n = 0;
+    for (i=0; i<_q->num_contexts; i++) {
+        if (!_q->contexts[i].complete)
+            continue;
+
+        // insertion sort by start of frame
+        for (j=n; j>0 && _q->contexts[_q->order[j-1]].start > _q->contexts[i].start; j--)
+            _q->order[j] = _q->order[j-1];
+        _q->order[j] = i;
+        n++;
+    }
+
+    for (i=0; i<n; i++) {
+        struct flexframesyncbank_context_s * c = &_q->contexts[_q->order[i]];
+        c->complete = 0;
+
+        // update statistics
+        _q->framedatastats.num_frames_detected++;
+        if (c->header_valid) {
+            _q->framedatastats.num_headers_valid++;
+            _q->framedatastats.num_payloads_valid += c->payload_valid;
+            _q->framedatastats.num_bytes_received += c->payload_len;
+        }
+
+        if (_q->callback != NULL) {
+            _q->callback(c->header,
+                         c->header_valid,
+                         c->payload,
+                         c->payload_len,
+                         c->payload_valid,
+                         c->stats,
+                         _q->userdata);
+        }
+    }
+}
+
+#if LIQUID_PTHREADS_ENABLED
+// worker thread
+void * flexframesyncbank_worker(void * _q)
+{
+    flexframesyncbank q = (flexframesyncbank) _q;
+    pthread_mutex_lock(&q->mutex);
+    unsigned int generation = q->generation;
+    while (1) {
+        // wait for next chunk
+        while (q->generation == generation && !q->shutdown)
+            pthread_cond_wait(&q->cond_work, &q->mutex);
+        if (q->shutdown)
+            break;
+        generation = q->generation;
+
+        // process contexts without holding lock
+        while (q->next_context < q->num_contexts) {
+            unsigned int i = q->next_context++;
+            pthread_mutex_unlock(&q->mutex);
+            flexframesyncbank_process_context(q, i);
+            pthread_mutex_lock(&q->mutex);
+            q->num_done++;
+        }
+        if (q->num_done == q->num_contexts)
+            pthread_cond_signal(&q->cond_done);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return NULL;
+}
+#endif
@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// framedecpool : asynchronous payload decoder for frame synchronizers
+//
+// The synchronizer acquires a frame from a fixed pool, writes the received
+// payload symbols directly into it and submits it. Worker threads pop
+// submitted frames in order, run demodulation and packet decoding with
+// their own qpacketmodem object, and invoke the user callback. Callbacks
+// are serialized and always fire in submission order. Acquiring a frame
+// blocks while every frame in the pool is in flight, which bounds memory
+// and provides back-pressure on the synchronizer.
+//
+// Without threads (or without pthreads support) frames are decoded and
+// delivered on the calling thread as soon as they are submitted.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_PTHREADS_ENABLED
+#include <pthread.h>
+#endif
+
+struct framedecpool_s {
+    framesync_callback  callback;       // user-defined callback function
+    void *              userdata;       // user-defined data structure
+    framedatastats_s *  stats;          // packet statistics (optional)
+
+    unsigned int        num_threads;    // number of worker threads
+    unsigned int        num_frames;     // number of pooled frames
+    struct framedecpool_frame_s * frames; // frame pool [size: num_frames]
+    qpacketmodem *      decoders;       // one decoder per worker (at least one)
+
+    // frame lists
+    framedecpool_frame  free_list;      // frames available to the synchronizer
+    framedecpool_frame  queue_head;     // submitted frames awaiting a worker
+    framedecpool_frame  queue_tail;     //
+    unsigned long       num_submitted;  // sequence number of next submission
+    unsigned long       num_delivered;  // sequence number of next delivery
+    int                 shutdown;       // workers exit when set
+
+#if LIQUID_PTHREADS_ENABLED
+    int                 delivering;     // callback is being invoked
+    pthread_t           delivery_thread;// thread invoking the callback
+    pthread_t *         threads;        // worker threads
+    struct framedecpool_worker_s * workers;
+    pthread_mutex_t     mutex;          // pool lock
+    pthread_cond_t      cond;           // signaled on any state change
+#endif
+};
+
+#if LIQUID_PTHREADS_ENABLED
+struct framedecpool_worker_s {
+    framedecpool q;
+    unsigned int index;
+};
+
+// worker thread
+void * framedecpool_worker(void * _w);
+#endif
+
+// decode frame payload and invoke callback
+void framedecpool_decode(framedecpool       _q,
+                         framedecpool_frame _f,
+                         qpacketmodem       _decoder);
+void framedecpool_deliver(framedecpool       _q,
+                          framedecpool_frame _f);
+
+// create pool
+//  _num_threads    :   number of worker threads (0: decode on calling thread)
+//  _num_frames     :   number of pooled frames, _num_frames > 0
+//  _callback       :   user-defined callback function
+//  _userdata       :   user-defined data structure passed to callback
+//  _stats          :   packet statistics updated on delivery (may be NULL)
+framedecpool framedecpool_create(unsigned int       _num_threads,
+                                 unsigned int       _num_frames,
+                                 framesync_callback _callback,
+                                 void *             _userdata,
+                                 framedatastats_s * _stats)
+{
+    if (_num_frames == 0) {
+        fprintf(stderr,"error: framedecpool_create(), number of frames must be greater than zero\n");
+        exit(1);
+    }
+
+    framedecpool q = (framedecpool) malloc(sizeof(struct framedecpool_s));
+    q->callback = _callback;
+    q->userdata = _userdata;
+    q->stats    = _stats;
+#if LIQUID_PTHREADS_ENABLED
+    q->num_threads = _num_threads;
+#else
+    q->num_threads = 0;
+#endif
+    q->num_frames  = _num_frames;
+
+    // allocate frames and build free list
+    q->frames = (struct framedecpool_frame_s*) calloc(q->num_frames, sizeof(struct framedecpool_frame_s));
+    unsigned int i;
+    for (i=0; i<q->num_frames; i++)
+        q->frames[i].next = (i+1 < q->num_frames) ? &q->frames[i+1] : NULL;
+    q->free_list  = &q->frames[0];
+    q->queue_head = NULL;
+    q->queue_tail = NULL;
+    q->num_submitted = 0;
+    q->num_delivered = 0;
+    q->shutdown      = 0;
+
+    // create decoders (objects are created here as they are not shared)
+    unsigned int num_decoders = q->num_threads > 0 ? q->num_threads : 1;
+    q->decoders = (qpacketmodem*) malloc(num_decoders*sizeof(qpacketmodem));
+    for (i=0; i<num_decoders; i++)
+        q->decoders[i] = qpacketmodem_create();
+
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_init(&q->mutex, NULL);
+    pthread_cond_init (&q->cond,  NULL);
+    q->delivering = 0;
+    q->threads = NULL;
+    q->workers = NULL;
+    if (q->num_threads > 0) {
+        q->threads = (pthread_t*) malloc(q->num_threads*sizeof(pthread_t));
+        q->workers = (struct framedecpool_worker_s*) malloc(q->num_threads*sizeof(struct framedecpool_worker_s));
+        for (i=0; i<q->num_threads; i++) {
+            q->workers[i].q     = q;
+            q->workers[i].index = i;
+            if (pthread_create(&q->threads[i], NULL, framedecpool_worker, (void*)&q->workers[i]) != 0) {
+                fprintf(stderr,"error: framedecpool_create(), could not create thread\n");
+                exit(1);
+            }
+        }
+    }
+#endif
+    return q;
+}
+
+// destroy pool, delivering all submitted frames first
+void framedecpool_destroy(framedecpool _q)
+{
+    framedecpool_drain(_q);
+
+#if LIQUID_PTHREADS_ENABLED
+    if (_q->num_threads > 0) {
+        pthread_mutex_lock(&_q->mutex);
+        _q->shutdown = 1;
+        pthread_cond_broadcast(&_q->cond);
+        pthread_mutex_unlock(&_q->mutex);
+
+        unsigned int i;
+        for (i=0; i<_q->num_threads; i++)
+            pthread_join(_q->threads[i], NULL);
+        free(_q->threads);
+        free(_q->workers);
+    }
+    pthread_mutex_destroy(&_q->mutex);
+    pthread_cond_destroy (&_q->cond);
+#endif
+
+    unsigned int i;
+    unsigned int num_decoders = _q->num_threads > 0 ? _q->num_threads : 1;
+    for (i=0; i<num_decoders; i++)
+        qpacketmodem_destroy(_q->decoders[i]);
+    free(_q->decoders);
+
+    for (i=0; i<_q->num_frames; i++) {
+        free(_q->frames[i].header);
+        free(_q->frames[i].payload_sym);
+        free(_q->frames[i].payload_dec);
+    }
+    free(_q->frames);
+    free(_q);
+}
+
+// get number of worker threads
+unsigned int framedecpool_get_num_threads(framedecpool _q)
+{
+    return _q->num_threads;
+}
+
+// acquire frame from pool, blocking until one is available; the header
+// and payload symbol buffers are sized to hold at least the requested
+// number of elements
+//  _q                  :   pool object
+//  _header_len         :   decoded header length [bytes]
+//  _payload_sym_len    :   number of payload symbols
+framedecpool_frame framedecpool_acquire(framedecpool _q,
+                                        unsigned int _header_len,
+                                        unsigned int _payload_sym_len)
+{
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_lock(&_q->mutex);
+    while (_q->free_list == NULL)
+        pthread_cond_wait(&_q->cond, &_q->mutex);
+#endif
+    framedecpool_frame f = _q->free_list;
+    _q->free_list = f->next;
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_unlock(&_q->mutex);
+#endif
+
+    // frame is now owned by the caller; grow buffers as needed
+    if (_header_len > f->header_cap) {
+        f->header     = (unsigned char*) realloc(f->header, _header_len*sizeof(unsigned char));
+        f->header_cap = _header_len;
+    }
+    if (_payload_sym_len > f->payload_sym_cap) {
+        f->payload_sym     = (float complex*) realloc(f->payload_sym, _payload_sym_len*sizeof(float complex));
+        f->payload_sym_cap = _payload_sym_len;
+    }
+    f->header_len      = _header_len;
+    f->header_valid    = 0;
+    f->payload_sym_len = _payload_sym_len;
+    f->payload_len     = 0;
+    f->payload_valid   = 0;
+    f->next            = NULL;
+    return f;
+}
+
+// return acquired frame to pool without submitting it
+void framedecpool_release(framedecpool       _q,
+                          framedecpool_frame _f)
+{
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_lock(&_q->mutex);
+#endif
+    _f->next = _q->free_list;
+    _q->free_list = _f;
+#if LIQUID_PTHREADS_ENABLED
+    pthread_cond_broadcast(&_q->cond);
+    pthread_mutex_unlock(&_q->mutex);
+#endif
+}
+
+// submit acquired frame for decoding; frames are delivered to the
+// callback in the order in which they are submitted
+void framedecpool_submit(framedecpool       _q,
+                         framedecpool_frame _f)
+{
+    if (_q->num_threads == 0) {
+        // decode and deliver on calling thread
+        _f->seq = _q->num_submitted++;
+        framedecpool_decode(_q, _f, _q->decoders[0]);
+        framedecpool_deliver(_q, _f);
+        _q->num_delivered++;
+        _f->next = _q->free_list;
+        _q->free_list = _f;
+        return;
+    }
+
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_lock(&_q->mutex);
+    _f->seq  = _q->num_submitted++;
+    _f->next = NULL;
+    if (_q->queue_tail == NULL)
+        _q->queue_head = _f;
+    else
+        _q->queue_tail->next = _f;
+    _q->queue_tail = _f;
+    pthread_cond_broadcast(&_q->cond);
+    pthread_mutex_unlock(&_q->mutex);
+#endif
+}
+
+// block until every submitted frame has been delivered; the frame being
+// delivered cannot complete until the callback returns, so return
+// immediately when invoked from within the callback
+void framedecpool_drain(framedecpool _q)
+{
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_lock(&_q->mutex);
+    if (_q->delivering && pthread_equal(_q->delivery_thread, pthread_self())) {
+        pthread_mutex_unlock(&_q->mutex);
+        return;
+    }
+    while (_q->num_delivered != _q->num_submitted)
+        pthread_cond_wait(&_q->cond, &_q->mutex);
+    pthread_mutex_unlock(&_q->mutex);
+#endif
+}
+
+//
+// internal methods
+//
+
+#if LIQUID_PTHREADS_ENABLED
+// worker thread
+void * framedecpool_worker(void * _w)
+{
+    struct framedecpool_worker_s * w = (struct framedecpool_worker_s*) _w;
+    framedecpool q = w->q;
+    qpacketmodem decoder = q->decoders[w->index];
+
+    pthread_mutex_lock(&q->mutex);
+    while (1) {
+        // wait for frame (or shutdown once queue is empty)
+        while (q->queue_head == NULL && !q->shutdown)
+            pthread_cond_wait(&q->cond, &q->mutex);
+        if (q->queue_head == NULL)
+            break;
+
+        // pop frame from queue
+        framedecpool_frame f = q->queue_head;
+        q->queue_head = f->next;
+        if (q->queue_head == NULL)
+            q->queue_tail = NULL;
+
+        // decode without holding lock
+        pthread_mutex_unlock(&q->mutex);
+        framedecpool_decode(q, f, decoder);
+        pthread_mutex_lock(&q->mutex);
+
+        // wait for all earlier frames to be delivered
+        while (q->num_delivered != f->seq)
+            pthread_cond_wait(&q->cond, &q->mutex);
+
+        // invoke callback without holding lock; no other frame can be
+        // delivered until num_delivered is advanced below
+        pthread_mutex_unlock(&q->mutex);
+        framedecpool_deliver(q, f);
+        pthread_mutex_lock(&q->mutex);
+
+        // return frame to pool
+        q->num_delivered++;
+        f->next = q->free_list;
+        q->free_list = f;
+        pthread_cond_broadcast(&q->cond);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return NULL;
+}
+#endif
+
+// decode frame payload
+void framedecpool_decode(framedecpool       _q,
+                         framedecpool_frame _f,
+                         qpacketmodem       _decoder)
+{
+    if (!_f->header_valid)
+        return;
+
+    if (_f->payload_len > _f->payload_dec_cap) {
+        _f->payload_dec     = (unsigned char*) realloc(_f->payload_dec, _f->payload_len*sizeof(unsigned char));
+        _f->payload_dec_cap = _f->payload_len;
+    }
+
+    // configure decoder and validate frame length
+    qpacketmodem_configure(_decoder, _f->payload_len, _f->check, _f->fec0, _f->fec1, _f->mod_scheme);
+    if (qpacketmodem_get_frame_len(_decoder) != _f->payload_sym_len) {
+        fprintf(stderr,"error: framedecpool_decode(), payload symbol length mismatch\n");
+        exit(1);
+    }
+
+    // demodulate and decode payload
+    if (_f->soft)
+        _f->payload_valid = qpacketmodem_decode_soft(_decoder, _f->payload_sym, _f->payload_dec);
+    else
+        _f->payload_valid = qpacketmodem_decode(_decoder, _f->payload_sym, _f->payload_dec);
+}
+
+// update statistics and invoke callback
+void framedecpool_deliver(framedecpool       _q,
+                          framedecpool_frame _f)
+{
+    if (_q->stats != NULL) {
+        _q->stats->num_frames_detected++;
+        if (_f->header_valid) {
+            _q->stats->num_headers_valid++;
+            _q->stats->num_payloads_valid += _f->payload_valid;
+            _q->stats->num_bytes_received += _f->payload_len;
+        }
+    }
+
+    if (_q->callback == NULL)
+        return;
+
+#if LIQUID_PTHREADS_ENABLED
+    // deliveries are serialized, so at most one thread is marked
+    pthread_mutex_lock(&_q->mutex);
+    _q->delivering      = 1;
+    _q->delivery_thread = pthread_self();
+    pthread_mutex_unlock(&_q->mutex);
+#endif
+
+    if (_f->header_valid) {
+        _f->stats.framesyms     = _f->payload_sym;
+        _f->stats.num_framesyms = _f->payload_sym_len;
+    } else {
+        _f->stats.framesyms     = NULL;
+        _f->stats.num_framesyms = 0;
+    }
+    _q->callback(_f->header,
+                 _f->header_valid,
+                 _f->header_valid ? _f->payload_dec : NULL,
+                 _f->header_valid ? _f->payload_len : 0,
+                 _f->payload_valid,
+                 _f->stats,
+                 _q->userdata);
+
+#if LIQUID_PTHREADS_ENABLED
+    pthread_mutex_lock(&_q->mutex);
+    _q->delivering = 0;
+    pthread_mutex_unlock(&_q->mutex);
+#endif
+}
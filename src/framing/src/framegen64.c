@@ -35,30 +35,47 @@
 
 #include "liquid.internal.h"
 
+#define FRAMEGEN64_M            (7)     // filter delay (symbols)
+#define FRAMEGEN64_PN_LEN       (64)    // p/n sequence length (symbols)
+#define FRAMEGEN64_PAYLOAD_LEN  (630)   // payload symbols with pilots
+#define FRAMEGEN64_TAIL_LEN     (2*FRAMEGEN64_M + 2 + 10) // interpolator settling
+
+// number of output symbols (two samples each)
+#define FRAMEGEN64_NUM_SYMBOLS  (FRAMEGEN64_PN_LEN + FRAMEGEN64_PAYLOAD_LEN + FRAMEGEN64_TAIL_LEN)
+
+// frame symbol buffer: 2m symbols of filter history followed by all
+// output symbols (zero tail included)
+#define FRAMEGEN64_BUF_LEN      (2*FRAMEGEN64_M + FRAMEGEN64_NUM_SYMBOLS)
+
+#if 2*FRAMEGEN64_NUM_SYMBOLS != LIQUID_FRAME64_LEN
+#  error "framegen64: frame layout does not match LIQUID_FRAME64_LEN"
+#endif
+
 struct framegen64_s {
     qpacketmodem    enc;                // packet encoder/modulator
     qpilotgen       pilotgen;           // pilot symbol generator
-    float complex   pn_sequence[64];    // 64-symbol p/n sequence
+    float complex   pn_sequence[FRAMEGEN64_PN_LEN];     // 64-symbol p/n sequence
     unsigned char   payload_dec[150];   // 600 = 150 bytes * 8 bits/bytes / 2 bits/symbol
     float complex   payload_sym[600];   // modulated payload symbols
-    float complex   payload_tx[630];    // modulated payload symbols with pilots
     unsigned int    m;                  // filter delay (symbols)
     float           beta;               // filter excess bandwidth factor
-    firinterp_crcf interp;              // pulse-shaping filter
+    dotprod_crcf    dp[2];              // polyphase pulse-shaping filters (k=2)
+    float complex   preamble_wave[2*FRAMEGEN64_PN_LEN]; // interpolated p/n sequence
+    float complex   frame_sym[FRAMEGEN64_BUF_LEN]; // filter history, p/n, payload with pilots, tail
 };
 
 // create framegen64 object
 framegen64 framegen64_create()
 {
     framegen64 q = (framegen64) malloc(sizeof(struct framegen64_s));
-    q->m    = 7;
+    q->m    = FRAMEGEN64_M;
     q->beta = 0.3f;
 
     unsigned int i;
 
     // generate pn sequence
     msequence ms = msequence_create(7, 0x0089, 1);
-    for (i=0; i<64; i++) {
+    for (i=0; i<FRAMEGEN64_PN_LEN; i++) {
         q->pn_sequence[i]  = (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2);
         q->pn_sequence[i] += (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2)*_Complex_I;
     }
@@ -76,10 +93,29 @@ framegen64 framegen64_create()
 
     // create pilot generator
     q->pilotgen = qpilotgen_create(600, 21);
-    assert( qpilotgen_get_frame_len(q->pilotgen)==630 );
+    assert( qpilotgen_get_frame_len(q->pilotgen)==FRAMEGEN64_PAYLOAD_LEN );
+
+    // create pulse-shaping filter (k=2), realized as one dot product
+    // per output phase operating directly on the frame symbol buffer
+    float h[4*q->m+2];
+    liquid_firdes_prototype(LIQUID_FIRFILT_ARKAISER,2,q->m,q->beta,0,h);
+    h[4*q->m+1] = 0.0f;
+    float h_sub[2*q->m+1];
+    unsigned int n;
+    for (i=0; i<2; i++) {
+        // load sub-filter in reverse order
+        for (n=0; n<2*q->m+1; n++)
+            h_sub[2*q->m-n] = h[i + 2*n];
+        q->dp[i] = dotprod_crcf_create(h_sub, 2*q->m+1);
+    }
+
+    // initialize frame buffer: filter history, p/n sequence, and tail
+    memset(q->frame_sym, 0x00, sizeof(q->frame_sym));
+    memmove(&q->frame_sym[2*FRAMEGEN64_M], q->pn_sequence, FRAMEGEN64_PN_LEN*sizeof(float complex));
 
-    // create pulse-shaping filter (k=2)
-    q->interp = firinterp_crcf_create_prototype(LIQUID_FIRFILT_ARKAISER,2,q->m,q->beta,0);
+    // interpolate p/n sequence once; it never changes
+    for (i=0; i<2*FRAMEGEN64_PN_LEN; i++)
+        dotprod_crcf_execute(q->dp[i%2], &q->frame_sym[i/2], &q->preamble_wave[i]);
 
     // return main object
     return q;
@@ -91,6 +127,8 @@ void framegen64_destroy(framegen64 _q)
     // destroy internal objects
     qpacketmodem_destroy(_q->enc);
     qpilotgen_destroy(_q->pilotgen);
+    dotprod_crcf_destroy(_q->dp[0]);
+    dotprod_crcf_destroy(_q->dp[1]);
 
     // free main object memory
     free(_q);
@@ -143,33 +181,19 @@ void framegen64_execute(framegen64      _q,
     // run packet encoder and modulator
     qpacketmodem_encode(_q->enc, _q->payload_dec, _q->payload_sym);
 
-    // add pilot symbols
-    qpilotgen_execute(_q->pilotgen, _q->payload_sym, _q->payload_tx);
-
-    unsigned int n=0;
-
-    // reset interpolator
-    firinterp_crcf_reset(_q->interp);
+    // add pilot symbols directly into frame buffer
+    qpilotgen_execute(_q->pilotgen, _q->payload_sym,
+                      &_q->frame_sym[2*FRAMEGEN64_M + FRAMEGEN64_PN_LEN]);
 
     // p/n sequence
-    for (i=0; i<64; i++) {
-        firinterp_crcf_execute(_q->interp, _q->pn_sequence[i], &_frame[n]);
-        n+=2;
-    }
+    memmove(_frame, _q->preamble_wave, 2*FRAMEGEN64_PN_LEN*sizeof(float complex));
 
-    // frame payload
-    for (i=0; i<630; i++) {
-        firinterp_crcf_execute(_q->interp, _q->payload_tx[i], &_frame[n]);
-        n+=2;
+    // frame payload and interpolator settling; window for symbol i is
+    // frame_sym[i, i+2m] (preceded by 2m zeros of filter history)
+    for (i=FRAMEGEN64_PN_LEN; i<FRAMEGEN64_NUM_SYMBOLS; i++) {
+        dotprod_crcf_execute(_q->dp[0], &_q->frame_sym[i], &_frame[2*i  ]);
+        dotprod_crcf_execute(_q->dp[1], &_q->frame_sym[i], &_frame[2*i+1]);
     }
 
-    // interpolator settling
-    for (i=0; i<2*_q->m + 2 + 10; i++) {
-        firinterp_crcf_execute(_q->interp, 0.0f, &_frame[n]);
-        n+=2;
-    }
-
-    assert(n==LIQUID_FRAME64_LEN);
+    assert(2*i == LIQUID_FRAME64_LEN);
 }
-
-
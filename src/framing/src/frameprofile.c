@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// frameprofile.c
+//
+// Execution time of frame synchronizer stages
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "liquid.internal.h"
+
+const char * liquid_frameprofile_stage_str[LIQUID_FRAMEPROFILE_NUM_STAGES] = {
+    "detect",
+    "preamble",
+    "header",
+    "payload",
+    "decode",
+    "callback",
+};
+
+// read monotonic clock [ns]
+static uint64_t frameprofile_get_ns()
+{
+#if HAVE_CLOCK_GETTIME
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+#else
+    return (uint64_t)clock() * (1000000000ULL / CLOCKS_PER_SEC);
+#endif
+}
+
+// read time-stamp counter (zero if unavailable)
+static uint64_t frameprofile_get_cycles()
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    return (uint64_t)__builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// reset frameprofile object, retaining enabled flag
+void frameprofile_reset(frameprofile_s * _profile)
+{
+    if (_profile == NULL)
+        return;
+
+    unsigned int i;
+    for (i=0; i<LIQUID_FRAMEPROFILE_NUM_STAGES; i++) {
+        _profile->num_calls[i]  = 0;
+        _profile->num_ns[i]     = 0;
+        _profile->num_cycles[i] = 0;
+    }
+    _profile->stage     = -1;
+    _profile->t0_ns     = 0;
+    _profile->t0_cycles = 0;
+}
+
+// print frameprofile object
+void frameprofile_print(frameprofile_s * _profile)
+{
+    if (_profile == NULL)
+        return;
+
+    uint64_t total_ns = 0;
+    unsigned int i;
+    for (i=0; i<LIQUID_FRAMEPROFILE_NUM_STAGES; i++)
+        total_ns += _profile->num_ns[i];
+
+    printf("  profiling         : %s\n", _profile->enabled ? "enabled" : "disabled");
+    for (i=0; i<LIQUID_FRAMEPROFILE_NUM_STAGES; i++) {
+        float percent = total_ns > 0 ? 100.0f*(float)_profile->num_ns[i] / (float)total_ns : 0.0f;
+        printf("  %-10s : %10llu calls, %14.3f ms (%6.2f %%), %16llu cycles\n",
+                liquid_frameprofile_stage_str[i],
+                (unsigned long long)_profile->num_calls[i],
+                1e-6*(double)_profile->num_ns[i],
+                percent,
+                (unsigned long long)_profile->num_cycles[i]);
+    }
+}
+
+// accumulate time spent in active stage (if any) and start timing
+// _stage (none if negative)
+void frameprofile_set_stage(frameprofile_s * _profile,
+                            int              _stage)
+{
+    uint64_t t_ns     = frameprofile_get_ns();
+    uint64_t t_cycles = frameprofile_get_cycles();
+    if (_profile->stage >= 0) {
+        _profile->num_ns[_profile->stage]     += t_ns     - _profile->t0_ns;
+        _profile->num_cycles[_profile->stage] += t_cycles - _profile->t0_cycles;
+    }
+
+    _profile->stage     = _stage;
+    _profile->t0_ns     = t_ns;
+    _profile->t0_cycles = t_cycles;
+    if (_stage >= 0)
+        _profile->num_calls[_stage]++;
+}
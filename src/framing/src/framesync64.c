@@ -62,6 +62,9 @@ void framesync64_execute_rxpreamble(framesync64   _q,
 void framesync64_execute_rxpayload(framesync64   _q,
                                    float complex _x);
 
+// recover, demodulate, and decode payload symbols
+int framesync64_decode_payload(framesync64 _q);
+
 // framesync64 object structure
 struct framesync64_s {
     // callback
@@ -69,6 +72,7 @@ struct framesync64_s {
     void *              userdata;   // user-defined data structure
     framesyncstats_s    framesyncstats; // frame statistic object (synchronizer)
     framedatastats_s    framedatastats; // frame statistic object (packet statistics)
+    frameprofile_s      profile;    // execution time of internal stages
     
     // synchronizer objects
     unsigned int        m;          // filter delay (symbols)
@@ -96,8 +100,9 @@ struct framesync64_s {
     // payload decoder
     float complex payload_rx [630]; // received payload symbols with pilots
     float complex payload_sym[600]; // received payload symbols
+    unsigned char payload_enc[150]; // demodulated payload bytes (encoded)
     unsigned char payload_dec[ 72]; // decoded payload bytes
-    qpacketmodem  dec;              // packet demodulator/decoder
+    packetizer    dec;              // payload decoder
     qpilotsync    pilotsync;        // pilot extraction, carrier recovery
     int           payload_valid;    // did payload pass crc?
     
@@ -158,22 +163,22 @@ framesync64 framesync64_create(framesync_callback _callback,
     // create down-coverters for carrier phase tracking
     q->mixer = nco_crcf_create(LIQUID_NCO);
     
-    // create payload demodulator/decoder object
+    // create payload decoder object; the payload is always QPSK, so the
+    // symbols are sliced directly to encoded bytes (no modem object)
     int check      = LIQUID_CRC_24;
     int fec0       = LIQUID_FEC_NONE;
     int fec1       = LIQUID_FEC_GOLAY2412;
-    int mod_scheme = LIQUID_MODEM_QPSK;
-    q->dec         = qpacketmodem_create();
-    qpacketmodem_configure(q->dec, 72, check, fec0, fec1, mod_scheme);
-    //qpacketmodem_print(q->dec);
-    assert( qpacketmodem_get_frame_len(q->dec)==600 );
+    q->dec         = packetizer_create(72, check, fec0, fec1);
+    assert( packetizer_get_enc_msg_len(q->dec)==150 );
 
     // create pilot synchronizer
     q->pilotsync   = qpilotsync_create(600, 21);
     assert( qpilotsync_get_frame_len(q->pilotsync)==630);
  
-    // reset global data counters
+    // reset global data counters, profiling disabled
     framesync64_reset_framedatastats(q);
+    q->profile.enabled = 0;
+    framesync64_reset_profile(q);
 
 #if DEBUG_FRAMESYNC64
     // set debugging flags, objects to NULL
@@ -201,7 +206,7 @@ void framesync64_destroy(framesync64 _q)
     qdetector_cccf_destroy(_q->detector);   // frame detector
     firpfb_crcf_destroy   (_q->mf);         // matched filter
     nco_crcf_destroy      (_q->mixer);      // coarse NCO
-    qpacketmodem_destroy  (_q->dec);        // payload demodulator
+    packetizer_destroy    (_q->dec);        // payload decoder
     qpilotsync_destroy    (_q->pilotsync);  // pilot synchronizer
 #if FRAMESYNC64_ENABLE_EQ
     eqlms_cccf_destroy    (_q->equalizer);  // LMS equalizer
@@ -239,6 +244,13 @@ void framesync64_reset(framesync64 _q)
     _q->framesyncstats.evm = 0.0f;
 }
 
+// profiling stage for each internal state
+static const int framesync64_profile_stage[3] = {
+    LIQUID_FRAMEPROFILE_DETECT,     // FRAMESYNC64_STATE_DETECTFRAME
+    LIQUID_FRAMEPROFILE_PREAMBLE,   // FRAMESYNC64_STATE_RXPREAMBLE
+    LIQUID_FRAMEPROFILE_PAYLOAD,    // FRAMESYNC64_STATE_RXPAYLOAD
+};
+
 // execute frame synchronizer
 //  _q     :   frame synchronizer object
 //  _x      :   input sample array [size: _n x 1]
@@ -249,6 +261,7 @@ void framesync64_execute(framesync64     _q,
 {
     unsigned int i;
     for (i=0; i<_n; i++) {
+        frameprofile_switch(&_q->profile, framesync64_profile_stage[_q->state]);
 #if DEBUG_FRAMESYNC64
         if (_q->debug_enabled)
             windowcf_push(_q->debug_x, _x[i]);
@@ -271,6 +284,7 @@ void framesync64_execute(framesync64     _q,
             exit(1);
         }
     }
+    frameprofile_stop(&_q->profile);
 }
 
 // 
@@ -429,13 +443,9 @@ void framesync64_execute_rxpayload(framesync64   _q,
         _q->payload_counter++;
 
         if (_q->payload_counter == 630) {
-            // recover data symbols from pilots
-            qpilotsync_execute(_q->pilotsync, _q->payload_rx, _q->payload_sym);
-
-            // decode payload
-            _q->payload_valid = qpacketmodem_decode(_q->dec,
-                                                    _q->payload_sym,
-                                                    _q->payload_dec);
+            // recover data symbols from pilots, decode payload
+            frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
+            _q->payload_valid = framesync64_decode_payload(_q);
 
             // update statistics
             _q->framedatastats.num_frames_detected++;
@@ -458,6 +468,7 @@ void framesync64_execute_rxpayload(framesync64   _q,
                 _q->framesyncstats.fec1          = LIQUID_FEC_GOLAY2412;
 
                 // invoke callback method
+                frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
                 _q->callback(&_q->payload_dec[0],   // header is first 8 bytes
                              _q->payload_valid,
                              &_q->payload_dec[8],   // payload is last 64 bytes
@@ -474,6 +485,28 @@ void framesync64_execute_rxpayload(framesync64   _q,
     }
 }
 
+// recover, demodulate, and decode payload symbols
+int framesync64_decode_payload(framesync64 _q)
+{
+    // recover data symbols from pilots
+    qpilotsync_execute(_q->pilotsync, _q->payload_rx, _q->payload_sym);
+
+    // slice QPSK symbols directly into encoded bytes, four symbols per
+    // byte, most-significant bits first (same as modem_demodulate() and
+    // liquid_pack_array() in qpacketmodem_decode())
+    unsigned int i;
+    for (i=0; i<150; i++) {
+        float complex * v = &_q->payload_sym[4*i];
+        _q->payload_enc[i] = ((crealf(v[0]) > 0 ? 0 : 0x40) | (cimagf(v[0]) > 0 ? 0 : 0x80) |
+                              (crealf(v[1]) > 0 ? 0 : 0x10) | (cimagf(v[1]) > 0 ? 0 : 0x20) |
+                              (crealf(v[2]) > 0 ? 0 : 0x04) | (cimagf(v[2]) > 0 ? 0 : 0x08) |
+                              (crealf(v[3]) > 0 ? 0 : 0x01) | (cimagf(v[3]) > 0 ? 0 : 0x02));
+    }
+
+    // decode payload, returning flag if decoded payload is valid
+    return packetizer_decode(_q->dec, _q->payload_enc, _q->payload_dec);
+}
+
 // enable debugging
 void framesync64_debug_enable(framesync64 _q)
 {
@@ -586,3 +619,28 @@ framedatastats_s framesync64_get_framedatastats(framesync64 _q)
     return _q->framedatastats;
 }
 
+// enable profiling of internal stages
+void framesync64_profile_enable(framesync64 _q)
+{
+    _q->profile.enabled = 1;
+}
+
+// disable profiling of internal stages
+void framesync64_profile_disable(framesync64 _q)
+{
+    frameprofile_stop(&_q->profile);
+    _q->profile.enabled = 0;
+}
+
+// reset profiling counters
+void framesync64_reset_profile(framesync64 _q)
+{
+    frameprofile_reset(&_q->profile);
+}
+
+// retrieve profiling counters
+frameprofile_s framesync64_get_profile(framesync64 _q)
+{
+    return _q->profile;
+}
+
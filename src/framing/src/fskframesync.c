@@ -39,6 +39,7 @@
 #define DEBUG_FSKFRAMESYNC_BUFFER_LEN  (2000)
 
 // execute stages
+void fskframesync_execute_sample(     fskframesync _q, float complex _x);
 void fskframesync_execute_detectframe(fskframesync _q, float complex _x);
 void fskframesync_execute_rxheader(   fskframesync _q, float complex _x);
 void fskframesync_execute_rxpayload(  fskframesync _q, float complex _x);
@@ -59,6 +60,7 @@ struct fskframesync_s {
     framesync_callback  callback;       // user-defined callback function
     void *              userdata;       // user-defined data structure
     framesyncstats_s    framestats;     // frame statistic object
+    frameprofile_s      profile;        // execution time of internal stages
 
     // synchronizer objects, states
     firpfb_crcf     pfb;                // timing recovery
@@ -244,6 +246,10 @@ fskframesync fskframesync_create(framesync_callback _callback,
     q->debug_x               = NULL;
 #endif
 
+    // profiling disabled
+    q->profile.enabled = 0;
+    fskframesync_reset_profile(q);
+
     // reset synchronizer
     fskframesync_reset(q);
 
@@ -354,6 +360,41 @@ void fskframesync_reset(fskframesync _q)
 void fskframesync_execute(fskframesync  _q,
                           float complex _x)
 {
+    fskframesync_execute_sample(_q, _x);
+    frameprofile_stop(&_q->profile);
+}
+
+// execute frame synchronizer on a block of samples
+//  _q      :   frame synchronizer object
+//  _x      :   input sample array [size: _n x 1]
+//  _n      :   number of input samples
+void fskframesync_execute_block(fskframesync    _q,
+                                float complex * _x,
+                                unsigned int    _n)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        fskframesync_execute_sample(_q, _x[i]);
+    frameprofile_stop(&_q->profile);
+}
+
+// 
+// internal methods
+//
+
+// profiling stage for each internal state
+static const int fskframesync_profile_stage[3] = {
+    LIQUID_FRAMEPROFILE_DETECT,     // STATE_DETECTFRAME
+    LIQUID_FRAMEPROFILE_HEADER,     // STATE_RXHEADER
+    LIQUID_FRAMEPROFILE_PAYLOAD,    // STATE_RXPAYLOAD
+};
+
+// push single sample through synchronizer
+void fskframesync_execute_sample(fskframesync  _q,
+                                 float complex _x)
+{
+    frameprofile_switch(&_q->profile, fskframesync_profile_stage[_q->state]);
+
     // push through synchronizer
 #if DEBUG_FSKFRAMESYNC
     if (_q->debug_enabled)
@@ -378,23 +419,6 @@ void fskframesync_execute(fskframesync  _q,
     }
 }
 
-// execute frame synchronizer on a block of samples
-//  _q      :   frame synchronizer object
-//  _x      :   input sample array [size: _n x 1]
-//  _n      :   number of input samples
-void fskframesync_execute_block(fskframesync    _q,
-                                float complex * _x,
-                                unsigned int    _n)
-{
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        fskframesync_execute(_q, _x[i]);
-}
-
-// 
-// internal methods
-//
-
 void fskframesync_execute_detectframe(fskframesync  _q,
                                       float complex _x)
 {
@@ -566,6 +590,7 @@ void fskframesync_execute_rxheader(fskframesync  _q,
             _q->framestats.fec1          = LIQUID_FEC_UNKNOWN;
 
             // invoke callback method
+            frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
             _q->callback(_q->header_dec,
                          0,     // header valid
                          NULL,  // payload
@@ -621,6 +646,7 @@ void fskframesync_execute_rxpayload(fskframesync  _q,
         printf("\n");
 #endif
         // decode payload
+        frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
         int payload_valid = qpacketmodem_decode_syms(_q->payload_decoder,
                                                      _q->payload_sym,
                                                      _q->payload_dec);
@@ -641,6 +667,7 @@ void fskframesync_execute_rxpayload(fskframesync  _q,
             _q->framestats.fec1          = _q->payload_fec1;
 
             // invoke callback method
+            frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
             _q->callback(_q->header_dec,        // decoded header
                          1,                     // header valid
                          _q->payload_dec,       // payload
@@ -661,6 +688,31 @@ void fskframesync_decode_header(fskframesync _q)
 {
 }
 
+// enable profiling of internal stages
+void fskframesync_profile_enable(fskframesync _q)
+{
+    _q->profile.enabled = 1;
+}
+
+// disable profiling of internal stages
+void fskframesync_profile_disable(fskframesync _q)
+{
+    frameprofile_stop(&_q->profile);
+    _q->profile.enabled = 0;
+}
+
+// reset profiling counters
+void fskframesync_reset_profile(fskframesync _q)
+{
+    frameprofile_reset(&_q->profile);
+}
+
+// retrieve profiling counters
+frameprofile_s fskframesync_get_profile(fskframesync _q)
+{
+    return _q->profile;
+}
+
 void fskframesync_debug_enable(fskframesync _q)
 {
     // create debugging objects if necessary
@@ -33,6 +33,10 @@
 
 #include "liquid.internal.h"
 
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+#include <xmmintrin.h>
+#endif
+
 #define DEBUG_GMSKFRAMESYNC             1
 #define DEBUG_GMSKFRAMESYNC_PRINT       0
 #define DEBUG_GMSKFRAMESYNC_FILENAME    "gmskframesync_debug.m"
@@ -41,10 +45,18 @@
 // enable pre-demodulation filter (remove out-of-band noise)
 #define GMSKFRAMESYNC_PREFILTER         1
 
+// number of samples processed at a time by the block receive path
+#define GMSKFRAMESYNC_BLOCK_LEN         (256)
+
 // execute a single, post-filtered sample
 void gmskframesync_execute_sample(gmskframesync _q,
                                   float complex _x);
 
+// execute a block of input samples, _n <= GMSKFRAMESYNC_BLOCK_LEN
+void gmskframesync_execute_block(gmskframesync   _q,
+                                 float complex * _x,
+                                 unsigned int    _n);
+
 // push buffered p/n sequence through synchronizer
 void gmskframesync_pushpn(gmskframesync _q);
 
@@ -55,6 +67,13 @@ void gmskframesync_syncpn(gmskframesync _q);
 void gmskframesync_update_fi(gmskframesync _q,
                              float complex _x);
 
+// compute instantaneous frequency of mixed-down samples in buf_mix,
+// storing in buf_fi, and update previous sample state
+//  _q      :   frame synchronizer
+//  _n      :   number of samples
+void gmskframesync_update_fi_block(gmskframesync _q,
+                                   unsigned int  _n);
+
 // update symbol synchronizer internal state (filtered error, index, etc.)
 //  _q      :   frame synchronizer
 //  _x      :   input sample
@@ -63,11 +82,24 @@ int gmskframesync_update_symsync(gmskframesync _q,
                                  float         _x,
                                  float *       _y);
 
-// execute stages
+// execute stages on a single sample
 void gmskframesync_execute_detectframe(gmskframesync _q, float complex _x);
-void gmskframesync_execute_rxpreamble( gmskframesync _q, float complex _x);
-void gmskframesync_execute_rxheader(   gmskframesync _q, float complex _x);
-void gmskframesync_execute_rxpayload(  gmskframesync _q, float complex _x);
+void gmskframesync_execute_rx(         gmskframesync _q, float complex _x);
+
+// execute stages on a block of samples, returning the number of samples
+// consumed before the state changed to or from frame detection
+unsigned int gmskframesync_execute_detectframe_block(gmskframesync   _q,
+                                                     float complex * _x,
+                                                     unsigned int    _n);
+unsigned int gmskframesync_execute_rx_block(gmskframesync   _q,
+                                            float complex * _x,
+                                            unsigned int    _n);
+
+// receive demodulated symbol (matched filter output)
+void gmskframesync_rxsymbol(  gmskframesync _q, float _y);
+void gmskframesync_rxpreamble(gmskframesync _q, float _y);
+void gmskframesync_rxheader(  gmskframesync _q, float _y);
+void gmskframesync_rxpayload( gmskframesync _q, float _y);
 
 // decode header
 void gmskframesync_decode_header(gmskframesync _q);
@@ -83,6 +115,7 @@ struct gmskframesync_s {
     framesync_callback callback;    // user-defined callback function
     void * userdata;                // user-defined data structure
     framesyncstats_s framestats;    // frame statistic object
+    frameprofile_s profile;         // execution time of internal stages
     
     //
     float complex x_prime;          // received sample state
@@ -98,6 +131,11 @@ struct gmskframesync_s {
     int pfb_timer;                  // filterbank output flag
     float symsync_out;              // symbol synchronizer output
 
+    // block receive path
+    float complex * buf_rx;         // pre-filtered input samples
+    float complex * buf_mix;        // previous and mixed-down samples
+    float *         buf_fi;         // instantaneous frequency estimates
+
     // synchronizer objects
     detector_cccf frame_detector;   // pre-demod detector
     float tau_hat;                  // fractional timing offset estimate
@@ -216,6 +254,11 @@ gmskframesync gmskframesync_create(framesync_callback _callback,
     // create down-coverters for carrier phase tracking
     q->nco_coarse = nco_crcf_create(LIQUID_NCO);
 
+    // allocate buffers for block receive path
+    q->buf_rx  = (float complex*) malloc(GMSKFRAMESYNC_BLOCK_LEN*sizeof(float complex));
+    q->buf_mix = (float complex*) malloc((GMSKFRAMESYNC_BLOCK_LEN+1)*sizeof(float complex));
+    q->buf_fi  = (float*)         malloc(GMSKFRAMESYNC_BLOCK_LEN*sizeof(float));
+
     // create/allocate header objects/arrays
     q->header_mod = NULL;
     q->header_enc = NULL;
@@ -246,6 +289,10 @@ gmskframesync gmskframesync_create(framesync_callback _callback,
     q->debug_framesyms       = NULL;
 #endif
 
+    // profiling disabled
+    q->profile.enabled = 0;
+    gmskframesync_reset_profile(q);
+
     // reset synchronizer
     gmskframesync_reset(q);
 
@@ -274,6 +321,9 @@ void gmskframesync_destroy(gmskframesync _q)
     firpfb_rrrf_destroy(_q->mf);                // matched filter
     firpfb_rrrf_destroy(_q->dmf);               // derivative matched filter
     nco_crcf_destroy(_q->nco_coarse);           // coarse NCO
+    free(_q->buf_rx);
+    free(_q->buf_mix);
+    free(_q->buf_fi);
 
     // preamble
     detector_cccf_destroy(_q->frame_detector);
@@ -360,29 +410,56 @@ int gmskframesync_is_frame_open(gmskframesync _q)
     return (_q->state == STATE_DETECTFRAME) ? 0 : 1;
 }
 
+// profiling stage for each internal state
+static const int gmskframesync_profile_stage[4] = {
+    LIQUID_FRAMEPROFILE_DETECT,     // STATE_DETECTFRAME
+    LIQUID_FRAMEPROFILE_PREAMBLE,   // STATE_RXPREAMBLE
+    LIQUID_FRAMEPROFILE_HEADER,     // STATE_RXHEADER
+    LIQUID_FRAMEPROFILE_PAYLOAD,    // STATE_RXPAYLOAD
+};
+
 void gmskframesync_execute_sample(gmskframesync _q,
                                   float complex _x)
 {
-    switch (_q->state) {
-    case STATE_DETECTFRAME:
+    frameprofile_switch(&_q->profile, gmskframesync_profile_stage[_q->state]);
+
+    if (_q->state == STATE_DETECTFRAME) {
         // look for p/n sequence
         gmskframesync_execute_detectframe(_q, _x);
-        break;
+    } else {
+        // receive p/n sequence, header, or payload symbols
+        gmskframesync_execute_rx(_q, _x);
+    }
+}
 
-    case STATE_RXPREAMBLE:
-        // receive p/n sequence symbols
-        gmskframesync_execute_rxpreamble(_q, _x);
-        break;
+void gmskframesync_execute_block(gmskframesync   _q,
+                                 float complex * _x,
+                                 unsigned int    _n)
+{
+#if GMSKFRAMESYNC_PREFILTER
+    iirfilt_crcf_execute_block(_q->prefilter, _x, _n, _q->buf_rx);
+#else
+    memmove(_q->buf_rx, _x, _n*sizeof(float complex));
+#endif
 
-    case STATE_RXHEADER:
-        // receive header
-        gmskframesync_execute_rxheader(_q, _x);
-        break;
+#if DEBUG_GMSKFRAMESYNC
+    if (_q->debug_enabled) {
+        unsigned int i;
+        for (i=0; i<_n; i++)
+            windowcf_push(_q->debug_x, _q->buf_rx[i]);
+    }
+#endif
 
-    case STATE_RXPAYLOAD:
-        // receive payload
-        gmskframesync_execute_rxpayload(_q, _x);
-        break;
+    // run stages until block is consumed
+    unsigned int num_consumed = 0;
+    while (num_consumed < _n) {
+        frameprofile_switch(&_q->profile, gmskframesync_profile_stage[_q->state]);
+
+        float complex * x = &_q->buf_rx[num_consumed];
+        if (_q->state == STATE_DETECTFRAME)
+            num_consumed += gmskframesync_execute_detectframe_block(_q, x, _n - num_consumed);
+        else
+            num_consumed += gmskframesync_execute_rx_block(_q, x, _n - num_consumed);
     }
 }
 
@@ -394,24 +471,14 @@ void gmskframesync_execute(gmskframesync   _q,
                            float complex * _x,
                            unsigned int    _n)
 {
-    // push through synchronizer
+    // push through synchronizer in blocks
     unsigned int i;
-    for (i=0; i<_n; i++) {
-        float complex xf;   // input sample
-#if GMSKFRAMESYNC_PREFILTER
-        iirfilt_crcf_execute(_q->prefilter, _x[i], &xf);
-#else
-        xf = _x[i];
-#endif
-
-#if DEBUG_GMSKFRAMESYNC
-        if (_q->debug_enabled)
-            windowcf_push(_q->debug_x, xf);
-#endif
-
-        gmskframesync_execute_sample(_q, xf);
-
+    for (i=0; i<_n; i+=GMSKFRAMESYNC_BLOCK_LEN) {
+        unsigned int num_samples = _n - i < GMSKFRAMESYNC_BLOCK_LEN ?
+                                   _n - i : GMSKFRAMESYNC_BLOCK_LEN;
+        gmskframesync_execute_block(_q, &_x[i], num_samples);
     }
+    frameprofile_stop(&_q->profile);
 }
 
 // 
@@ -570,6 +637,40 @@ void gmskframesync_update_fi(gmskframesync _q,
     _q->x_prime = _x;
 }
 
+void gmskframesync_update_fi_block(gmskframesync _q,
+                                   unsigned int  _n)
+{
+    // buf_mix holds the previous sample followed by _n new samples; the
+    // differential phase products conj(r[i])*r[i+1] are computed with the
+    // same operations as the scalar complex product so that estimates are
+    // identical to those of gmskframesync_update_fi()
+    float complex * r = _q->buf_mix;
+    unsigned int i = 0;
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+    const __m128 sign = _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f);
+    float z[4];
+    for (i=0; i+2<=_n; i+=2) {
+        __m128 p  = _mm_loadu_ps((float*)&r[i  ]);          // [pr0 pi0 pr1 pi1]
+        __m128 x  = _mm_loadu_ps((float*)&r[i+1]);          // [xr0 xi0 xr1 xi1]
+        __m128 xs = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2,3,0,1));
+        __m128 a  = _mm_mul_ps(p, x);                       // [pr*xr, pi*xi, ...]
+        __m128 b  = _mm_mul_ps(p, xs);                      // [pr*xi, pi*xr, ...]
+        __m128 e  = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+        __m128 o  = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+
+        // [re0 re1 im0 im1] = [pr*xr + pi*xi, pr*xi - pi*xr]
+        _mm_storeu_ps(z, _mm_add_ps(e, _mm_xor_ps(o, sign)));
+        _q->buf_fi[i  ] = atan2f(z[2], z[0]) * _q->k;
+        _q->buf_fi[i+1] = atan2f(z[3], z[1]) * _q->k;
+    }
+#endif
+    for ( ; i<_n; i++)
+        _q->buf_fi[i] = cargf(conjf(r[i])*r[i+1]) * _q->k;
+
+    // update internal state
+    _q->x_prime = r[_n];
+}
+
 void gmskframesync_execute_detectframe(gmskframesync _q,
                                        float complex _x)
 {
@@ -594,15 +695,31 @@ void gmskframesync_execute_detectframe(gmskframesync _q,
     }
 }
 
-void gmskframesync_execute_rxpreamble(gmskframesync _q,
-                                      float complex _x)
+unsigned int gmskframesync_execute_detectframe_block(gmskframesync   _q,
+                                                     float complex * _x,
+                                                     unsigned int    _n)
 {
-    // validate input
-    if (_q->preamble_counter == _q->preamble_len) {
-        fprintf(stderr,"warning: gmskframesync_execute_rxpn(), p/n buffer already full!\n");
-        return;
+    // run pre-demod synchronizer up to and including detection
+    int detected = 0;
+    unsigned int num_consumed = detector_cccf_correlate_block(_q->frame_detector,
+                                                              _x, _n, &detected,
+                                                              &_q->tau_hat,
+                                                              &_q->dphi_hat,
+                                                              &_q->gamma_hat);
+
+    // push consumed samples into pre-demod p/n sequence buffer
+    windowcf_write(_q->buffer, _x, num_consumed);
+
+    if (detected) {
+        // push buffered samples through synchronizer
+        gmskframesync_pushpn(_q);
     }
+    return num_consumed;
+}
 
+void gmskframesync_execute_rx(gmskframesync _q,
+                              float complex _x)
+{
     // mix signal down
     float complex y;
     nco_crcf_mix_down(_q->nco_coarse, _x, &y);
@@ -616,150 +733,190 @@ void gmskframesync_execute_rxpreamble(gmskframesync _q,
     int sample_available = gmskframesync_update_symsync(_q, _q->fi_hat, &mf_out);
 
     // compute output if timeout
-    if (sample_available) {
-        // save output in p/n symbols buffer
-        _q->preamble_rx[ _q->preamble_counter ] = mf_out / (float)(_q->k);
+    if (sample_available)
+        gmskframesync_rxsymbol(_q, mf_out);
+}
+
+unsigned int gmskframesync_execute_rx_block(gmskframesync   _q,
+                                            float complex * _x,
+                                            unsigned int    _n)
+{
+    // mix signal down and estimate instantaneous frequency over entire
+    // block; if the frame ends part way through, resetting the object
+    // discards the remaining carrier and phase state
+    _q->buf_mix[0] = _q->x_prime;
+    nco_crcf_mix_block_down(_q->nco_coarse, _x, &_q->buf_mix[1], _n);
+    gmskframesync_update_fi_block(_q, _n);
 
-        // update counter
-        _q->preamble_counter++;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        _q->fi_hat = _q->buf_fi[i];
 
-        if (_q->preamble_counter == _q->preamble_len) {
-            gmskframesync_syncpn(_q);
-            _q->state = STATE_RXHEADER;
-        }
+        // update symbol synchronizer
+        float mf_out = 0.0f;
+        if (!gmskframesync_update_symsync(_q, _q->fi_hat, &mf_out))
+            continue;
+
+        gmskframesync_rxsymbol(_q, mf_out);
+
+        // return remaining samples to frame detection once frame is done
+        if (_q->state == STATE_DETECTFRAME)
+            return i+1;
+
+        frameprofile_switch(&_q->profile, gmskframesync_profile_stage[_q->state]);
     }
+    return _n;
 }
 
-void gmskframesync_execute_rxheader(gmskframesync _q,
-                                    float complex _x)
+void gmskframesync_rxsymbol(gmskframesync _q,
+                            float         _y)
 {
-    // mix signal down
-    float complex y;
-    nco_crcf_mix_down(_q->nco_coarse, _x, &y);
-    nco_crcf_step(_q->nco_coarse);
+    switch (_q->state) {
+    case STATE_RXPREAMBLE:
+        // receive p/n sequence symbols
+        gmskframesync_rxpreamble(_q, _y);
+        break;
 
-    // update instantanenous frequency estimate
-    gmskframesync_update_fi(_q, y);
+    case STATE_RXHEADER:
+        // receive header
+        gmskframesync_rxheader(_q, _y);
+        break;
 
-    // update symbol synchronizer
-    float mf_out = 0.0f;
-    int sample_available = gmskframesync_update_symsync(_q, _q->fi_hat, &mf_out);
+    case STATE_RXPAYLOAD:
+        // receive payload
+        gmskframesync_rxpayload(_q, _y);
+        break;
 
-    // compute output if timeout
-    if (sample_available) {
-        // demodulate
-        unsigned char s = mf_out > 0.0f ? 1 : 0;
-
-        // TODO: update evm
-
-        // save bit in buffer
-        _q->header_mod[_q->header_counter] = s;
-
-        // increment header counter
-        _q->header_counter++;
-        if (_q->header_counter == _q->header_mod_len) {
-            // decode header
-            gmskframesync_decode_header(_q);
-
-            // invoke callback if header is invalid
-            if (!_q->header_valid && _q->callback != NULL) {
-                // set framestats internals
-                _q->framestats.rssi          = 20*log10f(_q->gamma_hat);
-                _q->framestats.evm           = 0.0f;
-                _q->framestats.framesyms     = NULL;
-                _q->framestats.num_framesyms = 0;
-                _q->framestats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
-                _q->framestats.mod_bps       = 1;
-                _q->framestats.check         = LIQUID_CRC_UNKNOWN;
-                _q->framestats.fec0          = LIQUID_FEC_UNKNOWN;
-                _q->framestats.fec1          = LIQUID_FEC_UNKNOWN;
-
-                // invoke callback method
-                _q->callback(_q->header_dec,
-                             _q->header_valid,
-                             NULL,
-                             0,
-                             0,
-                             _q->framestats,
-                             _q->userdata);
-
-                gmskframesync_reset(_q);
-            }
-
-            // reset if invalid
-            if (!_q->header_valid) {
-                gmskframesync_reset(_q);
-                return;
-            }
-
-            // update state
-            _q->state = STATE_RXPAYLOAD;
-        }
+    default:
+        fprintf(stderr,"error: gmskframesync_rxsymbol(), unexpected internal state\n");
+        exit(1);
     }
 }
 
-void gmskframesync_execute_rxpayload(gmskframesync _q,
-                                     float complex _x)
+void gmskframesync_rxpreamble(gmskframesync _q,
+                              float         _y)
 {
-    // mix signal down
-    float complex y;
-    nco_crcf_mix_down(_q->nco_coarse, _x, &y);
-    nco_crcf_step(_q->nco_coarse);
+    // validate input
+    if (_q->preamble_counter == _q->preamble_len) {
+        fprintf(stderr,"warning: gmskframesync_rxpreamble(), p/n buffer already full!\n");
+        return;
+    }
 
-    // update instantanenous frequency estimate
-    gmskframesync_update_fi(_q, y);
+    // save output in p/n symbols buffer
+    _q->preamble_rx[ _q->preamble_counter ] = _y / (float)(_q->k);
 
-    // update symbol synchronizer
-    float mf_out = 0.0f;
-    int sample_available = gmskframesync_update_symsync(_q, _q->fi_hat, &mf_out);
+    // update counter
+    _q->preamble_counter++;
 
-    // compute output if timeout
-    if (sample_available) {
-        // demodulate
-        unsigned char s = mf_out > 0.0f ? 1 : 0;
-
-        // TODO: update evm
-
-        // save payload
-        _q->payload_byte <<= 1;
-        _q->payload_byte |= s ? 0x01 : 0x00;
-        _q->payload_enc[_q->payload_counter/8] = _q->payload_byte;
-
-        // increment counter
-        _q->payload_counter++;
-
-        if (_q->payload_counter == 8*_q->payload_enc_len) {
-            // decode payload
-            _q->payload_valid = packetizer_decode(_q->p_payload,
-                                                  _q->payload_enc,
-                                                  _q->payload_dec);
-
-            // invoke callback
-            if (_q->callback != NULL) {
-                // set framestats internals
-                _q->framestats.rssi          = 20*log10f(_q->gamma_hat);
-                _q->framestats.evm           = 0.0f;
-                _q->framestats.framesyms     = NULL;
-                _q->framestats.num_framesyms = 0;
-                _q->framestats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
-                _q->framestats.mod_bps       = 1;
-                _q->framestats.check         = _q->check;
-                _q->framestats.fec0          = _q->fec0;
-                _q->framestats.fec1          = _q->fec1;
-
-                // invoke callback method
-                _q->callback(_q->header_dec,
-                             _q->header_valid,
-                             _q->payload_dec,
-                             _q->payload_dec_len,
-                             _q->payload_valid,
-                             _q->framestats,
-                             _q->userdata);
-            }
-
-            // reset frame synchronizer
+    if (_q->preamble_counter == _q->preamble_len) {
+        gmskframesync_syncpn(_q);
+        _q->state = STATE_RXHEADER;
+    }
+}
+
+void gmskframesync_rxheader(gmskframesync _q,
+                            float         _y)
+{
+    // demodulate
+    unsigned char s = _y > 0.0f ? 1 : 0;
+
+    // TODO: update evm
+
+    // save bit in buffer
+    _q->header_mod[_q->header_counter] = s;
+
+    // increment header counter
+    _q->header_counter++;
+    if (_q->header_counter == _q->header_mod_len) {
+        // decode header
+        gmskframesync_decode_header(_q);
+
+        // invoke callback if header is invalid
+        if (!_q->header_valid && _q->callback != NULL) {
+            // set framestats internals
+            _q->framestats.rssi          = 20*log10f(_q->gamma_hat);
+            _q->framestats.evm           = 0.0f;
+            _q->framestats.framesyms     = NULL;
+            _q->framestats.num_framesyms = 0;
+            _q->framestats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
+            _q->framestats.mod_bps       = 1;
+            _q->framestats.check         = LIQUID_CRC_UNKNOWN;
+            _q->framestats.fec0          = LIQUID_FEC_UNKNOWN;
+            _q->framestats.fec1          = LIQUID_FEC_UNKNOWN;
+
+            // invoke callback method
+            frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
+            _q->callback(_q->header_dec,
+                         _q->header_valid,
+                         NULL,
+                         0,
+                         0,
+                         _q->framestats,
+                         _q->userdata);
+
+            gmskframesync_reset(_q);
+        }
+
+        // reset if invalid
+        if (!_q->header_valid) {
             gmskframesync_reset(_q);
+            return;
+        }
+
+        // update state
+        _q->state = STATE_RXPAYLOAD;
+    }
+}
+
+void gmskframesync_rxpayload(gmskframesync _q,
+                             float         _y)
+{
+    // demodulate
+    unsigned char s = _y > 0.0f ? 1 : 0;
+
+    // TODO: update evm
+
+    // save payload
+    _q->payload_byte <<= 1;
+    _q->payload_byte |= s ? 0x01 : 0x00;
+    _q->payload_enc[_q->payload_counter/8] = _q->payload_byte;
+
+    // increment counter
+    _q->payload_counter++;
+
+    if (_q->payload_counter == 8*_q->payload_enc_len) {
+        // decode payload
+        frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
+        _q->payload_valid = packetizer_decode(_q->p_payload,
+                                              _q->payload_enc,
+                                              _q->payload_dec);
+
+        // invoke callback
+        if (_q->callback != NULL) {
+            // set framestats internals
+            _q->framestats.rssi          = 20*log10f(_q->gamma_hat);
+            _q->framestats.evm           = 0.0f;
+            _q->framestats.framesyms     = NULL;
+            _q->framestats.num_framesyms = 0;
+            _q->framestats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
+            _q->framestats.mod_bps       = 1;
+            _q->framestats.check         = _q->check;
+            _q->framestats.fec0          = _q->fec0;
+            _q->framestats.fec1          = _q->fec1;
+
+            // invoke callback method
+            frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
+            _q->callback(_q->header_dec,
+                         _q->header_valid,
+                         _q->payload_dec,
+                         _q->payload_dec_len,
+                         _q->payload_valid,
+                         _q->framestats,
+                         _q->userdata);
         }
+
+        // reset frame synchronizer
+        gmskframesync_reset(_q);
     }
 }
 
@@ -860,6 +1017,30 @@ void gmskframesync_decode_header(gmskframesync _q)
     //
 }
 
+// enable profiling of internal stages
+void gmskframesync_profile_enable(gmskframesync _q)
+{
+    _q->profile.enabled = 1;
+}
+
+// disable profiling of internal stages
+void gmskframesync_profile_disable(gmskframesync _q)
+{
+    frameprofile_stop(&_q->profile);
+    _q->profile.enabled = 0;
+}
+
+// reset profiling counters
+void gmskframesync_reset_profile(gmskframesync _q)
+{
+    frameprofile_reset(&_q->profile);
+}
+
+// retrieve profiling counters
+frameprofile_s gmskframesync_get_profile(gmskframesync _q)
+{
+    return _q->profile;
+}
 
 void gmskframesync_debug_enable(gmskframesync _q)
 {
@@ -114,7 +114,8 @@ struct ofdmflexframegen_s {
     unsigned int header_sym_len;  // header length (mod symbols)
 
     // payload
-    packetizer p_payload;               // payload packetizer
+    packetizer_cache p_cache;           // payload packetizers
+    packetizer p_payload;               // payload packetizer (active)
     unsigned int payload_dec_len;       // payload length (num un-encoded bytes)
     modem mod_payload;                  // payload modulator
     unsigned char * payload_enc;        // payload data (encoded bytes)
@@ -202,10 +203,12 @@ ofdmflexframegen ofdmflexframegen_create(unsigned int              _M,
 
     // initial memory allocation for payload
     q->payload_dec_len = 1;
-    q->p_payload = packetizer_create(q->payload_dec_len,
-                                     LIQUID_CRC_NONE,
-                                     LIQUID_FEC_NONE,
-                                     LIQUID_FEC_NONE);
+    q->p_cache   = packetizer_cache_create();
+    q->p_payload = packetizer_cache_get(q->p_cache,
+                                        q->payload_dec_len,
+                                        LIQUID_CRC_NONE,
+                                        LIQUID_FEC_NONE,
+                                        LIQUID_FEC_NONE);
     q->payload_enc_len = packetizer_get_enc_msg_len(q->p_payload);
     q->payload_enc = (unsigned char*) malloc(q->payload_enc_len*sizeof(unsigned char));
 
@@ -231,7 +234,7 @@ void ofdmflexframegen_destroy(ofdmflexframegen _q)
     ofdmframegen_destroy(_q->fg);       // OFDM frame generator
     packetizer_destroy(_q->p_header);   // header packetizer
     modem_destroy(_q->mod_header);      // header modulator
-    packetizer_destroy(_q->p_payload);  // payload packetizer
+    packetizer_cache_destroy(_q->p_cache); // payload packetizers
     modem_destroy(_q->mod_payload);     // payload modulator
 
     // free buffers/arrays
@@ -500,12 +503,12 @@ int ofdmflexframegen_write(ofdmflexframegen _q,
 // reconfigure internal buffers, objects, etc.
 void ofdmflexframegen_reconfigure(ofdmflexframegen _q)
 {
-    // re-create payload packetizer
-    _q->p_payload = packetizer_recreate(_q->p_payload,
-                                        _q->payload_dec_len,
-                                        _q->props.check,
-                                        _q->props.fec0,
-                                        _q->props.fec1);
+    // get payload packetizer from cache
+    _q->p_payload = packetizer_cache_get(_q->p_cache,
+                                         _q->payload_dec_len,
+                                         _q->props.check,
+                                         _q->props.fec0,
+                                         _q->props.fec1);
 
     // re-allocate memory for encoded message
     _q->payload_enc_len = packetizer_get_enc_msg_len(_q->p_payload);
@@ -38,6 +38,9 @@
 
 #define OFDMFLEXFRAME_P_SOFT (1)
 
+// number of pooled frames per decoder thread
+#define OFDMFLEXFRAMESYNC_DECODE_FRAMES_PER_THREAD (2)
+
 // 
 // ofdmflexframesync
 //
@@ -59,6 +62,9 @@ void ofdmflexframesync_decode_header(ofdmflexframesync _q);
 void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
                                 float complex * _X);
 
+// stage currently being processed, used for profiling
+int ofdmflexframesync_profile_stage(ofdmflexframesync _q);
+
 static ofdmflexframegenprops_s ofdmflexframesyncprops_header_default = {
     OFDMFLEXFRAME_H_CRC,
     OFDMFLEXFRAME_H_FEC0,
@@ -113,6 +119,10 @@ struct ofdmflexframesync_s {
     int payload_valid;                  // valid payload flag
     float complex * payload_syms;       // received payload symbols
 
+    // asynchronous payload decoding
+    framedecpool decpool;               // payload decoder pool (NULL: decode in place)
+    framedecpool_frame decframe;        // pooled frame being received
+
     // callback
     framesync_callback callback;        // user-defined callback function
     void * userdata;                    // user-defined data structure
@@ -131,6 +141,8 @@ struct ofdmflexframesync_s {
     unsigned int header_symbol_index;   // number of header symbols received
     unsigned int payload_symbol_index;  // number of payload symbols received
     unsigned int payload_buffer_index;  // bit-level index of payload (pack array)
+
+    frameprofile_s profile;             // per-stage profile (disabled by default)
 };
 
 // create ofdmflexframesync object
@@ -212,6 +224,14 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
     q->payload_syms = (float complex *) malloc(q->payload_len*sizeof(float complex));
     q->payload_mod_len = 0;
 
+    // payload is decoded in place by default
+    q->decpool  = NULL;
+    q->decframe = NULL;
+
+    // profiling disabled by default
+    q->profile.enabled = 0;
+    ofdmflexframesync_reset_profile(q);
+
     // reset state
     ofdmflexframesync_reset(q);
 
@@ -221,6 +241,9 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
 
 void ofdmflexframesync_destroy(ofdmflexframesync _q)
 {
+    // deliver outstanding frames and stop decoder threads
+    ofdmflexframesync_set_decode_threads(_q, 0);
+
     // destroy internal objects
     ofdmframesync_destroy(_q->fs);
     packetizer_destroy(_q->p_header);
@@ -323,6 +346,35 @@ void ofdmflexframesync_set_header_props(ofdmflexframesync _q,
     ofdmflexframesync_set_header_len(_q, _q->header_user_len);
 }
 
+void ofdmflexframesync_set_decode_threads(ofdmflexframesync _q,
+                                          unsigned int      _num_threads)
+{
+    // abandon partially-received frame
+    if (_q->decframe != NULL)
+        ofdmflexframesync_reset(_q);
+
+    // deliver outstanding frames and stop existing threads
+    if (_q->decpool != NULL) {
+        framedecpool_destroy(_q->decpool);
+        _q->decpool = NULL;
+    }
+
+    if (_num_threads == 0)
+        return;
+
+    _q->decpool = framedecpool_create(_num_threads,
+                                      _num_threads*OFDMFLEXFRAMESYNC_DECODE_FRAMES_PER_THREAD,
+                                      _q->callback,
+                                      _q->userdata,
+                                      NULL);
+}
+
+void ofdmflexframesync_drain(ofdmflexframesync _q)
+{
+    if (_q->decpool != NULL)
+        framedecpool_drain(_q->decpool);
+}
+
 void ofdmflexframesync_reset(ofdmflexframesync _q)
 {
     // reset internal state
@@ -340,6 +392,12 @@ void ofdmflexframesync_reset(ofdmflexframesync _q)
     // reset framestats object
     framesyncstats_init_default(&_q->framestats);
 
+    // return partially-received frame to decoder pool
+    if (_q->decframe != NULL) {
+        framedecpool_release(_q->decpool, _q->decframe);
+        _q->decframe = NULL;
+    }
+
     // reset internal OFDM frame synchronizer object
     ofdmframesync_reset(_q->fs);
 }
@@ -354,8 +412,12 @@ void ofdmflexframesync_execute(ofdmflexframesync _q,
                                float complex * _x,
                                unsigned int _n)
 {
+    frameprofile_switch(&_q->profile, ofdmflexframesync_profile_stage(_q));
+
     // push samples through ofdmframesync object
     ofdmframesync_execute(_q->fs, _x, _n);
+
+    frameprofile_stop(&_q->profile);
 }
 
 // 
@@ -407,10 +469,48 @@ void ofdmflexframesync_debug_print(ofdmflexframesync _q,
     ofdmframesync_debug_print(_q->fs, _filename);
 }
 
+// enable profiling of internal stages
+void ofdmflexframesync_profile_enable(ofdmflexframesync _q)
+{
+    _q->profile.enabled = 1;
+}
+
+// disable profiling of internal stages
+void ofdmflexframesync_profile_disable(ofdmflexframesync _q)
+{
+    frameprofile_stop(&_q->profile);
+    _q->profile.enabled = 0;
+}
+
+// reset per-stage profile
+void ofdmflexframesync_reset_profile(ofdmflexframesync _q)
+{
+    frameprofile_reset(&_q->profile);
+}
+
+// retrieve per-stage profile; detection and PLCP preamble are handled
+// by the internal ofdmframesync object and are only resolved at the
+// granularity of the input block
+frameprofile_s ofdmflexframesync_get_profile(ofdmflexframesync _q)
+{
+    return _q->profile;
+}
+
 //
 // internal methods
 //
 
+// stage currently being processed
+int ofdmflexframesync_profile_stage(ofdmflexframesync _q)
+{
+    if (!ofdmframesync_is_frame_open(_q->fs))
+        return LIQUID_FRAMEPROFILE_DETECT;
+    if (_q->state == OFDMFLEXFRAMESYNC_STATE_PAYLOAD)
+        return LIQUID_FRAMEPROFILE_PAYLOAD;
+    return _q->symbol_counter == 0 ? LIQUID_FRAMEPROFILE_PREAMBLE :
+                                     LIQUID_FRAMEPROFILE_HEADER;
+}
+
 // internal callback
 //  _X          :   subcarrier symbols
 //  _p          :   subcarrier allocation
@@ -433,6 +533,9 @@ int ofdmflexframesync_internal_callback(float complex * _X,
     printf("received symbol %u\n", _q->symbol_counter);
 #endif
 
+    frameprofile_switch(&_q->profile, _q->state == OFDMFLEXFRAMESYNC_STATE_HEADER ?
+        LIQUID_FRAMEPROFILE_HEADER : LIQUID_FRAMEPROFILE_PAYLOAD);
+
     // extract symbols
     switch (_q->state) {
     case OFDMFLEXFRAMESYNC_STATE_HEADER:
@@ -446,6 +549,9 @@ int ofdmflexframesync_internal_callback(float complex * _X,
         exit(1);
     }
 
+    // remaining samples are attributed to the next stage
+    frameprofile_switch(&_q->profile, ofdmflexframesync_profile_stage(_q));
+
     // return
     return 0;
 }
@@ -493,9 +599,32 @@ void ofdmflexframesync_rxheader(ofdmflexframesync _q,
                 _q->framestats.evm = 10*log10f( _q->evm_hat/_q->header_sym_len );
 
                 // invoke callback if header is invalid
-                if (_q->header_valid)
+                if (_q->header_valid) {
+                    // capture payload symbols directly into pooled frame
+                    if (_q->decpool != NULL) {
+                        // waiting for a free frame is counted as decoding
+                        frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
+                        _q->decframe = framedecpool_acquire(_q->decpool, _q->header_dec_len, _q->payload_mod_len);
+                        memmove(_q->decframe->header, _q->header, _q->header_dec_len*sizeof(unsigned char));
+                    }
                     _q->state = OFDMFLEXFRAMESYNC_STATE_PAYLOAD;
-                else {
+                } else if (_q->decpool != NULL) {
+                    // hand off to decoder pool to preserve frame order
+                    frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
+                    framedecpool_frame f = framedecpool_acquire(_q->decpool, _q->header_dec_len, 0);
+                    memmove(f->header, _q->header, _q->header_dec_len*sizeof(unsigned char));
+                    f->header_valid     = 0;
+                    f->stats            = _q->framestats;
+                    f->stats.rssi       = ofdmframesync_get_rssi(_q->fs);
+                    f->stats.cfo        = ofdmframesync_get_cfo(_q->fs);
+                    f->stats.mod_scheme = LIQUID_MODEM_UNKNOWN;
+                    f->stats.mod_bps    = 0;
+                    f->stats.check      = LIQUID_CRC_UNKNOWN;
+                    f->stats.fec0       = LIQUID_FEC_UNKNOWN;
+                    f->stats.fec1       = LIQUID_FEC_UNKNOWN;
+                    framedecpool_submit(_q->decpool, f);
+                    ofdmflexframesync_reset(_q);
+                } else {
                     //printf("**** header invalid!\n");
                     // set framestats internals
                     _q->framestats.rssi             = ofdmframesync_get_rssi(_q->fs);
@@ -509,6 +638,7 @@ void ofdmflexframesync_rxheader(ofdmflexframesync _q,
                     _q->framestats.fec1             = LIQUID_FEC_UNKNOWN;
 
                     // invoke callback method
+                    frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
                     _q->callback(_q->header,
                                  _q->header_valid,
                                  NULL,
@@ -691,7 +821,35 @@ void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
         sctype = _q->p[i];
 
         // ignore pilot and null subcarriers
-        if (sctype == OFDMFRAME_SCTYPE_DATA) {
+        if (sctype == OFDMFRAME_SCTYPE_DATA && _q->decframe != NULL) {
+            // store received symbol in pooled frame; demodulation and
+            // decoding run on the decoder pool
+            _q->decframe->payload_sym[_q->payload_symbol_index++] = _X[i];
+
+            if (_q->payload_symbol_index == _q->payload_mod_len) {
+                framedecpool_frame f = _q->decframe;
+                f->header_valid     = 1;
+                f->payload_len      = _q->payload_len;
+                f->check            = _q->check;
+                f->fec0             = _q->fec0;
+                f->fec1             = _q->fec1;
+                f->mod_scheme       = _q->ms_payload;
+                f->soft             = _q->payload_soft;
+                f->stats            = _q->framestats;
+                f->stats.rssi       = ofdmframesync_get_rssi(_q->fs);
+                f->stats.cfo        = ofdmframesync_get_cfo(_q->fs);
+                f->stats.mod_scheme = _q->ms_payload;
+                f->stats.mod_bps    = _q->bps_payload;
+                f->stats.check      = _q->check;
+                f->stats.fec0       = _q->fec0;
+                f->stats.fec1       = _q->fec1;
+                _q->decframe = NULL;
+                frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
+                framedecpool_submit(_q->decpool, f);
+                ofdmflexframesync_reset(_q);
+                break;
+            }
+        } else if (sctype == OFDMFRAME_SCTYPE_DATA) {
             // unload payload symbols
             unsigned int sym;
             // store received symbol
@@ -718,6 +876,7 @@ void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
 
             if (_q->payload_symbol_index == _q->payload_mod_len) {
                 // payload extracted
+                frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_DECODE);
                 if (_q->payload_soft) {
                     _q->payload_valid = packetizer_decode_soft(_q->p_payload, _q->payload_enc, _q->payload_dec);
                 } else {
@@ -746,6 +905,7 @@ void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
                 _q->framestats.fec1             = _q->fec1;
 
                 // invoke callback method
+                frameprofile_switch(&_q->profile, LIQUID_FRAMEPROFILE_CALLBACK);
                 _q->callback(_q->header,
                              _q->header_valid,
                              _q->payload_dec,
@@ -477,19 +477,16 @@ void qdetector_cccf_execute_seek(qdetector_cccf _q,
     // NOTE: this offset may be coarse as a fine carrier estimate is computed later
     for (offset=-_q->range; offset<=_q->range; offset++) {
 
-        // cross-multiply, aligning appropriately
+        // cross-multiply, aligning appropriately (shifted index wraps
+        // around at the end of the template)
+        unsigned int j = (_q->nfft - offset) % _q->nfft;
         for (i=0; i<_q->nfft; i++) {
-            // shifted index
-            unsigned int j = (i + _q->nfft - offset) % _q->nfft;
-
             _q->buf_freq_1[i] = _q->buf_freq_0[i] * conjf(_q->S[j]);
+            j = (j == _q->nfft-1) ? 0 : j+1;
         }
 
         // run inverse transform
         fft_execute(_q->ifft);
-        
-        // scale output appropriately
-        liquid_vectorcf_mulscalar(_q->buf_time_1, _q->nfft, g, _q->buf_time_1);
 
 #if DEBUG_QDETECTOR
         // debug output
@@ -499,7 +496,7 @@ void qdetector_cccf_execute_seek(qdetector_cccf _q,
         fprintf(fid,"clear all; close all;\n");
         fprintf(fid,"nfft = %u;\n", _q->nfft);
         for (i=0; i<_q->nfft; i++)
-            fprintf(fid,"rxy(%6u) = %12.4e + 1i*%12.4e;\n", i+1, crealf(_q->buf_time_1[i]), cimagf(_q->buf_time_1[i]));
+            fprintf(fid,"rxy(%6u) = %12.4e + 1i*%12.4e;\n", i+1, g*crealf(_q->buf_time_1[i]), g*cimagf(_q->buf_time_1[i]));
         fprintf(fid,"figure;\n");
         fprintf(fid,"t=[0:(nfft-1)];\n");
         fprintf(fid,"plot(t,abs(rxy));\n");
@@ -510,18 +507,22 @@ void qdetector_cccf_execute_seek(qdetector_cccf _q,
         fclose(fid);
         printf("debug: %s\n", filename);
 #endif
-        // search for peak
+        // search for peak, comparing squared magnitudes of unscaled output
         // TODO: only search over range [-nfft/2, nfft/2)
         for (i=0; i<_q->nfft; i++) {
-            float rxy_abs = cabsf(_q->buf_time_1[i]);
-            if (rxy_abs > rxy_peak) {
-                rxy_peak   = rxy_abs;
+            float rxy2 = crealf(_q->buf_time_1[i])*crealf(_q->buf_time_1[i]) +
+                         cimagf(_q->buf_time_1[i])*cimagf(_q->buf_time_1[i]);
+            if (rxy2 > rxy_peak) {
+                rxy_peak   = rxy2;
                 rxy_index  = i;
                 rxy_offset = offset;
             }
         }
     }
 
+    // scale peak appropriately
+    rxy_peak = g * sqrtf(rxy_peak);
+
     // increment number of transforms (debugging)
     _q->num_transforms++;
 
@@ -570,10 +571,10 @@ void qdetector_cccf_execute_align(qdetector_cccf _q,
     // cross-multiply frequency-domain components, aligning appropriately with
     // estimated FFT offset index due to carrier frequency offset in received signal
     unsigned int i;
+    unsigned int j = (_q->nfft - _q->offset) % _q->nfft;
     for (i=0; i<_q->nfft; i++) {
-        // shifted index
-        unsigned int j = (i + _q->nfft - _q->offset) % _q->nfft;
         _q->buf_freq_1[i] = _q->buf_freq_0[i] * conjf(_q->S[j]);
+        j = (j == _q->nfft-1) ? 0 : j+1;
     }
     fft_execute(_q->ifft);
     // time aligned to index 0
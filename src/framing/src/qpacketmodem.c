@@ -38,7 +38,8 @@
 struct qpacketmodem_s {
     // properties
     modem           mod_payload;        // payload modulator/demodulator
-    packetizer      p;                  // packet encoder/decoder
+    packetizer_cache p_cache;           // packet encoders/decoders
+    packetizer      p;                  // packet encoder/decoder (active)
     unsigned int    bits_per_symbol;    // modulator bits/symbol
     unsigned int    payload_dec_len;    // number of decoded payload bytes
     unsigned char * payload_enc;        // payload data (encoded bytes)
@@ -61,10 +62,12 @@ qpacketmodem qpacketmodem_create()
     
     // initial memory allocation for payload
     q->payload_dec_len = 1;
-    q->p = packetizer_create(q->payload_dec_len,
-                             LIQUID_CRC_NONE,
-                             LIQUID_FEC_NONE,
-                             LIQUID_FEC_NONE);
+    q->p_cache = packetizer_cache_create();
+    q->p = packetizer_cache_get(q->p_cache,
+                                q->payload_dec_len,
+                                LIQUID_CRC_NONE,
+                                LIQUID_FEC_NONE,
+                                LIQUID_FEC_NONE);
 
     // number of bytes in encoded payload
     q->payload_enc_len = packetizer_get_enc_msg_len(q->p);
@@ -93,7 +96,7 @@ qpacketmodem qpacketmodem_create()
 void qpacketmodem_destroy(qpacketmodem _q)
 {
     // free objects
-    packetizer_destroy(_q->p);
+    packetizer_cache_destroy(_q->p_cache);
     modem_destroy(_q->mod_payload);
 
     // free arrays
@@ -138,8 +141,8 @@ int qpacketmodem_configure(qpacketmodem _q,
     _q->mod_payload = modem_recreate(_q->mod_payload, _ms);
     _q->bits_per_symbol = modem_get_bps(_q->mod_payload);
 
-    // recreate packetizer object and compute new encoded payload length
-    _q->p = packetizer_recreate(_q->p, _q->payload_dec_len, _check, _fec0, _fec1);
+    // get packetizer object from cache and compute new encoded payload length
+    _q->p = packetizer_cache_get(_q->p_cache, _q->payload_dec_len, _check, _fec0, _fec1);
     _q->payload_enc_len = packetizer_get_enc_msg_len(_q->p);
 
     // number of bits in encoded payload
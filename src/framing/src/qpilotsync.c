@@ -205,11 +205,15 @@ void qpilotsync_execute(qpilotsync      _q,
         printf("X(%3u) = %12.8f + 1i*%12.8f; %% %12.8f\n",
                 i+1, crealf(_q->buf_freq[i]), cimagf(_q->buf_freq[i]), cabsf(_q->buf_freq[i]));
 #endif
-        if (i==0 || cabsf(_q->buf_freq[i]) > y0) {
+        // compare squared magnitudes
+        float y2 = crealf(_q->buf_freq[i])*crealf(_q->buf_freq[i]) +
+                   cimagf(_q->buf_freq[i])*cimagf(_q->buf_freq[i]);
+        if (i==0 || y2 > y0) {
             i0 = i;
-            y0 = cabsf(_q->buf_freq[i]);
+            y0 = y2;
         }
     }
+    y0 = cabsf(_q->buf_freq[i0]);
 
     // interpolate and recover frequency
     unsigned int ineg = (i0 + _q->nfft - 1) % _q->nfft;
@@ -249,8 +253,12 @@ void qpilotsync_execute(qpilotsync      _q,
     // NOTE: this is possibly more accurate than the above method but might also
     //       be more computationally complex
     float complex metric = 0;
-    for (i=0; i<_q->num_pilots; i++)
-        metric += _q->buf_time[i] * cexpf(-_Complex_I*_q->dphi_hat*i*(float)(_q->pilot_spacing));
+    float complex r      = 1.0f;
+    float complex r_step = cexpf(-_Complex_I*_q->dphi_hat*(float)(_q->pilot_spacing));
+    for (i=0; i<_q->num_pilots; i++) {
+        metric += _q->buf_time[i] * r;
+        r *= r_step;
+    }
     //printf("metric : %12.8f <%12.8f>\n", cabsf(metric), cargf(metric));
     _q->phi_hat = cargf(metric);
     _q->g_hat   = cabsf(metric) / (float)(_q->num_pilots);
@@ -259,18 +267,25 @@ void qpilotsync_execute(qpilotsync      _q,
     // frequency correction
     float g = 1.0f / _q->g_hat;
 
-    // recover frame symbols
+    // recover frame symbols, one pilot and the data symbols following it
+    // at a time; the de-rotation phasor is computed exactly at each pilot
+    // and stepped in between
     _q->evm_hat = 0.0f;
-    for (i=0; i<_q->frame_len; i++) {
-        float complex v = g * _frame[i] * cexpf(-_Complex_I*(_q->dphi_hat*i + _q->phi_hat));
-        if ( (i % _q->pilot_spacing)==0 ) {
-            // pilot symbol
-            float complex e = _q->pilots[p] - v;
-            _q->evm_hat += crealf( e * conjf(e) );
-            p++;
-        } else {
-            // data symbol
-            _payload[n++] = v;
+    r_step = cexpf(-_Complex_I*_q->dphi_hat);
+    for (i=0; i<_q->frame_len; i+=_q->pilot_spacing) {
+        // pilot symbol
+        r = g * cexpf(-_Complex_I*(_q->dphi_hat*i + _q->phi_hat));
+        float complex v = _frame[i] * r;
+        float complex e = _q->pilots[p] - v;
+        _q->evm_hat += crealf( e * conjf(e) );
+        p++;
+
+        // data symbols
+        unsigned int j;
+        unsigned int j1 = i + _q->pilot_spacing < _q->frame_len ? i + _q->pilot_spacing : _q->frame_len;
+        for (j=i+1; j<j1; j++) {
+            r *= r_step;
+            _payload[n++] = _frame[j] * r;
         }
     }
     _q->evm_hat = 10*log10f( _q->evm_hat / (float)(_q->num_pilots) );
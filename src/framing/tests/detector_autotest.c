@@ -172,3 +172,163 @@ void detector_cccf_runtest(unsigned int _n,
 }
 
 
+
+// autotest helper function: compare block correlation against running
+// the detector one sample at a time
+//  _n          :   sequence length
+//  _block_len  :   number of samples passed to each block call
+void detector_cccf_runtest_block(unsigned int _n,
+                                 unsigned int _block_len)
+{
+    unsigned int i;
+    unsigned int num_samples = 4*_n + 200;
+    float        dphi        = 0.02f;
+
+    // generate random QPSK sequence and signal with two occurrences
+    float complex s[_n];
+    for (i=0; i<_n; i++)
+        s[i] = (randf() < 0.5f ? 1.0f : -1.0f) + (randf() < 0.5f ? 1.0f : -1.0f)*_Complex_I;
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++) {
+        x[i] = 0.1f*(randnf() + _Complex_I*randnf());
+        if (i >= 50 && i < 50+_n)
+            x[i] += 0.5f * s[i-50] * cexpf(_Complex_I*dphi*i);
+        if (i >= 2*_n+100 && i < 3*_n+100)
+            x[i] += 0.5f * s[i-2*_n-100] * cexpf(-_Complex_I*dphi*i);
+    }
+
+    // run detector sample by sample
+    detector_cccf q = detector_cccf_create(s, _n, 0.5f, 0.05f);
+    unsigned int num_detect_0 = 0;
+    unsigned int index_0[8];
+    float        est_0[8][3];
+    float tau_hat, dphi_hat, gamma_hat;
+    for (i=0; i<num_samples; i++) {
+        if (detector_cccf_correlate(q, x[i], &tau_hat, &dphi_hat, &gamma_hat)) {
+            if (num_detect_0 < 8) {
+                index_0[num_detect_0]  = i;
+                est_0[num_detect_0][0] = tau_hat;
+                est_0[num_detect_0][1] = dphi_hat;
+                est_0[num_detect_0][2] = gamma_hat;
+            }
+            num_detect_0++;
+        }
+    }
+
+    // run detector in blocks
+    detector_cccf_reset(q);
+    unsigned int num_detect_1 = 0;
+    unsigned int num_consumed = 0;
+    while (num_consumed < num_samples) {
+        unsigned int num_remaining = num_samples - num_consumed;
+        unsigned int num_block     = num_remaining < _block_len ? num_remaining : _block_len;
+        int detected = 0;
+        num_consumed += detector_cccf_correlate_block(q, &x[num_consumed], num_block,
+                                                      &detected, &tau_hat, &dphi_hat, &gamma_hat);
+        if (detected) {
+            if (num_detect_1 < 8 && num_detect_1 < num_detect_0) {
+                CONTEND_EQUALITY( num_consumed-1, index_0[num_detect_1] );
+                CONTEND_DELTA( tau_hat,   est_0[num_detect_1][0], 1e-3f );
+                CONTEND_DELTA( dphi_hat,  est_0[num_detect_1][1], 1e-4f );
+                CONTEND_DELTA( gamma_hat, est_0[num_detect_1][2], 1e-4f );
+            }
+            num_detect_1++;
+        }
+    }
+    detector_cccf_destroy(q);
+
+    // both signals should have been detected, with identical detections
+    // from both methods
+    CONTEND_GREATER_THAN( num_detect_0, 1 );
+    CONTEND_EQUALITY( num_detect_1, num_detect_0 );
+}
+
+void autotest_detector_cccf_block_n64()   { detector_cccf_runtest_block(  64,   37); }
+void autotest_detector_cccf_block_n256()  { detector_cccf_runtest_block( 256, 1000); }
+void autotest_detector_cccf_block_n1024() { detector_cccf_runtest_block(1024, 4096); }
+
+// autotest helper function: compare block correlation against running
+// the detector one sample at a time at an SNR where the correlation
+// peak straddles the threshold; frequency-domain rounding may flip
+// marginal detections, but only rarely
+//  _n          :   sequence length
+//  _block_len  :   number of samples passed to each block call
+//  _num_trials :   number of independent trials
+void detector_cccf_runtest_marginal(unsigned int _n,
+                                    unsigned int _block_len,
+                                    unsigned int _num_trials)
+{
+    unsigned int i, t;
+    unsigned int num_samples = 4*_n;
+    float        gain        = 0.275f;  // roughly half of trials detected
+
+    unsigned int num_detect_0 = 0;  // trials detected sample by sample
+    unsigned int num_detect_1 = 0;  // trials detected in blocks
+    unsigned int num_mismatch = 0;  // trials with differing detections
+    float complex s[_n];
+    float complex x[num_samples];
+    float tau_hat, dphi_hat, gamma_hat;
+    for (t=0; t<_num_trials; t++) {
+        // generate random QPSK sequence buried in noise
+        for (i=0; i<_n; i++)
+            s[i] = (randf() < 0.5f ? 1.0f : -1.0f) + (randf() < 0.5f ? 1.0f : -1.0f)*_Complex_I;
+        for (i=0; i<num_samples; i++) {
+            x[i] = M_SQRT1_2*(randnf() + _Complex_I*randnf());
+            if (i >= _n && i < 2*_n)
+                x[i] += gain * s[i-_n] * cexpf(_Complex_I*0.01f*i);
+        }
+
+        // run detector sample by sample, stopping at first detection
+        detector_cccf q = detector_cccf_create(s, _n, 0.5f, 0.05f);
+        int index_0 = -1;
+        float est_0[3] = {0,0,0};
+        for (i=0; i<num_samples; i++) {
+            if (detector_cccf_correlate(q, x[i], &est_0[0], &est_0[1], &est_0[2])) {
+                index_0 = i;
+                break;
+            }
+        }
+
+        // run detector in blocks, stopping at first detection
+        detector_cccf_reset(q);
+        int index_1 = -1;
+        unsigned int num_consumed = 0;
+        while (num_consumed < num_samples) {
+            unsigned int num_remaining = num_samples - num_consumed;
+            unsigned int num_block     = num_remaining < _block_len ? num_remaining : _block_len;
+            int detected = 0;
+            num_consumed += detector_cccf_correlate_block(q, &x[num_consumed], num_block,
+                                                          &detected, &tau_hat, &dphi_hat, &gamma_hat);
+            if (detected) {
+                index_1 = num_consumed - 1;
+                break;
+            }
+        }
+        detector_cccf_destroy(q);
+
+        num_detect_0 += index_0 >= 0;
+        num_detect_1 += index_1 >= 0;
+        if (index_0 != index_1) {
+            num_mismatch++;
+        } else if (index_0 >= 0) {
+            // identical detections must produce the same estimates
+            CONTEND_DELTA( tau_hat,   est_0[0], 1e-3f );
+            CONTEND_DELTA( dphi_hat,  est_0[1], 1e-4f );
+            CONTEND_DELTA( gamma_hat, est_0[2], 1e-4f );
+        }
+    }
+
+    if (liquid_autotest_verbose) {
+        printf("detector marginal [%3u/%4u]: detected %u / %u (sample), %u / %u (block), %u mismatched\n",
+                _n, _block_len, num_detect_0, _num_trials, num_detect_1, _num_trials, num_mismatch);
+    }
+
+    // operating point must actually be marginal
+    CONTEND_GREATER_THAN( num_detect_0, _num_trials/10 );
+    CONTEND_LESS_THAN   ( num_detect_0, _num_trials - _num_trials/10 );
+
+    // divergence between the two methods is bounded
+    CONTEND_LESS_THAN( num_mismatch, _num_trials/50 + 1 );
+}
+
+void autotest_detector_cccf_block_marginal_n256()  { detector_cccf_runtest_marginal( 256, 1000, 200); }
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+typedef struct {
+    unsigned char * payload;        // expected payload
+    unsigned int    payload_len;    // expected payload length
+    unsigned int    num_valid;      // number of valid, matching frames
+} dsssframesync_autotest_s;
+
+static int callback(unsigned char *  _header,
+                    int              _header_valid,
+                    unsigned char *  _payload,
+                    unsigned int     _payload_len,
+                    int              _payload_valid,
+                    framesyncstats_s _stats,
+                    void *           _userdata)
+{
+    dsssframesync_autotest_s * s = (dsssframesync_autotest_s*) _userdata;
+    if (_header_valid && _payload_valid && _payload_len == s->payload_len &&
+        memcmp(_payload, s->payload, _payload_len) == 0)
+    {
+        s->num_valid++;
+    }
+    return 0;
+}
+
+// 
+// AUTOTEST : recover several consecutive frames with the same objects
+//
+void autotest_dsssframesync()
+{
+    unsigned int num_frames  = 4;
+    unsigned int payload_len = 8;
+    unsigned int buf_len     = 256;
+    float        nstd        = 0.01f;
+    unsigned int i, n;
+
+    dsssframegenprops_s fgprops = {LIQUID_CRC_16, LIQUID_FEC_NONE, LIQUID_FEC_NONE};
+    dsssframegen fg = dsssframegen_create(&fgprops);
+
+    unsigned char payload[payload_len];
+    dsssframesync_autotest_s s = {payload, payload_len, 0};
+    dsssframesync fs = dsssframesync_create(callback, (void*)&s);
+
+    float complex buf[buf_len];
+    for (n=0; n<num_frames; n++) {
+        // assemble frame with new payload
+        for (i=0; i<payload_len; i++)
+            payload[i] = rand() & 0xff;
+        dsssframegen_assemble(fg, NULL, payload, payload_len);
+
+        // generate frame in blocks, add noise, and run through synchronizer
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = dsssframegen_write_samples(fg, buf, buf_len);
+            for (i=0; i<buf_len; i++)
+                buf[i] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+            dsssframesync_execute(fs, buf, buf_len);
+        }
+    }
+
+    // check that every frame was recovered
+    CONTEND_EQUALITY( s.num_valid, num_frames );
+
+    dsssframegen_destroy(fg);
+    dsssframesync_destroy(fs);
+}
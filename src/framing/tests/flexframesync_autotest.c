@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
@@ -89,3 +90,313 @@ void autotest_flexframesync()
     flexframesync_destroy(fs);
 }
 
+
+// callback for decoupled decoding test: record frame order and payload
+struct flexframesync_decode_threads_s {
+    unsigned int    num_frames;     // number of frames transmitted
+    unsigned int    payload_len;    // payload length (bytes)
+    unsigned char * payloads;       // transmitted payloads
+    unsigned int    num_received;   // number of callbacks invoked
+    unsigned int    num_in_order;   // number of frames received in order
+    unsigned int    num_valid;      // number of payloads recovered exactly
+    flexframesync   fs;             // query statistics from callback (optional)
+    unsigned int    num_stats;      // number of consistent statistics queries
+};
+
+static int flexframesync_decode_threads_callback(unsigned char *  _header,
+                                                 int              _header_valid,
+                                                 unsigned char *  _payload,
+                                                 unsigned int     _payload_len,
+                                                 int              _payload_valid,
+                                                 framesyncstats_s _stats,
+                                                 void *           _userdata)
+{
+    struct flexframesync_decode_threads_s * d = (struct flexframesync_decode_threads_s*) _userdata;
+    unsigned int id = _header[0];
+    if (d->fs != NULL) {
+        // statistics include the frame being delivered
+        framedatastats_s stats = flexframesync_get_framedatastats(d->fs);
+        if (stats.num_frames_detected == d->num_received + 1)
+            d->num_stats++;
+    }
+    if (_header_valid && id == d->num_received)
+        d->num_in_order++;
+    d->num_received++;
+    if (_header_valid && _payload_valid && id < d->num_frames &&
+        _payload_len == d->payload_len &&
+        memcmp(_payload, d->payloads + id*d->payload_len, d->payload_len) == 0)
+    {
+        d->num_valid++;
+    }
+    return 0;
+}
+
+// 
+// AUTOTEST : recover back-to-back frames with payloads decoded on
+//            worker threads; callbacks must fire in frame order, and
+//            may query the frame statistics without blocking
+//
+void flexframesync_decode_threads_test(unsigned int _num_threads,
+                                       int          _soft,
+                                       int          _query_stats)
+{
+    unsigned int i;
+    unsigned int num_frames  = 24;
+    unsigned int payload_len = 200;
+
+    // create flexframegen object
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = LIQUID_MODEM_QAM16;
+    fgprops.check       = LIQUID_CRC_32;
+    fgprops.fec0        = LIQUID_FEC_HAMMING128;
+    fgprops.fec1        = LIQUID_FEC_NONE;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // create flexframesync object with decoder threads
+    struct flexframesync_decode_threads_s d;
+    d.num_frames   = num_frames;
+    d.payload_len  = payload_len;
+    d.payloads     = (unsigned char*) malloc(num_frames*payload_len);
+    d.num_received = 0;
+    d.num_in_order = 0;
+    d.num_valid    = 0;
+    d.num_stats    = 0;
+    flexframesync fs = flexframesync_create(flexframesync_decode_threads_callback, (void*)&d);
+    d.fs           = _query_stats ? fs : NULL;
+    flexframesync_decode_payload_soft(fs, _soft);
+    flexframesync_set_decode_threads(fs, _num_threads);
+
+    for (i=0; i<num_frames*payload_len; i++)
+        d.payloads[i] = rand() & 0xff;
+
+    // generate frames back to back
+    unsigned char header[14] = {0};
+    float complex buf[256];
+    for (i=0; i<num_frames; i++) {
+        header[0] = i;
+        flexframegen_assemble(fg, header, d.payloads + i*payload_len, payload_len);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = flexframegen_write_samples(fg, buf, 256);
+            flexframesync_execute(fs, buf, 256);
+        }
+    }
+    // flush synchronizer with a few zero-valued samples
+    for (i=0; i<256; i++)
+        buf[i] = 0.0f;
+    for (i=0; i<4; i++)
+        flexframesync_execute(fs, buf, 256);
+
+    // wait for outstanding frames and check results
+    flexframesync_drain(fs);
+    framedatastats_s stats = flexframesync_get_framedatastats(fs);
+    if (liquid_autotest_verbose)
+        flexframesync_print(fs);
+
+    CONTEND_EQUALITY( d.num_received,             num_frames );
+    CONTEND_EQUALITY( d.num_in_order,             num_frames );
+    CONTEND_EQUALITY( d.num_valid,                num_frames );
+    CONTEND_EQUALITY( stats.num_frames_detected,  num_frames );
+    CONTEND_EQUALITY( stats.num_payloads_valid,   num_frames );
+    CONTEND_EQUALITY( stats.num_bytes_received,   num_frames*payload_len );
+    if (_query_stats)
+        CONTEND_EQUALITY( d.num_stats, num_frames );
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+    free(d.payloads);
+}
+
+void autotest_flexframesync_decode_threads_1()       { flexframesync_decode_threads_test(1, 0, 0); }
+void autotest_flexframesync_decode_threads_4()       { flexframesync_decode_threads_test(4, 0, 0); }
+void autotest_flexframesync_decode_threads_4_soft()  { flexframesync_decode_threads_test(4, 1, 0); }
+void autotest_flexframesync_decode_threads_0_stats() { flexframesync_decode_threads_test(0, 0, 1); }
+void autotest_flexframesync_decode_threads_1_stats() { flexframesync_decode_threads_test(1, 0, 1); }
+void autotest_flexframesync_decode_threads_4_stats() { flexframesync_decode_threads_test(4, 0, 1); }
+
+// 
+// AUTOTEST : per-stage profiling, with payloads decoded either on the
+//            calling thread or on a pool of decoder threads (in which
+//            case waiting for the pool is counted as decoding and
+//            callbacks run outside the profiled thread)
+//
+void flexframesync_profile_test(unsigned int _num_threads)
+{
+    unsigned int i;
+    unsigned int num_frames  = 8;
+    unsigned int payload_len = 200;
+
+    // create flexframegen object
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = LIQUID_MODEM_QPSK;
+    fgprops.check       = LIQUID_CRC_32;
+    fgprops.fec0        = LIQUID_FEC_HAMMING128;
+    fgprops.fec1        = LIQUID_FEC_NONE;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // create flexframesync object
+    struct flexframesync_decode_threads_s d;
+    d.num_frames   = num_frames;
+    d.payload_len  = payload_len;
+    d.payloads     = (unsigned char*) malloc(num_frames*payload_len);
+    d.fs           = NULL;
+    flexframesync fs = flexframesync_create(flexframesync_decode_threads_callback, (void*)&d);
+    flexframesync_set_decode_threads(fs, _num_threads);
+
+    for (i=0; i<num_frames*payload_len; i++)
+        d.payloads[i] = rand() & 0xff;
+
+    // generate frames back to back, followed by a few zero-valued samples
+    unsigned int buf_len = 0;
+    float complex * buf = NULL;
+    unsigned char header[14] = {0};
+    for (i=0; i<num_frames; i++) {
+        header[0] = i;
+        flexframegen_assemble(fg, header, d.payloads + i*payload_len, payload_len);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            buf = (float complex*) realloc(buf, (buf_len+256)*sizeof(float complex));
+            frame_complete = flexframegen_write_samples(fg, buf + buf_len, 256);
+            buf_len += 256;
+        }
+    }
+    buf = (float complex*) realloc(buf, (buf_len+1024)*sizeof(float complex));
+    for (i=0; i<1024; i++)
+        buf[buf_len++] = 0.0f;
+
+    // run all frames through synchronizer with profiling disabled (default),
+    // enabled, and disabled again after resetting the counters
+    frameprofile_s p;
+    unsigned int run;
+    for (run=0; run<3; run++) {
+        if (run == 1) flexframesync_profile_enable(fs);
+        if (run == 2) {
+            flexframesync_reset_profile(fs);
+            p = flexframesync_get_profile(fs);
+            for (i=0; i<LIQUID_FRAMEPROFILE_NUM_STAGES; i++)
+                CONTEND_EQUALITY( p.num_calls[i], 0 );
+            flexframesync_profile_disable(fs);
+        }
+
+        d.num_received = 0;
+        d.num_in_order = 0;
+        d.num_valid    = 0;
+        for (i=0; i<buf_len; i+=256)
+            flexframesync_execute(fs, buf + i, 256);
+        flexframesync_drain(fs);
+        CONTEND_EQUALITY( d.num_valid, num_frames );
+
+        p = flexframesync_get_profile(fs);
+        if (liquid_autotest_verbose && run == 1)
+            frameprofile_print(&p);
+        if (run != 1) {
+            // nothing is recorded while disabled
+            for (i=0; i<LIQUID_FRAMEPROFILE_NUM_STAGES; i++)
+                CONTEND_EQUALITY( p.num_calls[i], 0 );
+            continue;
+        }
+
+        CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_DETECT],   0 );
+        CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_PREAMBLE], 0 );
+        CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_HEADER],   0 );
+        CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_PAYLOAD],  0 );
+        if (_num_threads == 0) {
+            CONTEND_EQUALITY( p.num_calls[LIQUID_FRAMEPROFILE_DECODE],   num_frames );
+            CONTEND_EQUALITY( p.num_calls[LIQUID_FRAMEPROFILE_CALLBACK], num_frames );
+        } else {
+            // decoding is entered when acquiring a pooled frame after the
+            // header and again when submitting it after the payload
+            CONTEND_EQUALITY( p.num_calls[LIQUID_FRAMEPROFILE_DECODE],   2*num_frames );
+            CONTEND_EQUALITY( p.num_calls[LIQUID_FRAMEPROFILE_CALLBACK], 0 );
+        }
+    }
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+    free(d.payloads);
+    free(buf);
+}
+
+void autotest_flexframesync_profile()               { flexframesync_profile_test(0); }
+void autotest_flexframesync_profile_decode_threads() { flexframesync_profile_test(2); }
+
+// 
+// AUTOTEST : batch generation matches frames written one at a time,
+//            and all frames are recovered
+//
+void autotest_flexframegen_generate_batch()
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int num_frames = 12;
+    unsigned int gap        = 37;
+
+    // create frame generator
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = LIQUID_MODEM_QPSK;
+    fgprops.check       = LIQUID_CRC_32;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // initialize header and payloads with a few different lengths
+    unsigned char header[14] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+    unsigned char payloads[num_frames][120];
+    const unsigned char * payload_ptrs[num_frames];
+    unsigned int lens[num_frames];
+    for (i=0; i<num_frames; i++) {
+        for (j=0; j<120; j++)
+            payloads[i][j] = rand() & 0xff;
+        payload_ptrs[i] = payloads[i];
+        lens[i] = 20 + 25*(i % 4);
+    }
+
+    // generate frames one at a time for reference
+    unsigned int buf_len = 200000;
+    float complex * buf_ref   = (float complex*) malloc(buf_len*sizeof(float complex));
+    float complex * buf_batch = (float complex*) malloc(buf_len*sizeof(float complex));
+    unsigned int n = 0;
+    for (i=0; i<num_frames; i++) {
+        if (i > 0) {
+            memset(&buf_ref[n], 0x00, gap*sizeof(float complex));
+            n += gap;
+        }
+        flexframegen_assemble(fg, header, payload_ptrs[i], lens[i]);
+        unsigned int frame_len = flexframegen_getframelen(fg);
+        flexframegen_write_samples(fg, &buf_ref[n], frame_len);
+        n += frame_len;
+    }
+
+    // generate batch; results should be identical
+    unsigned int num_written = 0;
+    unsigned int num_batch = flexframegen_generate_batch(fg, header, payload_ptrs, lens,
+            num_frames, gap, buf_batch, buf_len, &num_written);
+    CONTEND_EQUALITY( num_batch,   num_frames );
+    CONTEND_EQUALITY( num_written, n );
+    CONTEND_EQUALITY( memcmp(buf_ref, buf_batch, n*sizeof(float complex)), 0 );
+
+    // batch should stop at first frame which does not fit
+    num_batch = flexframegen_generate_batch(fg, header, payload_ptrs, lens,
+            num_frames, gap, buf_batch, n-1, &num_written);
+    CONTEND_EQUALITY( num_batch, num_frames-1 );
+    CONTEND_LESS_THAN( num_written, n );
+
+    // run batch through frame synchronizer
+    flexframesync fs = flexframesync_create(NULL,NULL);
+    flexframesync_execute(fs, buf_ref, n);
+    float complex zeros[100] = {0};
+    flexframesync_execute(fs, zeros, 100);
+    framedatastats_s stats = flexframesync_get_framedatastats(fs);
+    CONTEND_EQUALITY( stats.num_frames_detected, num_frames );
+    CONTEND_EQUALITY( stats.num_headers_valid,   num_frames );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  num_frames );
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+    free(buf_ref);
+    free(buf_batch);
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// received frame record; false alarms at the end of a burst (invalid
+// headers) are counted separately
+struct flexframesyncbank_autotest_s {
+    unsigned int num_frames;        // number of valid headers received
+    unsigned int num_invalid;       // number of invalid headers received
+    unsigned int id[8];             // header[0] of each frame
+    int          payload_valid[8];  // payload valid flag of each frame
+};
+
+static int flexframesyncbank_autotest_callback(unsigned char *  _header,
+                                               int              _header_valid,
+                                               unsigned char *  _payload,
+                                               unsigned int     _payload_len,
+                                               int              _payload_valid,
+                                               framesyncstats_s _stats,
+                                               void *           _userdata)
+{
+    struct flexframesyncbank_autotest_s * r = (struct flexframesyncbank_autotest_s*) _userdata;
+    if (!_header_valid) {
+        r->num_invalid++;
+        return 0;
+    }
+    if (r->num_frames < 8) {
+        r->id           [r->num_frames] = _header[0];
+        r->payload_valid[r->num_frames] = _payload_valid;
+    }
+    r->num_frames++;
+    return 0;
+}
+
+// generate frame into buffer, returning number of samples written
+static unsigned int flexframesyncbank_autotest_gen(flexframegen    _fg,
+                                                   unsigned char   _id,
+                                                   unsigned int    _payload_len,
+                                                   float           _gain,
+                                                   float complex * _y)
+{
+    unsigned char header[14] = {_id};
+    unsigned char payload[_payload_len];
+    unsigned int i;
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+    flexframegen_assemble(_fg, header, payload, _payload_len);
+    unsigned int n = flexframegen_getframelen(_fg);
+    flexframegen_write_samples(_fg, _y, n);
+    for (i=0; i<n; i++)
+        _y[i] *= _gain;
+    return n;
+}
+
+// 
+// AUTOTEST : strong short frame arriving during the payload of a weak,
+//            long frame; flexframesync misses the second frame
+//
+void autotest_flexframesyncbank_overlap()
+{
+    unsigned int i;
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme = LIQUID_MODEM_QPSK;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // weak 800-byte frame with strong 40-byte frame starting in its payload
+    unsigned int num_samples = 16000;
+    float complex * y = (float complex*) calloc(num_samples, sizeof(float complex));
+    float complex * v = (float complex*) malloc(num_samples*sizeof(float complex));
+    unsigned int n0 = flexframesyncbank_autotest_gen(fg, 0, 800, 0.1f, v);
+    for (i=0; i<n0; i++) y[200+i] += v[i];
+    unsigned int n1 = flexframesyncbank_autotest_gen(fg, 1, 40, 1.0f, v);
+    for (i=0; i<n1; i++) y[4000+i] += v[i];
+    CONTEND_GREATER_THAN( 200+n0, 4000+n1 );
+    for (i=0; i<num_samples; i++)
+        y[i] += 0.001f*(randnf() + _Complex_I*randnf());
+
+    // run through frame receiver in blocks of irregular size
+    struct flexframesyncbank_autotest_s r;
+    memset(&r, 0, sizeof(r));
+    flexframesyncbank fb = flexframesyncbank_create(4, flexframesyncbank_autotest_callback, &r);
+    for (i=0; i<num_samples; i+=777)
+        flexframesyncbank_execute(fb, y+i, i+777 < num_samples ? 777 : num_samples-i);
+    if (liquid_autotest_verbose)
+        flexframesyncbank_print(fb);
+
+    // both headers are recovered; the strong frame completes (and is
+    // delivered) first and its payload is intact
+    CONTEND_EQUALITY( r.num_frames,       2 );
+    CONTEND_EQUALITY( r.id[0],            1 );
+    CONTEND_EQUALITY( r.payload_valid[0], 1 );
+    CONTEND_EQUALITY( r.id[1],            0 );
+    CONTEND_EQUALITY( flexframesyncbank_get_num_active(fb), 0 );
+
+    // single-state synchronizer only receives the first frame
+    memset(&r, 0, sizeof(r));
+    flexframesync fs = flexframesync_create(flexframesyncbank_autotest_callback, &r);
+    flexframesync_execute(fs, y, num_samples);
+    CONTEND_EQUALITY( r.num_frames, 1 );
+
+    flexframegen_destroy(fg);
+    flexframesyncbank_destroy(fb);
+    flexframesync_destroy(fs);
+    free(y);
+    free(v);
+}
+
+// 
+// AUTOTEST : back-to-back frames with no gap; every frame is recovered
+//            regardless of the number of threads
+//
+void flexframesyncbank_test_b2b(unsigned int _num_threads)
+{
+    unsigned int i;
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme = LIQUID_MODEM_QAM16;
+    fgprops.fec0       = LIQUID_FEC_HAMMING128;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    unsigned int num_frames = 6;
+    float complex * y = (float complex*) calloc(6000*num_frames, sizeof(float complex));
+    unsigned int n = 0;
+    for (i=0; i<num_frames; i++)
+        n += flexframesyncbank_autotest_gen(fg, i, 300, 1.0f, y+n);
+    n += 1000;
+
+    struct flexframesyncbank_autotest_s r;
+    memset(&r, 0, sizeof(r));
+    flexframesyncbank fb = flexframesyncbank_create(3, flexframesyncbank_autotest_callback, &r);
+    flexframesyncbank_set_num_threads(fb, _num_threads);
+    flexframesyncbank_execute(fb, y, n);
+    framedatastats_s stats = flexframesyncbank_get_framedatastats(fb);
+
+    CONTEND_EQUALITY( r.num_frames,               num_frames );
+    CONTEND_EQUALITY( stats.num_payloads_valid,   num_frames );
+    CONTEND_EQUALITY( stats.num_headers_valid,    num_frames );
+    CONTEND_EQUALITY( stats.num_bytes_received,   num_frames*300 );
+    for (i=0; i<num_frames; i++)
+        CONTEND_EQUALITY( r.id[i], i );
+
+    flexframegen_destroy(fg);
+    flexframesyncbank_destroy(fb);
+    free(y);
+}
+
+void autotest_flexframesyncbank_b2b_1() { flexframesyncbank_test_b2b(1); }
+void autotest_flexframesyncbank_b2b_3() { flexframesyncbank_test_b2b(3); }
@@ -90,3 +90,56 @@ void autotest_framesync64()
     framesync64_destroy(fs);
 }
 
+
+// 
+// AUTOTEST : per-stage profiling of framesync64
+//
+void autotest_framesync64_profile()
+{
+    unsigned int i;
+
+    framegen64 fg = framegen64_create();
+    int frame_recovered = 0;
+    framesync64 fs = framesync64_create(callback,(void*)&frame_recovered);
+
+    // generate the frame
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[64];
+    for (i=0; i<64; i++)
+        payload[i] = rand() & 0xff;
+    unsigned int frame_len = LIQUID_FRAME64_LEN;
+    float complex frame[frame_len];
+    framegen64_execute(fg, header, payload, frame);
+
+    // profiling is disabled by default: nothing is recorded
+    framesync64_execute(fs, frame, frame_len);
+    CONTEND_EQUALITY( frame_recovered, 1 );
+    frameprofile_s p = framesync64_get_profile(fs);
+    for (i=0; i<LIQUID_FRAMEPROFILE_NUM_STAGES; i++)
+        CONTEND_EQUALITY( p.num_calls[i], 0 );
+
+    // enable profiling and receive the frame again
+    frame_recovered = 0;
+    framesync64_profile_enable(fs);
+    framesync64_execute(fs, frame, frame_len);
+    CONTEND_EQUALITY( frame_recovered, 1 );
+    p = framesync64_get_profile(fs);
+    if (liquid_autotest_verbose)
+        frameprofile_print(&p);
+
+    CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_DETECT],   0 );
+    CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_PREAMBLE], 0 );
+    CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_PAYLOAD],  0 );
+    CONTEND_EQUALITY(     p.num_calls[LIQUID_FRAMEPROFILE_DECODE],   1 );
+    CONTEND_EQUALITY(     p.num_calls[LIQUID_FRAMEPROFILE_CALLBACK], 1 );
+
+    // reset clears counters
+    framesync64_reset_profile(fs);
+    p = framesync64_get_profile(fs);
+    for (i=0; i<LIQUID_FRAMEPROFILE_NUM_STAGES; i++)
+        CONTEND_EQUALITY( p.num_calls[i], 0 );
+
+    // destroy objects
+    framegen64_destroy(fg);
+    framesync64_destroy(fs);
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+typedef struct {
+    unsigned char * payload;        // expected payload
+    unsigned int    payload_len;    // expected payload length
+    unsigned int    num_valid;      // number of valid, matching frames
+} gmskframesync_autotest_s;
+
+static int callback(unsigned char *  _header,
+                    int              _header_valid,
+                    unsigned char *  _payload,
+                    unsigned int     _payload_len,
+                    int              _payload_valid,
+                    framesyncstats_s _stats,
+                    void *           _userdata)
+{
+    gmskframesync_autotest_s * s = (gmskframesync_autotest_s*) _userdata;
+    if (_header_valid && _payload_valid && _payload_len == s->payload_len &&
+        memcmp(_payload, s->payload, _payload_len) == 0)
+    {
+        s->num_valid++;
+    }
+    return 0;
+}
+
+// recover several frames separated by noise, with a carrier offset,
+// pushing samples through the synchronizer in blocks of _block_len
+void gmskframesync_autotest_block(unsigned int _block_len)
+{
+    unsigned int num_frames  = 4;
+    unsigned int payload_len = 16;
+    unsigned int gap_len     = 300;
+    float        dphi        = 0.01f;
+    float        nstd        = 0.03f;
+    unsigned int i, j, n = 0;
+
+    gmskframegen fg = gmskframegen_create();
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+    gmskframegen_assemble(fg, header, payload, payload_len,
+                          LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+
+    // generate stream of frames
+    unsigned int frame_len = gmskframegen_getframelen(fg);
+    unsigned int buf_len   = num_frames*(frame_len + gap_len) + gap_len;
+    float complex * buf = (float complex*) malloc(buf_len*sizeof(float complex));
+    for (j=0; j<num_frames; j++) {
+        for (i=0; i<gap_len; i++)
+            buf[n++] = 0.0f;
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = gmskframegen_write_samples(fg, &buf[n]);
+            n += 2;
+        }
+        gmskframegen_assemble(fg, header, payload, payload_len,
+                              LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+    }
+    for (i=n; i<buf_len; i++)
+        buf[i] = 0.0f;
+
+    // add carrier offset and noise
+    for (i=0; i<buf_len; i++) {
+        buf[i] *= cexpf(_Complex_I*dphi*i);
+        buf[i] += nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+    }
+
+    // run through synchronizer in blocks
+    gmskframesync_autotest_s s = {payload, payload_len, 0};
+    gmskframesync fs = gmskframesync_create(callback, (void*)&s);
+    for (i=0; i<buf_len; i+=_block_len)
+        gmskframesync_execute(fs, &buf[i], buf_len - i < _block_len ? buf_len - i : _block_len);
+
+    // check that every frame was recovered
+    if (liquid_autotest_verbose)
+        printf("  block length %4u : %u / %u frames\n", _block_len, s.num_valid, num_frames);
+    CONTEND_EQUALITY( s.num_valid, num_frames );
+
+    free(buf);
+    gmskframegen_destroy(fg);
+    gmskframesync_destroy(fs);
+}
+
+void autotest_gmskframesync_b1()    { gmskframesync_autotest_block(   1); }
+void autotest_gmskframesync_b13()   { gmskframesync_autotest_block(  13); }
+void autotest_gmskframesync_b256()  { gmskframesync_autotest_block( 256); }
+void autotest_gmskframesync_b4096() { gmskframesync_autotest_block(4096); }
+
+// 
+// AUTOTEST : per-stage profiling of gmskframesync
+//
+void autotest_gmskframesync_profile()
+{
+    unsigned int payload_len = 16;
+    unsigned int i;
+
+    gmskframegen fg = gmskframegen_create();
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+    gmskframegen_assemble(fg, header, payload, payload_len,
+                          LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+
+    // generate frame surrounded by a few zero-valued samples
+    unsigned int frame_len = gmskframegen_getframelen(fg);
+    unsigned int buf_len   = frame_len + 128;
+    float complex buf[buf_len];
+    unsigned int n = 0;
+    for (i=0; i<64; i++)
+        buf[n++] = 0.0f;
+    int frame_complete = 0;
+    while (!frame_complete) {
+        frame_complete = gmskframegen_write_samples(fg, &buf[n]);
+        n += 2;
+    }
+    for (i=n; i<buf_len; i++)
+        buf[i] = 0.0f;
+
+    // profiling is disabled by default: nothing is recorded
+    gmskframesync_autotest_s s = {payload, payload_len, 0};
+    gmskframesync fs = gmskframesync_create(callback, (void*)&s);
+    gmskframesync_execute(fs, buf, buf_len);
+    CONTEND_EQUALITY( s.num_valid, 1 );
+    frameprofile_s p = gmskframesync_get_profile(fs);
+    for (i=0; i<LIQUID_FRAMEPROFILE_NUM_STAGES; i++)
+        CONTEND_EQUALITY( p.num_calls[i], 0 );
+
+    // enable profiling and receive the frame again
+    gmskframesync_profile_enable(fs);
+    gmskframesync_execute(fs, buf, buf_len);
+    CONTEND_EQUALITY( s.num_valid, 2 );
+    p = gmskframesync_get_profile(fs);
+    if (liquid_autotest_verbose)
+        frameprofile_print(&p);
+
+    CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_DETECT],   0 );
+    CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_PREAMBLE], 0 );
+    CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_HEADER],   0 );
+    CONTEND_GREATER_THAN( p.num_calls[LIQUID_FRAMEPROFILE_PAYLOAD],  0 );
+    CONTEND_EQUALITY(     p.num_calls[LIQUID_FRAMEPROFILE_DECODE],   1 );
+    CONTEND_EQUALITY(     p.num_calls[LIQUID_FRAMEPROFILE_CALLBACK], 1 );
+
+    // reset clears counters
+    gmskframesync_reset_profile(fs);
+    p = gmskframesync_get_profile(fs);
+    for (i=0; i<LIQUID_FRAMEPROFILE_NUM_STAGES; i++)
+        CONTEND_EQUALITY( p.num_calls[i], 0 );
+
+    // disabling stops recording
+    gmskframesync_profile_disable(fs);
+    gmskframesync_execute(fs, buf, buf_len);
+    CONTEND_EQUALITY( s.num_valid, 3 );
+    p = gmskframesync_get_profile(fs);
+    for (i=0; i<LIQUID_FRAMEPROFILE_NUM_STAGES; i++)
+        CONTEND_EQUALITY( p.num_calls[i], 0 );
+
+    gmskframegen_destroy(fg);
+    gmskframesync_destroy(fs);
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// callback for decoupled decoding test: record frame order and payload
+struct ofdmflexframesync_decode_threads_s {
+    unsigned int      num_frames;   // number of frames transmitted
+    unsigned int      payload_len;  // payload length (bytes)
+    unsigned char *   payloads;     // transmitted payloads
+    unsigned int      num_received; // number of callbacks invoked
+    unsigned int      num_in_order; // number of frames received in order
+    unsigned int      num_valid;    // number of payloads recovered exactly
+    ofdmflexframesync fs;           // drain from within callback (optional)
+};
+
+static int ofdmflexframesync_decode_threads_callback(unsigned char *  _header,
+                                                     int              _header_valid,
+                                                     unsigned char *  _payload,
+                                                     unsigned int     _payload_len,
+                                                     int              _payload_valid,
+                                                     framesyncstats_s _stats,
+                                                     void *           _userdata)
+{
+    struct ofdmflexframesync_decode_threads_s * d = (struct ofdmflexframesync_decode_threads_s*) _userdata;
+
+    // must return immediately rather than wait for this frame
+    if (d->fs != NULL)
+        ofdmflexframesync_drain(d->fs);
+
+    unsigned int id = _header[0];
+    if (_header_valid && id == d->num_received)
+        d->num_in_order++;
+    d->num_received++;
+    if (_header_valid && _payload_valid && id < d->num_frames &&
+        _payload_len == d->payload_len &&
+        memcmp(_payload, d->payloads + id*d->payload_len, d->payload_len) == 0)
+    {
+        d->num_valid++;
+    }
+    return 0;
+}
+
+// 
+// AUTOTEST : recover back-to-back OFDM frames with payloads decoded on
+//            worker threads; callbacks must fire in frame order
+//
+void ofdmflexframesync_decode_threads_test(unsigned int _num_threads,
+                                           int          _soft,
+                                           int          _drain)
+{
+    unsigned int i;
+    unsigned int M           = 64;  // number of subcarriers
+    unsigned int cp_len      = 16;  // cyclic prefix length
+    unsigned int taper_len   = 4;   // taper length
+    unsigned int num_frames  = 16;
+    unsigned int payload_len = 120;
+
+    // create frame generator
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme = LIQUID_MODEM_QPSK;
+    fgprops.check      = LIQUID_CRC_32;
+    fgprops.fec0       = LIQUID_FEC_HAMMING128;
+    fgprops.fec1       = LIQUID_FEC_NONE;
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, NULL, &fgprops);
+
+    // create frame synchronizer with decoder threads
+    struct ofdmflexframesync_decode_threads_s d;
+    d.num_frames   = num_frames;
+    d.payload_len  = payload_len;
+    d.payloads     = (unsigned char*) malloc(num_frames*payload_len);
+    d.num_received = 0;
+    d.num_in_order = 0;
+    d.num_valid    = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, NULL,
+                                                    ofdmflexframesync_decode_threads_callback,
+                                                    (void*)&d);
+    d.fs = _drain ? fs : NULL;
+    ofdmflexframesync_decode_payload_soft(fs, _soft);
+    ofdmflexframesync_set_decode_threads(fs, _num_threads);
+
+    for (i=0; i<num_frames*payload_len; i++)
+        d.payloads[i] = rand() & 0xff;
+
+    // generate frames back to back
+    unsigned char header[8] = {0};
+    unsigned int  buf_len   = M + cp_len;
+    float complex buf[buf_len];
+    for (i=0; i<num_frames; i++) {
+        header[0] = i;
+        ofdmflexframegen_assemble(fg, header, d.payloads + i*payload_len, payload_len);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = ofdmflexframegen_write(fg, buf, buf_len);
+            ofdmflexframesync_execute(fs, buf, buf_len);
+        }
+    }
+
+    // flush synchronizer with a few zero-valued samples
+    for (i=0; i<buf_len; i++)
+        buf[i] = 0.0f;
+    for (i=0; i<4; i++)
+        ofdmflexframesync_execute(fs, buf, buf_len);
+
+    // wait for outstanding frames and check results
+    ofdmflexframesync_drain(fs);
+    if (liquid_autotest_verbose) {
+        printf("  threads: %u, soft: %d, received %u / %u (%u in order, %u valid)\n",
+                _num_threads, _soft, d.num_received, num_frames, d.num_in_order, d.num_valid);
+    }
+    CONTEND_EQUALITY( d.num_received, num_frames );
+    CONTEND_EQUALITY( d.num_in_order, num_frames );
+    CONTEND_EQUALITY( d.num_valid,    num_frames );
+
+    // destroy objects
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+    free(d.payloads);
+}
+
+void autotest_ofdmflexframesync_decode_threads_0()       { ofdmflexframesync_decode_threads_test(0, 0, 0); }
+void autotest_ofdmflexframesync_decode_threads_1()       { ofdmflexframesync_decode_threads_test(1, 0, 0); }
+void autotest_ofdmflexframesync_decode_threads_4()       { ofdmflexframesync_decode_threads_test(4, 0, 0); }
+void autotest_ofdmflexframesync_decode_threads_4_soft()  { ofdmflexframesync_decode_threads_test(4, 1, 0); }
+void autotest_ofdmflexframesync_decode_threads_4_drain() { ofdmflexframesync_decode_threads_test(4, 0, 1); }
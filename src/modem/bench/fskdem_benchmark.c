@@ -101,3 +101,8 @@ void benchmark_fskdem_misc_M256    FSKDEM_BENCH_API( 8,  500, 0.3721451)
 void benchmark_fskdem_misc_M512    FSKDEM_BENCH_API( 9, 1000, 0.3721451)
 void benchmark_fskdem_misc_M1024   FSKDEM_BENCH_API(10, 2000, 0.3721451)
 
+
+// BENCHMARKS: low-order FSK with many samples/symbol
+void benchmark_fskdem_long_M2      FSKDEM_BENCH_API( 1, 1024, 0.25f    )
+void benchmark_fskdem_long_M4      FSKDEM_BENCH_API( 2,  256, 0.3721451)
+void benchmark_fskdem_long_M16     FSKDEM_BENCH_API( 4, 2048, 0.25f    )
@@ -33,10 +33,25 @@
 
 #define DEBUG_FSKDEM 0
 
+// relative cost of FFT (per sample, per radix) to a single complex
+// multiply-accumulate in a dot product; used to decide how many bins
+// are evaluated directly before running the full transform
+#define FSKDEM_FFT_COST (1.5f)
+
 // 
 // internal methods
 //
 
+// estimate number of bins which can be evaluated directly (each a dot
+// product of length _k) for less than the cost of a _K-point FFT
+unsigned int fskdem_max_bins(unsigned int _k,
+                             unsigned int _K);
+
+// compute FFT bin for current symbol, evaluating it directly if the
+// full transform has not been computed
+float complex fskdem_get_bin(fskdem       _q,
+                             unsigned int _index);
+
 // fskdem
 struct fskdem_s {
     // common
@@ -53,6 +68,14 @@ struct fskdem_s {
     FFT_PLAN        fft;        // FFT object
     unsigned int *  demod_map;  // demodulation map
 
+    // direct evaluation of individual bins (low-order FSK, large K)
+    unsigned int    max_bins;   // bins evaluated directly per symbol before running FFT
+    dotprod_cccf *  dp;         // DFT row for each bin, created when needed [size: K x 1]
+    unsigned int *  bin_symbol; // symbol counter when bin was last evaluated [size: K x 1]
+    unsigned int    num_bins;   // number of bins evaluated for current symbol
+    unsigned int    symbol_counter; // number of symbols demodulated
+    int             fft_valid;  // full transform computed for current symbol?
+
     // state variables
     unsigned int    s_demod;    // demodulated symbol (used for frequency error)
 };
@@ -145,6 +168,16 @@ fskdem fskdem_create(unsigned int _m,
     q->buf_freq = (float complex*) malloc(q->K * sizeof(float complex));
     q->fft = FFT_CREATE_PLAN(q->K, q->buf_time, q->buf_freq, FFT_DIR_FORWARD, 0);
 
+    // evaluate tone bins directly when cheaper than the full transform
+    q->max_bins   = fskdem_max_bins(q->k, q->K);
+    q->dp         = (dotprod_cccf *) malloc(q->K * sizeof(dotprod_cccf));
+    q->bin_symbol = (unsigned int *) malloc(q->K * sizeof(unsigned int));
+    for (i=0; i<q->K; i++) {
+        q->dp[i]         = NULL;
+        q->bin_symbol[i] = 0;
+    }
+    q->symbol_counter = 0;
+
     // reset modem object
     fskdem_reset(q);
 
@@ -161,6 +194,15 @@ void fskdem_destroy(fskdem _q)
     free(_q->buf_freq);
     FFT_DESTROY_PLAN(_q->fft);
 
+    // destroy direct evaluation objects
+    unsigned int i;
+    for (i=0; i<_q->K; i++) {
+        if (_q->dp[i] != NULL)
+            dotprod_cccf_destroy(_q->dp[i]);
+    }
+    free(_q->dp);
+    free(_q->bin_symbol);
+
     // free main object memory
     free(_q);
 }
@@ -172,6 +214,8 @@ void fskdem_print(fskdem _q)
     printf("    bits/symbol     :   %u\n", _q->m);
     printf("    samples/symbol  :   %u\n", _q->k);
     printf("    bandwidth       :   %8.5f\n", _q->bandwidth);
+    printf("    fft size        :   %u (%s)\n", _q->K,
+            _q->max_bins < _q->M ? "full transform" : "direct tone evaluation");
 }
 
 // reset state
@@ -184,8 +228,10 @@ void fskdem_reset(fskdem _q)
         _q->buf_freq[i] = 0.0f;
     }
 
-    // clear state variables
-    _q->s_demod = 0;
+    // clear state variables; zeroed frequency buffer is valid
+    _q->s_demod   = 0;
+    _q->num_bins  = 0;
+    _q->fft_valid = 1;
 }
 
 // demodulate symbol, assuming perfect symbol timing
@@ -197,16 +243,28 @@ unsigned int fskdem_demodulate(fskdem          _q,
     // copy input to internal time buffer
     memmove(_q->buf_time, _y, _q->k*sizeof(float complex));
 
-    // compute transform, storing result in 'buf_freq'
-    FFT_EXECUTE(_q->fft);
+    // compute transform, storing result in 'buf_freq', unless the tone
+    // bins are cheaper to evaluate directly
+    if (++_q->symbol_counter == 0) {
+        // counter wrapped around; invalidate all bins
+        memset(_q->bin_symbol, 0x00, _q->K*sizeof(unsigned int));
+        _q->symbol_counter = 1;
+    }
+    _q->num_bins  = 0;
+    _q->fft_valid = 0;
+    if (_q->max_bins < _q->M) {
+        FFT_EXECUTE(_q->fft);
+        _q->fft_valid = 1;
+    }
 
     // find maximum by looking at particular bins
     float        vmax  = 0;
     unsigned int s     = 0;
 
-    // run search
+    // run search (comparing squared magnitudes)
     for (s=0; s<_q->M; s++) {
-        float v = cabsf( _q->buf_freq[_q->demod_map[s]] );
+        float complex r = fskdem_get_bin(_q, _q->demod_map[s]);
+        float v = crealf(r)*crealf(r) + cimagf(r)*cimagf(r);
         if (s==0 || v > vmax) {
             // save optimal output symbol
             _q->s_demod = s;
@@ -227,9 +285,9 @@ float fskdem_get_frequency_error(fskdem _q)
     //unsigned int index = _q->buf_freq[ _q->s_demod ];
 
     // extract peak value of previous, post FFT index
-    float vm = cabsf(_q->buf_freq[(_q->s_demod+_q->K-1)%_q->K]);  // previous
-    float v0 = cabsf(_q->buf_freq[ _q->s_demod               ]);  // peak
-    float vp = cabsf(_q->buf_freq[(_q->s_demod+      1)%_q->K]);  // post
+    float vm = cabsf(fskdem_get_bin(_q, (_q->s_demod+_q->K-1)%_q->K));  // previous
+    float v0 = cabsf(fskdem_get_bin(_q,  _q->s_demod               ));  // peak
+    float vp = cabsf(fskdem_get_bin(_q, (_q->s_demod+      1)%_q->K));  // post
 
     // compute derivative
     // TODO: compensate for bin spacing
@@ -256,7 +314,7 @@ float fskdem_get_symbol_energy(fskdem       _q,
     unsigned int index = _q->demod_map[_s];
 
     // compute energy around FFT bin
-    float complex v = _q->buf_freq[index];
+    float complex v = fskdem_get_bin(_q, index);
     float energy = crealf(v)*crealf(v) + cimagf(v)*cimagf(v);
     int i;
     for (i=0; i<_range; i++) {
@@ -264,8 +322,8 @@ float fskdem_get_symbol_energy(fskdem       _q,
         unsigned int i0 = (index         + i) % _q->K;
         unsigned int i1 = (index + _q->K - i) % _q->K;
 
-        float complex v0 = _q->buf_freq[i0];
-        float complex v1 = _q->buf_freq[i1];
+        float complex v0 = fskdem_get_bin(_q, i0);
+        float complex v1 = fskdem_get_bin(_q, i1);
 
         energy += crealf(v0)*crealf(v0) + cimagf(v0)*cimagf(v0);
         energy += crealf(v1)*crealf(v1) + cimagf(v1)*cimagf(v1);
@@ -274,3 +332,56 @@ float fskdem_get_symbol_energy(fskdem       _q,
     return energy;
 }
 
+// estimate number of bins which can be evaluated directly (each a dot
+// product of length _k) for less than the cost of a _K-point FFT
+unsigned int fskdem_max_bins(unsigned int _k,
+                             unsigned int _K)
+{
+    // mixed-radix transform cost grows with the sum of the prime factors;
+    // large prime factors are computed with Rader's algorithm whose cost
+    // grows roughly logarithmically
+    unsigned int factors[LIQUID_MAX_FACTORS];
+    unsigned int num_factors;
+    liquid_factor(_K, factors, &num_factors);
+    unsigned int i;
+    float radix_sum = 0.0f;
+    for (i=0; i<num_factors; i++)
+        radix_sum += factors[i] <= 16 ? (float)factors[i] : 16.0f*log2f((float)factors[i]);
+
+    return (unsigned int) (FSKDEM_FFT_COST * (float)(_K) * radix_sum / (float)(_k));
+}
+
+// compute FFT bin for current symbol, evaluating it directly if the
+// full transform has not been computed
+float complex fskdem_get_bin(fskdem       _q,
+                             unsigned int _index)
+{
+    // full transform or bin already computed for this symbol
+    if (_q->fft_valid || _q->bin_symbol[_index] == _q->symbol_counter)
+        return _q->buf_freq[_index];
+
+    // too many bins requested; run full transform instead
+    if (_q->num_bins == _q->max_bins) {
+        FFT_EXECUTE(_q->fft);
+        _q->fft_valid = 1;
+        return _q->buf_freq[_index];
+    }
+
+    // create DFT row for this bin if necessary (input is zero-padded
+    // from k to K samples, so only the first k terms are needed)
+    if (_q->dp[_index] == NULL) {
+        float complex h[_q->k];
+        unsigned int n;
+        for (n=0; n<_q->k; n++) {
+            float theta = 2*M_PI*(float)((_index*n) % _q->K) / (float)(_q->K);
+            h[n] = cexpf(-_Complex_I*theta);
+        }
+        _q->dp[_index] = dotprod_cccf_create(h, _q->k);
+    }
+
+    // evaluate bin
+    dotprod_cccf_execute(_q->dp[_index], _q->buf_time, &_q->buf_freq[_index]);
+    _q->bin_symbol[_index] = _q->symbol_counter;
+    _q->num_bins++;
+    return _q->buf_freq[_index];
+}
@@ -83,3 +83,54 @@ void autotest_fskmodem_misc_M256()  { fskmodem_test_mod_demod( 8,  500, 0.372145
 void autotest_fskmodem_misc_M512()  { fskmodem_test_mod_demod( 9, 1000, 0.3721451); }
 void autotest_fskmodem_misc_M1024() { fskmodem_test_mod_demod(10, 2000, 0.3721451); }
 
+
+// AUTOTESTS: low-order FSK with many samples/symbol (tone bins evaluated directly)
+void autotest_fskmodem_long_M2()    { fskmodem_test_mod_demod( 1, 1024, 0.25f    ); }
+void autotest_fskmodem_long_M4()    { fskmodem_test_mod_demod( 2,  256, 0.3721451); }
+void autotest_fskmodem_long_M16()   { fskmodem_test_mod_demod( 4, 2048, 0.25f    ); }
+
+// Help function to keep code base small: check symbol energies of noisy
+// received symbols
+void fskmodem_test_symbol_energy(unsigned int _m,
+                                 unsigned int _k,
+                                 float        _bandwidth)
+{
+    fskmod mod = fskmod_create(_m,_k,_bandwidth);
+    fskdem dem = fskdem_create(_m,_k,_bandwidth);
+
+    unsigned int M = 1 << _m;   // constellation size
+    unsigned int range = 2;     // bins either side of tone
+    float complex buf[_k];
+    unsigned int i, j, s;
+
+    for (s=0; s<M; s++) {
+        // modulate symbol, add a small amount of noise
+        fskmod_modulate(mod, s, buf);
+        for (i=0; i<_k; i++)
+            buf[i] += 0.1f*(randnf() + _Complex_I*randnf());
+
+        // demodulate
+        unsigned int sym_out = fskdem_demodulate(dem, buf);
+        CONTEND_EQUALITY(sym_out, s);
+
+        // energy of transmitted tone should exceed that of any other
+        float e_tx = fskdem_get_symbol_energy(dem, s, range);
+        for (j=0; j<M; j++) {
+            if (j != s)
+                CONTEND_GREATER_THAN(e_tx, fskdem_get_symbol_energy(dem, j, range));
+        }
+
+        // total energy near transmitted tone is bounded by Parseval:
+        // sum over all bins of |X|^2 = K sum |x|^2 >= k sum |x|^2
+        float e_x = 0.0f;
+        for (i=0; i<_k; i++)
+            e_x += crealf(buf[i])*crealf(buf[i]) + cimagf(buf[i])*cimagf(buf[i]);
+        CONTEND_GREATER_THAN(e_tx, 0.5f*_k*e_x);
+    }
+
+    fskmod_destroy(mod);
+    fskdem_destroy(dem);
+}
+void autotest_fskmodem_energy_M2()  { fskmodem_test_symbol_energy( 1, 512, 0.25f    ); }
+void autotest_fskmodem_energy_M16() { fskmodem_test_symbol_energy( 4,  64, 0.3721451); }
+void autotest_fskmodem_energy_M64() { fskmodem_test_symbol_energy( 6, 512, 0.25f    ); }
@@ -311,28 +311,22 @@ void NCO(_mix_block_down)(NCO() _q,
                           unsigned int _n)
 {
     unsigned int i;
-    // FIXME: this method should be more efficient but is causing occasional
-    //        errors so instead favor slower but more reliable algorithm
-#if 0
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(-theta) + _Complex_I*sin(-theta)]
-        _y[i] = _x[i] * liquid_cexpjf(-theta);
-        
-        theta += d_theta;
-    }
-
-    NCO(_set_phase)(_q, theta);
-#else
+    // keep phase in a register and look up the table directly; the
+    // product is evaluated in double precision just as in NCO(_mix_down)
+    // (where conj() promotes the phasor) so results are bit-exact
+    uint32_t theta   = _q->theta;
+    uint32_t d_theta = _q->d_theta;
     for (i=0; i<_n; i++) {
-        // mix single sample down
-        NCO(_mix_down)(_q, _x[i], &_y[i]);
+        unsigned int index = ((theta + (1<<21)) >> 22) & 0x3ff;
+        double vsin = _q->sintab[(index    )        ];
+        double vcos = _q->sintab[(index+256) & 0x3ff];
+        double xr   = crealf(_x[i]);
+        double xi   = cimagf(_x[i]);
+        _y[i] = (T)(xr*vcos + xi*vsin) + _Complex_I*(T)(xi*vcos - xr*vsin);
 
-        // step NCO phase
-        NCO(_step)(_q);
+        theta += d_theta;
     }
-#endif
+    _q->theta = theta;
 }
 
 //
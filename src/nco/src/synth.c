@@ -31,11 +31,18 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+#include <xmmintrin.h>
+#endif
+
 #define SYNTH_PLL_BANDWIDTH_DEFAULT (0.1)
 #define SYNTH_PLL_GAIN_DEFAULT (1000)
 
 #define LIQUID_DEBUG_SYNTH (0)
 
+// maximum number of symbols despread in a single pass
+#define SYNTH_DESPREAD_BLOCK_LEN (16)
+
 struct SYNTH(_s) {
     T            theta;   // phase
     T            d_theta; // frequency
@@ -48,6 +55,24 @@ struct SYNTH(_s) {
     TC current;
     TC next_half;
 
+    // conjugated early (previous half), punctual, and late (next half)
+    // chips and their magnitudes for each table index [size: length x 1]
+    TC *         ref_tab[3];
+    T *          ref_abs[3];
+
+    // references gathered along synth trajectory for a block of symbols
+    // [size: SYNTH_DESPREAD_BLOCK_LEN*length x 1]
+    TC *         ref_buf[3];
+    T *          abs_buf[3];
+    T *          x_abs;         // input magnitudes
+
+    // conjugated table (and magnitudes) repeated with wrap-around, split
+    // into real/imaginary parts for correlating against many code phases
+    // at once [size: 2*length + 3 x 1]
+    T *          phase_re;
+    T *          phase_im;
+    T *          phase_abs;
+
     // phase-locked loop
     T alpha;
     T beta;
@@ -61,6 +86,35 @@ SYNTH() SYNTH(_create)(const TC * _table, unsigned int _length)
     q->tab    = (TC *)malloc(q->length * sizeof(TC));
     memcpy(q->tab, _table, q->length * sizeof(TC));
 
+    // compute despreading references
+    unsigned int i, j;
+    unsigned int buf_len = SYNTH_DESPREAD_BLOCK_LEN * q->length;
+    for (j=0; j<3; j++) {
+        q->ref_tab[j] = (TC *)malloc(q->length * sizeof(TC));
+        q->ref_abs[j] = (T  *)malloc(q->length * sizeof(T));
+        q->ref_buf[j] = (TC *)malloc(buf_len * sizeof(TC));
+        q->abs_buf[j] = (T  *)malloc(buf_len * sizeof(T));
+    }
+    q->x_abs = (T *)malloc(buf_len * sizeof(T));
+    for (i=0; i<q->length; i++) {
+        TC prev = q->tab[(i + q->length - 1) % q->length];
+        TC next = q->tab[(i + 1) % q->length];
+        q->ref_tab[0][i] = conjf((q->tab[i] + prev) / 2);
+        q->ref_tab[1][i] = conjf( q->tab[i]            );
+        q->ref_tab[2][i] = conjf((q->tab[i] + next) / 2);
+        for (j=0; j<3; j++)
+            q->ref_abs[j][i] = cabsf(q->ref_tab[j][i]);
+    }
+    unsigned int phase_len = 2*q->length + 3;
+    q->phase_re  = (T *)malloc(phase_len * sizeof(T));
+    q->phase_im  = (T *)malloc(phase_len * sizeof(T));
+    q->phase_abs = (T *)malloc(phase_len * sizeof(T));
+    for (i=0; i<phase_len; i++) {
+        q->phase_re[i]  = crealf(q->ref_tab[1][i % q->length]);
+        q->phase_im[i]  = cimagf(q->ref_tab[1][i % q->length]);
+        q->phase_abs[i] = q->ref_abs[1][i % q->length];
+    }
+
     // set default pll bandwidth
     SYNTH(_pll_set_bandwidth)(q, SYNTH_PLL_BANDWIDTH_DEFAULT);
 
@@ -79,6 +133,17 @@ void SYNTH(_destroy)(SYNTH() _q)
     }
 
     free(_q->tab);
+    unsigned int j;
+    for (j=0; j<3; j++) {
+        free(_q->ref_tab[j]);
+        free(_q->ref_abs[j]);
+        free(_q->ref_buf[j]);
+        free(_q->abs_buf[j]);
+    }
+    free(_q->x_abs);
+    free(_q->phase_re);
+    free(_q->phase_im);
+    free(_q->phase_abs);
     free(_q);
 }
 
@@ -238,47 +303,80 @@ void SYNTH(_spread)(SYNTH() _q, TC _x, TC * _y)
 
 void SYNTH(_despread)(SYNTH() _q, TC * _x, TC * _y)
 {
-    TC despread = 0;
-    T  sum      = 0;
-    unsigned int i;
-    for (i = 0; i < _q->length; i++) {
-        TC temp;
-        SYNTH(_mix_down)(_q, _x[i], &temp);
-
-        despread += temp;
-        sum += cabsf(_x[i]) * cabsf(_q->current);
-
-        SYNTH(_step)(_q);
-    }
-    *_y = despread / sum;
+    SYNTH(_despread_symbols)(_q, _x, 1, NULL, _y, NULL);
 }
 
 void SYNTH(_despread_triple)(SYNTH() _q, TC * _x, TC * _early, TC * _punctual, TC * _late)
 {
-    TC despread_early    = 0;
-    TC despread_punctual = 0;
-    TC despread_late     = 0;
-
-    T sum_early    = 0;
-    T sum_punctual = 0;
-    T sum_late     = 0;
+    SYNTH(_despread_symbols)(_q, _x, 1, _early, _punctual, _late);
+}
 
+void SYNTH(_despread_block)(SYNTH() _q, TC * _x, unsigned int _n, TC * _y)
+{
     unsigned int i;
-    for (i = 0; i < _q->length; i++) {
-        despread_early += _x[i] * conjf(_q->prev_half);
-        despread_punctual += _x[i] * conjf(_q->current);
-        despread_late += _x[i] * conjf(_q->next_half);
-
-        sum_early += cabsf(_x[i]) * cabsf(_q->prev_half);
-        sum_punctual += cabsf(_x[i]) * cabsf(_q->current);
-        sum_late += cabsf(_x[i]) * cabsf(_q->next_half);
+    for (i = 0; i < _n; i += SYNTH_DESPREAD_BLOCK_LEN) {
+        unsigned int n = _n - i < SYNTH_DESPREAD_BLOCK_LEN ? _n - i : SYNTH_DESPREAD_BLOCK_LEN;
+        SYNTH(_despread_symbols)(_q, _x + i*_q->length, n, NULL, _y + i, NULL);
+    }
+}
 
-        SYNTH(_step)(_q);
+void SYNTH(_despread_triple_block)(SYNTH()      _q,
+                                   TC *         _x,
+                                   unsigned int _n,
+                                   TC *         _early,
+                                   TC *         _punctual,
+                                   TC *         _late)
+{
+    unsigned int i;
+    for (i = 0; i < _n; i += SYNTH_DESPREAD_BLOCK_LEN) {
+        unsigned int n = _n - i < SYNTH_DESPREAD_BLOCK_LEN ? _n - i : SYNTH_DESPREAD_BLOCK_LEN;
+        SYNTH(_despread_symbols)(_q, _x + i*_q->length, n,
+                                 _early + i, _punctual + i, _late + i);
     }
+}
 
-    *_early    = despread_early / sum_early;
-    *_punctual = despread_punctual / sum_punctual;
-    *_late     = despread_late / sum_late;
+void SYNTH(_correlate_phases)(SYNTH() _q, TC * _x, TC * _y)
+{
+    unsigned int n = _q->length;
+    SYNTH(_compute_abs)(_x, n, _q->x_abs);
+
+    unsigned int p, i;
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+    // four code phases at a time; each input sample is multiplied by four
+    // consecutive entries of the repeated table
+    float * x = (float *)_x;
+    for (p = 0; p < n; p += 4) {
+        __m128 acc_re  = _mm_setzero_ps();
+        __m128 acc_im  = _mm_setzero_ps();
+        __m128 acc_abs = _mm_setzero_ps();
+        for (i = 0; i < n; i++) {
+            __m128 xr = _mm_set1_ps(x[2*i  ]);
+            __m128 xi = _mm_set1_ps(x[2*i+1]);
+            __m128 hr = _mm_loadu_ps(_q->phase_re  + p + i);
+            __m128 hi = _mm_loadu_ps(_q->phase_im  + p + i);
+            __m128 ha = _mm_loadu_ps(_q->phase_abs + p + i);
+            acc_re  = _mm_add_ps(acc_re, _mm_sub_ps(_mm_mul_ps(xr, hr), _mm_mul_ps(xi, hi)));
+            acc_im  = _mm_add_ps(acc_im, _mm_add_ps(_mm_mul_ps(xr, hi), _mm_mul_ps(xi, hr)));
+            acc_abs = _mm_add_ps(acc_abs, _mm_mul_ps(_mm_set1_ps(_q->x_abs[i]), ha));
+        }
+        float vr[4], vi[4], va[4];
+        _mm_storeu_ps(vr, acc_re);
+        _mm_storeu_ps(vi, acc_im);
+        _mm_storeu_ps(va, acc_abs);
+        for (i = 0; i < 4 && p + i < n; i++)
+            _y[p + i] = (vr[i] + _Complex_I*vi[i]) / va[i];
+    }
+#else
+    for (p = 0; p < n; p++) {
+        TC v   = 0;
+        T  sum = 0;
+        for (i = 0; i < n; i++) {
+            v   += _x[i] * (_q->phase_re[p + i] + _Complex_I*_q->phase_im[p + i]);
+            sum += _q->x_abs[i] * _q->phase_abs[p + i];
+        }
+        _y[p] = v / sum;
+    }
+#endif
 }
 
 //
@@ -303,13 +401,23 @@ void SYNTH(_constrain_phase)(SYNTH() _q)
         _q->theta += 2 * M_PI;
 }
 
-void SYNTH(_compute_synth)(SYNTH() _q)
+// compute table index from phase
+unsigned int SYNTH(_compute_index)(SYNTH() _q)
 {
     // assume phase is constrained to be in (-pi,pi)
+    float        v     = _q->theta * (float)_q->length / (2 * M_PI) + 2.f * (float)_q->length;
+    unsigned int index = (unsigned int)(v + 0.5f);
+
+    // typically within [L, 3L), so avoid integer division
+    while (index >= _q->length)
+        index -= _q->length;
+    return index;
+}
 
+void SYNTH(_compute_synth)(SYNTH() _q)
+{
     // compute index
-    float index = _q->theta * (float)_q->length / (2 * M_PI) + 2.f * (float)_q->length;
-    _q->index   = ((unsigned int)(index + 0.5f)) % _q->length;
+    _q->index = SYNTH(_compute_index)(_q);
     assert(_q->index < _q->length);
 
     unsigned int prev_index = (_q->index + _q->length - 1) % _q->length;
@@ -322,3 +430,134 @@ void SYNTH(_compute_synth)(SYNTH() _q)
     _q->prev_half = (_q->current + prev) / 2;
     _q->next_half = (_q->current + next) / 2;
 }
+
+// despread up to SYNTH_DESPREAD_BLOCK_LEN consecutive symbols, stepping
+// synth for each chip: references for every chip in the block are
+// gathered in a single pass along the synth trajectory and magnitudes
+// are computed over the whole block before correlating each symbol
+// against its segment; early and late correlations are computed only
+// when requested (non-NULL)
+void SYNTH(_despread_symbols)(SYNTH()      _q,
+                              TC *         _x,
+                              unsigned int _n,
+                              TC *         _early,
+                              TC *         _punctual,
+                              TC *         _late)
+{
+    unsigned int L      = _q->length;
+    unsigned int n      = _n * L;
+    int          triple = (_early != NULL) || (_late != NULL);
+    assert(_n <= SYNTH_DESPREAD_BLOCK_LEN);
+
+    // gather references along synth trajectory, stepping phase only
+    unsigned int i, j;
+    for (i = 0; i < n; i++) {
+        unsigned int k = _q->index;
+        _q->ref_buf[1][i] = _q->ref_tab[1][k];
+        _q->abs_buf[1][i] = _q->ref_abs[1][k];
+        if (triple) {
+            _q->ref_buf[0][i] = _q->ref_tab[0][k];
+            _q->abs_buf[0][i] = _q->ref_abs[0][k];
+            _q->ref_buf[2][i] = _q->ref_tab[2][k];
+            _q->abs_buf[2][i] = _q->ref_abs[2][k];
+        }
+
+        _q->theta += _q->d_theta;
+        SYNTH(_constrain_phase)(_q);
+        _q->index = SYNTH(_compute_index)(_q);
+    }
+
+    // update outputs for final phase
+    SYNTH(_compute_synth)(_q);
+
+    // correlate each symbol against its references
+    SYNTH(_compute_abs)(_x, n, _q->x_abs);
+    TC * y[3] = {_early, _punctual, _late};
+    for (j = 0; j < 3; j++) {
+        if (y[j] == NULL)
+            continue;
+        for (i = 0; i < _n; i++) {
+            TC v;
+            T  sum;
+            SYNTH(_correlate)(_x + i*L, _q->x_abs + i*L,
+                              _q->ref_buf[j] + i*L, _q->abs_buf[j] + i*L,
+                              L, &v, &sum);
+            y[j][i] = v / sum;
+        }
+    }
+}
+
+// compute magnitude of each input sample
+void SYNTH(_compute_abs)(TC * _x, unsigned int _n, T * _y)
+{
+    unsigned int i = 0;
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+    // four samples at a time
+    float * x = (float *)_x;
+    for (i = 0; i + 4 <= _n; i += 4) {
+        __m128 v0 = _mm_loadu_ps(x + 2*i    );
+        __m128 v1 = _mm_loadu_ps(x + 2*i + 4);
+        v0 = _mm_mul_ps(v0, v0);
+        v1 = _mm_mul_ps(v1, v1);
+        __m128 re = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0));
+        __m128 im = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1));
+        _mm_storeu_ps(_y + i, _mm_sqrt_ps(_mm_add_ps(re, im)));
+    }
+#endif
+    for ( ; i < _n; i++)
+        _y[i] = sqrtf(crealf(_x[i])*crealf(_x[i]) + cimagf(_x[i])*cimagf(_x[i]));
+}
+
+// correlate input against references (already conjugated), computing the
+// sum of products and sum of magnitude products
+void SYNTH(_correlate)(TC *         _x,
+                       T *          _x_abs,
+                       TC *         _r,
+                       T *          _r_abs,
+                       unsigned int _n,
+                       TC *         _v,
+                       T *          _sum)
+{
+    unsigned int i = 0;
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+    // two complex samples at a time: accumulate x*real(r) and x*imag(r)
+    // separately and combine once at the end
+    float * x = (float *)_x;
+    float * r = (float *)_r;
+    __m128 a = _mm_setzero_ps();
+    __m128 b = _mm_setzero_ps();
+    for (i = 0; i + 2 <= _n; i += 2) {
+        __m128 vx = _mm_loadu_ps(x + 2*i);
+        __m128 vr = _mm_loadu_ps(r + 2*i);
+        a = _mm_add_ps(a, _mm_mul_ps(vx, _mm_shuffle_ps(vr, vr, _MM_SHUFFLE(2,2,0,0))));
+        b = _mm_add_ps(b, _mm_mul_ps(vx, _mm_shuffle_ps(vr, vr, _MM_SHUFFLE(3,3,1,1))));
+    }
+    a = _mm_add_ps(a, _mm_movehl_ps(a, a));
+    b = _mm_add_ps(b, _mm_movehl_ps(b, b));
+    float sa[4], sb[4];
+    _mm_storeu_ps(sa, a);
+    _mm_storeu_ps(sb, b);
+    TC v = (sa[0] - sb[1]) + _Complex_I*(sa[1] + sb[0]);
+
+    __m128 s = _mm_setzero_ps();
+    unsigned int k;
+    for (k = 0; k + 4 <= _n; k += 4)
+        s = _mm_add_ps(s, _mm_mul_ps(_mm_loadu_ps(_x_abs + k), _mm_loadu_ps(_r_abs + k)));
+    float ss[4];
+    _mm_storeu_ps(ss, s);
+    T sum = ss[0] + ss[1] + ss[2] + ss[3];
+    for ( ; k < _n; k++)
+        sum += _x_abs[k] * _r_abs[k];
+#else
+    TC v   = 0;
+    T  sum = 0;
+    unsigned int k;
+    for (k = 0; k < _n; k++)
+        sum += _x_abs[k] * _r_abs[k];
+#endif
+    for ( ; i < _n; i++)
+        v += _x[i] * _r[i];
+
+    *_v   = v;
+    *_sum = sum;
+}
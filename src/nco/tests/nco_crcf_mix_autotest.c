@@ -61,3 +61,50 @@ void autotest_nco_crcf_mix_block_up()
     nco_crcf_destroy(nco);
 }
 
+
+// block mixing must match mixing one sample at a time exactly
+void autotest_nco_crcf_mix_block_down()
+{
+    // options
+    unsigned int buf_len = 4096;
+    float        phase   = 0.7123f;
+    float        freq    = 0.1324f;
+
+    // create objects
+    nco_crcf nco_0 = nco_crcf_create(LIQUID_NCO);
+    nco_crcf nco_1 = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_set_phase    (nco_0, phase);
+    nco_crcf_set_frequency(nco_0, freq);
+    nco_crcf_set_phase    (nco_1, phase);
+    nco_crcf_set_frequency(nco_1, freq);
+
+    // generate signal
+    float complex buf_0[buf_len];
+    float complex buf_1[buf_len];
+    unsigned int i;
+    for (i=0; i<buf_len; i++)
+        buf_0[i] = 3.0f*randnf() + _Complex_I*1e-3f*randnf();
+
+    // mix signal in blocks of varying length
+    unsigned int n = 0;
+    while (n < buf_len) {
+        unsigned int num_samples = 1 + (n % 37);
+        num_samples = n + num_samples > buf_len ? buf_len - n : num_samples;
+        nco_crcf_mix_block_down(nco_1, &buf_0[n], &buf_1[n], num_samples);
+        n += num_samples;
+    }
+
+    // compare result to mixing each sample
+    for (i=0; i<buf_len; i++) {
+        float complex v;
+        nco_crcf_mix_down(nco_0, buf_0[i], &v);
+        nco_crcf_step(nco_0);
+        CONTEND_EQUALITY( crealf(buf_1[i]), crealf(v) );
+        CONTEND_EQUALITY( cimagf(buf_1[i]), cimagf(v) );
+    }
+    CONTEND_EQUALITY( nco_crcf_get_phase(nco_1), nco_crcf_get_phase(nco_0) );
+
+    // destroy objects
+    nco_crcf_destroy(nco_0);
+    nco_crcf_destroy(nco_1);
+}
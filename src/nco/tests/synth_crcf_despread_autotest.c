@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <complex.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// generate QPSK spreading code from m-sequence
+static void synth_crcf_despread_gen_code(unsigned int    _m,
+                                         float complex * _code,
+                                         unsigned int    _len)
+{
+    msequence ms = msequence_create_default(_m);
+    unsigned int i;
+    for (i=0; i<_len; i++) {
+        _code[i]  = (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2);
+        _code[i] += (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2) * _Complex_I;
+    }
+    msequence_destroy(ms);
+}
+
+// spread symbols, despread in a single block and compare with both the
+// transmitted symbols and symbol-by-symbol despreading (which must give
+// identical results)
+void synth_crcf_despread_block_test(unsigned int _m,
+                                    unsigned int _len,
+                                    float        _dtheta)
+{
+    unsigned int num_symbols = 40;
+    float        tol         = 1e-4f;
+
+    float complex code[_len];
+    synth_crcf_despread_gen_code(_m, code, _len);
+    synth_crcf tx  = synth_crcf_create(code, _len);
+    synth_crcf rx0 = synth_crcf_create(code, _len);
+    synth_crcf rx1 = synth_crcf_create(code, _len);
+    synth_crcf rx2 = synth_crcf_create(code, _len);
+    synth_crcf rx3 = synth_crcf_create(code, _len);
+    synth_crcf_adjust_frequency(tx,  _dtheta);
+    synth_crcf_adjust_frequency(rx0, _dtheta);
+    synth_crcf_adjust_frequency(rx1, _dtheta);
+    synth_crcf_adjust_frequency(rx2, _dtheta);
+    synth_crcf_adjust_frequency(rx3, _dtheta);
+
+    // spread random QPSK symbols
+    float complex sym[num_symbols];
+    float complex chips[num_symbols*_len];
+    unsigned int i;
+    for (i=0; i<num_symbols; i++) {
+        sym[i] = cexpf(_Complex_I*(M_PI/4 + M_PI/2*(rand() % 4)));
+        synth_crcf_spread(tx, sym[i], chips + i*_len);
+    }
+
+    // despread block, and one symbol at a time
+    float complex early[num_symbols], punctual[num_symbols], late[num_symbols];
+    float complex y[num_symbols], y_block[num_symbols];
+    float complex e[num_symbols], p[num_symbols], l[num_symbols];
+    synth_crcf_despread_triple_block(rx0, chips, num_symbols, early, punctual, late);
+    synth_crcf_despread_block(rx2, chips, num_symbols, y_block);
+    for (i=0; i<num_symbols; i++) {
+        synth_crcf_despread(rx1, chips + i*_len, &y[i]);
+        synth_crcf_despread_triple(rx3, chips + i*_len, &e[i], &p[i], &l[i]);
+    }
+
+    for (i=0; i<num_symbols; i++) {
+        // perfectly aligned, so punctual correlation recovers symbol
+        if (_dtheta == 0.0f) {
+            CONTEND_DELTA( crealf(punctual[i]), crealf(sym[i]), tol );
+            CONTEND_DELTA( cimagf(punctual[i]), cimagf(sym[i]), tol );
+        }
+        CONTEND_EQUALITY( crealf(punctual[i]), crealf(y[i]) );
+        CONTEND_EQUALITY( cimagf(punctual[i]), cimagf(y[i]) );
+        CONTEND_EQUALITY( crealf(y_block[i]),  crealf(y[i]) );
+        CONTEND_EQUALITY( cimagf(y_block[i]),  cimagf(y[i]) );
+        CONTEND_EQUALITY( crealf(early[i]),    crealf(e[i]) );
+        CONTEND_EQUALITY( cimagf(early[i]),    cimagf(e[i]) );
+        CONTEND_EQUALITY( crealf(punctual[i]), crealf(p[i]) );
+        CONTEND_EQUALITY( cimagf(punctual[i]), cimagf(p[i]) );
+        CONTEND_EQUALITY( crealf(late[i]),     crealf(l[i]) );
+        CONTEND_EQUALITY( cimagf(late[i]),     cimagf(l[i]) );
+
+        // early/late references are half-chip offsets and correlate less
+        CONTEND_LESS_THAN( cabsf(early[i]), cabsf(punctual[i]) + tol );
+        CONTEND_LESS_THAN( cabsf(late[i]),  cabsf(punctual[i]) + tol );
+    }
+
+    // synthesizers remain aligned
+    CONTEND_DELTA( synth_crcf_get_phase(rx0), synth_crcf_get_phase(rx1), tol );
+    CONTEND_DELTA( synth_crcf_get_phase(rx0), synth_crcf_get_phase(tx),  tol );
+    CONTEND_EQUALITY( synth_crcf_get_phase(rx2), synth_crcf_get_phase(rx1) );
+    CONTEND_EQUALITY( synth_crcf_get_phase(rx3), synth_crcf_get_phase(rx0) );
+
+    synth_crcf_destroy(tx);
+    synth_crcf_destroy(rx0);
+    synth_crcf_destroy(rx1);
+    synth_crcf_destroy(rx2);
+    synth_crcf_destroy(rx3);
+}
+
+void autotest_synth_crcf_despread_block_L31() { synth_crcf_despread_block_test(5,  31, 0.0f  ); }
+void autotest_synth_crcf_despread_block_L64() { synth_crcf_despread_block_test(7,  64, 0.0f  ); }
+void autotest_synth_crcf_despread_block_df()  { synth_crcf_despread_block_test(7,  64, 0.004f); }
+
+// correlate against every code phase and find the offset of the received code
+void synth_crcf_correlate_phases_test(unsigned int _m,
+                                      unsigned int _len,
+                                      unsigned int _offset)
+{
+    float tol = 1e-4f;
+
+    float complex code[_len];
+    synth_crcf_despread_gen_code(_m, code, _len);
+    synth_crcf q = synth_crcf_create(code, _len);
+
+    // received code starting at table entry '_offset', with arbitrary
+    // gain/phase and a little noise
+    float complex g = 0.3f * cexpf(_Complex_I*1.2f);
+    float complex x[_len];
+    unsigned int i;
+    for (i=0; i<_len; i++)
+        x[i] = g*code[(i + _offset) % _len] + 1e-3f*(randnf() + _Complex_I*randnf());
+
+    // correlate
+    float complex y[_len];
+    synth_crcf_correlate_phases(q, x, y);
+
+    // compare with direct computation and find peak
+    unsigned int p, p_max = 0;
+    for (p=0; p<_len; p++) {
+        float complex v = 0;
+        float sum = 0;
+        for (i=0; i<_len; i++) {
+            v   += x[i] * conjf(code[(i + p) % _len]);
+            sum += cabsf(x[i]) * cabsf(code[(i + p) % _len]);
+        }
+        CONTEND_DELTA( crealf(y[p]), crealf(v/sum), tol );
+        CONTEND_DELTA( cimagf(y[p]), cimagf(v/sum), tol );
+
+        if (cabsf(y[p]) > cabsf(y[p_max]))
+            p_max = p;
+    }
+    CONTEND_EQUALITY( p_max, _offset );
+    CONTEND_DELTA( cargf(y[p_max]), 1.2f, 0.01f );
+
+    synth_crcf_destroy(q);
+}
+
+void autotest_synth_crcf_correlate_phases_L31() { synth_crcf_correlate_phases_test(5, 31, 17); }
+void autotest_synth_crcf_correlate_phases_L64() { synth_crcf_correlate_phases_test(7, 64,  0); }
+void autotest_synth_crcf_correlate_phases_L63() { synth_crcf_correlate_phases_test(6, 63, 62); }
@@ -57,6 +57,40 @@ void bsequence_correlate_bench(struct rusage *_start,
     bsequence_destroy(bs2);
 }
 
+// Helper function for pushing bits; _num_bits bits per call
+void bsequence_push_bench(struct rusage *_start,
+                          struct rusage *_finish,
+                          unsigned long int *_num_iterations,
+                          unsigned int _n,
+                          unsigned int _num_bits)
+{
+    // normalize number of iterations
+    *_num_iterations *= 200;
+    *_num_iterations /= _n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // create binary sequence
+    bsequence bs = bsequence_create(_n);
+
+    unsigned long int i;
+    unsigned int j;
+
+    // start trials: push 32 bits per iteration
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        for (j=0; j<32; j+=_num_bits) {
+            if (_num_bits == 1)
+                bsequence_push(bs, (i >> j) & 1);
+            else
+                bsequence_push_bits(bs, (unsigned int)(i ^ j), _num_bits);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    // clean up memory
+    bsequence_destroy(bs);
+}
+
 #define BSEQUENCE_BENCHMARK_API(N)          \
 (   struct rusage *_start,                  \
     struct rusage *_finish,                 \
@@ -69,3 +103,16 @@ void benchmark_bsequence_xcorr_n64      BSEQUENCE_BENCHMARK_API(64)
 void benchmark_bsequence_xcorr_n256     BSEQUENCE_BENCHMARK_API(256)
 void benchmark_bsequence_xcorr_n1024    BSEQUENCE_BENCHMARK_API(1024)
 
+
+#define BSEQUENCE_PUSH_BENCHMARK_API(N,B)   \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ bsequence_push_bench(_start, _finish, _num_iterations, N, B); }
+
+// push 32 bits one at a time, or in groups
+void benchmark_bsequence_push_n64_b1    BSEQUENCE_PUSH_BENCHMARK_API(  64,  1)
+void benchmark_bsequence_push_n64_b32   BSEQUENCE_PUSH_BENCHMARK_API(  64, 32)
+void benchmark_bsequence_push_n1024_b1  BSEQUENCE_PUSH_BENCHMARK_API(1024,  1)
+void benchmark_bsequence_push_n1024_b8  BSEQUENCE_PUSH_BENCHMARK_API(1024,  8)
+void benchmark_bsequence_push_n1024_b32 BSEQUENCE_PUSH_BENCHMARK_API(1024, 32)
@@ -33,12 +33,14 @@
 
 #include "liquid.internal.h"
 
-// 
+// sequence is stored in 64-bit blocks with the most recent bit in the
+// least-significant position of the last block; unused bits in the
+// most-significant block are always zero
 struct bsequence_s {
-    unsigned int * s;           // sequence array, memory pointer
+    uint64_t * s;               // sequence array, memory pointer
     unsigned int num_bits;      // number of bits in sequence
     unsigned int num_bits_msb;  // number of bits in most-significant block
-    unsigned int bit_mask_msb;  // bit mask for most-significant block
+    uint64_t bit_mask_msb;      // bit mask for most-significant block
     unsigned int s_len;         // length of array, number of allocated blocks
 };
 
@@ -56,23 +58,19 @@ bsequence bsequence_create(unsigned int _num_bits)
     bs->num_bits = _num_bits;
     
     // initialize array length
-    div_t d = div( bs->num_bits, sizeof(unsigned int)*8 );
+    div_t d = div( bs->num_bits, 64 );
     bs->s_len = d.quot;
     bs->s_len += (d.rem > 0) ? 1 : 0;
 
     // number of bits in MSB block
-    bs->num_bits_msb = (d.rem == 0) ? 8*sizeof(unsigned int) : (unsigned int) d.rem;
+    bs->num_bits_msb = (d.rem == 0) ? 64 : (unsigned int) d.rem;
 
     // bit mask for MSB block
-    unsigned int i;
-    bs->bit_mask_msb = 0;
-    for (i=0; i<bs->num_bits_msb; i++) {
-        bs->bit_mask_msb <<= 1;
-        bs->bit_mask_msb |=  1;
-    }
+    bs->bit_mask_msb = bs->num_bits_msb == 64 ? ~(uint64_t)0 :
+                       ((uint64_t)1 << bs->num_bits_msb) - 1;
 
     // initialze array with zeros
-    bs->s = (unsigned int*) malloc( bs->s_len * sizeof(unsigned int) );
+    bs->s = (uint64_t*) malloc( bs->s_len * sizeof(uint64_t) );
     bsequence_reset(bs);
 
     return bs;
@@ -87,35 +85,31 @@ void bsequence_destroy(bsequence _bs)
 
 void bsequence_reset(bsequence _bs)
 {
-    memset( _bs->s, 0x00, (_bs->s_len)*sizeof(unsigned int) );
+    memset( _bs->s, 0x00, (_bs->s_len)*sizeof(uint64_t) );
 }
 
 // initialize sequence on external array
 void bsequence_init(bsequence _bs,
                     unsigned char * _v)
 {
-    // push single bit at a time
+    // push full bytes at a time
     unsigned int i;
-    unsigned int k=0;
-    unsigned char byte = 0x00;
-    unsigned char mask = 0x80;
-    for (i=0; i<_bs->num_bits; i++) {
-        if ( (i%8)==0 ) {
-            byte = _v[k++];
-            mask = 0x80;
-        }
-
-        bsequence_push(_bs, byte & mask ? 1 : 0);
-        mask >>= 1;
-    }
+    unsigned int num_bytes = _bs->num_bits / 8;
+    for (i=0; i<num_bytes; i++)
+        bsequence_push_bits(_bs, _v[i], 8);
+
+    // push remaining most-significant bits of last byte
+    unsigned int r = _bs->num_bits % 8;
+    if (r > 0)
+        bsequence_push_bits(_bs, _v[num_bytes] >> (8-r), r);
 }
 
 // Print sequence to the screen
 void bsequence_print(bsequence _bs)
 {
     unsigned int i, j;
-    unsigned int chunk;
-    unsigned int p = 8*sizeof(unsigned int);
+    uint64_t chunk;
+    unsigned int p = 64;
 
     printf("bsequence[%6u]:     ", _bs->num_bits);
     for (i=0; i<_bs->s_len; i++) {
@@ -139,9 +133,9 @@ void bsequence_print(bsequence _bs)
 void bsequence_push(bsequence _bs,
                     unsigned int _bit)
 {
-    unsigned int overflow;
+    uint64_t overflow;
     unsigned int i;
-    unsigned int p = 8*sizeof(unsigned int);
+    unsigned int p = 64;
 
     // shift first block
     _bs->s[0] <<= 1;
@@ -162,12 +156,40 @@ void bsequence_push(bsequence _bs,
     _bs->s[_bs->s_len-1] |= ( _bit & 1 );
 }
 
+// push several bits in from the right at once, most-significant first
+//  _bs     :   binary sequence
+//  _bits   :   bits to push, right-justified
+//  _n      :   number of bits to push, _n <= 32
+void bsequence_push_bits(bsequence    _bs,
+                         unsigned int _bits,
+                         unsigned int _n)
+{
+    if (_n == 0) {
+        return;
+    } else if (_n > 8*sizeof(unsigned int)) {
+        fprintf(stderr,"error: bsequence_push_bits(), cannot push more than %u bits at once\n",
+                (unsigned int)(8*sizeof(unsigned int)));
+        exit(-1);
+    }
+
+    // shift each block by _n bits, carrying in from the next block
+    unsigned int i;
+    for (i=0; i<_bs->s_len-1; i++)
+        _bs->s[i] = (_bs->s[i] << _n) | (_bs->s[i+1] >> (64-_n));
+
+    // append input bits to last block
+    uint64_t mask = ((uint64_t)1 << _n) - 1;
+    _bs->s[_bs->s_len-1] = (_bs->s[_bs->s_len-1] << _n) | ((uint64_t)_bits & mask);
+
+    // clear unused bits in most-significant block
+    _bs->s[0] &= _bs->bit_mask_msb;
+}
+
 // circular shift (left)
 void bsequence_circshift(bsequence _bs)
 {
     // extract most-significant (left-most) bit
-    unsigned int msb_mask = 1 << (_bs->num_bits_msb-1);
-    unsigned int b = (_bs->s[0] & msb_mask) >> (_bs->num_bits_msb-1);
+    unsigned int b = (unsigned int)(_bs->s[0] >> (_bs->num_bits_msb-1)) & 1;
 
     // push bit into sequence
     bsequence_push(_bs, b);
@@ -177,27 +199,18 @@ void bsequence_circshift(bsequence _bs)
 signed int bsequence_correlate(bsequence _bs1,
                                bsequence _bs2)
 {
-    signed int rxy = 0;
-    unsigned int i;
-    
     if ( _bs1->s_len != _bs2->s_len ) {
         printf("error: bsequence_correlate(), binary sequences must be the same length!\n");
         exit(-1);
     }
-    
-    unsigned int chunk;
 
-    for (i=0; i<_bs1->s_len; i++) {
-        //
-        chunk = _bs1->s[i] ^ _bs2->s[i];
-        chunk = ~chunk;
-
-        rxy += liquid_count_ones(chunk);
-    }
+    // count differing bits; unused bits in most-significant block are
+    // zero in both sequences and never differ
+    unsigned int d;
+    liquid_count_bit_errors_bank64(_bs1->s, _bs2->s, _bs1->s_len, 1, &d);
 
-    // compensate for most-significant block and return
-    rxy -= 8*sizeof(unsigned int) - _bs1->num_bits_msb;
-    return rxy;
+    // return number of matching bits
+    return (signed int)(_bs1->num_bits) - (signed int)d;
 }
 
 // compute the binary addition of two bit sequences
@@ -251,7 +264,7 @@ unsigned int bsequence_accumulate(bsequence _bs)
     unsigned int r=0;
 
     for (i=0; i<_bs->s_len; i++)
-        r += liquid_count_ones(_bs->s[i]);
+        r += liquid_count_ones_uint64(_bs->s[i]);
 
     return r;
 }
@@ -270,13 +283,13 @@ unsigned int bsequence_index(bsequence _bs,
         fprintf(stderr,"error: bsequence_index(), invalid index %u\n", _i);
         exit(-1);
     }
-    div_t d = div( _i, 8*sizeof(unsigned int) );
+    div_t d = div( _i, 64 );
 
     // compute byte index
     unsigned int k = _bs->s_len - d.quot - 1;
 
     // return particular bit at byte index
-    return (_bs->s[k] >> d.rem ) & 1;
+    return (unsigned int)(_bs->s[k] >> d.rem ) & 1;
 }
 
 // intialize two sequences to complementary codes.  sequences must
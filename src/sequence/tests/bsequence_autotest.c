@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -202,3 +203,36 @@ void autotest_bsequence_accumulate()
 }
 
 
+
+// 
+// test pushing several bits at once across 64-bit block boundaries
+//
+void autotest_bsequence_push_bits()
+{
+    unsigned int n = 150;   // sequence length (spans three blocks)
+    unsigned int i, j;
+
+    // create sequences
+    bsequence q0 = bsequence_create(n);
+    bsequence q1 = bsequence_create(n);
+
+    // push random bits in variable-length groups into q1, and one
+    // bit at a time into q0
+    for (i=0; i<40; i++) {
+        unsigned int num_bits = i % 33;
+        unsigned int bits     = rand() ^ (rand() << 16);
+        bsequence_push_bits(q1, bits, num_bits);
+        for (j=0; j<num_bits; j++)
+            bsequence_push(q0, (bits >> (num_bits-j-1)) & 1);
+    }
+
+    // sequences should be identical
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY( bsequence_index(q0,i), bsequence_index(q1,i) );
+    CONTEND_EQUALITY( bsequence_correlate(q0,q1), n );
+    CONTEND_EQUALITY( bsequence_accumulate(q0), bsequence_accumulate(q1) );
+
+    // clean up memory
+    bsequence_destroy(q0);
+    bsequence_destroy(q1);
+}
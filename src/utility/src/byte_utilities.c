@@ -24,6 +24,7 @@
 // general utilities for manipulating bits and bytes, including
 //  * counting ones in a byte, word, long word, etc.
 //  * counting bit differences (e.g. errors) in arrays
+//  * counting bit differences against banks of 64-bit word sequences
 //  * arrays for fast counting
 //  * array for reversing bytes
 //
@@ -31,6 +32,26 @@
 #include <stdio.h>
 #include "liquid.internal.h"
 
+// Use hardware population count when available. If the compiler already
+// targets POPCNT use it directly; otherwise on x86 with gcc/clang compile
+// a second version of the bank kernel for POPCNT and select at run time.
+#if defined(__POPCNT__)
+#  define LIQUID_POPCOUNT_NATIVE   1
+#  define LIQUID_POPCOUNT_DISPATCH 0
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define LIQUID_POPCOUNT_NATIVE   0
+#  define LIQUID_POPCOUNT_DISPATCH 1
+#else
+#  define LIQUID_POPCOUNT_NATIVE   0
+#  define LIQUID_POPCOUNT_DISPATCH 0
+#endif
+
+#if defined(__GNUC__)
+#  define LIQUID_FORCE_INLINE static inline __attribute__((always_inline))
+#else
+#  define LIQUID_FORCE_INLINE static inline
+#endif
+
 // count the number of ones in an integer
 unsigned int liquid_count_ones(unsigned int _x) {
 #if SIZEOF_INT == 2
@@ -110,6 +131,100 @@ unsigned int count_bit_errors_array(unsigned char * _msg0,
     return num_bit_errors;
 }
 
+// count the number of ones in a 64-bit word (parallel bit summation)
+static inline unsigned int liquid_count_ones_uint64_port(uint64_t _x)
+{
+    _x = _x - ((_x >> 1) & 0x5555555555555555ULL);
+    _x = (_x & 0x3333333333333333ULL) + ((_x >> 2) & 0x3333333333333333ULL);
+    _x = (_x + (_x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (unsigned int)((_x * 0x0101010101010101ULL) >> 56);
+}
+
+// count the number of ones in a 64-bit word
+unsigned int liquid_count_ones_uint64(uint64_t _x)
+{
+#if LIQUID_POPCOUNT_NATIVE
+    return __builtin_popcountll(_x);
+#else
+    return liquid_count_ones_uint64_port(_x);
+#endif
+}
+
+// bank kernel: _hw selects hardware population count and is resolved at
+// compile time once inlined into each of the wrappers below
+LIQUID_FORCE_INLINE
+void liquid_count_bit_errors_bank64_kernel(uint64_t *     _x,
+                                           uint64_t *     _h,
+                                           unsigned int   _num_words,
+                                           unsigned int   _num_seq,
+                                           unsigned int * _d,
+                                           int            _hw)
+{
+    unsigned int i, k;
+    for (k=0; k<_num_seq; k++) {
+        unsigned int d = 0;
+        for (i=0; i<_num_words; i++) {
+            uint64_t v = _x[i] ^ _h[i];
+#if defined(__GNUC__)
+            d += _hw ? __builtin_popcountll(v) : liquid_count_ones_uint64_port(v);
+#else
+            d += liquid_count_ones_uint64_port(v);
+#endif
+        }
+        _d[k] = d;
+        _h   += _num_words;
+    }
+}
+
+#if LIQUID_POPCOUNT_DISPATCH
+// portable and POPCNT versions of bank kernel
+static void liquid_count_bit_errors_bank64_port(uint64_t *     _x,
+                                                uint64_t *     _h,
+                                                unsigned int   _num_words,
+                                                unsigned int   _num_seq,
+                                                unsigned int * _d)
+{
+    liquid_count_bit_errors_bank64_kernel(_x, _h, _num_words, _num_seq, _d, 0);
+}
+
+__attribute__((target("popcnt")))
+static void liquid_count_bit_errors_bank64_popcnt(uint64_t *     _x,
+                                                  uint64_t *     _h,
+                                                  unsigned int   _num_words,
+                                                  unsigned int   _num_seq,
+                                                  unsigned int * _d)
+{
+    liquid_count_bit_errors_bank64_kernel(_x, _h, _num_words, _num_seq, _d, 1);
+}
+#endif
+
+// count the number of different bits between an input sequence and each
+// of a bank of reference sequences, all packed in 64-bit words
+//  _x          :   input sequence, [size: _num_words x 1]
+//  _h          :   reference sequences, [size: _num_seq*_num_words x 1]
+//  _num_words  :   number of words in each sequence
+//  _num_seq    :   number of reference sequences
+//  _d          :   number of different bits, [size: _num_seq x 1]
+void liquid_count_bit_errors_bank64(uint64_t *     _x,
+                                    uint64_t *     _h,
+                                    unsigned int   _num_words,
+                                    unsigned int   _num_seq,
+                                    unsigned int * _d)
+{
+#if LIQUID_POPCOUNT_DISPATCH
+    // select kernel on every call: the cpu model is filled in by the
+    // runtime before main() and only read here, so this is safe to call
+    // from multiple threads without any shared lazily-initialized state
+    if (__builtin_cpu_supports("popcnt"))
+        liquid_count_bit_errors_bank64_popcnt(_x, _h, _num_words, _num_seq, _d);
+    else
+        liquid_count_bit_errors_bank64_port(_x, _h, _num_words, _num_seq, _d);
+#else
+    liquid_count_bit_errors_bank64_kernel(_x, _h, _num_words, _num_seq, _d,
+                                          LIQUID_POPCOUNT_NATIVE);
+#endif
+}
+
 // print string of bits to standard output
 void liquid_print_bitstring(unsigned int _x,
                             unsigned int _n)